@@ -14,4 +14,11 @@ echo "*******************************"
 echo "Testing 'main' executable file."
 echo "*******************************"
 
-./test/exe/main
\ No newline at end of file
+./test/exe/main
+
+echo
+echo "***********************************"
+echo "Testing 'main_cpp' executable file."
+echo "***********************************"
+
+./test/exe/main_cpp
\ No newline at end of file
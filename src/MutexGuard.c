@@ -1,5 +1,9 @@
 /********** Include statements ***********/
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 #include <stdint.h>
 #include <pthread.h>
@@ -9,18 +13,67 @@
 #include <time.h>
 #include <limits.h>
 #include <errno.h>
+#include <signal.h>
+#include <sched.h>
 #include <execinfo.h>
 #include <stdbool.h>
+#include <fcntl.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <dlfcn.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
 #include "MutexGuard_api.h"
 
+// USDT probes are compiled in whenever sys/sdt.h (systemtap-sdt-dev) is available, unless MTX_GRD_NO_USDT is defined.
+#if !defined(MTX_GRD_NO_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define MTX_GRD_USDT_ENABLED
+#endif
+#endif
+
 /*****************************************/
 
 /*********** Define statements ***********/
 
+/// @brief USDT probes (provider "mtx_grd"). Each one is a single nop until a tracer (bpftrace, perf, ...) attaches to it.
+/// Without USDT support they compile to nothing: arguments are only evaluated and discarded, and no stapsdt note is emitted.
+#ifdef MTX_GRD_USDT_ENABLED
+#define MTX_GRD_PROBE3(name, arg1, arg2, arg3)                      DTRACE_PROBE3(mtx_grd, name, arg1, arg2, arg3)
+#define MTX_GRD_PROBE4(name, arg1, arg2, arg3, arg4)                DTRACE_PROBE4(mtx_grd, name, arg1, arg2, arg3, arg4)
+#define MTX_GRD_PROBE5(name, arg1, arg2, arg3, arg4, arg5)          DTRACE_PROBE5(mtx_grd, name, arg1, arg2, arg3, arg4, arg5)
+#else
+#define MTX_GRD_PROBE3(name, arg1, arg2, arg3)                      do { (void)(arg1); (void)(arg2); (void)(arg3); } while(0)
+#define MTX_GRD_PROBE4(name, arg1, arg2, arg3, arg4)                do { (void)(arg1); (void)(arg2); (void)(arg3); (void)(arg4); } while(0)
+#define MTX_GRD_PROBE5(name, arg1, arg2, arg3, arg4, arg5)          do { (void)(arg1); (void)(arg2); (void)(arg3); (void)(arg4); (void)(arg5); } while(0)
+#endif
+
 #ifndef __MTX_GRD_FULL_BT_MAX_SIZE__
 #define __MTX_GRD_FULL_BT_MAX_SIZE__    100
 #endif
 
+#ifndef __MTX_GRD_PROFILE_STACK_NUM__
+#define __MTX_GRD_PROFILE_STACK_NUM__   1024
+#endif
+
+#ifndef __MTX_GRD_PROFILE_DEPTH__
+#define __MTX_GRD_PROFILE_DEPTH__       32
+#endif
+
+#ifndef __MTX_GRD_TRACE_EVENT_NUM__
+#define __MTX_GRD_TRACE_EVENT_NUM__     16384
+#endif
+
 #ifndef __MTX_GRD_LAST_LOCK_ERR_STRING_LEN__
 #define __MTX_GRD_LAST_LOCK_ERR_STRING_LEN__    10000
 #endif
@@ -32,6 +85,7 @@
 #define MTX_GRD_TOUT_1_SEC_AS_NS    (uint64_t)1000000000
 
 #define MTX_GRD_LAST_LOCK_ERR_DEF_MSG   "Could not lock target mutex. "
+#define MTX_GRD_OWNER_DEAD_ERR_DEF_MSG  "Previous owner died while holding MTX_GRD. "
 #define MTX_GRD_STD_ERR_DEF_MSG         "Standard error code. "
 
 #define MTX_GRD_PROC_MAX_LEN        (uint16_t)256
@@ -44,11 +98,118 @@
 #define MTX_GRD_FN_LINE_DELIMITER               ':'
 
 #define MTX_GRD_ACQ_LOCATION_FULL_FORMAT    "#%u %p (+%p): %s defined at %s:%llu\r\n"
+#define MTX_GRD_ACQ_CALLSITE_FORMAT         "#%u %s+0x%lx\r\n"
+
+#define MTX_GRD_BUILD_ID_NOTE_NAME      "GNU"
+#define MTX_GRD_BUILD_ID_NOTE_ALIGN     4
+#define MTX_GRD_BUILD_ID_STR_LEN        ((__MTX_GRD_BUILD_ID_LEN__ * 2) + 1)
+
+#define MTX_GRD_SHM_HEADER_SIZE         (size_t)64
+#define MTX_GRD_SHM_READY_MAGIC         (uint32_t)0x4D475244
+#define MTX_GRD_SHM_PERMISSIONS         0600
+#define MTX_GRD_SHM_POLL_PERIOD_NS      (uint64_t)1000000
+#define MTX_GRD_SHM_POLL_MAX_ATTEMPTS   1000
+
+#define MTX_GRD_DUMP_STR_LEN            (size_t)4096
+#define MTX_GRD_DUMP_HEADER_FORMAT      "MTX_GRD dump (PID: <%d>, executable base address: <0x%lx>)\r\n"
+#define MTX_GRD_DUMP_GUARD_FORMAT       "MTX_GRD <%s> at <%p> held by thread with ID: <0x%lx> (PID: <%d>, TID: <%d>) for <%lu> ns, <%u> waiter(s), locked at the following address(es):\r\n"
+#define MTX_GRD_DUMP_ADDRESS_FORMAT     "#%u %p\r\n"
+#define MTX_GRD_DUMP_FOOTER_FORMAT      "%u guard(s) registered, %u held\r\n"
+#define MTX_GRD_DUMP_UNNAMED            "unnamed"
+#define MTX_GRD_DUMP_NULL_STR           "(null)"
+#define MTX_GRD_DUMP_NUMBER_LEN         24
+#define MTX_GRD_DUMP_HEX_DIGITS         "0123456789abcdef"
+
+#define MTX_GRD_WATCHDOG_TICK_NS            (uint64_t)10000000
+#define MTX_GRD_WATCHDOG_MAX_REPORTS        16
+#define MTX_GRD_MSG_ERR_HOLD_BUDGET         "MTX_GRD <%s> at <%p> locked at the following address(es):\r\n"
+#define MTX_GRD_MSG_ERR_HOLD_BUDGET_OWNER   "Held by thread with ID: <0x%lx> (PID: <%d>, TID: <%d>) for more than its budget (%lu s, %lu ns)"
+
+#define MTX_GRD_HIST_BUCKET_BASE_NS         (uint64_t)1000
+#define MTX_GRD_HIST_BUCKET_FACTOR_SHIFT    2
+
+#define MTX_GRD_SAMPLING_UNIT               ((int64_t)1 << 32)
+#define MTX_GRD_SAMPLING_RANDOM_MULTIPLIER  0x2545F4914F6CDD1DULL
+#define MTX_GRD_SAMPLING_SEED_MULTIPLIER    0x9E3779B97F4A7C15ULL
+
+#define MTX_GRD_SLOW_CAPTURE_PERCENTILE_SCALE   10000U
+#define MTX_GRD_SLOW_CAPTURE_MIN_SAMPLES        100ULL
+#define MTX_GRD_SLOW_CAPTURE_REFRESH_NUM        64
+#define MTX_GRD_SLOW_CAPTURE_UNNAMED            "(unnamed)"
+#define MTX_GRD_SLOW_CAPTURE_HEADER_FORMAT      "#%llu MTX_GRD <%s> at <%p> locked at %s waited %llu ns (threshold %llu ns), waiter TID <%d>:\n"
+#define MTX_GRD_SLOW_CAPTURE_FRAME_FORMAT       "    #%u %p %s\n"
+#define MTX_GRD_SLOW_CAPTURE_OWNER_FORMAT       "  Owner (PID <%d>, TID <%d>) had locked it at:\n"
+
+#define MTX_GRD_EXPORT_STR_LEN              (size_t)4096
+#define MTX_GRD_EXPORT_LABEL_LEN            (size_t)256
+#define MTX_GRD_EXPORT_OTHER                "other"
+#define MTX_GRD_EXPORT_TMP_SUFFIX           ".tmp"
+#define MTX_GRD_EXPORT_FILE_PERMISSIONS     0644
+#define MTX_GRD_EXPORT_SOCKET_BACKLOG       8
+#define MTX_GRD_EXPORT_POLL_PERIOD_MS       100
+#define MTX_GRD_EXPORT_REQUEST_LEN          1024
+#define MTX_GRD_EXPORT_SEND_TIMEOUT_MS      1000
+#define MTX_GRD_STATS_SHM_PERMISSIONS       0644
+#define MTX_GRD_EXPORT_HTTP_HEADER          "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nConnection: close\r\n\r\n"
+
+#define MTX_GRD_PROFILE_FNV_OFFSET          (uint64_t)14695981039346656037ULL
+#define MTX_GRD_PROFILE_FNV_PRIME           (uint64_t)1099511628211ULL
+#define MTX_GRD_PROFILE_STRINGS_MIN_SIZE    (size_t)64
+#define MTX_GRD_PROFILE_MAPPING_NUM         64
+#define MTX_GRD_PROFILE_CONTENTIONS         "contentions"
+#define MTX_GRD_PROFILE_COUNT               "count"
+#define MTX_GRD_PROFILE_DELAY               "delay"
+#define MTX_GRD_PROFILE_NANOSECONDS         "nanoseconds"
+#define MTX_GRD_PROFILE_DROPPED_FORMAT      "%llu contended acquisitions dropped (profile full)"
+
+#define MTX_GRD_TRACE_1_US_AS_NS            (uint64_t)1000
+#define MTX_GRD_TRACE_CATEGORY              "MTX_GRD"
+#define MTX_GRD_TRACE_WAIT_NAME             "waiting for"
+#define MTX_GRD_TRACE_HOLD_NAME             "holding"
+#define MTX_GRD_TRACE_FLOW_NAME             "handoff"
+
+#define MTX_GRD_PB_BUFFER_MIN_SIZE          (size_t)256
+#define MTX_GRD_PB_VARINT_MAX_LEN           10
+#define MTX_GRD_PB_WIRE_VARINT              0
+#define MTX_GRD_PB_WIRE_LEN                 2
+
+// pprof's profile.proto field numbers.
+#define MTX_GRD_PB_PROFILE_SAMPLE_TYPE      1
+#define MTX_GRD_PB_PROFILE_SAMPLE           2
+#define MTX_GRD_PB_PROFILE_MAPPING          3
+#define MTX_GRD_PB_PROFILE_LOCATION         4
+#define MTX_GRD_PB_PROFILE_FUNCTION         5
+#define MTX_GRD_PB_PROFILE_STRING_TABLE     6
+#define MTX_GRD_PB_PROFILE_TIME_NANOS       9
+#define MTX_GRD_PB_PROFILE_DURATION_NANOS   10
+#define MTX_GRD_PB_PROFILE_PERIOD_TYPE      11
+#define MTX_GRD_PB_PROFILE_PERIOD           12
+#define MTX_GRD_PB_PROFILE_COMMENT          13
+#define MTX_GRD_PB_VALUE_TYPE_TYPE          1
+#define MTX_GRD_PB_VALUE_TYPE_UNIT          2
+#define MTX_GRD_PB_SAMPLE_LOCATION_ID       1
+#define MTX_GRD_PB_SAMPLE_VALUE             2
+#define MTX_GRD_PB_MAPPING_ID               1
+#define MTX_GRD_PB_MAPPING_MEMORY_START     2
+#define MTX_GRD_PB_MAPPING_MEMORY_LIMIT     3
+#define MTX_GRD_PB_MAPPING_FILE_OFFSET      4
+#define MTX_GRD_PB_MAPPING_FILENAME         5
+#define MTX_GRD_PB_MAPPING_BUILD_ID         6
+#define MTX_GRD_PB_MAPPING_HAS_FUNCTIONS    7
+#define MTX_GRD_PB_LOCATION_ID              1
+#define MTX_GRD_PB_LOCATION_MAPPING_ID      2
+#define MTX_GRD_PB_LOCATION_ADDRESS         3
+#define MTX_GRD_PB_LOCATION_LINE            4
+#define MTX_GRD_PB_LINE_FUNCTION_ID         1
+#define MTX_GRD_PB_FUNCTION_ID              1
+#define MTX_GRD_PB_FUNCTION_NAME            2
+#define MTX_GRD_PB_FUNCTION_SYSTEM_NAME     3
+#define MTX_GRD_PB_FUNCTION_FILENAME        4
 
 #define MTX_GRD_MSG_ERR_MUTEX_HEADER            "*********************************\r\n"
 #define MTX_GRD_MSG_ERR_MUTEX_TIMEOUT           "Timeout elapsed (%lu s, %lu ns). "
 #define MTX_GRD_MSG_ERR_MUTEX_ACQ               "Thread with ID <0x%lx> cannot acquire mutex at <%p> (%s).\r\n"
-#define MTX_GRD_MSG_ERR_MUTEX_ACQ_ADDR_HEADER   "Locked previously by thread with ID: <0x%lx> at the following address(es):\r\n"
+#define MTX_GRD_MSG_ERR_MUTEX_ACQ_ADDR_HEADER   "Locked previously by thread with ID: <0x%lx> (PID: <%d>, TID: <%d>) at the following address(es):\r\n"
 #define MTX_GRD_MSG_ERR_MUTEX_FOOTER            "---------------------------------\r\n"
 
 #define MTX_GRD_ACQ_FN_NAME_LEN 100
@@ -75,6 +236,34 @@
 
 #define MTX_GRD_BT_FOOTER   "BT END"
 
+#define MTX_GRD_COND_WAITER_WAITING     (uint32_t)0
+#define MTX_GRD_COND_WAITER_REQUEUED    (uint32_t)1
+#define MTX_GRD_COND_WAITER_WOKEN       (uint32_t)2
+
+#define MTX_GRD_COMBINE_SLOT_PENDING    (uint32_t)0
+#define MTX_GRD_COMBINE_SLOT_SLEEPING   (uint32_t)1
+#define MTX_GRD_COMBINE_SLOT_DONE       (uint32_t)2
+#define MTX_GRD_COMBINE_PASS_NUM        4
+
+#define MTX_GRD_MAILBOX_FREE            (uint32_t)0
+#define MTX_GRD_MAILBOX_CLAIMED         (uint32_t)1
+#define MTX_GRD_MAILBOX_PENDING         (uint32_t)2
+#define MTX_GRD_MAILBOX_SLEEPING        (uint32_t)3
+#define MTX_GRD_MAILBOX_DONE            (uint32_t)4
+
+/// @brief Polls spent by delegation clients (waiting for their operations) and servers (waiting for operations) before sleeping
+/// (none on a single CPU, where polling only delays whoever it waits for).
+#define MTX_GRD_DELEGATION_CLIENT_SPIN_NUM  1000
+#define MTX_GRD_DELEGATION_SERVER_SPIN_NUM  10000
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MTX_GRD_CPU_RELAX()             __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define MTX_GRD_CPU_RELAX()             __asm__ __volatile__("yield" ::: "memory")
+#else
+#define MTX_GRD_CPU_RELAX()             __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#endif
+
 #define MTX_GRD_CTRL_MUTEX_CONTROL_FLOW(expression)                                     \
 do                                                                                      \
 {                                                                                       \
@@ -102,6 +291,173 @@ typedef struct C_MUTEX_GUARD_ALIGNED
     char                file_path[PATH_MAX + 1];
 } MTX_GRD_ACQ_LOCATION_DETAIL;
 
+/// @brief Condition variable waiter. Lives on the waiting thread's stack, queued either on the MTX_GRD_COND
+/// (state WAITING, protected by the condition's ctrl_mutex) or on the MTX_GRD after a broadcast (state REQUEUED,
+/// protected by the guard's ctrl_mutex).
+struct MTX_GRD_COND_WAITER
+{
+    struct MTX_GRD_COND_WAITER* prev;
+    struct MTX_GRD_COND_WAITER* next;
+    uint32_t                    state;
+    uint64_t                    wake_ns;
+};
+
+typedef struct MTX_GRD_COND_WAITER MTX_GRD_COND_WAITER;
+
+/// @brief Operation published through MutexGuardExecute. Lives on the publishing thread's stack, pushed onto the guard's combine_head
+/// list (state PENDING, or SLEEPING once its publisher waits for it) until the guard's holder runs it and marks it DONE.
+struct MTX_GRD_COMBINE_SLOT
+{
+    struct MTX_GRD_COMBINE_SLOT*    next;
+    void                            (*fn)(void*);
+    void*                           arg;
+    void*                           address;
+    uint64_t                        publish_ns;
+    bool                            accounted;
+    uint32_t                        state;
+};
+
+typedef struct MTX_GRD_COMBINE_SLOT MTX_GRD_COMBINE_SLOT;
+
+/// @brief Calling thread's latest lock failure (see MutexGuardGetErrorString): the guard's mutex, along with its owner and its dead
+/// owner (if any) as found at the time.
+typedef struct
+{
+    const pthread_mutex_t*  mutex_address;
+    MTX_GRD_ACQ_LOCATION    owner_location;
+    MTX_GRD_ACQ_LOCATION    dead_owner_location;
+} MTX_GRD_LOCK_FAILURE;
+
+/// @brief Statistics shard of a CPU, on cache lines of its own.
+typedef struct __attribute__((aligned(MTX_GRD_CACHE_LINE_SIZE)))
+{
+    MTX_GRD_STATS_SHARD shard;
+} MTX_GRD_STATS_CPU_SHARD;
+
+/// @brief Out-of-line statistics shards of a private guard, allocated on its first recorded acquisition and freed when it is destroyed.
+struct MTX_GRD_STATS_SHARDS
+{
+    MTX_GRD_STATS_CPU_SHARD cpus[__MTX_GRD_STATS_SHARD_NUM__];
+};
+
+/// @brief Delegation client mailbox, on a cache line of its own. Claimed by a client (FREE -> CLAIMED), which then submits an
+/// operation (PENDING, or SLEEPING once the client waits for it) the server runs and marks DONE, before the client frees it again.
+typedef struct __attribute__((aligned(MTX_GRD_CACHE_LINE_SIZE)))
+{
+    uint32_t    state;
+    void        (*fn)(void*);
+    void*       arg;
+    void*       address;
+    uint64_t    submit_ns;
+} MTX_GRD_MAILBOX;
+
+/// @brief Delegation server of a guard (see MutexGuardAttrSetDelegation). Clients ring the doorbell (a futex word) only if they find
+/// the server announced it was going to sleep. Statistics are only written by the server, with the guard's ctrl_mutex held.
+struct MTX_GRD_DELEGATION
+{
+    MTX_GRD_MAILBOX             mailboxes[__MTX_GRD_DELEGATION_CLIENT_NUM__];
+    uint32_t                    doorbell __attribute__((aligned(MTX_GRD_CACHE_LINE_SIZE)));
+    uint32_t                    server_asleep;
+    uint32_t                    stop;
+    bool                        spin;
+    pthread_t                   server;
+    MTX_GRD_DELEGATION_STATS    stats;
+};
+
+typedef struct MTX_GRD_DELEGATION MTX_GRD_DELEGATION;
+
+/// @brief Asynchronous lock request (see MutexGuardLockAsync), queued up on its guard (ctrl_mutex protected) until granted it.
+struct MTX_GRD_ASYNC_WAITER
+{
+    struct MTX_GRD_ASYNC_WAITER*    next;
+    int                             fd;
+    bool                            timed;
+    void*                           address;
+    uint64_t                        wait_start_ns;
+    uint64_t                        deadline_ns;
+};
+
+typedef struct MTX_GRD_ASYNC_WAITER MTX_GRD_ASYNC_WAITER;
+
+/// @brief Source location standing for a lock address (see MutexGuardSourceCallsite).
+typedef struct
+{
+    const char*     file;
+    const char*     function;
+    unsigned int    line;
+} MTX_GRD_SOURCE_CALLSITE;
+
+/// @brief Work deferred until a guard is released (see MutexGuardDeferAfterUnlock).
+typedef struct
+{
+    MTX_GRD*    p_mtx_grd;
+    void        (*fn)(void*);
+    void*       arg;
+} MTX_GRD_DEFERRED_WORK;
+
+/// @brief Flush causes of operation batches (see MTX_GRD_BATCH_STATS).
+typedef enum
+{
+    MTX_GRD_BATCH_FLUSH_EXPLICIT    ,
+    MTX_GRD_BATCH_FLUSH_FULL        ,
+    MTX_GRD_BATCH_FLUSH_TIMED       ,
+    MTX_GRD_BATCH_FLUSH_EXIT        ,
+} MTX_GRD_BATCH_FLUSH_CAUSE;
+
+typedef struct
+{
+    void        (*fn)(void*);
+    void*       arg;
+} MTX_GRD_BATCH_OP;
+
+/// @brief A thread's batch of operations for a guard (unused while p_mtx_grd is NULL).
+typedef struct
+{
+    MTX_GRD*            p_mtx_grd;
+    void*               address;
+    uint64_t            first_ns;
+    unsigned long long  first_seq;
+    size_t              op_num;
+    MTX_GRD_BATCH_OP    ops[__MTX_GRD_BATCH_OP_NUM__];
+} MTX_GRD_BATCH;
+
+/// @brief A thread's batches, allocated on its first queued operation and applied and released when it exits.
+typedef struct
+{
+    MTX_GRD_BATCH       batches[__MTX_GRD_BATCH_GUARD_NUM__];
+    unsigned long long  batch_seq_counter;
+} MTX_GRD_BATCH_SET;
+
+/// @brief Reader-writer guard held in shared mode by a thread.
+typedef struct
+{
+    MTX_GRD_RW*         p_mtx_grd_rw;
+    void*               address;
+    uint64_t            acq_ns;
+    unsigned long long  lock_counter;
+    size_t              bias_slot;
+} MTX_GRD_RW_READ;
+
+/// @brief Visible readers table slot (see MutexGuardRwSetReaderBias), on a cache line of its own: reader-biased guard held by the
+/// reader the slot is hashed to, NULL if free.
+typedef struct __attribute__((aligned(MTX_GRD_CACHE_LINE_SIZE)))
+{
+    MTX_GRD_RW* p_mtx_grd_rw;
+} MTX_GRD_RW_BIAS_SLOT;
+
+/// @brief A thread's shared holds, registered on its first one and released when it exits. Only written by its own thread, under a
+/// seqlock (sequence is odd while they are being updated), so that they can be copied from other threads (see MutexGuardRwGetHolders).
+typedef struct __attribute__((aligned(MTX_GRD_CACHE_LINE_SIZE))) MTX_GRD_RW_READ_SET
+{
+    unsigned long long          sequence;
+    size_t                      read_num;
+    MTX_GRD_RW_READ             reads[__MTX_GRD_RW_READ_NUM__];
+    pthread_t                   thread_id;
+    pid_t                       kernel_tid;
+    struct MTX_GRD_RW_READ_SET* prev;
+    struct MTX_GRD_RW_READ_SET* next;
+} MTX_GRD_RW_READ_SET;
+
 /// @brief Error codes to be stored in mutex_guard_errno.
 typedef enum
 {
@@ -126,6 +482,31 @@ typedef enum
     MTX_GRD_ERR_OUT_OF_ADDR_COUNTER_BOUNDARIES              ,
     MTX_GRD_ERR_INTERNAL_MUTEX_ERROR                        ,
     MTX_GRD_INVALID_INT_ERR_MGMT_MODE                       ,
+    MTX_GRD_ERR_NULL_MTX_GRD_COND                           ,
+    MTX_GRD_ERR_COND_RECURSIVE_WAIT                         ,
+    MTX_GRD_ERR_COND_GUARD_MISMATCH                         ,
+    MTX_GRD_ERR_COND_BUSY                                   ,
+    MTX_GRD_ERR_PROC_SHARED_UNSUPPORTED                     ,
+    MTX_GRD_ERR_SHM_ERROR                                   ,
+    MTX_GRD_ERR_OWNER_DEAD                                  ,
+    MTX_GRD_ERR_NOT_INCONSISTENT                            ,
+    MTX_GRD_ERR_EXPORTER_ERROR                              ,
+    MTX_GRD_ERR_INVALID_SAMPLING_PERIOD                     ,
+    MTX_GRD_ERR_INVALID_SLOW_CAPTURE_THRESHOLD              ,
+    MTX_GRD_ERR_NULL_OPERATION                              ,
+    MTX_GRD_ERR_INVALID_GUARD_NUM                           ,
+    MTX_GRD_ERR_DUPLICATE_MTX_GRD                           ,
+    MTX_GRD_ERR_DELEGATION_ERROR                            ,
+    MTX_GRD_ERR_DEFER_QUEUE_FULL                            ,
+    MTX_GRD_ERR_ASYNC_UNSUPPORTED                           ,
+    MTX_GRD_ERR_ASYNC_UNKNOWN_REQUEST                       ,
+    MTX_GRD_ERR_NULL_MTX_GRD_RW                             ,
+    MTX_GRD_ERR_RW_INVALID_MODE                             ,
+    MTX_GRD_ERR_RW_READ_SET_FULL                            ,
+    MTX_GRD_ERR_RW_BUSY                                     ,
+    MTX_GRD_ERR_BATCH_PENDING                               ,
+    MTX_GRD_ERR_REGISTRY_FULL                               ,
+    MTX_GRD_ERR_HOLD_BUDGET_EXCEEDED                        ,
     MTX_GRD_ERR_OUT_OF_BOUNDARIES_ERR                       ,
 
     MTX_GRD_ERR_MIN = MTX_GRD_ERR_INVALID_VERBOSITY_LEVEL   ,
@@ -135,11 +516,114 @@ typedef enum
 /// @brief Alias for timespec struct. 
 typedef struct timespec mtx_to_t;
 
+/// @brief Last module a callsite was resolved into (cached per thread, as consecutive locks tend to come from the same module).
+typedef struct
+{
+    uintptr_t   start;
+    uintptr_t   end;
+    uintptr_t   load_base;
+    uint8_t     build_id[__MTX_GRD_BUILD_ID_LEN__];
+} MTX_GRD_MODULE_CACHE;
+
+/// @brief Header placed before MTX_GRD instances mapped by MutexGuardShmOpen.
+typedef struct
+{
+    uint32_t    ready;
+} MTX_GRD_SHM_HEADER;
+
+/// @brief Buffered writer used by exporters. Snapshot writers flush to a growing in-memory snapshot instead of their descriptor.
+typedef struct
+{
+    int     fd;
+    int     error;
+    size_t  len;
+    char    buffer[MTX_GRD_EXPORT_STR_LEN];
+    bool    to_snapshot;
+    char*   snapshot;
+    size_t  snapshot_len;
+    size_t  snapshot_size;
+} MTX_GRD_EXPORT_WRITER;
+
+/// @brief Exported guard-level metric family (a single value per guard).
+typedef struct
+{
+    const char*         name;
+    const char*         help;
+    const char*         type;
+    unsigned long long  (*get_value)(const MTX_GRD* p_mutex_guard);
+} MTX_GRD_EXPORT_FAMILY;
+
+/// @brief Contended acquisitions aggregated by waiter's stack.
+typedef struct
+{
+    uint64_t            hash;
+    unsigned int        depth;
+    void*               frames[__MTX_GRD_PROFILE_DEPTH__];
+    unsigned long long  contention_counter;
+    uint64_t            wait_ns_total;
+} MTX_GRD_PROFILE_STACK;
+
+/// @brief Trace event types.
+enum
+{
+    MTX_GRD_TRACE_EVENT_WAIT    ,
+    MTX_GRD_TRACE_EVENT_HOLD    ,
+};
+
+/// @brief Traced span (a guard being waited for or held by a thread). sequence is 0 while the event is being written.
+typedef struct
+{
+    uint64_t        sequence;
+    uint8_t         type;
+    pid_t           kernel_tid;
+    const void*     guard;
+    uint64_t        start_ns;
+    uint64_t        end_ns;
+    uint64_t        flow_in_id;
+    uint64_t        flow_out_id;
+    char            name[__MTX_GRD_NAME_LEN__];
+} MTX_GRD_TRACE_EVENT;
+
+/// @brief Growable buffer protobuf messages are encoded into.
+typedef struct
+{
+    uint8_t*    data;
+    size_t      len;
+    size_t      size;
+    bool        error;
+} MTX_GRD_PB_BUFFER;
+
+/// @brief pprof profile string table (index 0 is the empty string).
+typedef struct
+{
+    char**  strings;
+    size_t  num;
+    size_t  size;
+    bool    error;
+} MTX_GRD_PROFILE_STRINGS;
+
+/// @brief Hold budget violation noticed by the watchdog (reported once the budgeted guards list is released).
+typedef struct
+{
+    const MTX_GRD*          p_mutex_guard;
+    char                    name[__MTX_GRD_NAME_LEN__];
+    uint64_t                hold_budget_ns;
+    MTX_GRD_ACQ_LOCATION    acq_location;
+} MTX_GRD_HOLD_VIOLATION;
+
 /*****************************************/
 
 /****** Private function prototypes ******/
 
 static void MutexGuardLoad(void) __attribute__((constructor));
+static void MutexGuardAtForkChild(void);
+
+static pid_t MutexGuardGetProcessId(void);
+static pid_t MutexGuardGetKernelTid(void);
+static bool MutexGuardIsOwner(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static int MutexGuardFindModuleCallback(struct dl_phdr_info* info, size_t size, void* data);
+static void MutexGuardGetCallsite(const void* address, MTX_GRD_CALLSITE* C_MUTEX_GUARD_RESTRICT p_callsite);
+static void MutexGuardBuildIdToString(const uint8_t* build_id, char* build_id_str);
 
 static int MutexGuardInitCtrlHelper(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
 
@@ -151,6 +635,7 @@ static int MutexGuardDestroyCtrlMutexAttr(  pthread_mutexattr_t* p_ctrl_mutex_at
 static int MutexGuardInitCtrlMutex( MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard         ,
                                     pthread_mutexattr_t* p_ctrl_mutex_attr  ,
                                     const bool one_shot                     );
+static int MutexGuardLockRobustMutex(pthread_mutex_t* p_mutex);
 static int MutexGuardLockCtrlMutex( MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard ,
                                     const bool one_shot             );
 static int MutexGuardUnlockCtrlMutex(   MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard ,
@@ -158,12 +643,101 @@ static int MutexGuardUnlockCtrlMutex(   MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_
 static int MutexGuardDestroyCtrlMutex(  MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard ,
                                         const bool one_shot             );
 
+static void MutexGuardRecordDeadOwner(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static void MutexGuardRecordLockFailure(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard                          ,
+                                        const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_owner_location         ,
+                                        const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_dead_owner_location    );
+static void MutexGuardCopyOwnerLocation(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_owner_location);
+static int MutexGuardGetSchedPriority(void);
+static int MutexGuardRegister(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static void MutexGuardUnregister(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static MTX_GRD* MutexGuardRegistryNext(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, size_t* C_MUTEX_GUARD_RESTRICT p_shared_index);
+static int MutexGuardDumpWrite(const int fd, const char* C_MUTEX_GUARD_RESTRICT buffer, size_t buffer_len);
+static size_t MutexGuardDumpPrint(char* C_MUTEX_GUARD_RESTRICT buffer, const size_t buffer_size, const char* C_MUTEX_GUARD_RESTRICT format, ...) __attribute__((format(printf, 3, 4)));
+static size_t MutexGuardDumpGuard(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, char* dump_string, const size_t dump_str_size);
+static void MutexGuardDumpSignalHandler(int signum);
+static size_t MutexGuardHistBucket(const uint64_t duration_ns);
+static MTX_GRD_STATS_SHARD* MutexGuardGetStatsShard(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const bool allocate);
+static unsigned long long MutexGuardStatsSum(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const size_t field_offset);
+static void MutexGuardStatsMergeShard(const MTX_GRD_STATS_SHARD* C_MUTEX_GUARD_RESTRICT p_shard, MTX_GRD_STATS* C_MUTEX_GUARD_RESTRICT p_stats);
+static void MutexGuardStatsMerge(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, MTX_GRD_STATS* C_MUTEX_GUARD_RESTRICT p_stats);
+static uint64_t MutexGuardSamplingRandom(void);
+static uint64_t MutexGuardSlowCaptureThreshold(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static void MutexGuardSlowCaptureRecord(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard                          ,
+                                        void* address                                                               ,
+                                        const uint64_t wait_ns                                                      ,
+                                        const uint64_t threshold_ns                                                 ,
+                                        void* const* frames                                                         ,
+                                        const unsigned int depth                                                    ,
+                                        const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_owner_acq_location     );
+static unsigned int MutexGuardSampleWeight(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static void MutexGuardRecordAcquisition(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard  ,
+                                        void* address                                   ,
+                                        const bool blocked                              ,
+                                        const uint64_t wait_ns                          ,
+                                        const unsigned int weight                       );
+static void MutexGuardExportFlush(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer);
+static void MutexGuardExportAppend(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const char* C_MUTEX_GUARD_RESTRICT format, ...) __attribute__((format(printf, 2, 3)));
+static void MutexGuardExportAppendEscaped(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const char* C_MUTEX_GUARD_RESTRICT label_value);
+static void MutexGuardExportGuardLabel(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static void MutexGuardExportCallsiteLabel(const void* address, char* label, const size_t label_size);
+static void MutexGuardExportFamily(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const MTX_GRD_EXPORT_FAMILY* C_MUTEX_GUARD_RESTRICT p_family);
+static void MutexGuardExportHistogram(  MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer    ,
+                                        const char* C_MUTEX_GUARD_RESTRICT name                     ,
+                                        const char* C_MUTEX_GUARD_RESTRICT help                     ,
+                                        const bool hold                                             );
+static void MutexGuardExportCallsites(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const bool wait_time);
+static unsigned long long MutexGuardExportAcquisitions(const MTX_GRD* p_mutex_guard);
+static unsigned long long MutexGuardExportContentions(const MTX_GRD* p_mutex_guard);
+static unsigned long long MutexGuardExportFailures(const MTX_GRD* p_mutex_guard);
+static unsigned long long MutexGuardExportHoldViolations(const MTX_GRD* p_mutex_guard);
+static unsigned long long MutexGuardExportPrioBoosts(const MTX_GRD* p_mutex_guard);
+static unsigned long long MutexGuardExportWaiters(const MTX_GRD* p_mutex_guard);
+static unsigned long long MutexGuardExportHeld(const MTX_GRD* p_mutex_guard);
+static void* MutexGuardExporterFileThread(void* arg);
+static void* MutexGuardExporterSocketThread(void* arg);
+static int MutexGuardExporterStartThread(pthread_t* p_thread, void* (*thread_fn)(void*));
+static void MutexGuardStatsShmPublish(MTX_GRD_STATS_SHM* C_MUTEX_GUARD_RESTRICT p_segment);
+static void* MutexGuardExporterShmThread(void* arg);
+static uint64_t MutexGuardProfileHash(void* const* frames, const unsigned int depth);
+static void MutexGuardProfileRecord(void* const* frames, const unsigned int depth, const uint64_t wait_ns, const unsigned int weight);
+static void MutexGuardPbAppend(MTX_GRD_PB_BUFFER* C_MUTEX_GUARD_RESTRICT p_buffer, const void* C_MUTEX_GUARD_RESTRICT data, const size_t data_len);
+static void MutexGuardPbVarint(MTX_GRD_PB_BUFFER* C_MUTEX_GUARD_RESTRICT p_buffer, uint64_t value);
+static void MutexGuardPbTagVarint(MTX_GRD_PB_BUFFER* C_MUTEX_GUARD_RESTRICT p_buffer, const unsigned int field, const uint64_t value);
+static void MutexGuardPbTagBytes(MTX_GRD_PB_BUFFER* C_MUTEX_GUARD_RESTRICT p_buffer, const unsigned int field, const void* data, const size_t data_len);
+static void MutexGuardPbTagMessage(MTX_GRD_PB_BUFFER* C_MUTEX_GUARD_RESTRICT p_buffer, const unsigned int field, MTX_GRD_PB_BUFFER* C_MUTEX_GUARD_RESTRICT p_message);
+static uint64_t MutexGuardProfileString(MTX_GRD_PROFILE_STRINGS* C_MUTEX_GUARD_RESTRICT p_strings, const char* C_MUTEX_GUARD_RESTRICT string);
+static int MutexGuardProfileCompareAddresses(const void* p_a, const void* p_b);
+static void MutexGuardTraceRecord(  const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard ,
+                                    const uint8_t type                                  ,
+                                    const uint64_t start_ns                             ,
+                                    const uint64_t end_ns                               ,
+                                    const uint64_t flow_in_id                           ,
+                                    const uint64_t flow_out_id                          );
+static void MutexGuardTraceAppendTime(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const char* C_MUTEX_GUARD_RESTRICT key, const uint64_t time_ns);
+static void MutexGuardTraceAppendEvent(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const MTX_GRD_TRACE_EVENT* C_MUTEX_GUARD_RESTRICT p_event, const pid_t pid);
+static void MutexGuardWatchdogStart(void);
+static void MutexGuardWatchdogAdd(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static void MutexGuardWatchdogRemove(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static void MutexGuardWatchdogArm(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static void MutexGuardWatchdogDisarm(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static void* MutexGuardWatchdogThread(void* arg);
+static void MutexGuardPrintHoldViolation(const MTX_GRD_HOLD_VIOLATION* C_MUTEX_GUARD_RESTRICT p_violation);
+static void MutexGuardRecordBoost(MTX_GRD_PRIO_STATS* C_MUTEX_GUARD_RESTRICT p_prio_stats, const uint64_t boost_ns);
+static void MutexGuardRecordHoldStart(  MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard                           ,
+                                        const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_prev_acq_location  ,
+                                        const uint64_t wait_start_ns                                            ,
+                                        const unsigned int sample_weight                                        );
+static uint64_t MutexGuardRecordHoldEnd(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static bool MutexGuardIsOwnerAlive(const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_mutex_guard_acq_location);
 static int MutexGuardStoreNewAddress(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, void* address);
 static int MutexGuardRemoveLatestAddress(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
 
 static mtx_to_t MutexGuardGenTimespec(const uint64_t timeout_ns);
+static mtx_to_t MutexGuardGenClockTimespec(const clockid_t clock_id, const uint64_t timeout_ns);
+static uint64_t MutexGuardGetMonotonicNs(void);
 
-static int MutexGuardGetLockError(  MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard ,
+static int MutexGuardGetLockError(  const MTX_GRD_LOCK_FAILURE* C_MUTEX_GUARD_RESTRICT p_lock_failure ,
                                     const uint64_t timeout_ns       ,
                                     char* lock_error_string         ,
                                     const size_t lock_error_str_size);
@@ -173,7 +747,7 @@ static void MutexGuardPrintLockError(   const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUAR
                                         const uint64_t timeout_ns                                       ,
                                         const int ret_lock                                              );
 
-static int MutexGuardCopyLockError( MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard ,
+static int MutexGuardCopyLockError( const MTX_GRD_LOCK_FAILURE* C_MUTEX_GUARD_RESTRICT p_lock_failure ,
                                     const uint64_t timeout_ns       ,
                                     const int ret_lock              ,
                                     char* lock_error_string         ,
@@ -196,17 +770,162 @@ static int MutexGuardPrintFileAndLineFromAddr(  const void* C_MUTEX_GUARD_RESTRI
                                                 const unsigned int address_index            ,
                                                 MTX_GRD_ACQ_LOCATION_DETAIL* C_MUTEX_GUARD_RESTRICT detail,
                                                 const size_t lock_error_str_size            );
+static const MTX_GRD_SOURCE_CALLSITE* MutexGuardFindSourceCallsite(const void* address);
 
 static void MutexGuardShowBacktrace(const pthread_mutex_t* C_MUTEX_GUARD_RESTRICT p_locked_mutex, const bool is_lock);
 
+static int MutexGuardFutexWait(uint32_t* p_futex, const uint32_t expected, const mtx_to_t* p_abs_timeout);
+static void MutexGuardFutexWake(uint32_t* p_futex, const int waiter_num);
+
+static int MutexGuardUnlockAndWake(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd);
+static void MutexGuardAsyncWakeGranted(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd);
+static void MutexGuardAsyncDrop(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd);
+static void MutexGuardAsyncRearm(const MTX_GRD_ASYNC_WAITER* C_MUTEX_GUARD_RESTRICT p_waiter, const uint64_t now_ns);
+
+static int MutexGuardDelegationStart(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+static void MutexGuardDelegationStop(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+
+static void MutexGuardCondQueuePush(MTX_GRD_COND_WAIT_QUEUE* p_queue, MTX_GRD_COND_WAITER* p_waiter);
+static MTX_GRD_COND_WAITER* MutexGuardCondQueuePop(MTX_GRD_COND_WAIT_QUEUE* p_queue);
+static void MutexGuardCondQueueRemove(MTX_GRD_COND_WAIT_QUEUE* p_queue, MTX_GRD_COND_WAITER* p_waiter);
+static void MutexGuardCondWakeWaiter(MTX_GRD_COND_WAITER* p_waiter);
+static void MutexGuardWakeRequeuedCondWaiter(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
+
+static int MutexGuardCondInitCtrlMutex(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond, const bool one_shot);
+static int MutexGuardCondLockCtrlMutex(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond, const bool one_shot);
+static int MutexGuardCondUnlockCtrlMutex(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond, const bool one_shot);
+static int MutexGuardCondDestroyCtrlMutex(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond, const bool one_shot);
+
+static int MutexGuardCondWaitHelper(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond ,
+                                    MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd           ,
+                                    void* C_MUTEX_GUARD_RESTRICT address                ,
+                                    const mtx_to_t* p_abs_timeout                       );
+
 /*****************************************/
 
 /*********** Private variables ***********/
 
+/// @brief Cached process ID (reset on fork).
+static __thread pid_t cached_process_id = 0;
+/// @brief Cached kernel thread ID (reset on fork).
+static __thread pid_t cached_kernel_tid = 0;
+/// @brief Module in which the latest callsite of a process-shared guard was found.
+static __thread MTX_GRD_MODULE_CACHE module_cache = {0};
+/// @brief Statistics shard of threads whose CPU cannot be known (-1 until assigned).
+static __thread int fallback_stats_shard = -1;
+/// @brief Round-robin counter fallback statistics shards are assigned from.
+static unsigned int fallback_stats_shard_counter = 0;
+/// @brief Global sampling period and wait time from which lock calls are always recorded (see MutexGuardSetSampling).
+static unsigned int sampling_period = 1;
+static uint64_t sampling_slow_ns = 0;
+/// @brief Calling thread's sampling countdown (in MTX_GRD_SAMPLING_UNIT units) and random generator state (0 until seeded).
+static __thread int64_t sampling_countdown = 0;
+static __thread uint64_t sampling_random_state = 0;
+/// @brief Delegation mailbox the calling thread looks for first (-1 until assigned), and counter those are assigned from.
+static __thread int delegation_client_index = -1;
+static unsigned int delegation_client_counter = 0;
+/// @brief Source locations handed out as lock addresses (appended under source_callsite_mutex, read lock-free up to the number
+/// published).
+static MTX_GRD_SOURCE_CALLSITE source_callsites[__MTX_GRD_SOURCE_CALLSITE_NUM__];
+static size_t source_callsite_num = 0;
+static pthread_mutex_t source_callsite_mutex = PTHREAD_MUTEX_INITIALIZER;
+/// @brief Calling thread's work deferred until guards are released, oldest first.
+static __thread MTX_GRD_DEFERRED_WORK deferred_works[__MTX_GRD_DEFER_NUM__];
+static __thread size_t deferred_work_num = 0;
+/// @brief Calling thread's operation batches (NULL until needed), and key their release at thread exit is bound to.
+static __thread MTX_GRD_BATCH_SET* batch_set = NULL;
+static pthread_key_t batch_set_key;
+static pthread_once_t batch_set_key_once = PTHREAD_ONCE_INIT;
+/// @brief Calling thread's shared holds (NULL until needed), every thread's ones (linked under rw_read_sets_mutex), and key their
+/// release at thread exit is bound to.
+static __thread MTX_GRD_RW_READ_SET* rw_read_set = NULL;
+static MTX_GRD_RW_READ_SET* rw_read_sets = NULL;
+static pthread_mutex_t rw_read_sets_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t rw_read_set_key;
+static pthread_once_t rw_read_set_key_once = PTHREAD_ONCE_INIT;
+/// @brief Visible readers of reader-biased guards (shared by every guard).
+static MTX_GRD_RW_BIAS_SLOT rw_bias_slots[__MTX_GRD_RW_BIAS_SLOT_NUM__];
+/// @brief Slow acquisition capture thresholds (percentile in hundredths of a percent, 0 if unused, see MutexGuardSetSlowCapture).
+static uint64_t slow_capture_fixed_ns = 0;
+static unsigned int slow_capture_percentile_bp = 0;
+/// @brief Ring of the latest slow acquisition captures, and number of captures ever stored into it.
+static MTX_GRD_SLOW_CAPTURE slow_captures[__MTX_GRD_SLOW_CAPTURE_NUM__];
+static unsigned long long slow_capture_counter = 0;
+static pthread_mutex_t slow_capture_mutex = PTHREAD_MUTEX_INITIALIZER;
+/// @brief Head of the registry of initialized guards (walked lock-free by dumps).
+static MTX_GRD* registry_head = NULL;
+/// @brief Process-shared guards mapped by this process, kept apart as their registry_next would leak this process' pointers to others.
+static MTX_GRD* registry_shared[__MTX_GRD_REGISTRY_SHARED_NUM__];
+/// @brief Serializes registry insertions and removals (neither lockers nor dumps take it).
+static pthread_mutex_t registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+/// @brief Number of dumps currently walking the registry (removed guards are not released until it drops to 0).
+static unsigned int registry_readers = 0;
+/// @brief Executable base address (printed by dumps, so that raw lock addresses can be resolved offline).
+static size_t executable_base_address = 0;
+/// @brief File descriptor dumps triggered by a signal are written to.
+static int dump_signal_fd = -1;
+/// @brief Latency histogram bucket upper bounds (as exported "le" label values, in seconds).
+static const char* hist_bucket_labels[MTX_GRD_HIST_BUCKET_NUM] =
+{
+    "1e-06", "4e-06", "1.6e-05", "6.4e-05", "0.000256", "0.001024", "0.004096", "0.016384", "0.065536", "0.262144", "1.048576", "+Inf"
+};
+/// @brief Exported guard-level metric families.
+static const MTX_GRD_EXPORT_FAMILY export_families[] =
+{
+    { "mtx_grd_acquisitions_total"          , "Number of acquisitions."                                         , "counter" , MutexGuardExportAcquisitions      },
+    { "mtx_grd_contended_acquisitions_total", "Number of acquisitions which had to wait for another owner."     , "counter" , MutexGuardExportContentions       },
+    { "mtx_grd_failures_total"              , "Number of failed (busy, timed out or erroneous) lock attempts."  , "counter" , MutexGuardExportFailures          },
+    { "mtx_grd_hold_budget_violations_total", "Number of holds which exceeded the guard's hold budget."         , "counter" , MutexGuardExportHoldViolations    },
+    { "mtx_grd_prio_boosts_total"           , "Number of priority inheritance or ceiling boosts."               , "counter" , MutexGuardExportPrioBoosts        },
+    { "mtx_grd_waiters"                     , "Number of threads currently waiting to acquire the guard."      , "gauge"   , MutexGuardExportWaiters           },
+    { "mtx_grd_held"                        , "Whether the guard is currently held."                            , "gauge"   , MutexGuardExportHeld              },
+};
+/// @brief Protects exporter threads' state.
+static pthread_mutex_t exporter_mutex = PTHREAD_MUTEX_INITIALIZER;
+/// @brief Wakes the file exporter thread up when exporters are stopped.
+static pthread_cond_t exporter_cond;
+/// @brief Tells exporter threads to exit.
+static bool exporter_stop = false;
+/// @brief File exporter thread data.
+static pthread_t exporter_file_thread;
+static bool exporter_file_running = false;
+static char exporter_file_path[PATH_MAX] = {0};
+static uint64_t exporter_period_ns = 0;
+/// @brief Socket exporter thread data.
+static pthread_t exporter_socket_thread;
+static bool exporter_socket_running = false;
+static int exporter_socket_fd = -1;
+static struct sockaddr_un exporter_socket_addr = {0};
+/// @brief Stats segment publisher thread data.
+static pthread_t exporter_shm_thread;
+static bool exporter_shm_running = false;
+static char exporter_shm_name[NAME_MAX + 1] = {0};
+static MTX_GRD_STATS_SHM* exporter_shm = NULL;
+/// @brief Contention profile: waiter stacks (open addressing hash table) and when profiling was enabled.
+static MTX_GRD_PROFILE_STACK profile_stacks[__MTX_GRD_PROFILE_STACK_NUM__];
+static pthread_mutex_t profile_mutex = PTHREAD_MUTEX_INITIALIZER;
+static bool profile_enabled = false;
+static uint64_t profile_start_ns = 0;
+/// @brief Contended acquisitions which did not fit in the profile.
+static unsigned long long profile_dropped_counter = 0;
+/// @brief Trace ring: published (trace_events) only while tracing is enabled, so that lockers can tell without taking any lock.
+static MTX_GRD_TRACE_EVENT* trace_events = NULL;
+static MTX_GRD_TRACE_EVENT* trace_ring_storage = NULL;
+static uint64_t trace_next_index = 0;
+static pthread_mutex_t trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+static bool trace_enabled = false;
+/// @brief Last handoff (release to next acquisition) flow ID.
+static uint64_t trace_flow_counter = 0;
+/// @brief Guards with a hold budget, whose deadlines the watchdog scans once per tick.
+static MTX_GRD* watchdog_head = NULL;
+/// @brief Protects the budgeted guards list (guards' ctrl_mutex may be held when taking it, the watchdog only tries to lock those).
+static pthread_mutex_t watchdog_mutex = PTHREAD_MUTEX_INITIALIZER;
+/// @brief Tells whether the watchdog thread is running.
+static bool watchdog_started = false;
 /// @brief Exit current program if any internal (ctrl) mutex lock, unlock, int or destroy procedure fails.
 static MTX_GRD_INT_ERR_MGMT ctrl_mutex_exit_if_error;
-/// @brief Variable in which data belonging to a mutex that failed to be locked is meant to be copied.
-static MTX_GRD last_failed_mutex_guard = {0};
+/// @brief Calling thread's latest lock failure.
+static __thread MTX_GRD_LOCK_FAILURE last_lock_failure = {0};
 /// @brief Verbosity level holding variable.
 static int verbosity_level = MTX_GRD_VERBOSITY_SILENT;
 /// @brief MTX_GRD_ERR_CODE holding variable.
@@ -215,6 +934,8 @@ static __thread int mutex_guard_errno = 0;
 static __thread int mutex_guard_lock_error_code = 0;
 /// @brief String to store lock error strings.
 static __thread char last_lock_error_string[__MTX_GRD_LAST_LOCK_ERR_STRING_LEN__] = MTX_GRD_LAST_LOCK_ERR_DEF_MSG;
+/// @brief String to store dead owner error strings.
+static __thread char owner_dead_error_string[__MTX_GRD_LAST_LOCK_ERR_STRING_LEN__] = MTX_GRD_OWNER_DEAD_ERR_DEF_MSG;
 /// @brief String to store standard error strings.
 static __thread char standard_error_string[__MTX_GRD_STD_ERR_STRING_LEN__] = MTX_GRD_STD_ERR_DEF_MSG;
 
@@ -242,6 +963,31 @@ static const char* error_str_table[MTX_GRD_ERR_MAX - MTX_GRD_ERR_MIN + 1] =
     "Address counter is out of boundaries"              ,
     "An internal mutex-related error happened"          ,
     "Provided invalid internal mutex management mode"   ,
+    "MTX_GRD_COND null pointer"                         ,
+    "MTX_GRD must be locked exactly once to wait"       ,
+    "MTX_GRD_COND is bound to a different MTX_GRD"      ,
+    "MTX_GRD_COND still has waiting threads"            ,
+    "Not supported by process-shared MTX_GRD"           ,
+    "Could not map shared memory MTX_GRD"               ,
+    NULL                                                ,
+    "MTX_GRD does not need to be made consistent"       ,
+    "Could not start or stop MTX_GRD exporter"          ,
+    "Invalid MTX_GRD sampling period"                   ,
+    "Invalid MTX_GRD slow capture threshold"            ,
+    "MTX_GRD operation to execute is null"              ,
+    "Invalid number of MTX_GRD to lock"                 ,
+    "MTX_GRD listed more than once"                     ,
+    "Could not set up MTX_GRD delegation"               ,
+    "MTX_GRD deferred work queue is full"               ,
+    "MTX_GRD does not support asynchronous locking"     ,
+    "Unknown MTX_GRD asynchronous lock request"         ,
+    "MTX_GRD_RW null pointer"                           ,
+    "Invalid MTX_GRD_RW lock mode"                      ,
+    "Too many MTX_GRD_RW held in shared mode"           ,
+    "MTX_GRD_RW is still held"                          ,
+    "MTX_GRD has operations batched by other threads"   ,
+    "MTX_GRD registry is full"                          ,
+    "MTX_GRD hold budget exceeded"                      ,
     "Out of boundaries error code"                      ,
 };
 
@@ -254,6 +1000,73 @@ static void __attribute__((constructor)) MutexGuardLoad(void)
 {
     MutexGuardSetPrintStatus(MTX_GRD_VERBOSITY_SILENT);
     MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_KEEP_TRYING);
+    pthread_atfork(NULL, NULL, MutexGuardAtForkChild);
+    executable_base_address = MutexGuardGetExecutableBaseddress();
+
+    pthread_condattr_t exporter_cond_attr;
+    pthread_condattr_init(&exporter_cond_attr);
+    pthread_condattr_setclock(&exporter_cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&exporter_cond, &exporter_cond_attr);
+    pthread_condattr_destroy(&exporter_cond_attr);
+}
+
+/// @brief Drops cached process and thread IDs within a newly forked child process.
+static void MutexGuardAtForkChild(void)
+{
+    cached_process_id = 0;
+    cached_kernel_tid = 0;
+
+    // Any other thread which was updating the registry is gone in the child.
+    pthread_mutex_init(&registry_mutex, NULL);
+    registry_readers = 0;
+
+    // Watchdog thread is not inherited either: it is started again on the next armed hold.
+    pthread_mutex_init(&watchdog_mutex, NULL);
+    watchdog_started = false;
+
+    pthread_mutex_init(&profile_mutex, NULL);
+    pthread_mutex_init(&trace_mutex, NULL);
+    pthread_mutex_init(&slow_capture_mutex, NULL);
+
+    // Neither are exporter threads (their socket, if any, is left to the parent).
+    pthread_mutex_init(&exporter_mutex, NULL);
+    exporter_file_running   = false;
+    exporter_socket_running = false;
+    exporter_socket_fd      = -1;
+    exporter_shm_running    = false;
+}
+
+/// @brief Gets current process ID.
+/// @return Current process ID.
+static pid_t MutexGuardGetProcessId(void)
+{
+    if(!cached_process_id)
+        cached_process_id = getpid();
+
+    return cached_process_id;
+}
+
+/// @brief Gets kernel thread ID of the calling thread (unique system-wide, as opposed to pthread_t).
+/// @return Kernel thread ID.
+static pid_t MutexGuardGetKernelTid(void)
+{
+    if(!cached_kernel_tid)
+        cached_kernel_tid = (pid_t)syscall(SYS_gettid);
+
+    return cached_kernel_tid;
+}
+
+/// @brief Tells whether the calling thread is the one that locked the guard. Process-shared guards are checked against process and
+/// kernel thread IDs, as pthread_t values from different processes may coincide.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @return true if the calling thread owns the guard, false otherwise.
+static bool MutexGuardIsOwner(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    if(p_mutex_guard->process_shared)
+        return  (p_mutex_guard->mutex_acq_location.process_id == MutexGuardGetProcessId()) &&
+                (p_mutex_guard->mutex_acq_location.kernel_tid == MutexGuardGetKernelTid());
+
+    return pthread_equal(pthread_self(), p_mutex_guard->mutex_acq_location.thread_id);
 }
 
 /// @brief Returns Mutex Guard error code.
@@ -277,10 +1090,30 @@ const char* MutexGuardGetErrorString(const int error_code)
     {
         char* custom_err_code_start = last_lock_error_string + strlen(MTX_GRD_LAST_LOCK_ERR_DEF_MSG);
         memset( custom_err_code_start, 0, strlen(custom_err_code_start));
-        MutexGuardGetLockError( &last_failed_mutex_guard, 0, custom_err_code_start, sizeof(last_lock_error_string));
+        MutexGuardGetLockError( &last_lock_failure, 0, custom_err_code_start, sizeof(last_lock_error_string));
         return last_lock_error_string;
     }
     
+    if(error_code == MTX_GRD_ERR_OWNER_DEAD)
+    {
+        char* custom_err_code_start = owner_dead_error_string + strlen(MTX_GRD_OWNER_DEAD_ERR_DEF_MSG);
+        memset(custom_err_code_start, 0, strlen(custom_err_code_start));
+
+        const MTX_GRD_ACQ_LOCATION* p_dead_owner_location = &last_lock_failure.dead_owner_location;
+
+        snprintf(   custom_err_code_start                                                           ,
+                    (sizeof(owner_dead_error_string) - strlen(owner_dead_error_string))             ,
+                    MTX_GRD_MSG_ERR_MUTEX_ACQ_ADDR_HEADER                                           ,
+                    p_dead_owner_location->thread_id                                                ,
+                    p_dead_owner_location->process_id                                               ,
+                    p_dead_owner_location->kernel_tid                                               );
+
+        MutexGuardPrintLockAddresses(   p_dead_owner_location                                               ,
+                                        (owner_dead_error_string + strlen(owner_dead_error_string))         ,
+                                        (sizeof(owner_dead_error_string) - strlen(owner_dead_error_string)) );
+        return owner_dead_error_string;
+    }
+
     if(error_code == MTX_GRD_ERR_STD_ERROR_CODE)
     {
         char* custom_std_code_start = standard_error_string + strlen(MTX_GRD_STD_ERR_DEF_MSG);
@@ -384,6 +1217,97 @@ int MutexGuardAttrInit( MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard ,
     return 0;
 }
 
+/// @brief Sets mutex attribute robustness.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param robustness Mutex robustness (STALLED, ROBUST).
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardAttrSetRobust(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const int robustness)
+{
+    if(!p_mutex_guard)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(pthread_mutexattr_setrobust(&p_mutex_guard->mutex_attr, robustness))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_ATTR_SET_FAILED;
+        return -2;
+    }
+
+    return 0;
+}
+
+/// @brief Sets mutex attribute priority ceiling.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param prio_ceiling Priority ceiling (within SCHED_FIFO priority range).
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardAttrSetPrioCeiling(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const int prio_ceiling)
+{
+    if(!p_mutex_guard)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(pthread_mutexattr_setprioceiling(&p_mutex_guard->mutex_attr, prio_ceiling))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_ATTR_SET_FAILED;
+        return -2;
+    }
+
+    return 0;
+}
+
+/// @brief Sets guard delegation (see MutexGuardAttrSetDelegation).
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param cpu CPU the server thread is pinned to (ANY_CPU not to pin it, OFF to disable delegation).
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardAttrSetDelegation(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const int cpu)
+{
+    if(!p_mutex_guard)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if( (cpu < MTX_GRD_DELEGATION_OFF) || (cpu >= CPU_SETSIZE) )
+    {
+        mutex_guard_errno = MTX_GRD_ERR_ATTR_SET_FAILED;
+        return -2;
+    }
+
+    p_mutex_guard->delegated        = (cpu != MTX_GRD_DELEGATION_OFF);
+    p_mutex_guard->delegation_cpu   = cpu;
+
+    return 0;
+}
+
+/// @brief Sets guard operation batching limits (see MutexGuardAttrSetBatching).
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param op_num Operations a batch is applied at (up to __MTX_GRD_BATCH_OP_NUM__, 0 for that very number).
+/// @param delay_ns Time a batch is applied at, from its first operation on (in nanoseconds, 0 for no limit).
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardAttrSetBatching(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const size_t op_num, const uint64_t delay_ns)
+{
+    if(!p_mutex_guard)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(op_num > __MTX_GRD_BATCH_OP_NUM__)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_ATTR_SET_FAILED;
+        return -2;
+    }
+
+    p_mutex_guard->batch_op_num     = op_num;
+    p_mutex_guard->batch_delay_ns   = delay_ns;
+
+    return 0;
+}
+
 /// @brief Initializes internal usage  mutex (locks MTX_GRD temporarily).
 /// @param p_mutex_guard Pointer to mutex guard structure.
 /// @return 0 if succeeded, < 0 otherwise.
@@ -397,11 +1321,17 @@ static int MutexGuardInitCtrlHelper(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guar
         return -1;
     }
 
+    // Control mutex must be reachable from every process the guard is shared with, and must not let a low-priority thread
+    // holding it block the guard's high-priority lockers: it inherits priorities whenever the guard has a priority protocol.
+    // It never takes a ceiling though, as lockers above it would then fail every bookkeeping step rather than the lock itself.
+    int ctrl_protocol = ((p_mutex_guard->protocol == PTHREAD_PRIO_NONE) ? PTHREAD_PRIO_NONE : PTHREAD_PRIO_INHERIT);
+
     int set_type    = pthread_mutexattr_settype(      &ctrl_mutex_attr, PTHREAD_MUTEX_RECURSIVE );
-    int set_proto   = pthread_mutexattr_setprotocol(  &ctrl_mutex_attr, PTHREAD_PRIO_NONE       );
-    int set_pshared = pthread_mutexattr_setpshared(   &ctrl_mutex_attr, PTHREAD_PROCESS_PRIVATE );
+    int set_proto   = pthread_mutexattr_setprotocol(  &ctrl_mutex_attr, ctrl_protocol           );
+    int set_pshared = pthread_mutexattr_setpshared(   &ctrl_mutex_attr, (p_mutex_guard->process_shared ? PTHREAD_PROCESS_SHARED : PTHREAD_PROCESS_PRIVATE));
+    int set_robust  = pthread_mutexattr_setrobust(    &ctrl_mutex_attr, (p_mutex_guard->robust ? PTHREAD_MUTEX_ROBUST : PTHREAD_MUTEX_STALLED));
     
-    if(set_type || set_proto || set_pshared)
+    if(set_type || set_proto || set_pshared || set_robust)
     {
         mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
         return -2;
@@ -457,13 +1387,26 @@ static int MutexGuardInitCtrlMutex( MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guar
     MTX_GRD_CTRL_MUTEX_CONTROL_FLOW(pthread_mutex_init(&p_mutex_guard->ctrl_mutex, p_ctrl_mutex_attr));
 }
 
+/// @brief Locks an internal mutex, recovering it if its previous owner died (it only protects bookkeeping, which is always left consistent).
+/// @param p_mutex Pointer to target mutex.
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardLockRobustMutex(pthread_mutex_t* p_mutex)
+{
+    int ret_lock = pthread_mutex_lock(p_mutex);
+
+    if(ret_lock == EOWNERDEAD)
+        ret_lock = pthread_mutex_consistent(p_mutex);
+
+    return ret_lock;
+}
+
 /// @brief Locks control mutex (used to lock MTX_GRD structure).
 /// @param p_mutex_guard Pointer to MTX_GRD variable in which target control mutex is found.
 /// @param one_shot Tells whether should it be tried to lock control mutex just once.
 /// @return 0 if succeeded, != 0 otherwise.
 static int MutexGuardLockCtrlMutex(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const bool one_shot)
 {
-    MTX_GRD_CTRL_MUTEX_CONTROL_FLOW(pthread_mutex_lock(&p_mutex_guard->ctrl_mutex));
+    MTX_GRD_CTRL_MUTEX_CONTROL_FLOW(MutexGuardLockRobustMutex(&p_mutex_guard->ctrl_mutex));
 }
 
 /// @brief Unlocks control mutex (used to lock MTX_GRD structure).
@@ -509,6 +1452,60 @@ int MutexGuardInit(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
         return -1;
     }
 
+    int proc_sharing = PTHREAD_PROCESS_PRIVATE;
+    pthread_mutexattr_getpshared(&p_mutex_guard->mutex_attr, &proc_sharing);
+    p_mutex_guard->process_shared = (proc_sharing == PTHREAD_PROCESS_SHARED);
+
+    int robustness = PTHREAD_MUTEX_STALLED;
+    pthread_mutexattr_getrobust(&p_mutex_guard->mutex_attr, &robustness);
+    p_mutex_guard->robust       = (robustness == PTHREAD_MUTEX_ROBUST);
+    p_mutex_guard->owner_died   = false;
+
+    int protocol = PTHREAD_PRIO_NONE;
+    pthread_mutexattr_getprotocol(&p_mutex_guard->mutex_attr, &protocol);
+    p_mutex_guard->protocol     = protocol;
+    p_mutex_guard->prio_ceiling = 0;
+
+    if(protocol == PTHREAD_PRIO_PROTECT)
+        pthread_mutexattr_getprioceiling(&p_mutex_guard->mutex_attr, &p_mutex_guard->prio_ceiling);
+
+    memset(&p_mutex_guard->prio_stats, 0, sizeof(MTX_GRD_PRIO_STATS));
+    memset(&p_mutex_guard->batch_stats, 0, sizeof(MTX_GRD_BATCH_STATS));
+    p_mutex_guard->batch_pending_counter = 0;
+    p_mutex_guard->waiter_counter = 0;
+
+    p_mutex_guard->hold_budget_ns           = 0;
+    p_mutex_guard->hold_deadline_ns         = 0;
+    p_mutex_guard->hold_violation_counter   = 0;
+    p_mutex_guard->watchdog_listed          = false;
+
+    memset(&p_mutex_guard->stats, 0, sizeof(MTX_GRD_STATS_SHARD));
+    memset(p_mutex_guard->callsite_addresses, 0, sizeof(p_mutex_guard->callsite_addresses));
+    p_mutex_guard->stats_shards                 = NULL;
+    p_mutex_guard->sampling_period              = 0;
+    p_mutex_guard->hold_sample_weight           = 0;
+    p_mutex_guard->slow_capture_threshold_ns    = 0;
+    p_mutex_guard->slow_capture_refresh_counter = 0;
+    p_mutex_guard->trace_acquire_flow_id    = 0;
+    p_mutex_guard->trace_release_flow_id    = 0;
+    p_mutex_guard->combine_head             = NULL;
+    p_mutex_guard->delegation               = NULL;
+    p_mutex_guard->async_head               = NULL;
+    p_mutex_guard->async_tail               = NULL;
+    p_mutex_guard->async_granted            = NULL;
+
+    // Asynchronous lockers are only woken up by releases from this process, and take the mutex with a plain try: dead owners,
+    // priority protocols and delegated operations are not handled on that path.
+    p_mutex_guard->async_capable = (    !p_mutex_guard->process_shared && !p_mutex_guard->robust    &&
+                                        (protocol == PTHREAD_PRIO_NONE) && !p_mutex_guard->delegated);
+
+    // Mailboxes are only reachable from this process, and the server must be able to run operations whatever the state of the guard.
+    if( p_mutex_guard->delegated && (p_mutex_guard->process_shared || p_mutex_guard->robust) )
+    {
+        mutex_guard_errno = MTX_GRD_ERR_DELEGATION_ERROR;
+        return -4;
+    }
+
     if(MutexGuardInitCtrlHelper(p_mutex_guard))
     {
         mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
@@ -525,6 +1522,29 @@ int MutexGuardInit(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
         return -3;
     }
 
+    if(p_mutex_guard->delegated && MutexGuardDelegationStart(p_mutex_guard))
+    {
+        pthread_mutex_destroy(&p_mutex_guard->mutex);
+
+        if(MutexGuardDestroyCtrlMutex(p_mutex_guard, true))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+        else
+            mutex_guard_errno = MTX_GRD_ERR_DELEGATION_ERROR;
+
+        return -4;
+    }
+
+    // Delegated guards are never process-shared, so there is no delegation server to stop here.
+    if(MutexGuardRegister(p_mutex_guard))
+    {
+        pthread_mutex_destroy(&p_mutex_guard->mutex);
+
+        if(MutexGuardDestroyCtrlMutex(p_mutex_guard, true))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        return -5;
+    }
+
     return 0;
 }
 
@@ -536,826 +1556,7465 @@ MTX_GRD* MutexGuardInitAddr(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
     return (MutexGuardInit(p_mutex_guard) ? NULL : p_mutex_guard);
 }
 
-/// @brief Stores a new lock address.
+/// @brief Moves the acquisition record left behind by a dead owner to dead_owner_location, so that the guard can be taken over.
+/// Meant to be called with the guard's ctrl_mutex held, right after its mutex was acquired with EOWNERDEAD.
 /// @param p_mutex_guard Pointer to mutex guard structure.
-/// @param address Target address to be stored.
-/// @return 0 if succeeded, < 0 otherwise.
-static int MutexGuardStoreNewAddress(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, void* address)
+static void MutexGuardRecordDeadOwner(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
 {
-    if(!p_mutex_guard)
-    {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
-        return -1;
-    }
+    memcpy(&p_mutex_guard->dead_owner_location, &p_mutex_guard->mutex_acq_location, sizeof(MTX_GRD_ACQ_LOCATION));
+    memset(&p_mutex_guard->mutex_acq_location, 0, sizeof(MTX_GRD_ACQ_LOCATION));
+    p_mutex_guard->lock_counter = 0;
+    p_mutex_guard->owner_died   = true;
 
-    for(int address_index = 0; address_index < __MTX_GRD_ADDR_NUM__; address_index++)
-    {
-        if(!p_mutex_guard->mutex_acq_location.addresses[address_index])
-        {
-            p_mutex_guard->mutex_acq_location.addresses[address_index] = address;
-            return 0;
-        }
-    }
-    
-    mutex_guard_errno = MTX_GRD_ERR_NO_ADDR_SPACE_AVAILABLE;
-    return -2;
+    // The dead owner's hold is over.
+    MutexGuardWatchdogDisarm(p_mutex_guard);
 }
 
-/// @brief Removes latest lock address.
+/// @brief Copies a guard's owner location, under its ctrl_mutex for other threads not to modify it meanwhile.
 /// @param p_mutex_guard Pointer to mutex guard structure.
-/// @return 0 if succeeded, < 0 otherwise.
-static int MutexGuardRemoveLatestAddress(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+/// @param p_owner_location Pointer to the structure the location is meant to be copied to.
+static void MutexGuardCopyOwnerLocation(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_owner_location)
 {
-    if(!p_mutex_guard)
-    {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
-        return -1;
-    }
+    if(MutexGuardLockCtrlMutex(p_mutex_guard, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
 
-    for(int address_index = (__MTX_GRD_ADDR_NUM__ - 1); address_index >= 0; address_index--)
-    {
-        if( p_mutex_guard->mutex_acq_location.addresses[address_index])
-        {
-            p_mutex_guard->mutex_acq_location.addresses[address_index] = NULL;
-            return 0;
-        }
-    }
-    
-    mutex_guard_errno = MTX_GRD_ERR_NO_ADDR_SPACE_AVAILABLE;
-    return -2;
+    memcpy(p_owner_location, &p_mutex_guard->mutex_acq_location, sizeof(MTX_GRD_ACQ_LOCATION));
+
+    if(MutexGuardUnlockCtrlMutex(p_mutex_guard, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
 }
 
-/// @brief Returns timespec type struct to be used alongside timed locks.
-/// @param timeout_ns Target timeout value (in nanoseconds).
-/// @return Resulting timespec.
-static mtx_to_t MutexGuardGenTimespec(const uint64_t timeout_ns)
+/// @brief Keeps what describes a lock failure of the calling thread, for MutexGuardGetErrorString to report it later.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param p_owner_location Owner's location, as found by the failed lock (NULL if unknown).
+/// @param p_dead_owner_location Dead owner's location (NULL if the guard was not acquired from a dead owner).
+static void MutexGuardRecordLockFailure(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard                          ,
+                                        const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_owner_location         ,
+                                        const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_dead_owner_location    )
 {
-    mtx_to_t lock_timeout;
-    clock_gettime(CLOCK_REALTIME, &lock_timeout);
-    
-    // Add the timeout (in nanoseconds) to the current time
-    lock_timeout.tv_sec += timeout_ns / MTX_GRD_TOUT_1_SEC_AS_NS;
-    lock_timeout.tv_nsec += timeout_ns % MTX_GRD_TOUT_1_SEC_AS_NS;
-    
-    // Handle possible overflow in nanoseconds (if it's >= 1 second)
-    if (lock_timeout.tv_nsec >= MTX_GRD_TOUT_1_SEC_AS_NS)
+    last_lock_failure.mutex_address = &p_mutex_guard->mutex;
+
+    if(p_owner_location)
+        memcpy(&last_lock_failure.owner_location, p_owner_location, sizeof(MTX_GRD_ACQ_LOCATION));
+    else
+        memset(&last_lock_failure.owner_location, 0, sizeof(MTX_GRD_ACQ_LOCATION));
+
+    if(p_dead_owner_location)
+        memcpy(&last_lock_failure.dead_owner_location, p_dead_owner_location, sizeof(MTX_GRD_ACQ_LOCATION));
+    else
+        memset(&last_lock_failure.dead_owner_location, 0, sizeof(MTX_GRD_ACQ_LOCATION));
+}
+
+/// @brief Adds a guard to the registry (unless it is already there, e.g. when initialized twice).
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @return 0 if succeeded, < 0 otherwise (process-shared guard and no free slot left in the side table).
+static int MutexGuardRegister(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    pthread_mutex_lock(&registry_mutex);
+
+    // Process-shared guards take the first free slot of the side table (__MTX_GRD_REGISTRY_SHARED_NUM__ of them).
+    if(p_mutex_guard->process_shared)
+    {
+        size_t free_index = __MTX_GRD_REGISTRY_SHARED_NUM__;
+
+        for(size_t shared_index = 0; shared_index < __MTX_GRD_REGISTRY_SHARED_NUM__; shared_index++)
+        {
+            if(registry_shared[shared_index] == p_mutex_guard)
+            {
+                pthread_mutex_unlock(&registry_mutex);
+                return 0;
+            }
+
+            if( !registry_shared[shared_index] && (free_index == __MTX_GRD_REGISTRY_SHARED_NUM__) )
+                free_index = shared_index;
+        }
+
+        if(free_index == __MTX_GRD_REGISTRY_SHARED_NUM__)
+        {
+            pthread_mutex_unlock(&registry_mutex);
+            mutex_guard_errno = MTX_GRD_ERR_REGISTRY_FULL;
+            return -1;
+        }
+
+        __atomic_store_n(&registry_shared[free_index], p_mutex_guard, __ATOMIC_RELEASE);
+
+        pthread_mutex_unlock(&registry_mutex);
+        return 0;
+    }
+
+    MTX_GRD* p_registered = registry_head;
+
+    while(p_registered && (p_registered != p_mutex_guard))
+        p_registered = p_registered->registry_next;
+
+    if(!p_registered)
+    {
+        p_mutex_guard->registry_next = registry_head;
+        __atomic_store_n(&registry_head, p_mutex_guard, __ATOMIC_RELEASE);
+    }
+
+    pthread_mutex_unlock(&registry_mutex);
+
+    return 0;
+}
+
+/// @brief Removes a guard from the registry, and waits until no dump can be walking through it.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+static void MutexGuardUnregister(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    pthread_mutex_lock(&registry_mutex);
+
+    bool registered = false;
+
+    if(p_mutex_guard->process_shared)
+    {
+        for(size_t shared_index = 0; shared_index < __MTX_GRD_REGISTRY_SHARED_NUM__; shared_index++)
+        {
+            if(registry_shared[shared_index] == p_mutex_guard)
+            {
+                __atomic_store_n(&registry_shared[shared_index], NULL, __ATOMIC_RELEASE);
+                registered = true;
+            }
+        }
+    }
+    else
+    {
+        MTX_GRD** pp_link = &registry_head;
+
+        while(*pp_link && (*pp_link != p_mutex_guard))
+            pp_link = &(*pp_link)->registry_next;
+
+        registered = (*pp_link != NULL);
+
+        MutexGuardWatchdogRemove(p_mutex_guard);
+
+        // A dump standing on the removed guard still finds its way through its (untouched) next pointer.
+        if(registered)
+            __atomic_store_n(pp_link, p_mutex_guard->registry_next, __ATOMIC_RELEASE);
+    }
+
+    pthread_mutex_unlock(&registry_mutex);
+
+    if(registered)
+        while(__atomic_load_n(&registry_readers, __ATOMIC_ACQUIRE))
+            sched_yield();
+}
+
+/// @brief Walks the registry: process-private guards first, then the process-shared ones. Lock-free, as it is called from dumps.
+/// @param p_mutex_guard Pointer to current mutex guard structure (NULL to get the first one).
+/// @param p_shared_index Pointer to the side table position (meant to be 0 before getting the first guard).
+/// @return Pointer to next registered guard, NULL if none is left.
+static MTX_GRD* MutexGuardRegistryNext(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, size_t* C_MUTEX_GUARD_RESTRICT p_shared_index)
+{
+    if(!p_mutex_guard || !p_mutex_guard->process_shared)
+    {
+        MTX_GRD* p_next = (p_mutex_guard ? __atomic_load_n(&p_mutex_guard->registry_next, __ATOMIC_ACQUIRE) : __atomic_load_n(&registry_head, __ATOMIC_ACQUIRE));
+
+        if(p_next)
+            return p_next;
+    }
+
+    while(*p_shared_index < __MTX_GRD_REGISTRY_SHARED_NUM__)
+    {
+        MTX_GRD* p_next = __atomic_load_n(&registry_shared[(*p_shared_index)++], __ATOMIC_ACQUIRE);
+
+        if(p_next)
+            return p_next;
+    }
+
+    return NULL;
+}
+
+/// @brief Gets calling thread's scheduling priority.
+/// @return Scheduling priority (0 for non real-time policies).
+static int MutexGuardGetSchedPriority(void)
+{
+    int policy;
+    struct sched_param sched_param = {0};
+
+    if(pthread_getschedparam(pthread_self(), &policy, &sched_param))
+        return 0;
+
+    return sched_param.sched_priority;
+}
+
+/// @brief Accounts a priority boost.
+/// @param p_prio_stats Pointer to target priority statistics.
+/// @param boost_ns Boost duration.
+static void MutexGuardRecordBoost(MTX_GRD_PRIO_STATS* C_MUTEX_GUARD_RESTRICT p_prio_stats, const uint64_t boost_ns)
+{
+    ++p_prio_stats->boost_counter;
+    p_prio_stats->boost_ns_total += boost_ns;
+
+    if(boost_ns > p_prio_stats->boost_ns_max)
+        p_prio_stats->boost_ns_max = boost_ns;
+}
+
+/// @brief Records the start of a hold (first acquisition by its owner). Meant to be called with the guard's ctrl_mutex held.
+/// A PRIO_INHERIT guard's previous owner ran boosted for as long as a higher-priority locker was blocked on it.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param p_prev_acq_location Acquisition record seen before blocking (NULL if the locker did not block).
+/// @param wait_start_ns Time the locker started blocking at.
+/// @param sample_weight Number of holds the hold stands for if sampled, 0 otherwise.
+static void MutexGuardRecordHoldStart(  MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard                           ,
+                                        const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_prev_acq_location  ,
+                                        const uint64_t wait_start_ns                                            ,
+                                        const unsigned int sample_weight                                        )
+{
+    p_mutex_guard->hold_sample_weight = sample_weight;
+
+    // Unsampled holds are not timed, unless their budget or priority boosts need it (acq_ns is then left to 0).
+    bool timed      = (sample_weight || p_mutex_guard->hold_budget_ns || (p_mutex_guard->protocol != PTHREAD_PRIO_NONE));
+    uint64_t now_ns = (timed ? MutexGuardGetMonotonicNs() : 0);
+    p_mutex_guard->mutex_acq_location.acq_ns = now_ns;
+
+    // The hold which starts now ends the handoff started by the previous release (if traced).
+    p_mutex_guard->trace_acquire_flow_id = ((sample_weight && __atomic_load_n(&trace_events, __ATOMIC_RELAXED)) ? p_mutex_guard->trace_release_flow_id : 0);
+
+    if(p_mutex_guard->hold_budget_ns)
+        MutexGuardWatchdogArm(p_mutex_guard);
+
+    if(p_mutex_guard->protocol == PTHREAD_PRIO_NONE)
+        return;
+
+    int sched_priority = MutexGuardGetSchedPriority();
+    p_mutex_guard->mutex_acq_location.sched_priority = sched_priority;
+
+    if( (p_mutex_guard->protocol == PTHREAD_PRIO_INHERIT) && p_prev_acq_location    &&
+        p_prev_acq_location->thread_id && (sched_priority > p_prev_acq_location->sched_priority) )
+        MutexGuardRecordBoost(&p_mutex_guard->prio_stats, now_ns - wait_start_ns);
+}
+
+/// @brief Records the end of a hold (last release by its owner). Meant to be called with the guard's ctrl_mutex held.
+/// A PRIO_PROTECT guard's owner runs at the ceiling for the whole hold if its own priority is lower.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @return Hold duration.
+static uint64_t MutexGuardRecordHoldEnd(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    MutexGuardWatchdogDisarm(p_mutex_guard);
+
+    p_mutex_guard->trace_release_flow_id = 0;
+
+    if(!p_mutex_guard->mutex_acq_location.acq_ns)
+        return 0;
+
+    uint64_t now_ns     = MutexGuardGetMonotonicNs();
+    uint64_t hold_ns    = now_ns - p_mutex_guard->mutex_acq_location.acq_ns;
+
+    if( (p_mutex_guard->protocol == PTHREAD_PRIO_PROTECT) &&
+        (p_mutex_guard->mutex_acq_location.sched_priority < p_mutex_guard->prio_ceiling) )
+        MutexGuardRecordBoost(&p_mutex_guard->prio_stats, hold_ns);
+
+    unsigned int sample_weight = p_mutex_guard->hold_sample_weight;
+
+    if(!sample_weight)
+        return hold_ns;
+
+    if(__atomic_load_n(&trace_events, __ATOMIC_RELAXED))
+    {
+        p_mutex_guard->trace_release_flow_id = __atomic_add_fetch(&trace_flow_counter, 1, __ATOMIC_RELAXED);
+
+        MutexGuardTraceRecord(  p_mutex_guard                                   ,
+                                MTX_GRD_TRACE_EVENT_HOLD                        ,
+                                p_mutex_guard->mutex_acq_location.acq_ns        ,
+                                now_ns                                          ,
+                                p_mutex_guard->trace_acquire_flow_id            ,
+                                p_mutex_guard->trace_release_flow_id            );
+    }
+
+    MTX_GRD_STATS_SHARD* p_shard = MutexGuardGetStatsShard(p_mutex_guard, false);
+
+    __atomic_add_fetch(&p_shard->hold_counter, sample_weight, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&p_shard->hold_ns_total, hold_ns * sample_weight, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&p_shard->hold_histogram[MutexGuardHistBucket(hold_ns)], sample_weight, __ATOMIC_RELAXED);
+
+    uint64_t hold_ns_max = __atomic_load_n(&p_shard->hold_ns_max, __ATOMIC_RELAXED);
+
+    while((hold_ns > hold_ns_max) && !__atomic_compare_exchange_n(&p_shard->hold_ns_max, &hold_ns_max, hold_ns, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    return hold_ns;
+}
+
+/// @brief Gets the latency histogram bucket a duration belongs to.
+/// @param duration_ns Target duration.
+/// @return Bucket index.
+static size_t MutexGuardHistBucket(const uint64_t duration_ns)
+{
+    uint64_t bucket_bound_ns = MTX_GRD_HIST_BUCKET_BASE_NS;
+
+    for(size_t bucket = 0; bucket < (MTX_GRD_HIST_BUCKET_NUM - 1); bucket++)
+    {
+        if(duration_ns <= bucket_bound_ns)
+            return bucket;
+
+        bucket_bound_ns <<= MTX_GRD_HIST_BUCKET_FACTOR_SHIFT;
+    }
+
+    return (MTX_GRD_HIST_BUCKET_NUM - 1);
+}
+
+/// @brief Gets the statistics shard of the CPU the calling thread runs on, allocating the guard's shards on first use. sched_getcpu
+/// is served from the rseq area (or vDSO), so it costs no system call. Threads sharing a CPU (or migrating meanwhile) may hit the
+/// same shard, hence shards are updated atomically. Process-shared guards keep their embedded one, which is shared across processes.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param allocate Tells whether shards are allocated if missing (the embedded one is used otherwise).
+/// @return Pointer to the calling thread's shard.
+static MTX_GRD_STATS_SHARD* MutexGuardGetStatsShard(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const bool allocate)
+{
+    if(p_mutex_guard->process_shared)
+        return &p_mutex_guard->stats;
+
+    struct MTX_GRD_STATS_SHARDS* p_shards = __atomic_load_n(&p_mutex_guard->stats_shards, __ATOMIC_ACQUIRE);
+
+    if(!p_shards && !allocate)
+        return &p_mutex_guard->stats;
+
+    if(!p_shards)
+    {
+        struct MTX_GRD_STATS_SHARDS* p_new_shards;
+
+        if(posix_memalign((void**)&p_new_shards, MTX_GRD_CACHE_LINE_SIZE, sizeof(struct MTX_GRD_STATS_SHARDS)))
+            return &p_mutex_guard->stats;
+
+        memset(p_new_shards, 0, sizeof(struct MTX_GRD_STATS_SHARDS));
+
+        // Concurrent first recorders race to install theirs, losers take the winner's.
+        if(__atomic_compare_exchange_n(&p_mutex_guard->stats_shards, &p_shards, p_new_shards, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            p_shards = p_new_shards;
+        else
+            free(p_new_shards);
+    }
+
+    int cpu = sched_getcpu();
+
+    if(cpu < 0)
+    {
+        if(fallback_stats_shard < 0)
+            fallback_stats_shard = (int)(__atomic_fetch_add(&fallback_stats_shard_counter, 1, __ATOMIC_RELAXED) % __MTX_GRD_STATS_SHARD_NUM__);
+
+        cpu = fallback_stats_shard;
+    }
+
+    return &p_shards->cpus[(unsigned int)cpu % __MTX_GRD_STATS_SHARD_NUM__].shard;
+}
+
+/// @brief Adds up a counter over every statistics shard of a guard.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param field_offset Offset of the counter within MTX_GRD_STATS_SHARD.
+/// @return Counter's value.
+static unsigned long long MutexGuardStatsSum(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const size_t field_offset)
+{
+    unsigned long long value = __atomic_load_n((const unsigned long long*)((const char*)&p_mutex_guard->stats + field_offset), __ATOMIC_RELAXED);
+    const struct MTX_GRD_STATS_SHARDS* p_shards = __atomic_load_n(&p_mutex_guard->stats_shards, __ATOMIC_ACQUIRE);
+
+    for(size_t shard_index = 0; p_shards && (shard_index < __MTX_GRD_STATS_SHARD_NUM__); shard_index++)
+        value += __atomic_load_n((const unsigned long long*)((const char*)&p_shards->cpus[shard_index].shard + field_offset), __ATOMIC_RELAXED);
+
+    return value;
+}
+
+/// @brief Adds a statistics shard up to merged statistics.
+/// @param p_shard Pointer to the shard.
+/// @param p_stats Pointer to the structure statistics are being merged into.
+static void MutexGuardStatsMergeShard(const MTX_GRD_STATS_SHARD* C_MUTEX_GUARD_RESTRICT p_shard, MTX_GRD_STATS* C_MUTEX_GUARD_RESTRICT p_stats)
+{
+    p_stats->acquisition_counter        += __atomic_load_n(&p_shard->acquisition_counter, __ATOMIC_RELAXED);
+    p_stats->contention_counter         += __atomic_load_n(&p_shard->contention_counter, __ATOMIC_RELAXED);
+    p_stats->failure_counter            += __atomic_load_n(&p_shard->failure_counter, __ATOMIC_RELAXED);
+    p_stats->hold_counter               += __atomic_load_n(&p_shard->hold_counter, __ATOMIC_RELAXED);
+    p_stats->wait_ns_total              += __atomic_load_n(&p_shard->wait_ns_total, __ATOMIC_RELAXED);
+    p_stats->hold_ns_total              += __atomic_load_n(&p_shard->hold_ns_total, __ATOMIC_RELAXED);
+    p_stats->sample_counter             += __atomic_load_n(&p_shard->sample_counter, __ATOMIC_RELAXED);
+    p_stats->callsite_overflow_counter  += __atomic_load_n(&p_shard->callsite_overflow_counter, __ATOMIC_RELAXED);
+
+    uint64_t hold_ns_max = __atomic_load_n(&p_shard->hold_ns_max, __ATOMIC_RELAXED);
+
+    if(hold_ns_max > p_stats->hold_ns_max)
+        p_stats->hold_ns_max = hold_ns_max;
+
+    for(size_t bucket = 0; bucket < MTX_GRD_HIST_BUCKET_NUM; bucket++)
+    {
+        p_stats->wait_histogram[bucket] += __atomic_load_n(&p_shard->wait_histogram[bucket], __ATOMIC_RELAXED);
+        p_stats->hold_histogram[bucket] += __atomic_load_n(&p_shard->hold_histogram[bucket], __ATOMIC_RELAXED);
+    }
+
+    for(unsigned int callsite_index = 0; callsite_index < __MTX_GRD_CALLSITE_STATS_NUM__; callsite_index++)
+    {
+        p_stats->callsites[callsite_index].acquisition_counter  += __atomic_load_n(&p_shard->callsite_acquisition_counters[callsite_index], __ATOMIC_RELAXED);
+        p_stats->callsites[callsite_index].wait_ns_total        += __atomic_load_n(&p_shard->callsite_wait_ns_totals[callsite_index], __ATOMIC_RELAXED);
+    }
+}
+
+/// @brief Merges every statistics shard of a guard. Takes no lock, so values may be slightly stale.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param p_stats Pointer to the structure statistics are meant to be merged into.
+static void MutexGuardStatsMerge(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, MTX_GRD_STATS* C_MUTEX_GUARD_RESTRICT p_stats)
+{
+    memset(p_stats, 0, sizeof(MTX_GRD_STATS));
+
+    for(unsigned int callsite_index = 0; callsite_index < __MTX_GRD_CALLSITE_STATS_NUM__; callsite_index++)
+        p_stats->callsites[callsite_index].address = __atomic_load_n(&p_mutex_guard->callsite_addresses[callsite_index], __ATOMIC_ACQUIRE);
+
+    MutexGuardStatsMergeShard(&p_mutex_guard->stats, p_stats);
+
+    const struct MTX_GRD_STATS_SHARDS* p_shards = __atomic_load_n(&p_mutex_guard->stats_shards, __ATOMIC_ACQUIRE);
+
+    for(size_t shard_index = 0; p_shards && (shard_index < __MTX_GRD_STATS_SHARD_NUM__); shard_index++)
+        MutexGuardStatsMergeShard(&p_shards->cpus[shard_index].shard, p_stats);
+}
+
+/// @brief Gets the next number of the calling thread's sampling random sequence (xorshift64*, seeded on first use).
+/// @return Random number.
+static uint64_t MutexGuardSamplingRandom(void)
+{
+    if(!sampling_random_state)
+        sampling_random_state = ((MutexGuardGetMonotonicNs() ^ ((uint64_t)MutexGuardGetKernelTid() * MTX_GRD_SAMPLING_SEED_MULTIPLIER)) | 1);
+
+    sampling_random_state ^= sampling_random_state >> 12;
+    sampling_random_state ^= sampling_random_state << 25;
+    sampling_random_state ^= sampling_random_state >> 27;
+
+    return sampling_random_state * MTX_GRD_SAMPLING_RANDOM_MULTIPLIER;
+}
+
+/// @brief Decides whether a lock call is sampled. Every call spends 1/period of the calling thread's countdown, and the one which
+/// exhausts it is sampled. The countdown is then refilled with a random amount averaging a whole unit, so that every call is sampled
+/// with a 1/period probability (whatever the mix of guards and periods) without locking into periodic patterns of the caller.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @return Number of calls the sampled call stands for, 0 if not sampled.
+static unsigned int MutexGuardSampleWeight(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    unsigned int period = __atomic_load_n(&p_mutex_guard->sampling_period, __ATOMIC_RELAXED);
+
+    if(!period)
+        period = __atomic_load_n(&sampling_period, __ATOMIC_RELAXED);
+
+    if(period <= 1)
+        return 1;
+
+    if(!sampling_random_state)
+        sampling_countdown = 1 + (int64_t)(MutexGuardSamplingRandom() % (2 * MTX_GRD_SAMPLING_UNIT - 1));
+
+    sampling_countdown -= MTX_GRD_SAMPLING_UNIT / period;
+
+    if(sampling_countdown > 0)
+        return 0;
+
+    sampling_countdown += 1 + (int64_t)(MutexGuardSamplingRandom() % (2 * MTX_GRD_SAMPLING_UNIT - 1));
+
+    return period;
+}
+
+/// @brief Accounts a successful acquisition. Takes no lock: lock addresses claim a slot of the guard's table once and for all,
+/// counters go to the calling thread's shard.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param address Address the guard was locked at (if any).
+/// @param blocked Tells whether the locker had to wait for another owner.
+/// @param wait_ns Time spent waiting.
+/// @param weight Number of acquisitions the recorded one stands for (see MutexGuardSampleWeight).
+static void MutexGuardRecordAcquisition(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard  ,
+                                        void* address                                   ,
+                                        const bool blocked                              ,
+                                        const uint64_t wait_ns                          ,
+                                        const unsigned int weight                       )
+{
+    MTX_GRD_STATS_SHARD* p_shard = MutexGuardGetStatsShard(p_mutex_guard, true);
+
+    __atomic_add_fetch(&p_shard->sample_counter, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&p_shard->acquisition_counter, weight, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&p_shard->wait_histogram[MutexGuardHistBucket(wait_ns)], weight, __ATOMIC_RELAXED);
+
+    if(blocked)
+    {
+        __atomic_add_fetch(&p_shard->contention_counter, weight, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&p_shard->wait_ns_total, wait_ns * weight, __ATOMIC_RELAXED);
+    }
+
+    if(!address)
+        return;
+
+    for(unsigned int callsite_index = 0; callsite_index < __MTX_GRD_CALLSITE_STATS_NUM__; callsite_index++)
+    {
+        void* callsite_address = __atomic_load_n(&p_mutex_guard->callsite_addresses[callsite_index], __ATOMIC_ACQUIRE);
+
+        // A locker losing the race for a free slot finds out which address won it, which may be its own.
+        if(!callsite_address && __atomic_compare_exchange_n(&p_mutex_guard->callsite_addresses[callsite_index], &callsite_address, address, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            callsite_address = address;
+
+        if(callsite_address != address)
+            continue;
+
+        __atomic_add_fetch(&p_shard->callsite_acquisition_counters[callsite_index], weight, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&p_shard->callsite_wait_ns_totals[callsite_index], wait_ns * weight, __ATOMIC_RELAXED);
+
+        return;
+    }
+
+    __atomic_add_fetch(&p_shard->callsite_overflow_counter, weight, __ATOMIC_RELAXED);
+}
+
+/// @brief Starts the watchdog thread if it is not running yet. Meant to be called with watchdog_mutex held.
+static void MutexGuardWatchdogStart(void)
+{
+    if(__atomic_load_n(&watchdog_started, __ATOMIC_RELAXED))
+        return;
+
+    pthread_t watchdog_thread;
+    pthread_attr_t watchdog_attr;
+
+    pthread_attr_init(&watchdog_attr);
+    pthread_attr_setdetachstate(&watchdog_attr, PTHREAD_CREATE_DETACHED);
+    __atomic_store_n(&watchdog_started, !pthread_create(&watchdog_thread, &watchdog_attr, MutexGuardWatchdogThread, NULL), __ATOMIC_RELAXED);
+    pthread_attr_destroy(&watchdog_attr);
+}
+
+/// @brief Adds a guard to the budgeted guards list (unless it is already there), starting the watchdog thread if needed.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+static void MutexGuardWatchdogAdd(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    pthread_mutex_lock(&watchdog_mutex);
+
+    MutexGuardWatchdogStart();
+
+    if(!p_mutex_guard->watchdog_listed)
+    {
+        p_mutex_guard->watchdog_prev = NULL;
+        p_mutex_guard->watchdog_next = watchdog_head;
+
+        if(watchdog_head)
+            watchdog_head->watchdog_prev = p_mutex_guard;
+
+        watchdog_head = p_mutex_guard;
+        p_mutex_guard->watchdog_listed = true;
+    }
+
+    pthread_mutex_unlock(&watchdog_mutex);
+}
+
+/// @brief Removes a guard from the budgeted guards list (if it is there), so that the watchdog no longer looks at it.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+static void MutexGuardWatchdogRemove(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    pthread_mutex_lock(&watchdog_mutex);
+
+    if(p_mutex_guard->watchdog_listed)
+    {
+        if(p_mutex_guard->watchdog_prev)
+            p_mutex_guard->watchdog_prev->watchdog_next = p_mutex_guard->watchdog_next;
+        else
+            watchdog_head = p_mutex_guard->watchdog_next;
+
+        if(p_mutex_guard->watchdog_next)
+            p_mutex_guard->watchdog_next->watchdog_prev = p_mutex_guard->watchdog_prev;
+
+        p_mutex_guard->watchdog_listed = false;
+    }
+
+    pthread_mutex_unlock(&watchdog_mutex);
+}
+
+/// @brief Publishes the deadline of a hold which just started, for the watchdog to find it on its next scans.
+/// Meant to be called with the guard's ctrl_mutex held.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+static void MutexGuardWatchdogArm(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    // A forked child has no watchdog thread until some hold starts it again.
+    if(!__atomic_load_n(&watchdog_started, __ATOMIC_RELAXED))
+    {
+        pthread_mutex_lock(&watchdog_mutex);
+        MutexGuardWatchdogStart();
+        pthread_mutex_unlock(&watchdog_mutex);
+    }
+
+    __atomic_store_n(&p_mutex_guard->hold_deadline_ns, p_mutex_guard->mutex_acq_location.acq_ns + p_mutex_guard->hold_budget_ns, __ATOMIC_RELAXED);
+}
+
+/// @brief Clears the deadline of a hold (if it was not already flagged). Meant to be called with the guard's ctrl_mutex held.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+static void MutexGuardWatchdogDisarm(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    if(__atomic_load_n(&p_mutex_guard->hold_deadline_ns, __ATOMIC_RELAXED))
+        __atomic_store_n(&p_mutex_guard->hold_deadline_ns, 0, __ATOMIC_RELAXED);
+}
+
+/// @brief Prints a hold budget violation through MutexGuardPrintError.
+/// @param p_violation Pointer to violation data.
+static void MutexGuardPrintHoldViolation(const MTX_GRD_HOLD_VIOLATION* C_MUTEX_GUARD_RESTRICT p_violation)
+{
+    char lock_error_string[MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN] = {0};
+
+    snprintf(   lock_error_string                                               ,
+                sizeof(lock_error_string)                                       ,
+                MTX_GRD_MSG_ERR_HOLD_BUDGET                                     ,
+                (p_violation->name[0] ? p_violation->name : MTX_GRD_DUMP_UNNAMED),
+                (const void*)p_violation->p_mutex_guard                         );
+
+    MutexGuardPrintLockAddresses(   &p_violation->acq_location                                          ,
+                                    (lock_error_string + strlen(lock_error_string))                     ,
+                                    (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)));
+
+    snprintf(   (lock_error_string + strlen(lock_error_string))                 ,
+                (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)),
+                MTX_GRD_MSG_ERR_HOLD_BUDGET_OWNER                               ,
+                p_violation->acq_location.thread_id                             ,
+                p_violation->acq_location.process_id                            ,
+                p_violation->acq_location.kernel_tid                            ,
+                p_violation->hold_budget_ns / MTX_GRD_TOUT_1_SEC_AS_NS          ,
+                p_violation->hold_budget_ns % MTX_GRD_TOUT_1_SEC_AS_NS          );
+
+    mutex_guard_errno = MTX_GRD_ERR_HOLD_BUDGET_EXCEEDED;
+    MutexGuardPrintError(lock_error_string);
+}
+
+/// @brief Watchdog thread: once per tick, flags the budgeted guards whose current hold exceeded its deadline.
+/// @param arg Unused.
+/// @return Never returns.
+static void* MutexGuardWatchdogThread(void* arg)
+{
+    (void)arg;
+
+    sigset_t blocked_signals;
+    sigfillset(&blocked_signals);
+    pthread_sigmask(SIG_BLOCK, &blocked_signals, NULL);
+
+    MTX_GRD_HOLD_VIOLATION violations[MTX_GRD_WATCHDOG_MAX_REPORTS];
+    uint64_t last_tick = MutexGuardGetMonotonicNs() / MTX_GRD_WATCHDOG_TICK_NS;
+
+    while(true)
+    {
+        uint64_t next_tick_ns   = (last_tick + 1) * MTX_GRD_WATCHDOG_TICK_NS;
+        mtx_to_t next_tick_time = { .tv_sec = next_tick_ns / MTX_GRD_TOUT_1_SEC_AS_NS, .tv_nsec = next_tick_ns % MTX_GRD_TOUT_1_SEC_AS_NS };
+
+        if(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_tick_time, NULL))
+            continue;
+
+        uint64_t now_ns             = MutexGuardGetMonotonicNs();
+        unsigned int violation_num  = 0;
+
+        pthread_mutex_lock(&watchdog_mutex);
+
+        for(MTX_GRD* p_mutex_guard = watchdog_head; p_mutex_guard; p_mutex_guard = p_mutex_guard->watchdog_next)
+        {
+            uint64_t deadline_ns = __atomic_load_n(&p_mutex_guard->hold_deadline_ns, __ATOMIC_RELAXED);
+
+            if(!deadline_ns || (deadline_ns > now_ns))
+                continue;
+
+            // Owners take ctrl_mutex before watchdog_mutex, so it is only tried: a busy guard is looked at again on the next tick.
+            if(pthread_mutex_trylock(&p_mutex_guard->ctrl_mutex))
+                continue;
+
+            // The hold may have ended (or another one started) since its deadline was read.
+            deadline_ns = p_mutex_guard->hold_deadline_ns;
+
+            if(deadline_ns && (deadline_ns <= now_ns))
+            {
+                __atomic_store_n(&p_mutex_guard->hold_deadline_ns, 0, __ATOMIC_RELAXED);
+                __atomic_add_fetch(&p_mutex_guard->hold_violation_counter, 1, __ATOMIC_RELAXED);
+
+                // Guards cannot be destroyed while the list is being walked, so their records are copied right now.
+                if( (verbosity_level & MTX_GRD_VERBOSITY_LOCK_ERROR) && (violation_num < MTX_GRD_WATCHDOG_MAX_REPORTS) )
+                {
+                    MTX_GRD_HOLD_VIOLATION* p_violation = &violations[violation_num++];
+
+                    p_violation->p_mutex_guard  = p_mutex_guard;
+                    p_violation->hold_budget_ns = p_mutex_guard->hold_budget_ns;
+                    memcpy(p_violation->name, p_mutex_guard->name, sizeof(p_violation->name));
+                    memcpy(&p_violation->acq_location, &p_mutex_guard->mutex_acq_location, sizeof(MTX_GRD_ACQ_LOCATION));
+                    p_violation->name[sizeof(p_violation->name) - 1] = 0;
+                }
+            }
+
+            pthread_mutex_unlock(&p_mutex_guard->ctrl_mutex);
+        }
+
+        pthread_mutex_unlock(&watchdog_mutex);
+
+        last_tick = now_ns / MTX_GRD_WATCHDOG_TICK_NS;
+
+        for(unsigned int violation_index = 0; violation_index < violation_num; violation_index++)
+            MutexGuardPrintHoldViolation(&violations[violation_index]);
+    }
+
+    return NULL;
+}
+
+/// @brief Tells whether the thread recorded as a guard's owner is still running.
+/// @param p_mutex_guard_acq_location Pointer to the guard's acquisition record.
+/// @return false if owner thread (or process) is known to be gone, true otherwise.
+static bool MutexGuardIsOwnerAlive(const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_mutex_guard_acq_location)
+{
+    if(!p_mutex_guard_acq_location->process_id || !p_mutex_guard_acq_location->kernel_tid)
+        return true;
+
+    if(syscall(SYS_tgkill, p_mutex_guard_acq_location->process_id, p_mutex_guard_acq_location->kernel_tid, 0) && (errno == ESRCH))
+        return false;
+
+    return true;
+}
+
+/// @brief Stores a new lock address.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param address Target address to be stored.
+/// @return 0 if succeeded, < 0 otherwise.
+static int MutexGuardStoreNewAddress(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, void* address)
+{
+    if(!p_mutex_guard)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    for(int address_index = 0; address_index < __MTX_GRD_ADDR_NUM__; address_index++)
+    {
+        if(!p_mutex_guard->mutex_acq_location.addresses[address_index])
+        {
+            p_mutex_guard->mutex_acq_location.addresses[address_index] = address;
+
+            if(p_mutex_guard->process_shared)
+                MutexGuardGetCallsite(address, &p_mutex_guard->mutex_acq_location.callsites[address_index]);
+
+            return 0;
+        }
+    }
+    
+    mutex_guard_errno = MTX_GRD_ERR_NO_ADDR_SPACE_AVAILABLE;
+    return -2;
+}
+
+/// @brief Removes latest lock address.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @return 0 if succeeded, < 0 otherwise.
+static int MutexGuardRemoveLatestAddress(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    if(!p_mutex_guard)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    for(int address_index = (__MTX_GRD_ADDR_NUM__ - 1); address_index >= 0; address_index--)
+    {
+        if( p_mutex_guard->mutex_acq_location.addresses[address_index])
+        {
+            p_mutex_guard->mutex_acq_location.addresses[address_index] = NULL;
+            memset(&p_mutex_guard->mutex_acq_location.callsites[address_index], 0, sizeof(MTX_GRD_CALLSITE));
+            return 0;
+        }
+    }
+    
+    mutex_guard_errno = MTX_GRD_ERR_NO_ADDR_SPACE_AVAILABLE;
+    return -2;
+}
+
+/// @brief Returns timespec type struct to be used alongside timed locks.
+/// @param timeout_ns Target timeout value (in nanoseconds).
+/// @return Resulting timespec.
+static mtx_to_t MutexGuardGenTimespec(const uint64_t timeout_ns)
+{
+    return MutexGuardGenClockTimespec(CLOCK_REALTIME, timeout_ns);
+}
+
+/// @brief Returns timespec type struct holding an absolute deadline measured against the given clock.
+/// @param clock_id Clock the deadline is measured against.
+/// @param timeout_ns Target timeout value (in nanoseconds).
+/// @return Resulting timespec.
+static mtx_to_t MutexGuardGenClockTimespec(const clockid_t clock_id, const uint64_t timeout_ns)
+{
+    mtx_to_t lock_timeout;
+    clock_gettime(clock_id, &lock_timeout);
+    
+    // Add the timeout (in nanoseconds) to the current time
+    lock_timeout.tv_sec += timeout_ns / MTX_GRD_TOUT_1_SEC_AS_NS;
+    lock_timeout.tv_nsec += timeout_ns % MTX_GRD_TOUT_1_SEC_AS_NS;
+    
+    // Handle possible overflow in nanoseconds (if it's >= 1 second)
+    if (lock_timeout.tv_nsec >= MTX_GRD_TOUT_1_SEC_AS_NS)
+    {
+        lock_timeout.tv_nsec -= MTX_GRD_TOUT_1_SEC_AS_NS;
+        lock_timeout.tv_sec += 1;
+    }
+
+    return lock_timeout;
+}
+
+/// @brief Gets current CLOCK_MONOTONIC time.
+/// @return Current time (in nanoseconds).
+static uint64_t MutexGuardGetMonotonicNs(void)
+{
+    mtx_to_t now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * MTX_GRD_TOUT_1_SEC_AS_NS) + (uint64_t)now.tv_nsec;
+}
+
+/// @brief Copies lock error to a provided buffer.
+/// @param p_lock_failure Pointer to the lock failure record.
+/// @param timeout_ns Target timeout value (if any, in nanoseconds).
+/// @param ret_lock Value returned by pthread mutex locking function.
+/// @param lock_error_string Buffer where the error is meant to eb copied to.
+/// @param lock_error_str_size Buffer size.
+/// @return 0 if succeeded, < 0 otherwise.
+static int MutexGuardCopyLockError( const MTX_GRD_LOCK_FAILURE* C_MUTEX_GUARD_RESTRICT p_lock_failure ,
+                                    const uint64_t timeout_ns       ,
+                                    const int ret_lock              ,
+                                    char* lock_error_string         ,
+                                    const size_t lock_error_str_size)
+{
+    if(!p_lock_failure)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!lock_error_string)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
+    }
+
+    // The owner's location was copied when the lock failed, as the guard may have changed hands (or be gone) since.
+    const MTX_GRD_ACQ_LOCATION* p_owner_location = &p_lock_failure->owner_location;
+
+    MutexGuardPrintLockErrorCause(  p_owner_location                                    ,
+                                    p_lock_failure->mutex_address                       ,
+                                    timeout_ns                                          ,
+                                    ret_lock                                            ,
+                                    (lock_error_string + strlen(lock_error_string))     ,
+                                    (lock_error_str_size - strlen(lock_error_string))   );
+
+    MutexGuardPrintLockAddresses(   p_owner_location                                    ,
+                                    (lock_error_string + strlen(lock_error_string))     ,
+                                    (lock_error_str_size - strlen(lock_error_string))   );
+    
+    return 0;
+}
+
+/// @brief Gets lock error and copies it provided buffer.
+/// @param p_lock_failure Pointer to the lock failure record.
+/// @param timeout_ns Target timeout value (if any, in nanoseconds).
+/// @param lock_error_string Buffer where the error is meant to eb copied to.
+/// @param lock_error_str_size Buffer size.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardGetLockError( const MTX_GRD_LOCK_FAILURE* C_MUTEX_GUARD_RESTRICT p_lock_failure ,
+                            const uint64_t timeout_ns       ,
+                            char* lock_error_string         ,
+                            const size_t lock_error_str_size)
+{
+    if(!p_lock_failure)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!lock_error_string)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
+    }
+
+    int copy_lock_error_string = MutexGuardCopyLockError(   p_lock_failure              ,
+                                                            timeout_ns                  ,
+                                                            mutex_guard_lock_error_code ,
+                                                            lock_error_string           ,
+                                                            lock_error_str_size         );
+    
+    if(copy_lock_error_string < 0)
+    {   
+        strncat(lock_error_string                                   ,
+                MTX_GRD_GET_LAST_ERR_STR                            ,
+                (lock_error_str_size - strlen(lock_error_string))   );
+        
+        return -3;
+    }
+    
+    return 0;
+}
+
+/// @brief Stores lock error cause to a given buffer.
+/// @param p_mutex_guard_acq_location Pointer to mutex acquisition location struct.
+/// @param mutex_address Pointer to target mutex variable.
+/// @param timeout_ns Target timeout value (if any, in nanoseconds).
+/// @param ret_lock Value returned by pthread mutex locking function.
+/// @param lock_error_string Buffer where the error is meant to eb copied to.
+/// @param lock_error_str_size Buffer size.
+/// @return 0 if succeeded, < 0 otherwise.
+static int MutexGuardPrintLockErrorCause(   const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_mutex_guard_acq_location ,
+                                            const pthread_mutex_t* C_MUTEX_GUARD_RESTRICT mutex_address                   ,
+                                            const uint64_t timeout_ns                                       ,
+                                            const int ret_lock                                              ,
+                                            char* lock_error_string                                         ,
+                                            const size_t lock_error_str_size                                )
+{
+    if(!p_mutex_guard_acq_location)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_ACQ;
+        return -1;
+    }
+
+    if(!lock_error_string)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
+    }
+
+    if(timeout_ns > 0 && (ret_lock == ETIMEDOUT))
+        snprintf(   lock_error_string + strlen(lock_error_string)       ,
+                    (lock_error_str_size - strlen(lock_error_string))   ,
+                    MTX_GRD_MSG_ERR_MUTEX_TIMEOUT                       ,
+                    timeout_ns / MTX_GRD_TOUT_1_SEC_AS_NS               ,
+                    timeout_ns % MTX_GRD_TOUT_1_SEC_AS_NS               );
+
+    snprintf(   lock_error_string + strlen(lock_error_string)       ,
+                (lock_error_str_size - strlen(lock_error_string))   ,
+                MTX_GRD_MSG_ERR_MUTEX_ACQ                           ,
+                pthread_self()                                      ,
+                mutex_address                                       ,
+                strerror(ret_lock)                                  );
+    
+    if(p_mutex_guard_acq_location->addresses[0])
+        snprintf(   lock_error_string + strlen(lock_error_string)       ,
+                    (lock_error_str_size - strlen(lock_error_string))   ,
+                    MTX_GRD_MSG_ERR_MUTEX_ACQ_ADDR_HEADER               ,
+                    p_mutex_guard_acq_location->thread_id               ,
+                    p_mutex_guard_acq_location->process_id              ,
+                    p_mutex_guard_acq_location->kernel_tid              );
+    
+    return 0;
+}
+
+/// @brief Prints lock address history to a given buffer.
+/// @param p_mutex_guard_acq_location Pointer to given mutex acquisition location.
+/// @param lock_error_string Buffer where the error is meant to eb copied to.
+/// @param lock_error_str_size Buffer size.
+/// @return 0 if succeeded, < 0 otherwise.
+static int MutexGuardPrintLockAddresses(const MTX_GRD_ACQ_LOCATION* p_mutex_guard_acq_location  ,
+                                        char* lock_error_string                                 ,
+                                        const size_t lock_error_str_size                        )
+{
+    if(!p_mutex_guard_acq_location)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_ACQ;
+        return -1;
+    }
+
+    if(!lock_error_string)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
+    }
+
+    MTX_GRD_ACQ_LOCATION_DETAIL detail = {0};
+
+    if(!p_mutex_guard_acq_location->addresses[0])
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NO_STORED_LOCK_ADDRESSES;
+        return -3;
+    }
+
+    // Addresses recorded by another process cannot be resolved locally, so their build ID + offset is shown instead.
+    bool foreign_process = (p_mutex_guard_acq_location->process_id && (p_mutex_guard_acq_location->process_id != MutexGuardGetProcessId()));
+
+    for(unsigned int adress_index = 0; adress_index < __MTX_GRD_ADDR_NUM__; adress_index++)
+    {
+        if(!p_mutex_guard_acq_location->addresses[adress_index])
+            break;
+
+        if(foreign_process)
+        {
+            char build_id_str[MTX_GRD_BUILD_ID_STR_LEN] = {0};
+            MutexGuardBuildIdToString(p_mutex_guard_acq_location->callsites[adress_index].build_id, build_id_str);
+
+            snprintf(   lock_error_string + strlen(lock_error_string)                       ,
+                        (lock_error_str_size - strlen(lock_error_string))                   ,
+                        MTX_GRD_ACQ_CALLSITE_FORMAT                                         ,
+                        adress_index                                                        ,
+                        build_id_str                                                        ,
+                        (unsigned long)p_mutex_guard_acq_location->callsites[adress_index].offset);
+            continue;
+        }
+        
+        MutexGuardPrintFileAndLineFromAddr( p_mutex_guard_acq_location->addresses[adress_index] ,
+                                            lock_error_string                                   ,
+                                            adress_index                                        ,
+                                            &detail                                             ,
+                                            (lock_error_str_size - strlen(lock_error_string))   );
+        
+        memset(detail.function_name, 0, strlen(detail.function_name));
+        memset(detail.file_path, 0, strlen(detail.file_path));
+        detail.line = 0;
+        detail.relative_address = NULL;
+    }
+
+    return 0;
+}
+
+/// @brief Directly prints mutex lock error to standard output.
+/// @param p_mutex_guard_acq_location Pointer to given mutex acquisition location.
+/// @param target_mutex_addr Pointer to target mutex variable.
+/// @param timeout_ns Target timeout value (if any, in nanoseconds).
+/// @param ret_lock Value returned by pthread mutex locking function.
+void MutexGuardPrintLockError(  const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_mutex_guard_acq_location ,
+                                const pthread_mutex_t* C_MUTEX_GUARD_RESTRICT target_mutex_addr               ,
+                                const uint64_t timeout_ns                                       ,
+                                const int ret_lock                                              )
+{
+    char lock_error_string[MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN] = {0};
+
+    strncat((lock_error_string + strlen(lock_error_string))                     ,
+            MTX_GRD_MSG_ERR_MUTEX_HEADER                                        ,
+            (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)));
+
+    MutexGuardPrintLockErrorCause(  p_mutex_guard_acq_location                                          ,
+                                    target_mutex_addr                                                   ,
+                                    timeout_ns                                                          ,
+                                    ret_lock                                                            ,
+                                    (lock_error_string + strlen(lock_error_string))                     ,
+                                    (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)));
+
+    MutexGuardPrintLockAddresses(   p_mutex_guard_acq_location                                          ,
+                                    (lock_error_string + strlen(lock_error_string))                     ,
+                                    (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)));
+
+    strncat((lock_error_string + strlen(lock_error_string))                     ,
+            MTX_GRD_MSG_ERR_MUTEX_FOOTER                                        ,
+            (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)));
+
+    printf("%s", lock_error_string);
+}
+
+/// @brief Directly prints mutex lock/unlock backtrace to standard output.
+/// @param p_locked_mutex Address of mutex to be locked/unlocked.
+/// @param is_lock true for locking operations, false for unlocking.
+static void MutexGuardShowBacktrace(const pthread_mutex_t* C_MUTEX_GUARD_RESTRICT p_locked_mutex, const bool is_lock)
+{
+    void* call_stack[__MTX_GRD_FULL_BT_MAX_SIZE__ + 1] = {0};
+    int call_stack_size = backtrace(call_stack, __MTX_GRD_FULL_BT_MAX_SIZE__ + 1);
+    char** call_stack_symbols = backtrace_symbols(call_stack, call_stack_size);
+
+    if(call_stack_symbols && call_stack_symbols[1])
+    {
+        char bt_id_str[MTX_GRD_BT_ID_LEN] = {0};
+
+        snprintf(   bt_id_str                                                   ,
+                    MTX_GRD_BT_ID_LEN                                           ,
+                    MTX_GRD_BT_ID_FORMAT                                        ,
+                    pthread_self()                                              ,
+                    p_locked_mutex                                              ,
+                    is_lock ? MTX_GRD_BT_ID_LOCK_STR : MTX_GRD_BT_ID_UNLOCK_STR );
+
+        printf("%s%s\r\n", bt_id_str, MTX_GRD_BT_HEADER);
+
+        unsigned bt_id_str_len = strlen(bt_id_str);
+
+        char lock_error_string[MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN] = {0};
+        strncpy(lock_error_string, bt_id_str, MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string));
+        MTX_GRD_ACQ_LOCATION_DETAIL detail = {0};
+
+        for(unsigned long long call_stack_index = 1; call_stack_index < call_stack_size; call_stack_index++)
+        {
+            snprintf((lock_error_string + strlen(lock_error_string))                    ,
+                    (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)),
+                    MTX_GRD_BT_FRAME_INFO                                               ,
+                    (call_stack_index - 1)                                              ,
+                    call_stack_symbols[call_stack_index]                                );
+
+            char* rel_addr_begin = strstr(call_stack_symbols[call_stack_index], MTX_GRD_BT_REL_ADDR_BEGIN_STR);
+            char* rel_addr_end = strstr(call_stack_symbols[call_stack_index], MTX_GRD_BT_REL_ADDR_END_STR);
+            
+            if(!rel_addr_begin || !rel_addr_end)
+            {
+                printf("\r\n");
+                continue;
+            }
+
+            char* end_ptr;
+
+            *rel_addr_end = 0;
+            unsigned long long rel_addr = strtoull( rel_addr_begin + strlen(MTX_GRD_BT_REL_ADDR_BEGIN_STR),
+                                                    &end_ptr,
+                                                    MTX_GRD_BT_REL_ADDR_HEX_BASE);
+            
+            if(*end_ptr)
+            {
+                printf("\r\n");
+                continue;
+            }
+
+            detail.relative_address = (void*)rel_addr;
+            
+            MutexGuardGetLockDetailFromAddr(NULL, &detail);
+
+            if(strcmp(detail.file_path, MTX_GRD_BT_NOT_FOUND_SYMBOL))
+                snprintf(   (lock_error_string + strlen(lock_error_string))                     ,
+                            (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)),
+                            MTX_GRD_BT_FRAME_TO_FILE_FORMAT                                     ,
+                            detail.file_path                                                    );
+
+            if(detail.line)
+                snprintf(   (lock_error_string + strlen(lock_error_string))                     ,
+                            (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)),
+                             MTX_GRD_BT_FRAME_TO_LINE_FORMAT                                    ,
+                            detail.line                                                         );
+            
+            if(strcmp(detail.function_name, MTX_GRD_BT_NOT_FOUND_SYMBOL))
+                snprintf(   (lock_error_string + strlen(lock_error_string))                     ,
+                            (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)),
+                            MTX_GRD_BT_FRAME_TO_FUNCTION_FORMAT                                 ,
+                            detail.function_name                                                );
+
+            printf("%s\r\n", lock_error_string);
+            memset(lock_error_string + bt_id_str_len, 0, strlen(lock_error_string + bt_id_str_len));
+        }
+
+        printf("%s%s\r\n", bt_id_str, MTX_GRD_BT_FOOTER);
+    }
+}
+
+/// @brief Records the acquisition of a guard by the calling thread, which has just locked its mutex (owner, addresses, stats and trace).
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param address Address in which the guard was locked.
+/// @param ret_lock Mutex lock return value (0 or EOWNERDEAD).
+/// @param blocked Tells whether the calling thread had to wait for the guard.
+/// @param wait_start_ns Time at which the wait started (if blocked).
+/// @param wait_ns Time spent waiting for the guard.
+/// @param sample_weight Number of acquisitions the current one stands for (0 if it is not sampled).
+/// @param p_target_acq_location Previous owner's location, as found when blocking (NULL if not blocked).
+/// @param timeout_ns Target timeout value (if any, in nanoseconds).
+static void MutexGuardRecordLocked( MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard                            ,
+                                    void* C_MUTEX_GUARD_RESTRICT address                                     ,
+                                    const int ret_lock                                                       ,
+                                    const bool blocked                                                       ,
+                                    const uint64_t wait_start_ns                                             ,
+                                    const uint64_t wait_ns                                                   ,
+                                    const unsigned int sample_weight                                         ,
+                                    const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_target_acq_location ,
+                                    const uint64_t timeout_ns                                                )
+{
+    // Slow calls are always recorded, as themselves, so that sampled (faster) ones still stand for the rest without bias.
+    uint64_t slow_ns            = __atomic_load_n(&sampling_slow_ns, __ATOMIC_RELAXED);
+    unsigned int stats_weight   = ((blocked && slow_ns && (wait_ns >= slow_ns)) ? 1 : sample_weight);
+
+    // Statistics take no lock: only the owner's record goes under ctrl_mutex.
+    if(stats_weight)
+        MutexGuardRecordAcquisition(p_mutex_guard, address, blocked, wait_ns, stats_weight);
+
+    if(MutexGuardLockCtrlMutex(p_mutex_guard, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    if(ret_lock == EOWNERDEAD)
+        MutexGuardRecordDeadOwner(p_mutex_guard);
+
+    if(!p_mutex_guard->lock_counter)
+        MutexGuardRecordHoldStart(p_mutex_guard, p_target_acq_location, wait_start_ns, sample_weight);
+
+    MutexGuardStoreNewAddress(p_mutex_guard, address);
+
+    if(blocked && stats_weight)
+        MutexGuardTraceRecord(p_mutex_guard, MTX_GRD_TRACE_EVENT_WAIT, wait_start_ns, wait_start_ns + wait_ns, 0, 0);
+
+    p_mutex_guard->mutex_acq_location.thread_id     = pthread_self();
+    p_mutex_guard->mutex_acq_location.process_id    = MutexGuardGetProcessId();
+    p_mutex_guard->mutex_acq_location.kernel_tid    = MutexGuardGetKernelTid();
+
+    ++p_mutex_guard->lock_counter;
+    
+    if(p_mutex_guard->lock_counter > __MTX_GRD_ADDR_NUM__)
+        mutex_guard_errno = MTX_GRD_ERR_OUT_OF_ADDR_COUNTER_BOUNDARIES;
+
+    if(verbosity_level & MTX_GRD_VERBOSITY_BT)
+        MutexGuardShowBacktrace(&p_mutex_guard->mutex, true);
+
+    if(ret_lock == EOWNERDEAD)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_OWNER_DEAD;
+        MutexGuardRecordLockFailure(p_mutex_guard, &p_mutex_guard->mutex_acq_location, &p_mutex_guard->dead_owner_location);
+
+        if(verbosity_level & MTX_GRD_VERBOSITY_LOCK_ERROR)
+            MutexGuardPrintLockError(&p_mutex_guard->dead_owner_location, &p_mutex_guard->mutex, timeout_ns, ret_lock);
+    }
+
+    if(MutexGuardUnlockCtrlMutex(p_mutex_guard, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+}
+
+/// @brief Locks target mutex.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param address Address in which the current mutex is being tried to be locked.
+/// @param timeout_ns Target timeout value (if any, in nanoseconds).
+/// @param lock_type Lock type (TR_LOCK, LOCK, TIMED_LOCK, PERIODIC_TIMED_LOCK).
+/// @return 0 if succeeded, != 0 otherwise.
+int MutexGuardLock(MTX_GRD* p_mutex_guard, void* C_MUTEX_GUARD_RESTRICT address, const uint64_t timeout_ns, const int lock_type)
+{
+    if(!p_mutex_guard)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    // Owner's location is only copied once the guard is found held (or failing), so that uncontended locks leave ctrl_mutex alone.
+    MTX_GRD_ACQ_LOCATION target_mutex_acq_location;
+
+    int ret_lock = EBUSY;
+
+    if( (lock_type < MTX_GRD_LOCK_TYPE_MIN) || (lock_type > MTX_GRD_LOCK_TYPE_MAX) )
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INVALID_LOCK_TYPE;
+        return -2;
+    }
+    
+    MTX_GRD_PROBE4(lock__attempt, p_mutex_guard, address, lock_type, timeout_ns);
+
+    unsigned int sample_weight = MutexGuardSampleWeight(p_mutex_guard);
+
+    mtx_to_t timed_lock_timeout;
+
+    if( (lock_type == MTX_GRD_LOCK_TYPE_TIMED) || (lock_type == MTX_GRD_LOCK_TYPE_PERIODIC) )
+        timed_lock_timeout = MutexGuardGenTimespec(timeout_ns);
+
+    bool blocked            = false;
+    uint64_t wait_start_ns  = 0;
+    void* profile_frames[__MTX_GRD_PROFILE_DEPTH__ + 1];
+    int profile_depth       = 0;
+
+    // Lockers are probed first, so that only those actually blocking are accounted as waiters (and as boosting PRIO_INHERIT owners).
+    ret_lock    = pthread_mutex_trylock(&p_mutex_guard->mutex);
+    blocked     = ((ret_lock == EBUSY) && (lock_type != MTX_GRD_LOCK_TYPE_TRY));
+
+    if(ret_lock && (ret_lock != EOWNERDEAD))
+        MutexGuardCopyOwnerLocation(p_mutex_guard, &target_mutex_acq_location);
+
+    if(blocked)
+    {
+        wait_start_ns = MutexGuardGetMonotonicNs();
+        __atomic_add_fetch(&p_mutex_guard->waiter_counter, 1, __ATOMIC_RELAXED);
+
+        // The waiter's stack is captured before blocking, so that the guard's hold time is not stretched by it.
+        if(sample_weight && __atomic_load_n(&profile_enabled, __ATOMIC_RELAXED))
+            profile_depth = backtrace(profile_frames, __MTX_GRD_PROFILE_DEPTH__ + 1);
+
+        switch (lock_type)
+        {
+            case MTX_GRD_LOCK_TYPE_PERMANENT:
+            {
+                ret_lock = pthread_mutex_lock(&p_mutex_guard->mutex);
+            }
+            break;
+        
+            case MTX_GRD_LOCK_TYPE_TIMED:
+            {            
+                ret_lock = pthread_mutex_timedlock(&p_mutex_guard->mutex, &timed_lock_timeout);
+            }
+            break;
+
+            case MTX_GRD_LOCK_TYPE_PERIODIC:
+            {
+                do
+                {
+                    ret_lock = pthread_mutex_timedlock(&p_mutex_guard->mutex, &timed_lock_timeout);
+
+                    if(ret_lock != ETIMEDOUT)
+                        break;
+
+                    MTX_GRD_PROBE4(lock__timeout, p_mutex_guard, address, lock_type, MutexGuardGetMonotonicNs() - wait_start_ns);
+
+                    MutexGuardCopyOwnerLocation(p_mutex_guard, &target_mutex_acq_location);
+
+                    // A non-robust guard whose owner is gone will never be released, so there is no point in waiting any longer.
+                    if(!p_mutex_guard->robust && !MutexGuardIsOwnerAlive(&target_mutex_acq_location))
+                        ret_lock = ENOTRECOVERABLE;
+                
+                    if(verbosity_level & MTX_GRD_VERBOSITY_LOCK_ERROR)
+                        MutexGuardPrintLockError(&target_mutex_acq_location, &p_mutex_guard->mutex, timeout_ns, ret_lock);
+
+                    timed_lock_timeout = MutexGuardGenTimespec(timeout_ns);
+                }
+                while(ret_lock == ETIMEDOUT);
+            }   
+            break;
+
+            default:
+            {
+                mutex_guard_errno = MTX_GRD_ERR_INVALID_LOCK_TYPE;
+                return -2;
+            }
+            break;
+        }
+    }
+
+    if(blocked)
+        __atomic_sub_fetch(&p_mutex_guard->waiter_counter, 1, __ATOMIC_RELAXED);
+
+    if(ret_lock && (ret_lock != EOWNERDEAD))
+    {        
+        // Periodic locks' timeouts have already been reported, period by period.
+        if(ret_lock == ETIMEDOUT)
+        {
+            if(lock_type != MTX_GRD_LOCK_TYPE_PERIODIC)
+                MTX_GRD_PROBE4(lock__timeout, p_mutex_guard, address, lock_type, MutexGuardGetMonotonicNs() - wait_start_ns);
+        }
+        else
+            MTX_GRD_PROBE5(lock__error, p_mutex_guard, address, lock_type, (blocked ? (MutexGuardGetMonotonicNs() - wait_start_ns) : 0), ret_lock);
+
+        if( (verbosity_level & MTX_GRD_VERBOSITY_LOCK_ERROR) && (lock_type != MTX_GRD_LOCK_TYPE_PERIODIC) )
+            MutexGuardPrintLockError(&target_mutex_acq_location, &p_mutex_guard->mutex, timeout_ns, ret_lock);
+
+        mutex_guard_errno           = MTX_GRD_ERR_LOCK_ERROR;
+        mutex_guard_lock_error_code = ret_lock;
+
+        __atomic_add_fetch(&MutexGuardGetStatsShard(p_mutex_guard, true)->failure_counter, 1, __ATOMIC_RELAXED);
+        MutexGuardRecordLockFailure(p_mutex_guard, &target_mutex_acq_location, NULL);
+
+        return ret_lock;
+    }
+
+    mutex_guard_lock_error_code = ret_lock;
+
+    uint64_t wait_ns = (blocked ? (MutexGuardGetMonotonicNs() - wait_start_ns) : 0);
+
+    MTX_GRD_PROBE5(lock__acquire, p_mutex_guard, address, lock_type, wait_ns, ret_lock);
+
+    MutexGuardRecordLocked(p_mutex_guard, address, ret_lock, blocked, wait_start_ns, wait_ns, sample_weight, (blocked ? &target_mutex_acq_location : NULL), timeout_ns);
+
+    // The innermost frame (this very function) is skipped.
+    if(profile_depth > 1)
+        MutexGuardProfileRecord(profile_frames + 1, profile_depth - 1, wait_ns, sample_weight);
+
+    uint64_t slow_capture_ns = (blocked ? MutexGuardSlowCaptureThreshold(p_mutex_guard) : 0);
+
+    // Only known to be slow once acquired: the stack is then captured while holding the guard, unless profiling already did it.
+    if(slow_capture_ns && (wait_ns >= slow_capture_ns))
+    {
+        if(profile_depth <= 1)
+            profile_depth = backtrace(profile_frames, __MTX_GRD_PROFILE_DEPTH__ + 1);
+
+        MutexGuardSlowCaptureRecord(p_mutex_guard, address, wait_ns, slow_capture_ns, profile_frames + 1, ((profile_depth > 1) ? (profile_depth - 1) : 0), &target_mutex_acq_location);
+    }
+
+    return ret_lock;
+}
+
+C_MUTEX_GUARD_API MTX_GRD* MutexGuardLockAddr(  MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard ,
+                                                void* C_MUTEX_GUARD_RESTRICT address          ,
+                                                const uint64_t timeout_ns       ,
+                                                const int lock_type             )
+{
+    // A guard acquired from a dead owner is held, so it must be returned for scoped macros to release it.
+    int ret_lock = MutexGuardLock(p_mutex_guard, address, timeout_ns, lock_type);
+
+    return ((ret_lock && (ret_lock != EOWNERDEAD)) ? NULL : p_mutex_guard);
+}
+
+/// @brief Gets base address of the executable in which a mutex lock error has happened.
+/// @return 0 if succeeded, < 0 otherwise.
+static size_t MutexGuardGetExecutableBaseddress(void)
+{
+    FILE *maps = fopen(MTX_GRD_PROC_MAPS_PATH, "r");
+    
+    if (!maps)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_COULD_NOT_FIND_PROCESS;
+        return 0;
+    }
+
+    char line[MTX_GRD_PROC_MAX_LEN];
+    size_t start = 0;
+
+    while (fgets(line, sizeof(line), maps))
+    {
+        if (strstr(line, "/"))
+        {
+            sscanf(line, "%lx", &start);
+            break;
+        }
+    }
+
+    int close_maps = fclose(maps);
+
+    if(close_maps)
+        mutex_guard_errno = MTX_GRD_ERR_COULD_NOT_CLOSE_PROC_FILE;
+
+    return start;
+}
+
+/// @brief Gets mutex lock acquisition details from the address in which a mutex was meant to be stored.
+/// @param addr Mutex lock address.
+/// @param detail Pointer to lock acquisition detail struct.
+/// @return 0 if succeeded, < 0 otherwise.
+static int MutexGuardGetLockDetailFromAddr(const void* C_MUTEX_GUARD_RESTRICT addr, MTX_GRD_ACQ_LOCATION_DETAIL* C_MUTEX_GUARD_RESTRICT detail)
+{
+    char cmd[MTX_GRD_ADDR2LINE_CMD_FORMAT_MAX_LEN + 1] = {0};
+    char full_path[PATH_MAX + 1] = {0};
+
+    const MTX_GRD_SOURCE_CALLSITE* p_source_callsite = MutexGuardFindSourceCallsite(addr);
+
+    if(p_source_callsite)
+    {
+        strncpy(detail->function_name, p_source_callsite->function, MTX_GRD_ACQ_FN_NAME_LEN);
+        strncpy(detail->file_path, p_source_callsite->file, PATH_MAX);
+        detail->line = p_source_callsite->line;
+
+        return 0;
+    }
+    
+    if(readlink(MTX_GRD_CURRENT_PROC_PATH, full_path, sizeof(full_path) - 1) < 0)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_COULD_NOT_FIND_EXE_PATH;
+        return -1;
+    }
+    
+    if(!detail->relative_address)
+        detail->relative_address = (void*)((size_t)addr - MutexGuardGetExecutableBaseddress());
+
+    snprintf(   cmd                                 ,
+                MTX_GRD_ADDR2LINE_CMD_FORMAT_MAX_LEN,
+                MTX_GRD_ADDR2LINE_CMD_FORMAT        ,
+                full_path                           ,
+                detail->relative_address            );
+
+    FILE *fp = popen(cmd, "r");
+    
+    if (fp == NULL)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_COULD_NOT_EXECUTE_ADDR2LINE;
+        return -2;
+    }
+
+    char line[PATH_MAX + 1] = {0};
+    
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        line[strcspn(line, "\n")] = 0;
+
+        char* at_pos = strrchr(line, MTX_GRD_FN_LINE_DELIMITER);
+        if(at_pos)
+        {
+            char* acq_line_start = at_pos + sizeof(char);
+            
+            if(acq_line_start && acq_line_start[0] >= '0' && acq_line_start[0] <= '9')
+                detail->line = atol(acq_line_start);
+            else
+                detail->line = 0;
+            
+            memset(at_pos, 0, strlen(at_pos));
+            strncpy(detail->file_path, line, PATH_MAX);
+        }
+        else
+        {
+            strncpy(detail->function_name, line, MTX_GRD_ACQ_FN_NAME_LEN);
+        }
+    }
+
+    int close_addr2line = pclose(fp);
+    
+    if(close_addr2line)
+        mutex_guard_errno = MTX_GRD_ERR_COULD_NOT_CLOSE_ADDR2LINE;
+
+    return 0;
+}
+
+/// @brief Prints file and line to a buffer given an address.
+/// @param addr Target address to be detailed.
+/// @param output_buffer Output buffer.
+/// @param address_index Address index within mutex guard.
+/// @param detail Pointer to mutex acquisition detail struct. 
+/// @param lock_error_str_size Output buffer size.
+/// @return 0 if succeeded, < 0 otherwise.
+static int MutexGuardPrintFileAndLineFromAddr(  const void* C_MUTEX_GUARD_RESTRICT addr                   ,
+                                                char* output_buffer                         ,
+                                                const unsigned int address_index            ,
+                                                MTX_GRD_ACQ_LOCATION_DETAIL* C_MUTEX_GUARD_RESTRICT detail,
+                                                const size_t lock_error_str_size            )
+{
+    int ret = MutexGuardGetLockDetailFromAddr(addr, detail);
+    if(ret < 0)
+        return ret;
+    
+    snprintf(   output_buffer + strlen(output_buffer)           ,
+                (lock_error_str_size - strlen(output_buffer))   ,
+                MTX_GRD_ACQ_LOCATION_FULL_FORMAT                ,
+                address_index                                   ,
+                addr                                            ,
+                detail->relative_address                        ,
+                detail->function_name                           ,
+                detail->file_path                               ,
+                detail->line                                    );
+    
+    if(detail->line == 0)
+    {
+        char* line_delimiter_pos = strrchr(output_buffer, MTX_GRD_FN_LINE_DELIMITER);
+        if(line_delimiter_pos)
+        {
+            memset(line_delimiter_pos, 0, strlen(line_delimiter_pos));
+            strncat(output_buffer, "\r\n", (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(output_buffer)));
+        }
+    }
+
+    return 0;
+}
+
+/// @brief Returns address within the program of line in which the current function was called. Meant to be used in macros.
+/// @return Current function calling address.
+C_MUTEX_GUARD_NOINLINE void* MutexGuardGetFuncRetAddr(void)
+{
+    return __builtin_return_address(0); 
+}
+
+/// @brief Returns a stable address standing for a source location.
+/// @param file Source file.
+/// @param line Source line.
+/// @param function Function name (may be NULL).
+/// @return Location's address if succeeded, NULL otherwise.
+void* MutexGuardSourceCallsite(const char* file, const unsigned int line, const char* function)
+{
+    if(!file)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return NULL;
+    }
+
+    if(!function)
+        function = "";
+
+    pthread_mutex_lock(&source_callsite_mutex);
+
+    MTX_GRD_SOURCE_CALLSITE* p_callsite = NULL;
+
+    for(size_t callsite_index = 0; callsite_index < source_callsite_num; callsite_index++)
+    {
+        MTX_GRD_SOURCE_CALLSITE* p_candidate = &source_callsites[callsite_index];
+
+        if( (p_candidate->line == line) && !strcmp(p_candidate->file, file) && !strcmp(p_candidate->function, function) )
+        {
+            p_callsite = p_candidate;
+            break;
+        }
+    }
+
+    if(!p_callsite && (source_callsite_num < __MTX_GRD_SOURCE_CALLSITE_NUM__))
+    {
+        p_callsite              = &source_callsites[source_callsite_num];
+        p_callsite->file        = file;
+        p_callsite->function    = function;
+        p_callsite->line        = line;
+
+        __atomic_store_n(&source_callsite_num, source_callsite_num + 1, __ATOMIC_RELEASE);
+    }
+
+    pthread_mutex_unlock(&source_callsite_mutex);
+
+    if(!p_callsite)
+        mutex_guard_errno = MTX_GRD_ERR_NO_ADDR_SPACE_AVAILABLE;
+
+    return p_callsite;
+}
+
+/// @brief Finds the source location a lock address stands for, if any (see MutexGuardSourceCallsite).
+/// @param address Target lock address.
+/// @return Pointer to the source location if found, NULL otherwise.
+static const MTX_GRD_SOURCE_CALLSITE* MutexGuardFindSourceCallsite(const void* address)
+{
+    size_t callsite_num = __atomic_load_n(&source_callsite_num, __ATOMIC_ACQUIRE);
+
+    if( ((const char*)address < (const char*)source_callsites) || ((const char*)address >= (const char*)&source_callsites[callsite_num]) )
+        return NULL;
+
+    return (const MTX_GRD_SOURCE_CALLSITE*)address;
+}
+
+/// @brief Marks the state protected by a robust guard as consistent again after its previous owner died, and drops dead owner's record.
+/// @param p_mtx_grd Pointer to mutex guard structure (locked by the calling thread).
+/// @return 0 if succeeded, < 0 if guard state is invalid, > 0 (standard error code) otherwise.
+int MutexGuardMakeConsistent(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(p_mtx_grd->mutex_acq_location.thread_id == 0)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NOT_LOCKED;
+        return -2;
+    }
+
+    if(!MutexGuardIsOwner(p_mtx_grd))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INVALID_OWNER_TID;
+        return -3;
+    }
+
+    if(!p_mtx_grd->owner_died)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NOT_INCONSISTENT;
+        return -4;
+    }
+
+    int ret_consistent = pthread_mutex_consistent(&p_mtx_grd->mutex);
+
+    if(ret_consistent)
+    {
+        mutex_guard_lock_error_code = ret_consistent;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return ret_consistent;
+    }
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    memset(&p_mtx_grd->dead_owner_location, 0, sizeof(MTX_GRD_ACQ_LOCATION));
+    p_mtx_grd->owner_died = false;
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    return 0;
+}
+
+/// @brief Tells whether a guard was acquired after its previous owner died and has not been made consistent yet.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @return true if guard needs to be made consistent, false otherwise.
+bool MutexGuardIsInconsistent(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return false;
+    }
+
+    return p_mtx_grd->owner_died;
+}
+
+/// @brief Gets priority boosting statistics of a PRIO_INHERIT/PRIO_PROTECT guard.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_stats Pointer to the structure statistics are meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardGetPrioStats( MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd               ,
+                            MTX_GRD_PRIO_STATS* C_MUTEX_GUARD_RESTRICT p_stats      )
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!p_stats)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
+    }
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    memcpy(p_stats, &p_mtx_grd->prio_stats, sizeof(MTX_GRD_PRIO_STATS));
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    return 0;
+}
+
+/// @brief Names a guard (shown by MutexGuardDumpAll).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param name Guard name (truncated to __MTX_GRD_NAME_LEN__ - 1 characters).
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardSetName(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const char* C_MUTEX_GUARD_RESTRICT name)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!name)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
+    }
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    snprintf(p_mtx_grd->name, sizeof(p_mtx_grd->name), "%s", name);
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    return 0;
+}
+
+/// @brief Sets a guard's maximum expected hold time. Holds exceeding it are flagged by a watchdog thread (started on first use).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param hold_budget_ns Hold budget in nanoseconds (0 disables it). Applies from the guard's next hold onwards.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardSetHoldBudget(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const uint64_t hold_budget_ns)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    // Budgeted guards list links are process-local pointers.
+    if(p_mtx_grd->process_shared)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_PROC_SHARED_UNSUPPORTED;
+        return -2;
+    }
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    p_mtx_grd->hold_budget_ns = hold_budget_ns;
+
+    if(hold_budget_ns)
+    {
+        MutexGuardWatchdogAdd(p_mtx_grd);
+    }
+    else
+    {
+        MutexGuardWatchdogDisarm(p_mtx_grd);
+        MutexGuardWatchdogRemove(p_mtx_grd);
+    }
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    return 0;
+}
+
+/// @brief Gets the number of holds which exceeded a guard's hold budget.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_violations Pointer to the variable the number of violations is meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardGetHoldViolations(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd           ,
+                                unsigned long long* C_MUTEX_GUARD_RESTRICT p_violations )
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!p_violations)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
+    }
+
+    *p_violations = __atomic_load_n(&p_mtx_grd->hold_violation_counter, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+/// @brief Writes a whole buffer to a file descriptor (async-signal-safe).
+/// @param fd Target file descriptor.
+/// @param buffer Buffer to be written.
+/// @param buffer_len Buffer length.
+/// @return 0 if succeeded, < 0 otherwise.
+static int MutexGuardDumpWrite(const int fd, const char* C_MUTEX_GUARD_RESTRICT buffer, size_t buffer_len)
+{
+    while(buffer_len)
+    {
+        ssize_t written = write(fd, buffer, buffer_len);
+
+        if(written < 0)
+        {
+            if(errno == EINTR)
+                continue;
+
+            return -1;
+        }
+
+        buffer      += written;
+        buffer_len  -= written;
+    }
+
+    return 0;
+}
+
+/// @brief Prints to a buffer like snprintf, but async-signal-safe (see MutexGuardDumpAll). Only supports the %s, %p, %d, %u, %x
+/// conversions (l-modified or not) and %%, without flags, width or precision. Output is truncated to the buffer and null-terminated.
+/// @param buffer Target buffer.
+/// @param buffer_size Buffer size.
+/// @param format Format string.
+/// @return Printed length.
+static size_t MutexGuardDumpPrint(char* C_MUTEX_GUARD_RESTRICT buffer, const size_t buffer_size, const char* C_MUTEX_GUARD_RESTRICT format, ...)
+{
+    va_list args;
+    size_t len = 0;
+
+    if(!buffer_size)
+        return 0;
+
+    va_start(args, format);
+
+    for(; *format; format++)
+    {
+        char number[MTX_GRD_DUMP_NUMBER_LEN];
+        const char* piece   = format;
+        size_t piece_len    = 1;
+
+        if(*format == '%')
+        {
+            bool is_long        = (format[1] == 'l');
+            bool is_number      = true;
+            bool negative       = false;
+            unsigned long value = 0;
+            unsigned int base   = 10;
+
+            format += (is_long ? 2 : 1);
+
+            if(!*format)
+                break;
+
+            switch(*format)
+            {
+                case 's':
+                {
+                    piece       = va_arg(args, const char*);
+                    piece       = (piece ? piece : MTX_GRD_DUMP_NULL_STR);
+                    piece_len   = strlen(piece);
+                    is_number   = false;
+                }
+                break;
+
+                case 'p':
+                {
+                    value   = (unsigned long)(uintptr_t)va_arg(args, const void*);
+                    base    = 16;
+                }
+                break;
+
+                case 'd':
+                {
+                    long signed_value = (is_long ? va_arg(args, long) : va_arg(args, int));
+
+                    negative    = (signed_value < 0);
+                    value       = (negative ? (0UL - (unsigned long)signed_value) : (unsigned long)signed_value);
+                }
+                break;
+
+                case 'u':
+                case 'x':
+                {
+                    value   = (is_long ? va_arg(args, unsigned long) : va_arg(args, unsigned int));
+                    base    = ((*format == 'x') ? 16 : 10);
+                }
+                break;
+
+                default:
+                {
+                    piece       = format;
+                    is_number   = false;
+                }
+                break;
+            }
+
+            if(is_number)
+            {
+                char* p_digit = number + sizeof(number);
+
+                do
+                {
+                    *--p_digit  = MTX_GRD_DUMP_HEX_DIGITS[value % base];
+                    value       /= base;
+                }
+                while(value);
+
+                if(*format == 'p')
+                {
+                    *--p_digit = 'x';
+                    *--p_digit = '0';
+                }
+
+                if(negative)
+                    *--p_digit = '-';
+
+                piece       = p_digit;
+                piece_len   = (size_t)((number + sizeof(number)) - p_digit);
+            }
+        }
+
+        for(size_t piece_index = 0; (piece_index < piece_len) && ((len + 1) < buffer_size); piece_index++)
+            buffer[len++] = piece[piece_index];
+    }
+
+    va_end(args);
+
+    buffer[len] = 0;
+
+    return len;
+}
+
+/// @brief Prints a held guard's state to a given buffer. The guard is read without taking its ctrl_mutex (fields may be slightly stale).
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param dump_string Buffer where the state is meant to be copied to.
+/// @param dump_str_size Buffer size.
+/// @return Printed length, 0 if the guard is not held.
+static size_t MutexGuardDumpGuard(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, char* dump_string, const size_t dump_str_size)
+{
+    MTX_GRD_ACQ_LOCATION acq_location;
+    memcpy(&acq_location, &p_mutex_guard->mutex_acq_location, sizeof(MTX_GRD_ACQ_LOCATION));
+
+    if(!acq_location.thread_id)
+        return 0;
+
+    uint64_t now_ns     = MutexGuardGetMonotonicNs();
+    uint64_t hold_ns    = ((acq_location.acq_ns && (now_ns > acq_location.acq_ns)) ? (now_ns - acq_location.acq_ns) : 0);
+
+    char name[__MTX_GRD_NAME_LEN__];
+    memcpy(name, p_mutex_guard->name, sizeof(name));
+    name[sizeof(name) - 1] = 0;
+
+    MutexGuardDumpPrint(dump_string                                                     ,
+                        dump_str_size                                                   ,
+                        MTX_GRD_DUMP_GUARD_FORMAT                                       ,
+                        (name[0] ? name : MTX_GRD_DUMP_UNNAMED)                         ,
+                        (const void*)p_mutex_guard                                      ,
+                        acq_location.thread_id                                          ,
+                        acq_location.process_id                                         ,
+                        acq_location.kernel_tid                                         ,
+                        hold_ns                                                         ,
+                        __atomic_load_n(&p_mutex_guard->waiter_counter, __ATOMIC_RELAXED));
+
+    bool foreign_process = (acq_location.process_id && (acq_location.process_id != MutexGuardGetProcessId()));
+
+    for(unsigned int address_index = 0; address_index < __MTX_GRD_ADDR_NUM__; address_index++)
+    {
+        if(!acq_location.addresses[address_index])
+            break;
+
+        size_t dump_len = strlen(dump_string);
+
+        if(foreign_process)
+        {
+            char build_id_str[MTX_GRD_BUILD_ID_STR_LEN] = {0};
+            MutexGuardBuildIdToString(acq_location.callsites[address_index].build_id, build_id_str);
+
+            MutexGuardDumpPrint(dump_string + dump_len                                      ,
+                                dump_str_size - dump_len                                    ,
+                                MTX_GRD_ACQ_CALLSITE_FORMAT                                 ,
+                                address_index                                               ,
+                                build_id_str                                                ,
+                                (unsigned long)acq_location.callsites[address_index].offset );
+        }
+        else
+            MutexGuardDumpPrint(dump_string + dump_len                      ,
+                                dump_str_size - dump_len                    ,
+                                MTX_GRD_DUMP_ADDRESS_FORMAT                 ,
+                                address_index                               ,
+                                acq_location.addresses[address_index]       );
+    }
+
+    return strlen(dump_string);
+}
+
+/// @brief Writes the state of every held guard (owner, hold duration, waiters and lock addresses) to a file descriptor.
+/// Guards are walked without taking any lock, so lockers are never blocked, and printed with MutexGuardDumpPrint (no snprintf),
+/// so that it can be called from a signal handler. Each held guard is formatted while the registry is being read, but written once
+/// done reading it (so that a slow descriptor never holds guards' destruction up): the walk then resumes from the guard's position.
+/// @param fd Target file descriptor.
+/// @return Number of held guards found if succeeded, < 0 otherwise.
+int MutexGuardDumpAll(const int fd)
+{
+    char dump_string[MTX_GRD_DUMP_STR_LEN];
+    unsigned int registered_counter = 0;
+    unsigned int held_counter       = 0;
+    int ret_dump                    = 0;
+
+    MutexGuardDumpPrint(dump_string, sizeof(dump_string), "%s" MTX_GRD_DUMP_HEADER_FORMAT, MTX_GRD_MSG_ERR_MUTEX_HEADER, MutexGuardGetProcessId(), (unsigned long)executable_base_address);
+    ret_dump |= MutexGuardDumpWrite(fd, dump_string, strlen(dump_string));
+
+    size_t dump_len = 0;
+
+    do
+    {
+        size_t registry_index   = 0;
+        size_t registry_pos     = 0;
+
+        dump_len = 0;
+
+        __atomic_add_fetch(&registry_readers, 1, __ATOMIC_ACQ_REL);
+
+        for(MTX_GRD* p_mutex_guard = MutexGuardRegistryNext(NULL, &registry_index); p_mutex_guard && !dump_len; p_mutex_guard = MutexGuardRegistryNext(p_mutex_guard, &registry_index))
+        {
+            // Already walked before the previous write (guards registered or destroyed meanwhile may shift the walk by a few).
+            if(registry_pos++ < registered_counter)
+                continue;
+
+            ++registered_counter;
+
+            dump_len = MutexGuardDumpGuard(p_mutex_guard, dump_string, sizeof(dump_string));
+        }
+
+        __atomic_sub_fetch(&registry_readers, 1, __ATOMIC_ACQ_REL);
+
+        if(dump_len)
+        {
+            ++held_counter;
+            ret_dump |= MutexGuardDumpWrite(fd, dump_string, dump_len);
+        }
+    }
+    while(dump_len);
+
+    MutexGuardDumpPrint(dump_string, sizeof(dump_string), MTX_GRD_DUMP_FOOTER_FORMAT "%s", registered_counter, held_counter, MTX_GRD_MSG_ERR_MUTEX_FOOTER);
+    ret_dump |= MutexGuardDumpWrite(fd, dump_string, strlen(dump_string));
+
+    if(ret_dump)
+    {
+        mutex_guard_lock_error_code = errno;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return -1;
+    }
+
+    return held_counter;
+}
+
+/// @brief Signal handler installed by MutexGuardSetDumpSignal (preserves errno values seen by the interrupted thread).
+/// @param signum Received signal.
+static void MutexGuardDumpSignalHandler(int signum)
+{
+    (void)signum;
+
+    int saved_errno                 = errno;
+    int saved_mutex_guard_errno     = mutex_guard_errno;
+    int saved_lock_error_code       = mutex_guard_lock_error_code;
+
+    MutexGuardDumpAll(dump_signal_fd);
+
+    errno                           = saved_errno;
+    mutex_guard_errno               = saved_mutex_guard_errno;
+    mutex_guard_lock_error_code     = saved_lock_error_code;
+}
+
+/// @brief Installs a handler which calls MutexGuardDumpAll whenever a given signal is received.
+/// @param signum Target signal (e.g. SIGUSR1).
+/// @param fd Target file descriptor.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardSetDumpSignal(const int signum, const int fd)
+{
+    struct sigaction dump_action = {0};
+
+    dump_action.sa_handler  = MutexGuardDumpSignalHandler;
+    dump_action.sa_flags    = SA_RESTART;
+    sigemptyset(&dump_action.sa_mask);
+
+    dump_signal_fd = fd;
+
+    if(sigaction(signum, &dump_action, NULL))
+    {
+        mutex_guard_lock_error_code = errno;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return -1;
+    }
+
+    return 0;
+}
+
+/// @brief Gets a guard's acquisition statistics.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_stats Pointer to the structure statistics are meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardGetStats(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, MTX_GRD_STATS* C_MUTEX_GUARD_RESTRICT p_stats)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!p_stats)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
+    }
+
+    MutexGuardStatsMerge(p_mtx_grd, p_stats);
+
+    return 0;
+}
+
+/// @brief Gets what a guard's statistics grew by since a previous snapshot, and replaces that snapshot with the current one,
+/// so that calling it periodically yields per-interval statistics. A zeroed snapshot yields the whole statistics.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_snapshot Pointer to the previous snapshot (updated to the current one).
+/// @param p_delta Pointer to the structure differences are meant to be copied to (hold_ns_max is the lifetime maximum, though).
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardGetStatsDelta(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd           ,
+                            MTX_GRD_STATS* C_MUTEX_GUARD_RESTRICT p_snapshot    ,
+                            MTX_GRD_STATS* C_MUTEX_GUARD_RESTRICT p_delta       )
+{
+    if(!p_snapshot || !p_delta)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
+    }
+
+    MTX_GRD_STATS current;
+
+    if(MutexGuardGetStats(p_mtx_grd, &current))
+        return -1;
+
+    memcpy(p_delta, &current, sizeof(MTX_GRD_STATS));
+
+    p_delta->acquisition_counter        -= p_snapshot->acquisition_counter;
+    p_delta->contention_counter         -= p_snapshot->contention_counter;
+    p_delta->failure_counter            -= p_snapshot->failure_counter;
+    p_delta->hold_counter               -= p_snapshot->hold_counter;
+    p_delta->wait_ns_total              -= p_snapshot->wait_ns_total;
+    p_delta->hold_ns_total              -= p_snapshot->hold_ns_total;
+    p_delta->sample_counter             -= p_snapshot->sample_counter;
+    p_delta->callsite_overflow_counter  -= p_snapshot->callsite_overflow_counter;
+
+    for(size_t bucket = 0; bucket < MTX_GRD_HIST_BUCKET_NUM; bucket++)
+    {
+        p_delta->wait_histogram[bucket] -= p_snapshot->wait_histogram[bucket];
+        p_delta->hold_histogram[bucket] -= p_snapshot->hold_histogram[bucket];
+    }
+
+    // Lock address slots are never released, so a slot holds the same address in both snapshots (or was empty in the previous one).
+    for(unsigned int callsite_index = 0; callsite_index < __MTX_GRD_CALLSITE_STATS_NUM__; callsite_index++)
+    {
+        if(p_snapshot->callsites[callsite_index].address != p_delta->callsites[callsite_index].address)
+            continue;
+
+        p_delta->callsites[callsite_index].acquisition_counter  -= p_snapshot->callsites[callsite_index].acquisition_counter;
+        p_delta->callsites[callsite_index].wait_ns_total        -= p_snapshot->callsites[callsite_index].wait_ns_total;
+    }
+
+    memcpy(p_snapshot, &current, sizeof(MTX_GRD_STATS));
+
+    return 0;
+}
+
+/// @brief Sets how many lock calls are recorded. Only a random 1-in-period of them (plus every one which waited for slow_threshold_ns
+/// or longer) pay for timestamps, stats, profiling backtraces and trace events, and they are accounted as many calls as they stand for,
+/// so that statistics and profiles remain unbiased estimates. Unsampled holds are not timed (dumps report them as 0 ns long), unless the
+/// guard has a hold budget or a priority protocol.
+/// @param period Sampling period (1 records every call, which is the default).
+/// @param slow_threshold_ns Wait time from which calls are always recorded (0 to disable).
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardSetSampling(const unsigned int period, const uint64_t slow_threshold_ns)
+{
+    if(!period)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INVALID_SAMPLING_PERIOD;
+        return -1;
+    }
+
+    __atomic_store_n(&sampling_period, period, __ATOMIC_RELAXED);
+    __atomic_store_n(&sampling_slow_ns, slow_threshold_ns, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+/// @brief Overrides the sampling period for a single guard (see MutexGuardSetSampling).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param period Sampling period (0 follows the global one).
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardSetGuardSampling(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const unsigned int period)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    __atomic_store_n(&p_mtx_grd->sampling_period, period, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+/// @brief Writes a writer's buffered content to its file descriptor (or appends it to its snapshot).
+/// @param p_writer Pointer to target writer.
+static void MutexGuardExportFlush(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer)
+{
+    if(p_writer->len && p_writer->to_snapshot)
+    {
+        size_t snapshot_size = (p_writer->snapshot_size ? p_writer->snapshot_size : MTX_GRD_EXPORT_STR_LEN);
+
+        while(snapshot_size < (p_writer->snapshot_len + p_writer->len))
+            snapshot_size *= 2;
+
+        char* snapshot = ((snapshot_size != p_writer->snapshot_size) ? realloc(p_writer->snapshot, snapshot_size) : p_writer->snapshot);
+
+        if(snapshot)
+        {
+            memcpy(snapshot + p_writer->snapshot_len, p_writer->buffer, p_writer->len);
+
+            p_writer->snapshot      = snapshot;
+            p_writer->snapshot_len  += p_writer->len;
+            p_writer->snapshot_size = snapshot_size;
+        }
+        else
+            p_writer->error = ENOMEM;
+    }
+    else if(p_writer->len && MutexGuardDumpWrite(p_writer->fd, p_writer->buffer, p_writer->len))
+        p_writer->error = errno;
+
+    p_writer->len = 0;
+}
+
+/// @brief Appends formatted text to a writer (flushing it first if it does not fit).
+/// @param p_writer Pointer to target writer.
+/// @param format printf-like format.
+static void MutexGuardExportAppend(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const char* C_MUTEX_GUARD_RESTRICT format, ...)
+{
+    for(unsigned int attempt = 0; attempt < 2; attempt++)
+    {
+        va_list args;
+        va_start(args, format);
+        int printed_len = vsnprintf(p_writer->buffer + p_writer->len, sizeof(p_writer->buffer) - p_writer->len, format, args);
+        va_end(args);
+
+        if(printed_len < 0)
+            return;
+
+        if((size_t)printed_len < (sizeof(p_writer->buffer) - p_writer->len))
+        {
+            p_writer->len += printed_len;
+            return;
+        }
+
+        // Did not fit: the (truncated) output is discarded, the buffer flushed and the text printed again.
+        MutexGuardExportFlush(p_writer);
+    }
+
+    p_writer->len = strlen(p_writer->buffer);
+}
+
+/// @brief Appends a label value, escaping backslashes, double quotes and line feeds.
+/// @param p_writer Pointer to target writer.
+/// @param label_value Label value to be appended.
+static void MutexGuardExportAppendEscaped(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const char* C_MUTEX_GUARD_RESTRICT label_value)
+{
+    for(; *label_value; label_value++)
+    {
+        if((sizeof(p_writer->buffer) - p_writer->len) < 3)
+            MutexGuardExportFlush(p_writer);
+
+        switch(*label_value)
+        {
+            case '\\':
+            case '"':
+            {
+                p_writer->buffer[p_writer->len++] = '\\';
+                p_writer->buffer[p_writer->len++] = *label_value;
+            }
+            break;
+
+            case '\n':
+            {
+                p_writer->buffer[p_writer->len++] = '\\';
+                p_writer->buffer[p_writer->len++] = 'n';
+            }
+            break;
+
+            default:
+            {
+                p_writer->buffer[p_writer->len++] = *label_value;
+            }
+            break;
+        }
+    }
+
+    p_writer->buffer[p_writer->len] = 0;
+}
+
+/// @brief Appends a guard's label (its name if set, its address otherwise).
+/// @param p_writer Pointer to target writer.
+/// @param p_mutex_guard Pointer to mutex guard structure (NULL for guards aggregated as "other").
+static void MutexGuardExportGuardLabel(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    MutexGuardExportAppend(p_writer, "guard=\"");
+
+    if(!p_mutex_guard)
+        MutexGuardExportAppend(p_writer, MTX_GRD_EXPORT_OTHER);
+    else
+    {
+        char name[__MTX_GRD_NAME_LEN__];
+        memcpy(name, p_mutex_guard->name, sizeof(name));
+        name[sizeof(name) - 1] = 0;
+
+        if(name[0])
+            MutexGuardExportAppendEscaped(p_writer, name);
+        else
+            MutexGuardExportAppend(p_writer, "%p", (const void*)p_mutex_guard);
+    }
+
+    MutexGuardExportAppend(p_writer, "\"");
+}
+
+/// @brief Generates a lock address' label: "file:line" for source locations, "symbol+0xoffset" if it can be resolved, "module+0xoffset" or its raw value otherwise.
+/// @param address Target lock address.
+/// @param label Buffer where the label is meant to be copied to.
+/// @param label_size Buffer size.
+static void MutexGuardExportCallsiteLabel(const void* address, char* label, const size_t label_size)
+{
+    Dl_info address_info;
+
+    const MTX_GRD_SOURCE_CALLSITE* p_source_callsite = MutexGuardFindSourceCallsite(address);
+
+    if(p_source_callsite)
+    {
+        snprintf(label, label_size, "%s:%u", p_source_callsite->file, p_source_callsite->line);
+        return;
+    }
+
+    if(!dladdr(address, &address_info))
+    {
+        snprintf(label, label_size, "%p", address);
+        return;
+    }
+
+    if(address_info.dli_sname && address_info.dli_saddr)
+    {
+        snprintf(label, label_size, "%s+0x%lx", address_info.dli_sname, (unsigned long)((uintptr_t)address - (uintptr_t)address_info.dli_saddr));
+        return;
+    }
+
+    const char* module_name = (address_info.dli_fname ? strrchr(address_info.dli_fname, '/') : NULL);
+    module_name = (module_name ? (module_name + 1) : address_info.dli_fname);
+
+    if(module_name && module_name[0])
+        snprintf(label, label_size, "%s+0x%lx", module_name, (unsigned long)((uintptr_t)address - (uintptr_t)address_info.dli_fbase));
+    else
+        snprintf(label, label_size, "%p", address);
+}
+
+static unsigned long long MutexGuardExportAcquisitions(const MTX_GRD* p_mutex_guard)
+{
+    return MutexGuardStatsSum(p_mutex_guard, offsetof(MTX_GRD_STATS_SHARD, acquisition_counter));
+}
+
+static unsigned long long MutexGuardExportContentions(const MTX_GRD* p_mutex_guard)
+{
+    return MutexGuardStatsSum(p_mutex_guard, offsetof(MTX_GRD_STATS_SHARD, contention_counter));
+}
+
+static unsigned long long MutexGuardExportFailures(const MTX_GRD* p_mutex_guard)
+{
+    return MutexGuardStatsSum(p_mutex_guard, offsetof(MTX_GRD_STATS_SHARD, failure_counter));
+}
+
+static unsigned long long MutexGuardExportHoldViolations(const MTX_GRD* p_mutex_guard)
+{
+    return __atomic_load_n(&p_mutex_guard->hold_violation_counter, __ATOMIC_RELAXED);
+}
+
+static unsigned long long MutexGuardExportPrioBoosts(const MTX_GRD* p_mutex_guard)
+{
+    return p_mutex_guard->prio_stats.boost_counter;
+}
+
+static unsigned long long MutexGuardExportWaiters(const MTX_GRD* p_mutex_guard)
+{
+    return __atomic_load_n(&p_mutex_guard->waiter_counter, __ATOMIC_RELAXED);
+}
+
+static unsigned long long MutexGuardExportHeld(const MTX_GRD* p_mutex_guard)
+{
+    return (p_mutex_guard->mutex_acq_location.thread_id != 0);
+}
+
+/// @brief Exports a single-valued metric family for every registered guard. Meant to be called while walking the registry.
+/// @param p_writer Pointer to target writer.
+/// @param p_family Pointer to target family.
+static void MutexGuardExportFamily(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const MTX_GRD_EXPORT_FAMILY* C_MUTEX_GUARD_RESTRICT p_family)
+{
+    unsigned int guard_counter      = 0;
+    unsigned long long other_value  = 0;
+
+    MutexGuardExportAppend(p_writer, "# HELP %s %s\n# TYPE %s %s\n", p_family->name, p_family->help, p_family->name, p_family->type);
+
+    size_t registry_index = 0;
+
+    for(MTX_GRD* p_mutex_guard = MutexGuardRegistryNext(NULL, &registry_index); p_mutex_guard; p_mutex_guard = MutexGuardRegistryNext(p_mutex_guard, &registry_index))
+    {
+        if(guard_counter++ >= __MTX_GRD_EXPORT_MAX_GUARDS__)
+        {
+            other_value += p_family->get_value(p_mutex_guard);
+            continue;
+        }
+
+        MutexGuardExportAppend(p_writer, "%s{", p_family->name);
+        MutexGuardExportGuardLabel(p_writer, p_mutex_guard);
+        MutexGuardExportAppend(p_writer, "} %llu\n", p_family->get_value(p_mutex_guard));
+    }
+
+    if(guard_counter > __MTX_GRD_EXPORT_MAX_GUARDS__)
+        MutexGuardExportAppend(p_writer, "%s{guard=\"" MTX_GRD_EXPORT_OTHER "\"} %llu\n", p_family->name, other_value);
+}
+
+/// @brief Exports the wait or hold time histogram of every registered guard. Meant to be called while walking the registry.
+/// @param p_writer Pointer to target writer.
+/// @param name Metric family name.
+/// @param help Metric family description.
+/// @param hold Tells whether hold (or wait) times are exported.
+static void MutexGuardExportHistogram(  MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer    ,
+                                        const char* C_MUTEX_GUARD_RESTRICT name                     ,
+                                        const char* C_MUTEX_GUARD_RESTRICT help                     ,
+                                        const bool hold                                             )
+{
+    unsigned int guard_counter                                      = 0;
+    unsigned long long other_histogram[MTX_GRD_HIST_BUCKET_NUM]     = {0};
+    uint64_t other_ns_total                                         = 0;
+
+    MutexGuardExportAppend(p_writer, "# HELP %s %s\n# TYPE %s histogram\n", name, help, name);
+
+    size_t registry_index   = 0;
+    MTX_GRD* p_mutex_guard  = MutexGuardRegistryNext(NULL, &registry_index);
+    bool other_exported     = false;
+
+    while(!other_exported)
+    {
+        const MTX_GRD* p_label_guard = p_mutex_guard;
+        unsigned long long histogram[MTX_GRD_HIST_BUCKET_NUM];
+        uint64_t ns_total;
+
+        if(p_mutex_guard)
+        {
+            MTX_GRD_STATS stats;
+            MutexGuardStatsMerge(p_mutex_guard, &stats);
+
+            memcpy(histogram, (hold ? stats.hold_histogram : stats.wait_histogram), sizeof(histogram));
+            ns_total = (hold ? stats.hold_ns_total : stats.wait_ns_total);
+
+            p_mutex_guard = MutexGuardRegistryNext(p_mutex_guard, &registry_index);
+
+            if(guard_counter++ >= __MTX_GRD_EXPORT_MAX_GUARDS__)
+            {
+                for(size_t bucket = 0; bucket < MTX_GRD_HIST_BUCKET_NUM; bucket++)
+                    other_histogram[bucket] += histogram[bucket];
+
+                other_ns_total += ns_total;
+                continue;
+            }
+        }
+        else if(guard_counter > __MTX_GRD_EXPORT_MAX_GUARDS__)
+        {
+            // Registry end reached: guards beyond the cardinality limit are exported as a single one.
+            memcpy(histogram, other_histogram, sizeof(histogram));
+            ns_total        = other_ns_total;
+            other_exported  = true;
+        }
+        else
+            break;
+
+        unsigned long long cumulative_counter = 0;
+
+        for(size_t bucket = 0; bucket < MTX_GRD_HIST_BUCKET_NUM; bucket++)
+        {
+            cumulative_counter += histogram[bucket];
+
+            MutexGuardExportAppend(p_writer, "%s_bucket{", name);
+            MutexGuardExportGuardLabel(p_writer, p_label_guard);
+            MutexGuardExportAppend(p_writer, ",le=\"%s\"} %llu\n", hist_bucket_labels[bucket], cumulative_counter);
+        }
+
+        MutexGuardExportAppend(p_writer, "%s_sum{", name);
+        MutexGuardExportGuardLabel(p_writer, p_label_guard);
+        MutexGuardExportAppend(p_writer, "} %lu.%09lu\n", (unsigned long)(ns_total / MTX_GRD_TOUT_1_SEC_AS_NS), (unsigned long)(ns_total % MTX_GRD_TOUT_1_SEC_AS_NS));
+
+        MutexGuardExportAppend(p_writer, "%s_count{", name);
+        MutexGuardExportGuardLabel(p_writer, p_label_guard);
+        MutexGuardExportAppend(p_writer, "} %llu\n", cumulative_counter);
+    }
+}
+
+/// @brief Exports per lock address acquisition counters or wait times of every registered guard. Meant to be called while walking the registry.
+/// @param p_writer Pointer to target writer.
+/// @param wait_time Tells whether wait times (or acquisition counters) are exported.
+static void MutexGuardExportCallsites(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const bool wait_time)
+{
+    const char* name            = (wait_time ? "mtx_grd_callsite_wait_seconds_total" : "mtx_grd_callsite_acquisitions_total");
+    unsigned int guard_counter  = 0;
+
+    MutexGuardExportAppend( p_writer                                                                                                ,
+                            "# HELP %s %s\n# TYPE %s counter\n"                                                                     ,
+                            name                                                                                                    ,
+                            (wait_time ? "Time spent waiting, per lock address." : "Number of acquisitions, per lock address.")    ,
+                            name                                                                                                    );
+
+    size_t registry_index = 0;
+
+    for(MTX_GRD* p_mutex_guard = MutexGuardRegistryNext(NULL, &registry_index); p_mutex_guard; p_mutex_guard = MutexGuardRegistryNext(p_mutex_guard, &registry_index))
+    {
+        if(guard_counter++ >= __MTX_GRD_EXPORT_MAX_GUARDS__)
+            break;
+
+        MTX_GRD_STATS stats;
+        MutexGuardStatsMerge(p_mutex_guard, &stats);
+
+        const MTX_GRD_CALLSITE_STATS* callsites = stats.callsites;
+
+        for(unsigned int callsite_index = 0; callsite_index < __MTX_GRD_CALLSITE_STATS_NUM__; callsite_index++)
+        {
+            if(!callsites[callsite_index].address)
+                break;
+
+            char callsite_label[MTX_GRD_EXPORT_LABEL_LEN];
+            MutexGuardExportCallsiteLabel(callsites[callsite_index].address, callsite_label, sizeof(callsite_label));
+
+            MutexGuardExportAppend(p_writer, "%s{", name);
+            MutexGuardExportGuardLabel(p_writer, p_mutex_guard);
+            MutexGuardExportAppend(p_writer, ",callsite=\"");
+            MutexGuardExportAppendEscaped(p_writer, callsite_label);
+
+            if(wait_time)
+                MutexGuardExportAppend( p_writer                                                                                ,
+                                        "\"} %lu.%09lu\n"                                                                       ,
+                                        (unsigned long)(callsites[callsite_index].wait_ns_total / MTX_GRD_TOUT_1_SEC_AS_NS)     ,
+                                        (unsigned long)(callsites[callsite_index].wait_ns_total % MTX_GRD_TOUT_1_SEC_AS_NS)     );
+            else
+                MutexGuardExportAppend(p_writer, "\"} %llu\n", callsites[callsite_index].acquisition_counter);
+        }
+
+        // Wait times of overflowing lock addresses are not tracked, only their acquisitions.
+        if(!wait_time && stats.callsite_overflow_counter)
+        {
+            MutexGuardExportAppend(p_writer, "%s{", name);
+            MutexGuardExportGuardLabel(p_writer, p_mutex_guard);
+            MutexGuardExportAppend(p_writer, ",callsite=\"" MTX_GRD_EXPORT_OTHER "\"} %llu\n", stats.callsite_overflow_counter);
+        }
+    }
+}
+
+/// @brief Gets the wait time from which a guard's acquisitions are captured: the fixed threshold, or the upper bound of the wait
+/// histogram bucket the percentile falls into (refreshed every MTX_GRD_SLOW_CAPTURE_REFRESH_NUM calls), whichever is higher.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @return Threshold in nanoseconds (0 if capturing is disabled, or the percentile is not known yet and there is no fixed threshold).
+static uint64_t MutexGuardSlowCaptureThreshold(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    uint64_t threshold_ns       = __atomic_load_n(&slow_capture_fixed_ns, __ATOMIC_RELAXED);
+    unsigned int percentile_bp  = __atomic_load_n(&slow_capture_percentile_bp, __ATOMIC_RELAXED);
+
+    if(!percentile_bp)
+        return threshold_ns;
+
+    uint64_t percentile_ns = __atomic_load_n(&p_mutex_guard->slow_capture_threshold_ns, __ATOMIC_RELAXED);
+
+    if(!percentile_ns || !(__atomic_add_fetch(&p_mutex_guard->slow_capture_refresh_counter, 1, __ATOMIC_RELAXED) % MTX_GRD_SLOW_CAPTURE_REFRESH_NUM))
+    {
+        MTX_GRD_STATS stats;
+        MutexGuardStatsMerge(p_mutex_guard, &stats);
+
+        unsigned long long total_counter = 0;
+
+        for(size_t bucket = 0; bucket < MTX_GRD_HIST_BUCKET_NUM; bucket++)
+            total_counter += stats.wait_histogram[bucket];
+
+        percentile_ns = 0;
+
+        if(total_counter >= MTX_GRD_SLOW_CAPTURE_MIN_SAMPLES)
+        {
+            unsigned long long rank_counter         = (total_counter * percentile_bp + (MTX_GRD_SLOW_CAPTURE_PERCENTILE_SCALE - 1)) / MTX_GRD_SLOW_CAPTURE_PERCENTILE_SCALE;
+            unsigned long long cumulative_counter   = 0;
+            uint64_t bucket_bound_ns                = MTX_GRD_HIST_BUCKET_BASE_NS;
+
+            // The last bucket has no upper bound, so its lower one is used instead.
+            for(size_t bucket = 0; bucket < (MTX_GRD_HIST_BUCKET_NUM - 1); bucket++)
+            {
+                cumulative_counter += stats.wait_histogram[bucket];
+
+                if(cumulative_counter >= rank_counter)
+                    break;
+
+                if(bucket < (MTX_GRD_HIST_BUCKET_NUM - 2))
+                    bucket_bound_ns <<= MTX_GRD_HIST_BUCKET_FACTOR_SHIFT;
+            }
+
+            // Waits within the percentile's bucket are not beyond the percentile.
+            percentile_ns = bucket_bound_ns + 1;
+        }
+
+        __atomic_store_n(&p_mutex_guard->slow_capture_threshold_ns, percentile_ns, __ATOMIC_RELAXED);
+    }
+
+    return ((percentile_ns > threshold_ns) ? percentile_ns : threshold_ns);
+}
+
+/// @brief Stores a slow acquisition into the capture ring (overwriting the oldest one if full).
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param address Address the guard was locked at (if any).
+/// @param wait_ns Time spent waiting.
+/// @param threshold_ns Threshold the wait went beyond.
+/// @param frames Waiter's stack frames (innermost first).
+/// @param depth Number of frames.
+/// @param p_owner_acq_location Acquisition record of the owner the waiter blocked on.
+static void MutexGuardSlowCaptureRecord(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard                          ,
+                                        void* address                                                               ,
+                                        const uint64_t wait_ns                                                      ,
+                                        const uint64_t threshold_ns                                                 ,
+                                        void* const* frames                                                         ,
+                                        const unsigned int depth                                                    ,
+                                        const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_owner_acq_location     )
+{
+    pthread_mutex_lock(&slow_capture_mutex);
+
+    MTX_GRD_SLOW_CAPTURE* p_capture = &slow_captures[slow_capture_counter % __MTX_GRD_SLOW_CAPTURE_NUM__];
+
+    p_capture->sequence             = ++slow_capture_counter;
+    p_capture->guard                = p_mutex_guard;
+    p_capture->capture_ns           = MutexGuardGetMonotonicNs();
+    p_capture->wait_ns              = wait_ns;
+    p_capture->threshold_ns         = threshold_ns;
+    p_capture->address              = address;
+    p_capture->waiter_kernel_tid    = MutexGuardGetKernelTid();
+    p_capture->depth                = ((depth < __MTX_GRD_SLOW_CAPTURE_DEPTH__) ? depth : __MTX_GRD_SLOW_CAPTURE_DEPTH__);
+    p_capture->owner_process_id     = p_owner_acq_location->process_id;
+    p_capture->owner_kernel_tid     = p_owner_acq_location->kernel_tid;
+
+    memcpy(p_capture->name, p_mutex_guard->name, sizeof(p_capture->name));
+    p_capture->name[sizeof(p_capture->name) - 1] = 0;
+    memcpy(p_capture->frames, frames, p_capture->depth * sizeof(void*));
+    memcpy(p_capture->owner_addresses, p_owner_acq_location->addresses, sizeof(p_capture->owner_addresses));
+
+    pthread_mutex_unlock(&slow_capture_mutex);
+}
+
+/// @brief Enables threshold-triggered capture of slow acquisitions: every lock call which waited for longer than the threshold
+/// records the waiter's stack and the lock addresses of the owner it waited for into a ring of the latest __MTX_GRD_SLOW_CAPTURE_NUM__
+/// captures. Calls which did not wait pay nothing, and those which did only pay for the timestamps they already take.
+/// @param threshold_ns Fixed wait threshold (0 for none).
+/// @param percentile Wait time percentile (e.g. 99.0) beyond which acquisitions are captured, estimated per guard from its wait histogram
+/// (0 for none). If both are given, the higher one applies. Both being 0 disables capturing.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardSetSlowCapture(const uint64_t threshold_ns, const double percentile)
+{
+    if(!(percentile >= 0) || (percentile >= 100))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INVALID_SLOW_CAPTURE_THRESHOLD;
+        return -1;
+    }
+
+    __atomic_store_n(&slow_capture_fixed_ns, threshold_ns, __ATOMIC_RELAXED);
+    __atomic_store_n(&slow_capture_percentile_bp, (unsigned int)(percentile * (MTX_GRD_SLOW_CAPTURE_PERCENTILE_SCALE / 100)), __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+/// @brief Copies the latest slow acquisition captures (see MutexGuardSetSlowCapture), oldest first.
+/// @param captures Target array.
+/// @param capture_num Target array's capacity.
+/// @return Number of captures copied if succeeded, < 0 otherwise.
+int MutexGuardGetSlowCaptures(MTX_GRD_SLOW_CAPTURE* C_MUTEX_GUARD_RESTRICT captures, const size_t capture_num)
+{
+    if(!captures)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -1;
+    }
+
+    pthread_mutex_lock(&slow_capture_mutex);
+
+    size_t stored_num   = ((slow_capture_counter < __MTX_GRD_SLOW_CAPTURE_NUM__) ? slow_capture_counter : __MTX_GRD_SLOW_CAPTURE_NUM__);
+    size_t copied_num   = ((stored_num < capture_num) ? stored_num : capture_num);
+
+    for(size_t capture_index = 0; capture_index < copied_num; capture_index++)
+        memcpy(&captures[capture_index], &slow_captures[(slow_capture_counter - copied_num + capture_index) % __MTX_GRD_SLOW_CAPTURE_NUM__], sizeof(MTX_GRD_SLOW_CAPTURE));
+
+    pthread_mutex_unlock(&slow_capture_mutex);
+
+    return (int)copied_num;
+}
+
+/// @brief Writes the latest slow acquisition captures (oldest first) in human-readable form, with symbolized stacks.
+/// @param fd Target file descriptor.
+/// @return Number of captures written if succeeded, < 0 otherwise.
+int MutexGuardWriteSlowCaptures(const int fd)
+{
+    MTX_GRD_SLOW_CAPTURE* captures = malloc(__MTX_GRD_SLOW_CAPTURE_NUM__ * sizeof(MTX_GRD_SLOW_CAPTURE));
+
+    if(!captures)
+    {
+        mutex_guard_lock_error_code = ENOMEM;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return -1;
+    }
+
+    int capture_num = MutexGuardGetSlowCaptures(captures, __MTX_GRD_SLOW_CAPTURE_NUM__);
+    MTX_GRD_EXPORT_WRITER writer;
+
+    writer.fd           = fd;
+    writer.error        = 0;
+    writer.len          = 0;
+    writer.buffer[0]    = 0;
+    writer.to_snapshot  = false;
+
+    for(int capture_index = 0; capture_index < capture_num; capture_index++)
+    {
+        const MTX_GRD_SLOW_CAPTURE* p_capture = &captures[capture_index];
+        char label[MTX_GRD_EXPORT_LABEL_LEN];
+
+        MutexGuardExportCallsiteLabel(p_capture->address, label, sizeof(label));
+
+        MutexGuardExportAppend( &writer, MTX_GRD_SLOW_CAPTURE_HEADER_FORMAT, p_capture->sequence                             ,
+                                (p_capture->name[0] ? p_capture->name : MTX_GRD_SLOW_CAPTURE_UNNAMED), (void*)p_capture->guard  ,
+                                label, (unsigned long long)p_capture->wait_ns, (unsigned long long)p_capture->threshold_ns      ,
+                                p_capture->waiter_kernel_tid                                                                    );
+
+        for(unsigned int frame_index = 0; frame_index < p_capture->depth; frame_index++)
+        {
+            MutexGuardExportCallsiteLabel(p_capture->frames[frame_index], label, sizeof(label));
+            MutexGuardExportAppend(&writer, MTX_GRD_SLOW_CAPTURE_FRAME_FORMAT, frame_index, p_capture->frames[frame_index], label);
+        }
+
+        MutexGuardExportAppend(&writer, MTX_GRD_SLOW_CAPTURE_OWNER_FORMAT, p_capture->owner_process_id, p_capture->owner_kernel_tid);
+
+        for(unsigned int address_index = 0; (address_index < __MTX_GRD_ADDR_NUM__) && p_capture->owner_addresses[address_index]; address_index++)
+        {
+            MutexGuardExportCallsiteLabel(p_capture->owner_addresses[address_index], label, sizeof(label));
+            MutexGuardExportAppend(&writer, MTX_GRD_SLOW_CAPTURE_FRAME_FORMAT, address_index, p_capture->owner_addresses[address_index], label);
+        }
+    }
+
+    MutexGuardExportFlush(&writer);
+    free(captures);
+
+    if(writer.error)
+    {
+        mutex_guard_lock_error_code = writer.error;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return -1;
+    }
+
+    return capture_num;
+}
+
+/// @brief Writes every registered guard's statistics in Prometheus text exposition format. Guard names (or addresses, if unnamed)
+/// and lock addresses are used as labels. Guards beyond the first __MTX_GRD_EXPORT_MAX_GUARDS__ ones are aggregated as "other".
+/// Guards are walked without taking any lock, so lockers are never blocked (values may be slightly stale), into a snapshot which is
+/// only written once done: a slow descriptor never holds guards' destruction up.
+/// @param fd Target file descriptor.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardExportPrometheus(const int fd)
+{
+    MTX_GRD_EXPORT_WRITER writer;
+
+    writer.fd               = fd;
+    writer.error            = 0;
+    writer.len              = 0;
+    writer.buffer[0]        = 0;
+    writer.to_snapshot      = true;
+    writer.snapshot         = NULL;
+    writer.snapshot_len     = 0;
+    writer.snapshot_size    = 0;
+
+    __atomic_add_fetch(&registry_readers, 1, __ATOMIC_ACQ_REL);
+
+    for(size_t family_index = 0; family_index < (sizeof(export_families) / sizeof(export_families[0])); family_index++)
+        MutexGuardExportFamily(&writer, &export_families[family_index]);
+
+    MutexGuardExportHistogram(&writer, "mtx_grd_wait_seconds", "Time spent waiting to acquire the guard.", false);
+    MutexGuardExportHistogram(&writer, "mtx_grd_hold_seconds", "Time the guard was held for.", true);
+    MutexGuardExportCallsites(&writer, false);
+    MutexGuardExportCallsites(&writer, true);
+    MutexGuardExportFlush(&writer);
+
+    __atomic_sub_fetch(&registry_readers, 1, __ATOMIC_ACQ_REL);
+
+    if(!writer.error && MutexGuardDumpWrite(fd, writer.snapshot, writer.snapshot_len))
+        writer.error = errno;
+
+    free(writer.snapshot);
+
+    if(writer.error)
+    {
+        mutex_guard_lock_error_code = writer.error;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return -1;
+    }
+
+    return 0;
+}
+
+/// @brief Periodically exports statistics to exporter_file_path (through a temporary file, so readers never see partial contents).
+/// @param arg Unused.
+/// @return NULL.
+static void* MutexGuardExporterFileThread(void* arg)
+{
+    (void)arg;
+
+    char tmp_path[PATH_MAX + sizeof(MTX_GRD_EXPORT_TMP_SUFFIX)];
+    snprintf(tmp_path, sizeof(tmp_path), "%s" MTX_GRD_EXPORT_TMP_SUFFIX, exporter_file_path);
+
+    pthread_mutex_lock(&exporter_mutex);
+
+    while(!exporter_stop)
+    {
+        pthread_mutex_unlock(&exporter_mutex);
+
+        int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, MTX_GRD_EXPORT_FILE_PERMISSIONS);
+
+        if(fd >= 0)
+        {
+            int ret_export = MutexGuardExportPrometheus(fd);
+            close(fd);
+
+            if(ret_export || rename(tmp_path, exporter_file_path))
+                unlink(tmp_path);
+        }
+
+        pthread_mutex_lock(&exporter_mutex);
+
+        mtx_to_t next_export = MutexGuardGenClockTimespec(CLOCK_MONOTONIC, exporter_period_ns);
+
+        while(!exporter_stop && (pthread_cond_timedwait(&exporter_cond, &exporter_mutex, &next_export) != ETIMEDOUT));
+    }
+
+    pthread_mutex_unlock(&exporter_mutex);
+
+    return NULL;
+}
+
+/// @brief Serves statistics to every connection accepted on exporter_socket_fd (checking for exporter_stop in between).
+/// @param arg Unused.
+/// @return NULL.
+static void* MutexGuardExporterSocketThread(void* arg)
+{
+    (void)arg;
+
+    while(!__atomic_load_n(&exporter_stop, __ATOMIC_ACQUIRE))
+    {
+        struct pollfd listen_poll = { .fd = exporter_socket_fd, .events = POLLIN };
+
+        if(poll(&listen_poll, 1, MTX_GRD_EXPORT_POLL_PERIOD_MS) <= 0)
+            continue;
+
+        int client_fd = accept4(exporter_socket_fd, NULL, NULL, SOCK_CLOEXEC);
+
+        if(client_fd < 0)
+            continue;
+
+        // A client which stops reading only holds the exporter up for so long.
+        struct timeval send_timeout = { .tv_sec = MTX_GRD_EXPORT_SEND_TIMEOUT_MS / 1000, .tv_usec = (MTX_GRD_EXPORT_SEND_TIMEOUT_MS % 1000) * 1000 };
+        setsockopt(client_fd, SOL_SOCKET, SO_SNDTIMEO, &send_timeout, sizeof(send_timeout));
+
+        // Whatever was requested, statistics are served. The request is only drained so that the peer does not see a reset.
+        char request[MTX_GRD_EXPORT_REQUEST_LEN];
+        struct pollfd client_poll = { .fd = client_fd, .events = POLLIN };
+
+        if(poll(&client_poll, 1, MTX_GRD_EXPORT_POLL_PERIOD_MS) > 0)
+            (void)!read(client_fd, request, sizeof(request));
+
+        if(!MutexGuardDumpWrite(client_fd, MTX_GRD_EXPORT_HTTP_HEADER, strlen(MTX_GRD_EXPORT_HTTP_HEADER)))
+            MutexGuardExportPrometheus(client_fd);
+
+        close(client_fd);
+    }
+
+    return NULL;
+}
+
+/// @brief Starts an exporter thread with every signal blocked (so that it neither handles the process' signals nor dies on SIGPIPE).
+/// @param p_thread Pointer to where the thread's ID is meant to be copied to.
+/// @param thread_fn Thread function.
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardExporterStartThread(pthread_t* p_thread, void* (*thread_fn)(void*))
+{
+    sigset_t blocked_signals, previous_signals;
+    sigfillset(&blocked_signals);
+    pthread_sigmask(SIG_SETMASK, &blocked_signals, &previous_signals);
+
+    int ret_create = pthread_create(p_thread, NULL, thread_fn, NULL);
+
+    pthread_sigmask(SIG_SETMASK, &previous_signals, NULL);
+
+    return ret_create;
+}
+
+/// @brief Starts a thread which periodically exports statistics to a file (atomically replaced, as textfile collectors expect).
+/// @param path Target file path.
+/// @param period_ns Export period in nanoseconds.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardExporterStartFile(const char* C_MUTEX_GUARD_RESTRICT path, const uint64_t period_ns)
+{
+    if(!path)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -1;
+    }
+
+    if(!period_ns || (strlen(path) >= sizeof(exporter_file_path)))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_EXPORTER_ERROR;
+        return -2;
+    }
+
+    pthread_mutex_lock(&exporter_mutex);
+
+    if(exporter_file_running)
+    {
+        pthread_mutex_unlock(&exporter_mutex);
+        mutex_guard_errno = MTX_GRD_ERR_EXPORTER_ERROR;
+        return -2;
+    }
+
+    strcpy(exporter_file_path, path);
+    exporter_period_ns  = period_ns;
+    exporter_stop       = false;
+
+    int ret_create = MutexGuardExporterStartThread(&exporter_file_thread, MutexGuardExporterFileThread);
+
+    exporter_file_running = !ret_create;
+
+    pthread_mutex_unlock(&exporter_mutex);
+
+    if(ret_create)
+    {
+        mutex_guard_lock_error_code = ret_create;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return -3;
+    }
+
+    return 0;
+}
+
+/// @brief Starts a thread which serves statistics (as an HTTP/1.0 response) to every connection accepted on a local Unix socket.
+/// @param socket_path Unix socket path (replaced if it already exists).
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardExporterStartSocket(const char* C_MUTEX_GUARD_RESTRICT socket_path)
+{
+    if(!socket_path)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -1;
+    }
+
+    if(strlen(socket_path) >= sizeof(exporter_socket_addr.sun_path))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_EXPORTER_ERROR;
+        return -2;
+    }
+
+    pthread_mutex_lock(&exporter_mutex);
+
+    if(exporter_socket_running)
+    {
+        pthread_mutex_unlock(&exporter_mutex);
+        mutex_guard_errno = MTX_GRD_ERR_EXPORTER_ERROR;
+        return -2;
+    }
+
+    memset(&exporter_socket_addr, 0, sizeof(exporter_socket_addr));
+    exporter_socket_addr.sun_family = AF_UNIX;
+    strcpy(exporter_socket_addr.sun_path, socket_path);
+
+    unlink(socket_path);
+
+    int ret_start = 0;
+    exporter_socket_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if( (exporter_socket_fd < 0)                                                                                    ||
+        bind(exporter_socket_fd, (const struct sockaddr*)&exporter_socket_addr, sizeof(exporter_socket_addr))       ||
+        listen(exporter_socket_fd, MTX_GRD_EXPORT_SOCKET_BACKLOG)                                                   )
+        ret_start = errno;
+    else
+    {
+        exporter_stop   = false;
+        ret_start       = MutexGuardExporterStartThread(&exporter_socket_thread, MutexGuardExporterSocketThread);
+    }
+
+    if(ret_start && (exporter_socket_fd >= 0))
+    {
+        close(exporter_socket_fd);
+        exporter_socket_fd = -1;
+    }
+
+    exporter_socket_running = !ret_start;
+
+    pthread_mutex_unlock(&exporter_mutex);
+
+    if(ret_start)
+    {
+        mutex_guard_lock_error_code = ret_start;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return -3;
+    }
+
+    return 0;
+}
+
+/// @brief Publishes every registered guard's statistics into the stats segment. Entries are written under the segment's seqlock,
+/// so that readers never see a half-updated snapshot (and never block the publisher).
+/// @param p_segment Pointer to the mapped stats segment.
+static void MutexGuardStatsShmPublish(MTX_GRD_STATS_SHM* C_MUTEX_GUARD_RESTRICT p_segment)
+{
+    MTX_GRD_STATS_SHM_ENTRY* entries    = MTX_GRD_STATS_SHM_ENTRIES(p_segment);
+    uint32_t sequence                   = __atomic_load_n(&p_segment->sequence, __ATOMIC_RELAXED);
+    uint32_t entry_num                  = 0;
+
+    __atomic_store_n(&p_segment->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    __atomic_add_fetch(&registry_readers, 1, __ATOMIC_ACQ_REL);
+
+    uint64_t now_ns = MutexGuardGetMonotonicNs();
+
+    size_t registry_index = 0;
+
+    for(MTX_GRD* p_mutex_guard = MutexGuardRegistryNext(NULL, &registry_index); p_mutex_guard && (entry_num < p_segment->entry_capacity); p_mutex_guard = MutexGuardRegistryNext(p_mutex_guard, &registry_index))
+    {
+        MTX_GRD_STATS_SHM_ENTRY* p_entry = &entries[entry_num++];
+        MTX_GRD_ACQ_LOCATION acq_location;
+        MTX_GRD_STATS stats;
+
+        memcpy(&acq_location, &p_mutex_guard->mutex_acq_location, sizeof(MTX_GRD_ACQ_LOCATION));
+        MutexGuardStatsMerge(p_mutex_guard, &stats);
+
+        memcpy(p_entry->name, p_mutex_guard->name, sizeof(p_entry->name));
+        p_entry->name[sizeof(p_entry->name) - 1] = 0;
+
+        p_entry->guard_address          = (uint64_t)(uintptr_t)p_mutex_guard;
+        p_entry->acquisition_counter    = stats.acquisition_counter;
+        p_entry->contention_counter     = stats.contention_counter;
+        p_entry->failure_counter        = stats.failure_counter;
+        p_entry->wait_ns_total          = stats.wait_ns_total;
+        p_entry->hold_ns_total          = stats.hold_ns_total;
+        p_entry->hold_ns_max            = stats.hold_ns_max;
+        p_entry->waiter_counter         = __atomic_load_n(&p_mutex_guard->waiter_counter, __ATOMIC_RELAXED);
+        p_entry->owner_pid              = (acq_location.thread_id ? acq_location.process_id : 0);
+        p_entry->owner_tid              = (acq_location.thread_id ? acq_location.kernel_tid : 0);
+        p_entry->hold_ns_current        = ((acq_location.thread_id && acq_location.acq_ns && (now_ns > acq_location.acq_ns)) ? (now_ns - acq_location.acq_ns) : 0);
+    }
+
+    __atomic_sub_fetch(&registry_readers, 1, __ATOMIC_ACQ_REL);
+
+    p_segment->entry_num    = entry_num;
+    p_segment->publish_ns   = now_ns;
+
+    __atomic_store_n(&p_segment->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+/// @brief Periodically publishes statistics into the stats segment mapped at exporter_shm.
+/// @param arg Unused.
+/// @return NULL.
+static void* MutexGuardExporterShmThread(void* arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&exporter_mutex);
+
+    while(!exporter_stop)
+    {
+        pthread_mutex_unlock(&exporter_mutex);
+
+        MutexGuardStatsShmPublish(exporter_shm);
+
+        pthread_mutex_lock(&exporter_mutex);
+
+        mtx_to_t next_publish = MutexGuardGenClockTimespec(CLOCK_MONOTONIC, exporter_shm->period_ns);
+
+        while(!exporter_stop && (pthread_cond_timedwait(&exporter_cond, &exporter_mutex, &next_publish) != ETIMEDOUT));
+    }
+
+    pthread_mutex_unlock(&exporter_mutex);
+
+    return NULL;
+}
+
+/// @brief Starts a thread which periodically publishes every guard's statistics into a named shared memory segment
+/// (see MTX_GRD_STATS_SHM), so that they can be watched live (e.g. with mgtop) without the process doing any I/O.
+/// @param name Shared memory object name (as used by shm_open, e.g. "/my_app_mtx_grd").
+/// @param period_ns Publishing period in nanoseconds.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardExporterStartShm(const char* C_MUTEX_GUARD_RESTRICT name, const uint64_t period_ns)
+{
+    if(!name)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -1;
+    }
+
+    if(!period_ns || (strlen(name) >= sizeof(exporter_shm_name)))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_EXPORTER_ERROR;
+        return -2;
+    }
+
+    pthread_mutex_lock(&exporter_mutex);
+
+    if(exporter_shm_running)
+    {
+        pthread_mutex_unlock(&exporter_mutex);
+        mutex_guard_errno = MTX_GRD_ERR_EXPORTER_ERROR;
+        return -2;
+    }
+
+    size_t segment_size = MTX_GRD_STATS_SHM_SIZE(__MTX_GRD_STATS_SHM_MAX_GUARDS__);
+    int ret_start       = 0;
+    int shm_fd          = shm_open(name, O_RDWR | O_CREAT | O_TRUNC, MTX_GRD_STATS_SHM_PERMISSIONS);
+
+    if((shm_fd < 0) || ftruncate(shm_fd, segment_size))
+        ret_start = errno;
+    else
+    {
+        exporter_shm = mmap(NULL, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+
+        if(exporter_shm == MAP_FAILED)
+        {
+            ret_start       = errno;
+            exporter_shm    = NULL;
+        }
+    }
+
+    if(shm_fd >= 0)
+        close(shm_fd);
+
+    if(!ret_start)
+    {
+        strcpy(exporter_shm_name, name);
+
+        exporter_shm->version           = MTX_GRD_STATS_SHM_VERSION;
+        exporter_shm->pid               = MutexGuardGetProcessId();
+        exporter_shm->entry_capacity    = __MTX_GRD_STATS_SHM_MAX_GUARDS__;
+        exporter_shm->period_ns         = period_ns;
+
+        // Readers only trust the segment once the magic number is there.
+        __atomic_store_n(&exporter_shm->magic, MTX_GRD_STATS_SHM_MAGIC, __ATOMIC_RELEASE);
+
+        exporter_stop   = false;
+        ret_start       = MutexGuardExporterStartThread(&exporter_shm_thread, MutexGuardExporterShmThread);
+
+        if(ret_start)
+        {
+            munmap(exporter_shm, segment_size);
+            shm_unlink(name);
+            exporter_shm = NULL;
+        }
+    }
+    else if(shm_fd >= 0)
+        shm_unlink(name);
+
+    exporter_shm_running = !ret_start;
+
+    pthread_mutex_unlock(&exporter_mutex);
+
+    if(ret_start)
+    {
+        mutex_guard_lock_error_code = ret_start;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return -3;
+    }
+
+    return 0;
+}
+
+/// @brief Stops every exporter thread started by MutexGuardExporterStartFile/MutexGuardExporterStartSocket/MutexGuardExporterStartShm
+/// (removing the stats segment, if any).
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardExporterStop(void)
+{
+    pthread_mutex_lock(&exporter_mutex);
+
+    if(!exporter_file_running && !exporter_socket_running && !exporter_shm_running)
+    {
+        pthread_mutex_unlock(&exporter_mutex);
+        mutex_guard_errno = MTX_GRD_ERR_EXPORTER_ERROR;
+        return -1;
+    }
+
+    __atomic_store_n(&exporter_stop, true, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&exporter_cond);
+
+    pthread_mutex_unlock(&exporter_mutex);
+
+    // Threads are joined without holding exporter_mutex, as the file exporter takes it.
+    if(exporter_file_running)
+        pthread_join(exporter_file_thread, NULL);
+
+    if(exporter_socket_running)
+    {
+        pthread_join(exporter_socket_thread, NULL);
+
+        close(exporter_socket_fd);
+        unlink(exporter_socket_addr.sun_path);
+    }
+
+    if(exporter_shm_running)
+    {
+        pthread_join(exporter_shm_thread, NULL);
+
+        munmap(exporter_shm, MTX_GRD_STATS_SHM_SIZE(exporter_shm->entry_capacity));
+        shm_unlink(exporter_shm_name);
+    }
+
+    pthread_mutex_lock(&exporter_mutex);
+
+    exporter_file_running   = false;
+    exporter_socket_running = false;
+    exporter_shm_running    = false;
+    exporter_socket_fd      = -1;
+    exporter_shm            = NULL;
+    exporter_stop           = false;
+
+    pthread_mutex_unlock(&exporter_mutex);
+
+    return 0;
+}
+
+/// @brief Hashes a stack (FNV-1a over its frames).
+/// @param frames Stack frames.
+/// @param depth Number of frames.
+/// @return Stack hash.
+static uint64_t MutexGuardProfileHash(void* const* frames, const unsigned int depth)
+{
+    uint64_t hash = MTX_GRD_PROFILE_FNV_OFFSET;
+
+    for(unsigned int frame_index = 0; frame_index < depth; frame_index++)
+    {
+        hash ^= (uint64_t)(uintptr_t)frames[frame_index];
+        hash *= MTX_GRD_PROFILE_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/// @brief Accounts a contended acquisition to the waiter's stack.
+/// @param frames Waiter's stack frames (innermost first).
+/// @param depth Number of frames.
+/// @param wait_ns Time spent waiting.
+/// @param weight Number of contended acquisitions the recorded one stands for (see MutexGuardSampleWeight).
+static void MutexGuardProfileRecord(void* const* frames, const unsigned int depth, const uint64_t wait_ns, const unsigned int weight)
+{
+    if(!depth)
+        return;
+
+    uint64_t hash = MutexGuardProfileHash(frames, depth);
+
+    pthread_mutex_lock(&profile_mutex);
+
+    for(unsigned int probe = 0; probe < __MTX_GRD_PROFILE_STACK_NUM__; probe++)
+    {
+        MTX_GRD_PROFILE_STACK* p_stack = &profile_stacks[(hash + probe) % __MTX_GRD_PROFILE_STACK_NUM__];
+
+        if(!p_stack->depth)
+        {
+            p_stack->hash   = hash;
+            p_stack->depth  = depth;
+            memcpy(p_stack->frames, frames, depth * sizeof(void*));
+        }
+        else if((p_stack->hash != hash) || (p_stack->depth != depth) || memcmp(p_stack->frames, frames, depth * sizeof(void*)))
+            continue;
+
+        p_stack->contention_counter += weight;
+        p_stack->wait_ns_total      += wait_ns * weight;
+
+        pthread_mutex_unlock(&profile_mutex);
+        return;
+    }
+
+    ++profile_dropped_counter;
+
+    pthread_mutex_unlock(&profile_mutex);
+}
+
+/// @brief Enables or disables contention profiling. While enabled, every lock which has to wait for another owner records
+/// the waiter's stack, so that contended acquisitions and wait times can be aggregated per stack. Enabling it clears previous samples.
+/// @param enable Tells whether profiling is meant to be enabled.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardSetContentionProfiling(const bool enable)
+{
+    pthread_mutex_lock(&profile_mutex);
+
+    if(enable && !profile_enabled)
+    {
+        memset(profile_stacks, 0, sizeof(profile_stacks));
+        profile_dropped_counter = 0;
+        profile_start_ns        = MutexGuardGetMonotonicNs();
+    }
+
+    __atomic_store_n(&profile_enabled, enable, __ATOMIC_RELAXED);
+
+    pthread_mutex_unlock(&profile_mutex);
+
+    return 0;
+}
+
+/// @brief Appends raw bytes to a protobuf buffer (growing it if needed).
+/// @param p_buffer Pointer to target buffer.
+/// @param data Bytes to be appended.
+/// @param data_len Number of bytes to be appended.
+static void MutexGuardPbAppend(MTX_GRD_PB_BUFFER* C_MUTEX_GUARD_RESTRICT p_buffer, const void* C_MUTEX_GUARD_RESTRICT data, const size_t data_len)
+{
+    if(p_buffer->error)
+        return;
+
+    if((p_buffer->len + data_len) > p_buffer->size)
+    {
+        size_t new_size = (p_buffer->size ? p_buffer->size : MTX_GRD_PB_BUFFER_MIN_SIZE);
+
+        while(new_size < (p_buffer->len + data_len))
+            new_size *= 2;
+
+        uint8_t* new_data = realloc(p_buffer->data, new_size);
+
+        if(!new_data)
+        {
+            p_buffer->error = true;
+            return;
+        }
+
+        p_buffer->data = new_data;
+        p_buffer->size = new_size;
+    }
+
+    memcpy(p_buffer->data + p_buffer->len, data, data_len);
+    p_buffer->len += data_len;
+}
+
+/// @brief Appends a base 128 varint.
+/// @param p_buffer Pointer to target buffer.
+/// @param value Value to be encoded.
+static void MutexGuardPbVarint(MTX_GRD_PB_BUFFER* C_MUTEX_GUARD_RESTRICT p_buffer, uint64_t value)
+{
+    uint8_t varint[MTX_GRD_PB_VARINT_MAX_LEN];
+    size_t varint_len = 0;
+
+    do
+    {
+        varint[varint_len++] = (uint8_t)((value & 0x7F) | ((value > 0x7F) ? 0x80 : 0));
+        value >>= 7;
+    }
+    while(value);
+
+    MutexGuardPbAppend(p_buffer, varint, varint_len);
+}
+
+/// @brief Appends a varint field (omitted if 0, as proto3 does).
+/// @param p_buffer Pointer to target buffer.
+/// @param field Field number.
+/// @param value Field value.
+static void MutexGuardPbTagVarint(MTX_GRD_PB_BUFFER* C_MUTEX_GUARD_RESTRICT p_buffer, const unsigned int field, const uint64_t value)
+{
+    if(!value)
+        return;
+
+    MutexGuardPbVarint(p_buffer, ((uint64_t)field << 3) | MTX_GRD_PB_WIRE_VARINT);
+    MutexGuardPbVarint(p_buffer, value);
+}
+
+/// @brief Appends a length-delimited field (string, bytes, packed repeated field or embedded message).
+/// @param p_buffer Pointer to target buffer.
+/// @param field Field number.
+/// @param data Field content.
+/// @param data_len Field content length.
+static void MutexGuardPbTagBytes(MTX_GRD_PB_BUFFER* C_MUTEX_GUARD_RESTRICT p_buffer, const unsigned int field, const void* data, const size_t data_len)
+{
+    MutexGuardPbVarint(p_buffer, ((uint64_t)field << 3) | MTX_GRD_PB_WIRE_LEN);
+    MutexGuardPbVarint(p_buffer, data_len);
+    MutexGuardPbAppend(p_buffer, data, data_len);
+}
+
+/// @brief Appends an embedded message field, releasing the buffer it was encoded into.
+/// @param p_buffer Pointer to target buffer.
+/// @param field Field number.
+/// @param p_message Pointer to the buffer holding the encoded message.
+static void MutexGuardPbTagMessage(MTX_GRD_PB_BUFFER* C_MUTEX_GUARD_RESTRICT p_buffer, const unsigned int field, MTX_GRD_PB_BUFFER* C_MUTEX_GUARD_RESTRICT p_message)
+{
+    p_buffer->error |= p_message->error;
+    MutexGuardPbTagBytes(p_buffer, field, p_message->data, p_message->len);
+
+    free(p_message->data);
+    memset(p_message, 0, sizeof(MTX_GRD_PB_BUFFER));
+}
+
+/// @brief Gets a string's index within the profile's string table (adding a copy of it if not found).
+/// @param p_strings Pointer to target string table.
+/// @param string Target string.
+/// @return String index (0, the empty string, if it could not be added).
+static uint64_t MutexGuardProfileString(MTX_GRD_PROFILE_STRINGS* C_MUTEX_GUARD_RESTRICT p_strings, const char* C_MUTEX_GUARD_RESTRICT string)
+{
+    if(!string || !string[0])
+        return 0;
+
+    for(size_t string_index = 1; string_index < p_strings->num; string_index++)
+        if(!strcmp(p_strings->strings[string_index], string))
+            return string_index;
+
+    if(p_strings->num == p_strings->size)
+    {
+        size_t new_size         = (p_strings->size ? (p_strings->size * 2) : MTX_GRD_PROFILE_STRINGS_MIN_SIZE);
+        char** new_strings      = realloc(p_strings->strings, new_size * sizeof(char*));
+
+        if(!new_strings)
+        {
+            p_strings->error = true;
+            return 0;
+        }
+
+        p_strings->strings  = new_strings;
+        p_strings->size     = new_size;
+    }
+
+    // Index 0 is always the empty string.
+    if(!p_strings->num)
+        p_strings->strings[p_strings->num++] = NULL;
+
+    char* string_copy = strdup(string);
+
+    if(!string_copy)
+    {
+        p_strings->error = true;
+        return 0;
+    }
+
+    p_strings->strings[p_strings->num] = string_copy;
+
+    return p_strings->num++;
+}
+
+/// @brief Compares two addresses (qsort/bsearch callback).
+/// @param p_a Pointer to first address.
+/// @param p_b Pointer to second address.
+/// @return < 0, 0 or > 0 if the first address is lower, equal or greater than the second one.
+static int MutexGuardProfileCompareAddresses(const void* p_a, const void* p_b)
+{
+    uintptr_t address_a = *(const uintptr_t*)p_a;
+    uintptr_t address_b = *(const uintptr_t*)p_b;
+
+    return (address_a > address_b) - (address_a < address_b);
+}
+
+/// @brief Writes the contention profile (contentions/count and delay/nanoseconds per waiter stack) in pprof protobuf format,
+/// so that it can be inspected or diffed with "pprof" (e.g. pprof -http=: -diff_base=old.pb new.pb).
+/// Locations are symbolized with dladdr and mappings carry their build IDs, so the profile can be read without the binaries.
+/// @param fd Target file descriptor.
+/// @return Number of samples written if succeeded, < 0 otherwise.
+int MutexGuardWriteContentionProfile(const int fd)
+{
+    MTX_GRD_PROFILE_STACK* stacks   = malloc(sizeof(profile_stacks));
+    unsigned int stack_num          = 0;
+    uint64_t start_ns;
+
+    if(!stacks)
+    {
+        mutex_guard_lock_error_code = ENOMEM;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return -2;
+    }
+
+    // Samples are copied so that lockers are not kept waiting while the profile is encoded.
+    pthread_mutex_lock(&profile_mutex);
+
+    for(unsigned int stack_index = 0; stack_index < __MTX_GRD_PROFILE_STACK_NUM__; stack_index++)
+        if(profile_stacks[stack_index].depth)
+            memcpy(&stacks[stack_num++], &profile_stacks[stack_index], sizeof(MTX_GRD_PROFILE_STACK));
+
+    start_ns                                = profile_start_ns;
+    unsigned long long dropped_counter      = profile_dropped_counter;
+
+    pthread_mutex_unlock(&profile_mutex);
+
+    size_t address_num  = 0;
+    uintptr_t* addresses = malloc((stack_num * __MTX_GRD_PROFILE_DEPTH__ + 1) * sizeof(uintptr_t));
+
+    // Frames are return addresses: 1 is subtracted so that they are resolved into the calling instruction.
+    for(unsigned int stack_index = 0; addresses && (stack_index < stack_num); stack_index++)
+        for(unsigned int frame_index = 0; frame_index < stacks[stack_index].depth; frame_index++)
+            addresses[address_num++] = (uintptr_t)stacks[stack_index].frames[frame_index] - 1;
+
+    if(addresses)
+        qsort(addresses, address_num, sizeof(uintptr_t), MutexGuardProfileCompareAddresses);
+
+    size_t unique_address_num = 0;
+
+    for(size_t address_index = 0; addresses && (address_index < address_num); address_index++)
+        if(!unique_address_num || (addresses[address_index] != addresses[unique_address_num - 1]))
+            addresses[unique_address_num++] = addresses[address_index];
+
+    MTX_GRD_PROFILE_STRINGS strings = {0};
+    MTX_GRD_PB_BUFFER profile       = {0};
+    MTX_GRD_PB_BUFFER message       = {0};
+    MTX_GRD_PB_BUFFER packed        = {0};
+
+    MutexGuardProfileString(&strings, MTX_GRD_PROFILE_CONTENTIONS);
+
+    // Sample types (contentions/count and delay/nanoseconds) and period type (contentions/count), as Go's mutex profiles.
+    MutexGuardPbTagVarint(&message, MTX_GRD_PB_VALUE_TYPE_TYPE, MutexGuardProfileString(&strings, MTX_GRD_PROFILE_CONTENTIONS));
+    MutexGuardPbTagVarint(&message, MTX_GRD_PB_VALUE_TYPE_UNIT, MutexGuardProfileString(&strings, MTX_GRD_PROFILE_COUNT));
+    MutexGuardPbTagMessage(&profile, MTX_GRD_PB_PROFILE_SAMPLE_TYPE, &message);
+
+    MutexGuardPbTagVarint(&message, MTX_GRD_PB_VALUE_TYPE_TYPE, MutexGuardProfileString(&strings, MTX_GRD_PROFILE_DELAY));
+    MutexGuardPbTagVarint(&message, MTX_GRD_PB_VALUE_TYPE_UNIT, MutexGuardProfileString(&strings, MTX_GRD_PROFILE_NANOSECONDS));
+    MutexGuardPbTagMessage(&profile, MTX_GRD_PB_PROFILE_SAMPLE_TYPE, &message);
+
+    MutexGuardPbTagVarint(&message, MTX_GRD_PB_VALUE_TYPE_TYPE, MutexGuardProfileString(&strings, MTX_GRD_PROFILE_CONTENTIONS));
+    MutexGuardPbTagVarint(&message, MTX_GRD_PB_VALUE_TYPE_UNIT, MutexGuardProfileString(&strings, MTX_GRD_PROFILE_COUNT));
+    MutexGuardPbTagMessage(&profile, MTX_GRD_PB_PROFILE_PERIOD_TYPE, &message);
+
+    MutexGuardPbTagVarint(&profile, MTX_GRD_PB_PROFILE_PERIOD, 1);
+
+    // Samples: location IDs (innermost first) plus values.
+    for(unsigned int stack_index = 0; addresses && (stack_index < stack_num); stack_index++)
+    {
+        for(unsigned int frame_index = 0; frame_index < stacks[stack_index].depth; frame_index++)
+        {
+            uintptr_t frame_address = (uintptr_t)stacks[stack_index].frames[frame_index] - 1;
+            uintptr_t* p_address    = bsearch(&frame_address, addresses, unique_address_num, sizeof(uintptr_t), MutexGuardProfileCompareAddresses);
+
+            MutexGuardPbVarint(&packed, (uint64_t)(p_address - addresses) + 1);
+        }
+
+        MutexGuardPbTagBytes(&message, MTX_GRD_PB_SAMPLE_LOCATION_ID, packed.data, packed.len);
+        packed.len = 0;
+
+        MutexGuardPbVarint(&packed, stacks[stack_index].contention_counter);
+        MutexGuardPbVarint(&packed, stacks[stack_index].wait_ns_total);
+        MutexGuardPbTagBytes(&message, MTX_GRD_PB_SAMPLE_VALUE, packed.data, packed.len);
+        packed.len = 0;
+
+        MutexGuardPbTagMessage(&profile, MTX_GRD_PB_PROFILE_SAMPLE, &message);
+    }
+
+    // Locations, each one with a single line pointing to the function it belongs to, and mappings of the modules they were found in.
+    MTX_GRD_MODULE_CACHE mappings[MTX_GRD_PROFILE_MAPPING_NUM];
+    size_t mapping_num      = 0;
+    uint64_t* function_names = malloc((unique_address_num + 1) * sizeof(uint64_t));
+    size_t function_num     = 0;
+
+    for(size_t address_index = 0; function_names && (address_index < unique_address_num); address_index++)
+    {
+        uintptr_t address   = addresses[address_index];
+        size_t mapping_id   = 0;
+
+        for(size_t mapping_index = 0; mapping_index < mapping_num; mapping_index++)
+            if((address >= mappings[mapping_index].start) && (address < mappings[mapping_index].end))
+                mapping_id = mapping_index + 1;
+
+        Dl_info address_info = {0};
+        dladdr((const void*)address, &address_info);
+
+        if(!mapping_id && (mapping_num < MTX_GRD_PROFILE_MAPPING_NUM))
+        {
+            MTX_GRD_MODULE_CACHE* p_mapping = &mappings[mapping_num];
+            memset(p_mapping, 0, sizeof(MTX_GRD_MODULE_CACHE));
+            p_mapping->start = address;
+
+            if(dl_iterate_phdr(MutexGuardFindModuleCallback, p_mapping))
+            {
+                char build_id_str[MTX_GRD_BUILD_ID_STR_LEN] = {0};
+                MutexGuardBuildIdToString(p_mapping->build_id, build_id_str);
+
+                mapping_id = ++mapping_num;
+
+                MutexGuardPbTagVarint(&message, MTX_GRD_PB_MAPPING_ID, mapping_id);
+                MutexGuardPbTagVarint(&message, MTX_GRD_PB_MAPPING_MEMORY_START, p_mapping->start);
+                MutexGuardPbTagVarint(&message, MTX_GRD_PB_MAPPING_MEMORY_LIMIT, p_mapping->end);
+                MutexGuardPbTagVarint(&message, MTX_GRD_PB_MAPPING_FILE_OFFSET, p_mapping->start - p_mapping->load_base);
+                MutexGuardPbTagVarint(&message, MTX_GRD_PB_MAPPING_FILENAME, MutexGuardProfileString(&strings, address_info.dli_fname));
+                MutexGuardPbTagVarint(&message, MTX_GRD_PB_MAPPING_BUILD_ID, MutexGuardProfileString(&strings, build_id_str));
+                MutexGuardPbTagVarint(&message, MTX_GRD_PB_MAPPING_HAS_FUNCTIONS, 1);
+                MutexGuardPbTagMessage(&profile, MTX_GRD_PB_PROFILE_MAPPING, &message);
+            }
+        }
+
+        // Unresolved symbols (e.g. static functions) are named after their module and offset, so that they are not merged together.
+        char unresolved_name[MTX_GRD_EXPORT_LABEL_LEN] = {0};
+
+        if(!address_info.dli_sname)
+            MutexGuardExportCallsiteLabel((const void*)address, unresolved_name, sizeof(unresolved_name));
+
+        uint64_t function_name  = MutexGuardProfileString(&strings, (address_info.dli_sname ? address_info.dli_sname : unresolved_name));
+        size_t function_id      = 0;
+
+        for(size_t function_index = 0; function_index < function_num; function_index++)
+            if(function_names[function_index] == function_name)
+                function_id = function_index + 1;
+
+        if(!function_id)
+        {
+            function_names[function_num] = function_name;
+            function_id = ++function_num;
+
+            MutexGuardPbTagVarint(&message, MTX_GRD_PB_FUNCTION_ID, function_id);
+            MutexGuardPbTagVarint(&message, MTX_GRD_PB_FUNCTION_NAME, function_name);
+            MutexGuardPbTagVarint(&message, MTX_GRD_PB_FUNCTION_SYSTEM_NAME, function_name);
+            MutexGuardPbTagVarint(&message, MTX_GRD_PB_FUNCTION_FILENAME, MutexGuardProfileString(&strings, address_info.dli_fname));
+            MutexGuardPbTagMessage(&profile, MTX_GRD_PB_PROFILE_FUNCTION, &message);
+        }
+
+        MTX_GRD_PB_BUFFER line = {0};
+        MutexGuardPbTagVarint(&line, MTX_GRD_PB_LINE_FUNCTION_ID, function_id);
+
+        MutexGuardPbTagVarint(&message, MTX_GRD_PB_LOCATION_ID, address_index + 1);
+        MutexGuardPbTagVarint(&message, MTX_GRD_PB_LOCATION_MAPPING_ID, mapping_id);
+        MutexGuardPbTagVarint(&message, MTX_GRD_PB_LOCATION_ADDRESS, address);
+        MutexGuardPbTagMessage(&message, MTX_GRD_PB_LOCATION_LINE, &line);
+        MutexGuardPbTagMessage(&profile, MTX_GRD_PB_PROFILE_LOCATION, &message);
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    MutexGuardPbTagVarint(&profile, MTX_GRD_PB_PROFILE_TIME_NANOS, ((uint64_t)now.tv_sec * MTX_GRD_TOUT_1_SEC_AS_NS) + now.tv_nsec);
+    MutexGuardPbTagVarint(&profile, MTX_GRD_PB_PROFILE_DURATION_NANOS, (start_ns ? (MutexGuardGetMonotonicNs() - start_ns) : 0));
+
+    if(dropped_counter)
+    {
+        char dropped_comment[MTX_GRD_EXPORT_LABEL_LEN];
+        snprintf(dropped_comment, sizeof(dropped_comment), MTX_GRD_PROFILE_DROPPED_FORMAT, dropped_counter);
+        MutexGuardPbTagVarint(&profile, MTX_GRD_PB_PROFILE_COMMENT, MutexGuardProfileString(&strings, dropped_comment));
+    }
+
+    // String table goes last, once every string has been referenced.
+    for(size_t string_index = 0; string_index < strings.num; string_index++)
+    {
+        const char* string = (string_index ? strings.strings[string_index] : "");
+        MutexGuardPbTagBytes(&profile, MTX_GRD_PB_PROFILE_STRING_TABLE, string, strlen(string));
+        free(strings.strings[string_index]);
+    }
+
+    bool alloc_error = (!addresses || !function_names || strings.error || profile.error || message.error || packed.error);
+
+    int ret_write = (alloc_error ? 0 : MutexGuardDumpWrite(fd, (const char*)profile.data, profile.len));
+    int write_errno = errno;
+
+    free(strings.strings);
+    free(profile.data);
+    free(message.data);
+    free(packed.data);
+    free(function_names);
+    free(addresses);
+    free(stacks);
+
+    if(alloc_error)
+    {
+        mutex_guard_lock_error_code = ENOMEM;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return -2;
+    }
+
+    if(ret_write)
+    {
+        mutex_guard_lock_error_code = write_errno;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return -1;
+    }
+
+    return stack_num;
+}
+
+/// @brief Appends an event to the trace ring (overwriting the oldest one if full). Lock-free, as it is called from lockers.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param type Event type (waiting for or holding the guard).
+/// @param start_ns Event start time.
+/// @param end_ns Event end time.
+/// @param flow_in_id Handoff the event ends (0 if none).
+/// @param flow_out_id Handoff the event starts (0 if none).
+static void MutexGuardTraceRecord(  const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard ,
+                                    const uint8_t type                                  ,
+                                    const uint64_t start_ns                             ,
+                                    const uint64_t end_ns                               ,
+                                    const uint64_t flow_in_id                           ,
+                                    const uint64_t flow_out_id                          )
+{
+    MTX_GRD_TRACE_EVENT* trace_ring = __atomic_load_n(&trace_events, __ATOMIC_ACQUIRE);
+
+    if(!trace_ring)
+        return;
+
+    uint64_t event_index            = __atomic_fetch_add(&trace_next_index, 1, __ATOMIC_RELAXED);
+    MTX_GRD_TRACE_EVENT* p_event    = &trace_ring[event_index % __MTX_GRD_TRACE_EVENT_NUM__];
+
+    // Readers skip events whose sequence changed (or is 0) while they were copying them.
+    __atomic_store_n(&p_event->sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    p_event->type           = type;
+    p_event->kernel_tid     = MutexGuardGetKernelTid();
+    p_event->guard          = p_mutex_guard;
+    p_event->start_ns       = start_ns;
+    p_event->end_ns         = end_ns;
+    p_event->flow_in_id     = flow_in_id;
+    p_event->flow_out_id    = flow_out_id;
+    memcpy(p_event->name, p_mutex_guard->name, sizeof(p_event->name));
+    p_event->name[sizeof(p_event->name) - 1] = 0;
+
+    __atomic_store_n(&p_event->sequence, event_index + 1, __ATOMIC_RELEASE);
+}
+
+/// @brief Enables or disables lock timeline tracing. While enabled, waits for and holds of every guard are recorded into a ring
+/// of the latest __MTX_GRD_TRACE_EVENT_NUM__ events. Enabling it clears previous events.
+/// @param enable Tells whether tracing is meant to be enabled.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardSetTracing(const bool enable)
+{
+    pthread_mutex_lock(&trace_mutex);
+
+    if(enable && !trace_enabled)
+    {
+        // The ring is allocated once and never released, as lockers may still be writing into it after tracing is disabled.
+        if(!trace_ring_storage)
+            trace_ring_storage = calloc(__MTX_GRD_TRACE_EVENT_NUM__, sizeof(MTX_GRD_TRACE_EVENT));
+
+        if(!trace_ring_storage)
+        {
+            pthread_mutex_unlock(&trace_mutex);
+
+            mutex_guard_lock_error_code = ENOMEM;
+            mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+            return -1;
+        }
+
+        for(size_t event_index = 0; event_index < __MTX_GRD_TRACE_EVENT_NUM__; event_index++)
+            __atomic_store_n(&trace_ring_storage[event_index].sequence, 0, __ATOMIC_RELAXED);
+
+        __atomic_store_n(&trace_next_index, 0, __ATOMIC_RELAXED);
+    }
+
+    trace_enabled = enable;
+    __atomic_store_n(&trace_events, (enable ? trace_ring_storage : NULL), __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&trace_mutex);
+
+    return 0;
+}
+
+/// @brief Appends a nanosecond timestamp as trace event microseconds.
+/// @param p_writer Pointer to target writer.
+/// @param key JSON key.
+/// @param time_ns Time in nanoseconds.
+static void MutexGuardTraceAppendTime(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const char* C_MUTEX_GUARD_RESTRICT key, const uint64_t time_ns)
+{
+    MutexGuardExportAppend(p_writer, ",\"%s\":%llu.%03llu", key, (unsigned long long)(time_ns / MTX_GRD_TRACE_1_US_AS_NS), (unsigned long long)(time_ns % MTX_GRD_TRACE_1_US_AS_NS));
+}
+
+/// @brief Appends a guard's span (and its handoff flow events, if any) to the trace.
+/// @param p_writer Pointer to target writer.
+/// @param p_event Pointer to target event.
+/// @param pid Process ID.
+static void MutexGuardTraceAppendEvent(MTX_GRD_EXPORT_WRITER* C_MUTEX_GUARD_RESTRICT p_writer, const MTX_GRD_TRACE_EVENT* C_MUTEX_GUARD_RESTRICT p_event, const pid_t pid)
+{
+    MutexGuardExportAppend(p_writer, ",\n{\"name\":\"%s ", ((p_event->type == MTX_GRD_TRACE_EVENT_WAIT) ? MTX_GRD_TRACE_WAIT_NAME : MTX_GRD_TRACE_HOLD_NAME));
+
+    if(p_event->name[0])
+        MutexGuardExportAppendEscaped(p_writer, p_event->name);
+    else
+        MutexGuardExportAppend(p_writer, "%p", p_event->guard);
+
+    MutexGuardExportAppend(p_writer, "\",\"cat\":\"" MTX_GRD_TRACE_CATEGORY "\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d", pid, p_event->kernel_tid);
+    MutexGuardTraceAppendTime(p_writer, "ts", p_event->start_ns);
+    MutexGuardTraceAppendTime(p_writer, "dur", p_event->end_ns - p_event->start_ns);
+    MutexGuardExportAppend(p_writer, ",\"args\":{\"guard\":\"%p\"}}", p_event->guard);
+
+    // The flow starts right before the hold ends, so that it is bound to the hold's slice rather than to whatever follows it.
+    if(p_event->flow_out_id)
+    {
+        MutexGuardExportAppend(p_writer, ",\n{\"name\":\"" MTX_GRD_TRACE_FLOW_NAME "\",\"cat\":\"" MTX_GRD_TRACE_CATEGORY "\",\"ph\":\"s\",\"id\":%llu,\"pid\":%d,\"tid\":%d", (unsigned long long)p_event->flow_out_id, pid, p_event->kernel_tid);
+        MutexGuardTraceAppendTime(p_writer, "ts", ((p_event->end_ns > p_event->start_ns) ? (p_event->end_ns - 1) : p_event->end_ns));
+        MutexGuardExportAppend(p_writer, "}");
+    }
+
+    if(p_event->flow_in_id)
+    {
+        MutexGuardExportAppend(p_writer, ",\n{\"name\":\"" MTX_GRD_TRACE_FLOW_NAME "\",\"cat\":\"" MTX_GRD_TRACE_CATEGORY "\",\"ph\":\"f\",\"bp\":\"e\",\"id\":%llu,\"pid\":%d,\"tid\":%d", (unsigned long long)p_event->flow_in_id, pid, p_event->kernel_tid);
+        MutexGuardTraceAppendTime(p_writer, "ts", p_event->start_ns);
+        MutexGuardExportAppend(p_writer, "}");
+    }
+}
+
+/// @brief Writes the traced lock timeline as Chrome trace event JSON (loadable by Perfetto or chrome://tracing): a track per thread,
+/// "waiting for" and "holding" spans per guard, and flow arrows from every release to the next owner's acquisition.
+/// @param fd Target file descriptor.
+/// @return Number of spans written if succeeded, < 0 otherwise.
+int MutexGuardWriteTrace(const int fd)
+{
+    MTX_GRD_EXPORT_WRITER writer;
+
+    writer.fd           = fd;
+    writer.error        = 0;
+    writer.len          = 0;
+    writer.buffer[0]    = 0;
+    writer.to_snapshot  = false;
+
+    pid_t pid = MutexGuardGetProcessId();
+
+    MutexGuardExportAppend(&writer, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    MutexGuardExportAppend(&writer, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"" MTX_GRD_TRACE_CATEGORY " %d\"}}", pid, pid);
+
+    pthread_mutex_lock(&trace_mutex);
+
+    MTX_GRD_TRACE_EVENT* trace_ring = trace_ring_storage;
+    uint64_t next_index             = __atomic_load_n(&trace_next_index, __ATOMIC_ACQUIRE);
+    uint64_t first_index            = ((next_index > __MTX_GRD_TRACE_EVENT_NUM__) ? (next_index - __MTX_GRD_TRACE_EVENT_NUM__) : 0);
+    int span_counter                = 0;
+
+    for(uint64_t event_index = first_index; trace_ring && (event_index < next_index); event_index++)
+    {
+        MTX_GRD_TRACE_EVENT* p_ring_event = &trace_ring[event_index % __MTX_GRD_TRACE_EVENT_NUM__];
+        MTX_GRD_TRACE_EVENT event;
+
+        uint64_t sequence = __atomic_load_n(&p_ring_event->sequence, __ATOMIC_ACQUIRE);
+        memcpy(&event, p_ring_event, sizeof(MTX_GRD_TRACE_EVENT));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if( (sequence != (event_index + 1)) || (__atomic_load_n(&p_ring_event->sequence, __ATOMIC_RELAXED) != sequence) )
+            continue;
+
+        MutexGuardTraceAppendEvent(&writer, &event, pid);
+        ++span_counter;
+    }
+
+    pthread_mutex_unlock(&trace_mutex);
+
+    MutexGuardExportAppend(&writer, "\n]}\n");
+    MutexGuardExportFlush(&writer);
+
+    if(writer.error)
+    {
+        mutex_guard_lock_error_code = writer.error;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return -1;
+    }
+
+    return span_counter;
+}
+
+/// @brief Runs operations published on a guard through MutexGuardExecute, oldest first. Meant to be called by the guard's owner right
+/// before releasing it. Passes are bounded, so that a steady flow of publishers cannot keep the owner from releasing it.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+static void MutexGuardCombine(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+{
+    for(unsigned int pass_index = 0; pass_index < MTX_GRD_COMBINE_PASS_NUM; pass_index++)
+    {
+        MTX_GRD_COMBINE_SLOT* p_slot    = __atomic_exchange_n(&p_mtx_grd->combine_head, NULL, __ATOMIC_ACQUIRE);
+        MTX_GRD_COMBINE_SLOT* p_batch   = NULL;
+
+        if(!p_slot)
+            break;
+
+        // Slots are pushed in front, so the batch is reversed to run them in publishing order.
+        while(p_slot)
+        {
+            MTX_GRD_COMBINE_SLOT* p_next_slot = p_slot->next;
+
+            p_slot->next    = p_batch;
+            p_batch         = p_slot;
+            p_slot          = p_next_slot;
+        }
+
+        // Operations are accounted as acquisitions from their own calling sites, as if their publishers had locked the guard.
+        if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        uint64_t now_ns     = MutexGuardGetMonotonicNs();
+        uint64_t slow_ns    = __atomic_load_n(&sampling_slow_ns, __ATOMIC_RELAXED);
+
+        for(p_slot = p_batch; p_slot; p_slot = p_slot->next)
+        {
+            // Publishers which got the guard by themselves have already been accounted as owners.
+            if(p_slot->accounted)
+                continue;
+
+            uint64_t wait_ns            = ((now_ns > p_slot->publish_ns) ? (now_ns - p_slot->publish_ns) : 0);
+            unsigned int stats_weight   = ((slow_ns && (wait_ns >= slow_ns)) ? 1 : MutexGuardSampleWeight(p_mtx_grd));
+
+            MTX_GRD_PROBE5(lock__acquire, p_mtx_grd, p_slot->address, MTX_GRD_LOCK_TYPE_PERMANENT, wait_ns, 0);
+
+            if(stats_weight)
+                MutexGuardRecordAcquisition(p_mtx_grd, p_slot->address, true, wait_ns, stats_weight);
+        }
+
+        if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        for(p_slot = p_batch; p_slot; p_slot = p_slot->next)
+            p_slot->fn(p_slot->arg);
+
+        // Publishers that went to sleep do not leave (nor do their stack frames) until they have acquired the ctrl_mutex after being woken up.
+        if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        while(p_batch)
+        {
+            p_slot  = p_batch;
+            p_batch = p_slot->next;
+
+            if(__atomic_exchange_n(&p_slot->state, MTX_GRD_COMBINE_SLOT_DONE, __ATOMIC_RELEASE) == MTX_GRD_COMBINE_SLOT_SLEEPING)
+                MutexGuardFutexWake(&p_slot->state, 1);
+        }
+
+        if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+    }
+}
+
+/// @brief Unlocks target mutex, running operations published through MutexGuardExecute first if it is actually about to be released.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param address Address in which the guard is being unlocked.
+/// @param p_combine_pending Pointer to the flag telling whether operations were published right before the guard was released
+/// (see MutexGuardCombineHandoff).
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardRelease(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void* C_MUTEX_GUARD_RESTRICT address, bool* C_MUTEX_GUARD_RESTRICT p_combine_pending)
+{
+    *p_combine_pending = false;
+
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(p_mtx_grd->mutex_acq_location.thread_id == 0)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NOT_LOCKED;
+        return -2;
+    }
+
+    if(!MutexGuardIsOwner(p_mtx_grd))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INVALID_OWNER_TID;
+        return -3;
+    }
+
+    if( (p_mtx_grd->lock_counter == 1) && __atomic_load_n(&p_mtx_grd->combine_head, __ATOMIC_ACQUIRE) )
+        MutexGuardCombine(p_mtx_grd);
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    int ret_unlock = ((p_mtx_grd->lock_counter == 1) ? MutexGuardUnlockAndWake(p_mtx_grd) : pthread_mutex_unlock(&p_mtx_grd->mutex));
+    
+    if(ret_unlock)
+    {
+        mutex_guard_lock_error_code = ret_unlock;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        
+        if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        return ret_unlock;
+    }
+
+    mutex_guard_lock_error_code = 0;
+
+    MutexGuardRemoveLatestAddress(p_mtx_grd);
+
+    if(p_mtx_grd->lock_counter > 0)
+        --p_mtx_grd->lock_counter;
+    else
+        mutex_guard_errno = MTX_GRD_ERR_OUT_OF_ADDR_COUNTER_BOUNDARIES;
+
+    if(verbosity_level & MTX_GRD_VERBOSITY_BT)
+        MutexGuardShowBacktrace(&p_mtx_grd->mutex, false);
+
+    if(!p_mtx_grd->lock_counter)
+    {
+        uint64_t hold_ns = MutexGuardRecordHoldEnd(p_mtx_grd);
+        MTX_GRD_PROBE3(release, p_mtx_grd, address, hold_ns);
+
+        memset(&p_mtx_grd->mutex_acq_location, 0, sizeof(MTX_GRD_ACQ_LOCATION));
+        MutexGuardWakeRequeuedCondWaiter(p_mtx_grd);
+
+        // Publishers push their operations with the ctrl_mutex held: any later one finds the guard released by itself.
+        *p_combine_pending = (__atomic_load_n(&p_mtx_grd->combine_head, __ATOMIC_RELAXED) != NULL);
+    }
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+    
+    return ret_unlock;
+}
+
+/// @brief Hands pending operations over after a guard was released with operations published right before (found under its ctrl_mutex
+/// along with the release). Their publishers may have found it held, and then sleep until their operations are done: the releasing
+/// thread takes it back to run them, unless another thread already got it (and will run them itself). Guards released with nothing
+/// pending are never touched again, as they may be destroyed right away; those with pending operations are kept alive by their
+/// publishers, still waiting within MutexGuardExecute.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param address Address in which the guard was unlocked.
+static void MutexGuardCombineHandoff(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void* C_MUTEX_GUARD_RESTRICT address)
+{
+    bool combine_pending = true;
+
+    while(combine_pending)
+    {
+        if(pthread_mutex_trylock(&p_mtx_grd->mutex))
+            return;
+
+        MutexGuardRecordLocked(p_mtx_grd, address, 0, false, 0, 0, 0, NULL, 0);
+
+        if(MutexGuardRelease(p_mtx_grd, address, &combine_pending))
+            return;
+    }
+}
+
+/// @brief Runs (or drops) the calling thread's work deferred until target guard was released. Works are taken off the queue
+/// beforehand, so that they may queue further ones.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param run Whether works are run, rather than dropped.
+static void MutexGuardRunDeferredWork(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const bool run)
+{
+    MTX_GRD_DEFERRED_WORK works[__MTX_GRD_DEFER_NUM__];
+    size_t work_num         = 0;
+    size_t kept_work_num    = 0;
+
+    for(size_t work_index = 0; work_index < deferred_work_num; work_index++)
+    {
+        if(deferred_works[work_index].p_mtx_grd == p_mtx_grd)
+            works[work_num++] = deferred_works[work_index];
+        else
+            deferred_works[kept_work_num++] = deferred_works[work_index];
+    }
+
+    deferred_work_num = kept_work_num;
+
+    for(size_t work_index = 0; run && (work_index < work_num); work_index++)
+        works[work_index].fn(works[work_index].arg);
+}
+
+/// @brief Unlocks target mutex and hands over operations published meanwhile, then runs deferred work, if it was released. Deferred
+/// work is dropped if it could not be released, so that it never outlives its guard.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param address Address in which the guard is being unlocked.
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardUnlockAddr(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void* C_MUTEX_GUARD_RESTRICT address)
+{
+    bool releasing          = (p_mtx_grd && (p_mtx_grd->lock_counter == 1));
+    bool combine_pending    = false;
+    int ret_unlock          = MutexGuardRelease(p_mtx_grd, address, &combine_pending);
+
+    if(!ret_unlock && releasing)
+    {
+        if(combine_pending)
+            MutexGuardCombineHandoff(p_mtx_grd, address);
+
+        if(deferred_work_num)
+            MutexGuardRunDeferredWork(p_mtx_grd, true);
+    }
+    else if(ret_unlock && releasing && deferred_work_num)
+        MutexGuardRunDeferredWork(p_mtx_grd, false);
+
+    return ret_unlock;
+}
+
+/// @brief Unlocks target mutex.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @return 0 if succeeded, != 0 otherwise.
+int MutexGuardUnlock(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+{
+    return MutexGuardUnlockAddr(p_mtx_grd, __builtin_return_address(0));
+}
+
+/// @brief Queues work to be run by the calling thread once it releases target guard.
+/// @param p_mtx_grd Pointer to mutex guard structure (locked by the calling thread).
+/// @param fn Work to be run.
+/// @param arg Work's argument.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardDeferAfterUnlock(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void (*fn)(void*), void* arg)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!fn)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_OPERATION;
+        return -2;
+    }
+
+    if(!MutexGuardIsOwner(p_mtx_grd))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NOT_LOCKED;
+        return -3;
+    }
+
+    if(deferred_work_num >= __MTX_GRD_DEFER_NUM__)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_DEFER_QUEUE_FULL;
+        return -4;
+    }
+
+    deferred_works[deferred_work_num].p_mtx_grd = p_mtx_grd;
+    deferred_works[deferred_work_num].fn        = fn;
+    deferred_works[deferred_work_num].arg       = arg;
+    ++deferred_work_num;
+
+    return 0;
+}
+
+/// @brief Records an acquisition of target guard made by an external locking scheme, without locking its mutex.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param address Address in which the guard was acquired.
+/// @param wait_ns Time the new owner spent waiting for the guard (0 if it did not).
+/// @return 0 if succeeded, < 0 if arguments are invalid, EBUSY if the guard is already recorded as held.
+int MutexGuardExternalAcquired(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void* C_MUTEX_GUARD_RESTRICT address, const uint64_t wait_ns)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    bool held = (p_mtx_grd->mutex_acq_location.thread_id != 0);
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    if(held)
+    {
+        mutex_guard_errno           = MTX_GRD_ERR_LOCK_ERROR;
+        mutex_guard_lock_error_code = EBUSY;
+        return EBUSY;
+    }
+
+    uint64_t now_ns = (wait_ns ? MutexGuardGetMonotonicNs() : 0);
+
+    MutexGuardRecordLocked(p_mtx_grd, address, 0, (wait_ns != 0), now_ns - wait_ns, wait_ns, MutexGuardSampleWeight(p_mtx_grd), NULL, 0);
+
+    return 0;
+}
+
+/// @brief Records the release of target guard by an external locking scheme, from any thread.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardExternalReleased(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    bool held = (p_mtx_grd->mutex_acq_location.thread_id != 0);
+
+    if(held)
+    {
+        uint64_t hold_ns = MutexGuardRecordHoldEnd(p_mtx_grd);
+        MTX_GRD_PROBE3(release, p_mtx_grd, __builtin_return_address(0), hold_ns);
+
+        memset(&p_mtx_grd->mutex_acq_location, 0, sizeof(MTX_GRD_ACQ_LOCATION));
+        p_mtx_grd->lock_counter = 0;
+    }
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    if(!held)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NOT_LOCKED;
+        return -2;
+    }
+
+    if(deferred_work_num)
+        MutexGuardRunDeferredWork(p_mtx_grd, true);
+
+    return 0;
+}
+
+/// @brief Makes an asynchronous lock request's descriptor readable.
+/// @param p_waiter Pointer to target request.
+static void MutexGuardAsyncSignal(const MTX_GRD_ASYNC_WAITER* C_MUTEX_GUARD_RESTRICT p_waiter)
+{
+    if(p_waiter->timed)
+    {
+        // Its deadline no longer matters: the timer is made to expire right away.
+        struct itimerspec expiration = { .it_interval = { 0, 0 }, .it_value = { 0, 1 } };
+
+        if(timerfd_settime(p_waiter->fd, 0, &expiration, NULL))
+            mutex_guard_errno = MTX_GRD_ERR_STD_ERROR_CODE;
+    }
+    else
+    {
+        uint64_t event = 1;
+
+        if(write(p_waiter->fd, &event, sizeof(event)) != sizeof(event))
+            mutex_guard_errno = MTX_GRD_ERR_STD_ERROR_CODE;
+    }
+}
+
+/// @brief Wakes up the asynchronous lock request a guard is granted to (with its ctrl_mutex held), granting it to the first queued
+/// request if none is.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+static void MutexGuardAsyncWakeGranted(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+{
+    MTX_GRD_ASYNC_WAITER* p_waiter = p_mtx_grd->async_granted;
+
+    if(!p_waiter)
+    {
+        p_waiter = p_mtx_grd->async_head;
+
+        if(!p_waiter)
+            return;
+
+        p_mtx_grd->async_head = p_waiter->next;
+
+        if(!p_mtx_grd->async_head)
+            p_mtx_grd->async_tail = NULL;
+
+        p_waiter->next              = NULL;
+        p_mtx_grd->async_granted    = p_waiter;
+    }
+
+    // Signaled with the ctrl_mutex held, so that the request cannot be withdrawn (and its descriptor closed) meanwhile.
+    MutexGuardAsyncSignal(p_waiter);
+}
+
+/// @brief Unlocks a guard's mutex on its final release (with its ctrl_mutex held), then wakes up the asynchronous lock request it
+/// is granted to, which takes the mutex itself (see MutexGuardLockAsyncComplete).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @return 0 if succeeded, > 0 (standard error code) otherwise.
+static int MutexGuardUnlockAndWake(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+{
+    int ret_unlock = pthread_mutex_unlock(&p_mtx_grd->mutex);
+
+    if(!ret_unlock)
+        MutexGuardAsyncWakeGranted(p_mtx_grd);
+
+    return ret_unlock;
+}
+
+/// @brief Looks an asynchronous lock request up by its descriptor (with the guard's ctrl_mutex held).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param fd Request's descriptor.
+/// @param pp_previous Pointer to where the request preceding it in the queue is provided (NULL if first or granted the guard).
+/// @return Pointer to the request if found, NULL otherwise.
+static MTX_GRD_ASYNC_WAITER* MutexGuardAsyncFind(   MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd               ,
+                                                    const int fd                                            ,
+                                                    MTX_GRD_ASYNC_WAITER** C_MUTEX_GUARD_RESTRICT pp_previous )
+{
+    *pp_previous = NULL;
+
+    if(p_mtx_grd->async_granted && (p_mtx_grd->async_granted->fd == fd))
+        return p_mtx_grd->async_granted;
+
+    for(MTX_GRD_ASYNC_WAITER* p_waiter = p_mtx_grd->async_head; p_waiter; p_waiter = p_waiter->next)
+    {
+        if(p_waiter->fd == fd)
+            return p_waiter;
+
+        *pp_previous = p_waiter;
+    }
+
+    return NULL;
+}
+
+/// @brief Takes a queued asynchronous lock request off its guard's queue (with the guard's ctrl_mutex held).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_waiter Pointer to target request.
+/// @param p_previous Pointer to the request preceding it (NULL if first).
+static void MutexGuardAsyncDequeue(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, MTX_GRD_ASYNC_WAITER* p_waiter, MTX_GRD_ASYNC_WAITER* p_previous)
+{
+    if(p_previous)
+        p_previous->next = p_waiter->next;
+    else
+        p_mtx_grd->async_head = p_waiter->next;
+
+    if(p_mtx_grd->async_tail == p_waiter)
+        p_mtx_grd->async_tail = p_previous;
+}
+
+/// @brief Drops every asynchronous lock request of a guard being destroyed (with its ctrl_mutex held), making their descriptors
+/// readable. Descriptors are left open: they may still be in their owners' poll sets, and are closed by them.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+static void MutexGuardAsyncDrop(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+{
+    if(p_mtx_grd->async_granted)
+    {
+        p_mtx_grd->async_granted->next  = p_mtx_grd->async_head;
+        p_mtx_grd->async_head           = p_mtx_grd->async_granted;
+    }
+
+    while(p_mtx_grd->async_head)
+    {
+        MTX_GRD_ASYNC_WAITER* p_waiter = p_mtx_grd->async_head;
+
+        p_mtx_grd->async_head = p_waiter->next;
+        MutexGuardAsyncSignal(p_waiter);
+        free(p_waiter);
+    }
+
+    p_mtx_grd->async_tail       = NULL;
+    p_mtx_grd->async_granted    = NULL;
+}
+
+/// @brief Makes a timed asynchronous lock request's descriptor readable again once its deadline is reached.
+/// @param p_waiter Pointer to target request.
+/// @param now_ns Current monotonic time (in nanoseconds).
+static void MutexGuardAsyncRearm(const MTX_GRD_ASYNC_WAITER* C_MUTEX_GUARD_RESTRICT p_waiter, const uint64_t now_ns)
+{
+    uint64_t remaining_ns = ((p_waiter->deadline_ns > now_ns) ? (p_waiter->deadline_ns - now_ns) : 1);
+    struct itimerspec deadline = { .it_interval = { 0, 0 }, .it_value = { (time_t)(remaining_ns / 1000000000ULL), (long)(remaining_ns % 1000000000ULL) } };
+
+    if(timerfd_settime(p_waiter->fd, 0, &deadline, NULL))
+        mutex_guard_errno = MTX_GRD_ERR_STD_ERROR_CODE;
+}
+
+/// @brief Locks target guard without blocking, or queues the caller up and provides a descriptor which becomes readable once the
+/// guard is released for it.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param address Address in which the guard is being locked.
+/// @param timeout_ns Time after which the descriptor becomes readable anyway (in nanoseconds, 0 to wait forever).
+/// @param p_fd Pointer to where the descriptor is provided (-1 if the guard was locked right away).
+/// @return 0 if locked right away, EINPROGRESS if queued up, < 0 if arguments are invalid, > 0 (standard error code) otherwise.
+int MutexGuardLockAsync(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void* C_MUTEX_GUARD_RESTRICT address, const uint64_t timeout_ns, int* C_MUTEX_GUARD_RESTRICT p_fd)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!p_fd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
+    }
+
+    *p_fd = -1;
+
+    if(!p_mtx_grd->async_capable)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_ASYNC_UNSUPPORTED;
+        return -3;
+    }
+
+    // The guard would never be released for a request queued up by its owner.
+    if(MutexGuardIsOwner(p_mtx_grd))
+    {
+        mutex_guard_lock_error_code = EDEADLK;
+        mutex_guard_errno           = MTX_GRD_ERR_LOCK_ERROR;
+        return EDEADLK;
+    }
+
+    MTX_GRD_PROBE4(lock__attempt, p_mtx_grd, address, MTX_GRD_LOCK_TYPE_TRY, timeout_ns);
+
+    unsigned int sample_weight = MutexGuardSampleWeight(p_mtx_grd);
+
+    if(!pthread_mutex_trylock(&p_mtx_grd->mutex))
+    {
+        MTX_GRD_PROBE5(lock__acquire, p_mtx_grd, address, MTX_GRD_LOCK_TYPE_TRY, 0, 0);
+        MutexGuardRecordLocked(p_mtx_grd, address, 0, false, 0, 0, sample_weight, NULL, 0);
+        return 0;
+    }
+
+    // Taken before the timer is armed, so that the deadline is never seen later than the timer expires.
+    uint64_t wait_start_ns          = MutexGuardGetMonotonicNs();
+    MTX_GRD_ASYNC_WAITER* p_waiter  = calloc(1, sizeof(MTX_GRD_ASYNC_WAITER));
+    int fd = (timeout_ns ? timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC) : eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+
+    if(timeout_ns && (fd >= 0))
+    {
+        struct itimerspec deadline = { .it_interval = { 0, 0 }, .it_value = { (time_t)(timeout_ns / 1000000000ULL), (long)(timeout_ns % 1000000000ULL) } };
+
+        if(timerfd_settime(fd, 0, &deadline, NULL))
+        {
+            close(fd);
+            fd = -1;
+        }
+    }
+
+    if(!p_waiter || (fd < 0))
+    {
+        int ret_setup = (p_waiter ? errno : ENOMEM);
+
+        if(fd >= 0)
+            close(fd);
+
+        free(p_waiter);
+
+        mutex_guard_lock_error_code = ret_setup;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return ret_setup;
+    }
+
+    p_waiter->fd            = fd;
+    p_waiter->timed         = (timeout_ns != 0);
+    p_waiter->address       = address;
+    p_waiter->wait_start_ns = wait_start_ns;
+    p_waiter->deadline_ns   = wait_start_ns + timeout_ns;
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    // Tried again with the ctrl_mutex held, under which the guard is released: either it is got here, or its release finds the request.
+    if(!pthread_mutex_trylock(&p_mtx_grd->mutex))
+    {
+        MTX_GRD_PROBE5(lock__acquire, p_mtx_grd, address, MTX_GRD_LOCK_TYPE_TRY, 0, 0);
+        MutexGuardRecordLocked(p_mtx_grd, address, 0, false, 0, 0, sample_weight, NULL, 0);
+
+        if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        close(fd);
+        free(p_waiter);
+        return 0;
+    }
+
+    if(p_mtx_grd->async_tail)
+        p_mtx_grd->async_tail->next = p_waiter;
+    else
+        p_mtx_grd->async_head = p_waiter;
+
+    p_mtx_grd->async_tail = p_waiter;
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    *p_fd = fd;
+
+    return EINPROGRESS;
+}
+
+/// @brief Completes an asynchronous lock request whose descriptor became readable.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param fd Request's descriptor.
+/// @return 0 if the guard is locked by the calling thread, ETIMEDOUT if the request timed out, EINPROGRESS if it is still queued
+/// up, < 0 if arguments are invalid.
+int MutexGuardLockAsyncComplete(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const int fd)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    MTX_GRD_ASYNC_WAITER* p_previous;
+    MTX_GRD_ASYNC_WAITER* p_waiter = MutexGuardAsyncFind(p_mtx_grd, fd, &p_previous);
+
+    if(!p_waiter)
+    {
+        if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        mutex_guard_errno = MTX_GRD_ERR_ASYNC_UNKNOWN_REQUEST;
+        return -2;
+    }
+
+    // Drained, so that it only becomes readable again on the guard's next release or once timed out.
+    uint64_t event_num = 0;
+
+    if( (read(fd, &event_num, sizeof(event_num)) < 0) && (errno != EAGAIN) )
+        mutex_guard_errno = MTX_GRD_ERR_STD_ERROR_CODE;
+
+    bool granted        = (p_waiter == p_mtx_grd->async_granted);
+    uint64_t now_ns     = MutexGuardGetMonotonicNs();
+    int ret_complete    = EINPROGRESS;
+
+    // Released for the request, the mutex is taken by this thread: a blocked locker may have got it first, whose release wakes the
+    // request up again.
+    if(granted && !pthread_mutex_trylock(&p_mtx_grd->mutex))
+    {
+        uint64_t wait_ns = now_ns - p_waiter->wait_start_ns;
+
+        p_mtx_grd->async_granted = NULL;
+
+        MTX_GRD_PROBE5(lock__acquire, p_mtx_grd, p_waiter->address, MTX_GRD_LOCK_TYPE_PERMANENT, wait_ns, 0);
+        MutexGuardRecordLocked(p_mtx_grd, p_waiter->address, 0, true, p_waiter->wait_start_ns, wait_ns, MutexGuardSampleWeight(p_mtx_grd), NULL, 0);
+
+        ret_complete = 0;
+    }
+    else if(p_waiter->timed && (now_ns >= p_waiter->deadline_ns))
+    {
+        if(granted)
+        {
+            p_mtx_grd->async_granted = NULL;
+            MutexGuardAsyncWakeGranted(p_mtx_grd);
+        }
+        else
+            MutexGuardAsyncDequeue(p_mtx_grd, p_waiter, p_previous);
+
+        MTX_GRD_PROBE4(lock__timeout, p_mtx_grd, p_waiter->address, MTX_GRD_LOCK_TYPE_TIMED, now_ns - p_waiter->wait_start_ns);
+        __atomic_add_fetch(&MutexGuardGetStatsShard(p_mtx_grd, true)->failure_counter, 1, __ATOMIC_RELAXED);
+
+        mutex_guard_lock_error_code = ETIMEDOUT;
+        mutex_guard_errno           = MTX_GRD_ERR_LOCK_ERROR;
+        ret_complete                = ETIMEDOUT;
+    }
+    else if(p_waiter->timed)
+        MutexGuardAsyncRearm(p_waiter, now_ns);
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    if(ret_complete != EINPROGRESS)
+    {
+        close(fd);
+        free(p_waiter);
+    }
+
+    return ret_complete;
+}
+
+/// @brief Withdraws an asynchronous lock request and closes its descriptor (waking the next request up if it was granted the guard).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param fd Request's descriptor.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardLockAsyncCancel(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const int fd)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    MTX_GRD_ASYNC_WAITER* p_previous;
+    MTX_GRD_ASYNC_WAITER* p_waiter = MutexGuardAsyncFind(p_mtx_grd, fd, &p_previous);
+
+    if(p_waiter && (p_waiter == p_mtx_grd->async_granted))
+    {
+        p_mtx_grd->async_granted = NULL;
+        MutexGuardAsyncWakeGranted(p_mtx_grd);
+    }
+    else if(p_waiter)
+        MutexGuardAsyncDequeue(p_mtx_grd, p_waiter, p_previous);
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    if(!p_waiter)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_ASYNC_UNKNOWN_REQUEST;
+        return -2;
+    }
+
+    close(fd);
+    free(p_waiter);
+
+    return 0;
+}
+
+/// @brief Runs a batch of operations found pending in a guard's mailboxes, with the guard locked, and marks them done.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param batch Mailboxes holding pending operations.
+/// @param batch_num Number of mailboxes within the batch.
+static void MutexGuardDelegationRunBatch(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, MTX_GRD_MAILBOX** batch, const size_t batch_num)
+{
+    MTX_GRD_DELEGATION* p_delegation = p_mtx_grd->delegation;
+    uint64_t latencies_ns[__MTX_GRD_DELEGATION_CLIENT_NUM__];
+    void* address = batch[0]->address;
+
+    // Direct lockers are excluded as usual: the server holds the guard like any of them (showing the first operation's calling site).
+    if(pthread_mutex_lock(&p_mtx_grd->mutex))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_LOCK_ERROR;
+        return;
+    }
+
+    MutexGuardRecordLocked(p_mtx_grd, address, 0, false, 0, 0, 0, NULL, 0);
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    for(size_t batch_index = 0; batch_index < batch_num; batch_index++)
+    {
+        unsigned int stats_weight = MutexGuardSampleWeight(p_mtx_grd);
+
+        MTX_GRD_PROBE5(lock__acquire, p_mtx_grd, batch[batch_index]->address, MTX_GRD_LOCK_TYPE_PERMANENT, 0, 0);
+
+        if(stats_weight)
+            MutexGuardRecordAcquisition(p_mtx_grd, batch[batch_index]->address, false, 0, stats_weight);
+    }
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    for(size_t batch_index = 0; batch_index < batch_num; batch_index++)
+    {
+        MTX_GRD_MAILBOX* p_mailbox = batch[batch_index];
+
+        p_mailbox->fn(p_mailbox->arg);
+        latencies_ns[batch_index] = MutexGuardGetMonotonicNs() - p_mailbox->submit_ns;
+    }
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    MTX_GRD_DELEGATION_STATS* p_stats = &p_delegation->stats;
+
+    p_stats->request_counter    += batch_num;
+    p_stats->queue_depth_total  += batch_num;
+    ++p_stats->batch_counter;
+
+    if(batch_num > p_stats->queue_depth_max)
+        p_stats->queue_depth_max = batch_num;
+
+    for(size_t batch_index = 0; batch_index < batch_num; batch_index++)
+    {
+        p_stats->latency_ns_total += latencies_ns[batch_index];
+        ++p_stats->latency_histogram[MutexGuardHistBucket(latencies_ns[batch_index])];
+
+        if(latencies_ns[batch_index] > p_stats->latency_ns_max)
+            p_stats->latency_ns_max = latencies_ns[batch_index];
+    }
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    // Operations are only marked done once accounted, so that clients find them in the statistics right after they return.
+    for(size_t batch_index = 0; batch_index < batch_num; batch_index++)
+    {
+        if(__atomic_exchange_n(&batch[batch_index]->state, MTX_GRD_MAILBOX_DONE, __ATOMIC_ACQ_REL) == MTX_GRD_MAILBOX_SLEEPING)
+            MutexGuardFutexWake(&batch[batch_index]->state, 1);
+    }
+
+    MutexGuardUnlockAddr(p_mtx_grd, address);
+}
+
+/// @brief Collects operations pending in a guard's mailboxes.
+/// @param p_delegation Pointer to delegation server structure.
+/// @param batch Array where mailboxes holding pending operations are meant to be stored.
+/// @return Number of pending operations found.
+static size_t MutexGuardDelegationCollect(MTX_GRD_DELEGATION* C_MUTEX_GUARD_RESTRICT p_delegation, MTX_GRD_MAILBOX** batch)
+{
+    size_t batch_num = 0;
+
+    for(size_t mailbox_index = 0; mailbox_index < __MTX_GRD_DELEGATION_CLIENT_NUM__; mailbox_index++)
+    {
+        uint32_t state = __atomic_load_n(&p_delegation->mailboxes[mailbox_index].state, __ATOMIC_ACQUIRE);
+
+        if( (state == MTX_GRD_MAILBOX_PENDING) || (state == MTX_GRD_MAILBOX_SLEEPING) )
+            batch[batch_num++] = &p_delegation->mailboxes[mailbox_index];
+    }
+
+    return batch_num;
+}
+
+/// @brief Delegation server thread: polls a guard's mailboxes and runs the operations submitted to them, sleeping while none show up.
+/// Once stopped, it leaves as soon as there is nothing left to run.
+/// @param arg Pointer to mutex guard structure.
+/// @return NULL.
+static void* MutexGuardDelegationServer(void* arg)
+{
+    MTX_GRD* p_mtx_grd                  = (MTX_GRD*)arg;
+    MTX_GRD_DELEGATION* p_delegation    = p_mtx_grd->delegation;
+    MTX_GRD_MAILBOX* batch[__MTX_GRD_DELEGATION_CLIENT_NUM__];
+    unsigned int idle_counter           = 0;
+
+    sigset_t blocked_signals;
+    sigfillset(&blocked_signals);
+    pthread_sigmask(SIG_BLOCK, &blocked_signals, NULL);
+
+    for(;;)
+    {
+        size_t batch_num = MutexGuardDelegationCollect(p_delegation, batch);
+
+        if(batch_num)
+        {
+            idle_counter = 0;
+            MutexGuardDelegationRunBatch(p_mtx_grd, batch, batch_num);
+            continue;
+        }
+
+        if(__atomic_load_n(&p_delegation->stop, __ATOMIC_ACQUIRE))
+            break;
+
+        if( p_delegation->spin && (++idle_counter < MTX_GRD_DELEGATION_SERVER_SPIN_NUM) )
+        {
+            MTX_GRD_CPU_RELAX();
+            continue;
+        }
+
+        idle_counter = 0;
+
+        // Announce the sleep before looking once more: clients submitting from then on find it announced and ring the doorbell.
+        __atomic_store_n(&p_delegation->server_asleep, 1, __ATOMIC_SEQ_CST);
+
+        uint32_t doorbell = __atomic_load_n(&p_delegation->doorbell, __ATOMIC_SEQ_CST);
+
+        if( !MutexGuardDelegationCollect(p_delegation, batch) && !__atomic_load_n(&p_delegation->stop, __ATOMIC_ACQUIRE) )
+        {
+            if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+                mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+            ++p_delegation->stats.server_sleep_counter;
+
+            if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+                mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+            MutexGuardFutexWait(&p_delegation->doorbell, doorbell, NULL);
+        }
+
+        __atomic_store_n(&p_delegation->server_asleep, 0, __ATOMIC_RELAXED);
+    }
+
+    return NULL;
+}
+
+/// @brief Starts a delegated guard's server thread (pinned to the guard's delegation CPU, if any).
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @return 0 if succeeded, < 0 otherwise.
+static int MutexGuardDelegationStart(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    MTX_GRD_DELEGATION* p_delegation = NULL;
+
+    if(posix_memalign((void**)&p_delegation, MTX_GRD_CACHE_LINE_SIZE, sizeof(MTX_GRD_DELEGATION)))
+    {
+        mutex_guard_lock_error_code = ENOMEM;
+        return -1;
+    }
+
+    memset(p_delegation, 0, sizeof(MTX_GRD_DELEGATION));
+    p_delegation->spin = (sysconf(_SC_NPROCESSORS_ONLN) > 1);
+    p_mutex_guard->delegation = p_delegation;
+
+    pthread_attr_t server_attr;
+    pthread_attr_init(&server_attr);
+
+    if(p_mutex_guard->delegation_cpu >= 0)
+    {
+        cpu_set_t server_cpus;
+
+        CPU_ZERO(&server_cpus);
+        CPU_SET(p_mutex_guard->delegation_cpu, &server_cpus);
+        pthread_attr_setaffinity_np(&server_attr, sizeof(cpu_set_t), &server_cpus);
+    }
+
+    int ret_create = pthread_create(&p_delegation->server, &server_attr, MutexGuardDelegationServer, p_mutex_guard);
+
+    pthread_attr_destroy(&server_attr);
+
+    if(ret_create)
+    {
+        p_mutex_guard->delegation = NULL;
+        free(p_delegation);
+
+        mutex_guard_lock_error_code = ret_create;
+        return -2;
+    }
+
+    return 0;
+}
+
+/// @brief Stops a delegated guard's server thread (once it has run every submitted operation) and releases its mailboxes.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+static void MutexGuardDelegationStop(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    MTX_GRD_DELEGATION* p_delegation = p_mutex_guard->delegation;
+
+    if(!p_delegation)
+        return;
+
+    __atomic_store_n(&p_delegation->stop, 1, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&p_delegation->doorbell, 1, __ATOMIC_SEQ_CST);
+    MutexGuardFutexWake(&p_delegation->doorbell, 1);
+
+    pthread_join(p_delegation->server, NULL);
+
+    p_mutex_guard->delegation = NULL;
+    free(p_delegation);
+}
+
+/// @brief Submits an operation to a delegated guard's server and waits for it to be run.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param fn Operation to be run by the server.
+/// @param arg Operation's argument.
+/// @param address Address in which the operation was submitted.
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardDelegate(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void (*fn)(void*), void* arg, void* C_MUTEX_GUARD_RESTRICT address)
+{
+    MTX_GRD_DELEGATION* p_delegation = p_mtx_grd->delegation;
+    MTX_GRD_MAILBOX* p_mailbox;
+
+    if(delegation_client_index < 0)
+        delegation_client_index = (int)(__atomic_fetch_add(&delegation_client_counter, 1, __ATOMIC_RELAXED) % __MTX_GRD_DELEGATION_CLIENT_NUM__);
+
+    MTX_GRD_PROBE4(lock__attempt, p_mtx_grd, address, MTX_GRD_LOCK_TYPE_PERMANENT, 0);
+
+    // Threads normally keep to their own mailbox, and only look for another one while it is taken by a thread sharing it.
+    for(size_t probe_index = 0; ; probe_index++)
+    {
+        p_mailbox = &p_delegation->mailboxes[(delegation_client_index + probe_index) % __MTX_GRD_DELEGATION_CLIENT_NUM__];
+
+        uint32_t state = MTX_GRD_MAILBOX_FREE;
+
+        if( (__atomic_load_n(&p_mailbox->state, __ATOMIC_RELAXED) == MTX_GRD_MAILBOX_FREE) &&
+            __atomic_compare_exchange_n(&p_mailbox->state, &state, MTX_GRD_MAILBOX_CLAIMED, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) )
+            break;
+
+        if((probe_index % __MTX_GRD_DELEGATION_CLIENT_NUM__) == (__MTX_GRD_DELEGATION_CLIENT_NUM__ - 1))
+            sched_yield();
+    }
+
+    p_mailbox->fn           = fn;
+    p_mailbox->arg          = arg;
+    p_mailbox->address      = address;
+    p_mailbox->submit_ns    = MutexGuardGetMonotonicNs();
+
+    __atomic_store_n(&p_mailbox->state, MTX_GRD_MAILBOX_PENDING, __ATOMIC_SEQ_CST);
+
+    if(__atomic_load_n(&p_delegation->server_asleep, __ATOMIC_SEQ_CST))
+    {
+        __atomic_add_fetch(&p_delegation->doorbell, 1, __ATOMIC_SEQ_CST);
+        MutexGuardFutexWake(&p_delegation->doorbell, 1);
+    }
+
+    uint32_t state;
+
+    for(unsigned int spin_index = 0; (state = __atomic_load_n(&p_mailbox->state, __ATOMIC_ACQUIRE)) != MTX_GRD_MAILBOX_DONE; spin_index++)
+    {
+        if( p_delegation->spin && (spin_index < MTX_GRD_DELEGATION_CLIENT_SPIN_NUM) )
+        {
+            MTX_GRD_CPU_RELAX();
+            continue;
+        }
+
+        // The server only wakes clients up if they announced they were going to sleep.
+        if( (state == MTX_GRD_MAILBOX_PENDING) &&
+            !__atomic_compare_exchange_n(&p_mailbox->state, &state, MTX_GRD_MAILBOX_SLEEPING, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) )
+            continue;
+
+        MutexGuardFutexWait(&p_mailbox->state, MTX_GRD_MAILBOX_SLEEPING, NULL);
+    }
+
+    __atomic_store_n(&p_mailbox->state, MTX_GRD_MAILBOX_FREE, __ATOMIC_RELEASE);
+
+    mutex_guard_lock_error_code = 0;
+
+    return 0;
+}
+
+/// @brief Gets a delegated guard's server statistics.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_stats Pointer to the structure statistics are meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardGetDelegationStats(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, MTX_GRD_DELEGATION_STATS* C_MUTEX_GUARD_RESTRICT p_stats)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!p_stats)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
+    }
+
+    if(!p_mtx_grd->delegation)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_DELEGATION_ERROR;
+        return -3;
+    }
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    memcpy(p_stats, &p_mtx_grd->delegation->stats, sizeof(MTX_GRD_DELEGATION_STATS));
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    return 0;
+}
+
+/// @brief Runs an operation on the state protected by target guard, as if it was locked around it (flat combining).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param fn Operation to be run (possibly by another thread).
+/// @param arg Operation's argument.
+/// @return 0 if succeeded, != 0 otherwise.
+int MutexGuardExecute(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void (*fn)(void*), void* arg)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!fn)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_OPERATION;
+        return -2;
+    }
+
+    void* address = __builtin_return_address(0);
+
+    if(MutexGuardIsOwner(p_mtx_grd))
+    {
+        fn(arg);
+        return 0;
+    }
+
+    if(p_mtx_grd->delegation)
+        return MutexGuardDelegate(p_mtx_grd, fn, arg, address);
+
+    // Publishers' slots live on their stacks, which are neither reachable from other processes nor guaranteed to outlive a dead owner.
+    if(p_mtx_grd->robust || p_mtx_grd->process_shared)
+    {
+        int ret_lock = MutexGuardLock(p_mtx_grd, address, 0, MTX_GRD_LOCK_TYPE_PERMANENT);
+
+        if(ret_lock)
+            return ret_lock;
+
+        fn(arg);
+
+        return MutexGuardUnlockAddr(p_mtx_grd, address);
+    }
+
+    MTX_GRD_PROBE4(lock__attempt, p_mtx_grd, address, MTX_GRD_LOCK_TYPE_PERMANENT, 0);
+
+    unsigned int sample_weight  = MutexGuardSampleWeight(p_mtx_grd);
+    int ret_lock                = pthread_mutex_trylock(&p_mtx_grd->mutex);
+
+    if(!ret_lock)
+    {
+        MTX_GRD_PROBE5(lock__acquire, p_mtx_grd, address, MTX_GRD_LOCK_TYPE_PERMANENT, 0, 0);
+        MutexGuardRecordLocked(p_mtx_grd, address, 0, false, 0, 0, sample_weight, NULL, 0);
+
+        fn(arg);
+
+        return MutexGuardUnlockAddr(p_mtx_grd, address);
+    }
+
+    if(ret_lock != EBUSY)
+    {
+        MTX_GRD_PROBE5(lock__error, p_mtx_grd, address, MTX_GRD_LOCK_TYPE_PERMANENT, 0, ret_lock);
+
+        mutex_guard_errno           = MTX_GRD_ERR_LOCK_ERROR;
+        mutex_guard_lock_error_code = ret_lock;
+
+        __atomic_add_fetch(&MutexGuardGetStatsShard(p_mtx_grd, true)->failure_counter, 1, __ATOMIC_RELAXED);
+
+        return ret_lock;
+    }
+
+    MTX_GRD_COMBINE_SLOT slot = { .fn = fn, .arg = arg, .address = address, .accounted = false, .state = MTX_GRD_COMBINE_SLOT_PENDING };
+    MTX_GRD_ACQ_LOCATION target_mutex_acq_location;
+    void* profile_frames[__MTX_GRD_PROFILE_DEPTH__ + 1];
+    int profile_depth = 0;
+
+    slot.publish_ns = MutexGuardGetMonotonicNs();
+    __atomic_add_fetch(&p_mtx_grd->waiter_counter, 1, __ATOMIC_RELAXED);
+
+    if(sample_weight && __atomic_load_n(&profile_enabled, __ATOMIC_RELAXED))
+        profile_depth = backtrace(profile_frames, __MTX_GRD_PROFILE_DEPTH__ + 1);
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    memcpy(&target_mutex_acq_location, &p_mtx_grd->mutex_acq_location, sizeof(MTX_GRD_ACQ_LOCATION));
+
+    // Pushed with the ctrl_mutex held, so that releasers find it along with their release, or are already done with the guard.
+    slot.next = __atomic_load_n(&p_mtx_grd->combine_head, __ATOMIC_RELAXED);
+
+    while(!__atomic_compare_exchange_n(&p_mtx_grd->combine_head, &slot.next, &slot, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    // Whoever holds the guard runs the operation before releasing it. Should the guard be released first, the publisher takes it
+    // and runs every pending operation (its own included) instead.
+    uint32_t slot_state;
+    bool slept = false;
+
+    while((slot_state = __atomic_load_n(&slot.state, __ATOMIC_ACQUIRE)) != MTX_GRD_COMBINE_SLOT_DONE)
+    {
+        if(pthread_mutex_trylock(&p_mtx_grd->mutex))
+        {
+            // The combining thread only wakes publishers up if they announced they were going to sleep.
+            if( (slot_state == MTX_GRD_COMBINE_SLOT_PENDING) &&
+                !__atomic_compare_exchange_n(&slot.state, &slot_state, MTX_GRD_COMBINE_SLOT_SLEEPING, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) )
+                continue;
+
+            slept = true;
+            MutexGuardFutexWait(&slot.state, MTX_GRD_COMBINE_SLOT_SLEEPING, NULL);
+            continue;
+        }
+
+        // The previous owner may have run the operation right before releasing the guard, which is then just handed over.
+        bool pending        = (__atomic_load_n(&slot.state, __ATOMIC_ACQUIRE) != MTX_GRD_COMBINE_SLOT_DONE);
+        uint64_t wait_ns    = MutexGuardGetMonotonicNs() - slot.publish_ns;
+
+        slot.accounted = pending;
+
+        if(pending)
+            MTX_GRD_PROBE5(lock__acquire, p_mtx_grd, address, MTX_GRD_LOCK_TYPE_PERMANENT, wait_ns, 0);
+
+        MutexGuardRecordLocked(p_mtx_grd, address, 0, pending, slot.publish_ns, wait_ns, (pending ? sample_weight : 0), (pending ? &target_mutex_acq_location : NULL), 0);
+        MutexGuardUnlockAddr(p_mtx_grd, address);
+    }
+
+    // Wait for the combining thread to be done waking the publisher up (see MutexGuardCombine).
+    if(slept)
+    {
+        if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+    }
+
+    __atomic_sub_fetch(&p_mtx_grd->waiter_counter, 1, __ATOMIC_RELAXED);
+
+    mutex_guard_lock_error_code = 0;
+
+    uint64_t wait_ns = MutexGuardGetMonotonicNs() - slot.publish_ns;
+
+    // The innermost frame (this very function) is skipped.
+    if(profile_depth > 1)
+        MutexGuardProfileRecord(profile_frames + 1, profile_depth - 1, wait_ns, sample_weight);
+
+    uint64_t slow_capture_ns = MutexGuardSlowCaptureThreshold(p_mtx_grd);
+
+    if(slow_capture_ns && (wait_ns >= slow_capture_ns))
+    {
+        if(profile_depth <= 1)
+            profile_depth = backtrace(profile_frames, __MTX_GRD_PROFILE_DEPTH__ + 1);
+
+        MutexGuardSlowCaptureRecord(p_mtx_grd, address, wait_ns, slow_capture_ns, profile_frames + 1, ((profile_depth > 1) ? (profile_depth - 1) : 0), &target_mutex_acq_location);
+    }
+
+    return 0;
+
+}
+
+/// @brief Locks several guards at once without deadlocking (see MutexGuardLockMany).
+/// @param guards Array of pointers to mutex guard structures (each listed once).
+/// @param guard_num Number of guards within the array.
+/// @param timeout_ns Maximum time to wait for the whole set (in nanoseconds, 0 to wait forever).
+/// @param address Address in which the guards are being locked.
+/// @return 0 if succeeded, < 0 if arguments are invalid, > 0 (standard error code) otherwise.
+/// @note Kept out of line, so that its callers' frames are always the ones skipped from captured stacks.
+static C_MUTEX_GUARD_NOINLINE int MutexGuardLockManyHelper( MTX_GRD** C_MUTEX_GUARD_RESTRICT guards  ,
+                                                            const size_t guard_num                  ,
+                                                            const uint64_t timeout_ns               ,
+                                                            void* C_MUTEX_GUARD_RESTRICT address    )
+{
+    if(!guards)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!guard_num)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INVALID_GUARD_NUM;
+        return -2;
+    }
+
+    for(size_t guard_index = 0; guard_index < guard_num; guard_index++)
+    {
+        if(!guards[guard_index])
+        {
+            mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+            return -1;
+        }
+
+        // A guard listed twice would always be found busy by its own locker.
+        for(size_t prev_index = 0; prev_index < guard_index; prev_index++)
+        {
+            if(guards[prev_index] == guards[guard_index])
+            {
+                mutex_guard_errno = MTX_GRD_ERR_DUPLICATE_MTX_GRD;
+                return -3;
+            }
+        }
+    }
+
+    int lock_type = (timeout_ns ? MTX_GRD_LOCK_TYPE_TIMED : MTX_GRD_LOCK_TYPE_PERMANENT);
+
+    for(size_t guard_index = 0; guard_index < guard_num; guard_index++)
+        MTX_GRD_PROBE4(lock__attempt, guards[guard_index], address, lock_type, timeout_ns);
+
+    unsigned int sample_weight = MutexGuardSampleWeight(guards[0]);
+
+    MTX_GRD_ACQ_LOCATION target_mutex_acq_location;
+    bool blocked            = false;
+    uint64_t wait_start_ns  = 0;
+    void* profile_frames[__MTX_GRD_PROFILE_DEPTH__ + 1];
+    int profile_depth       = 0;
+    size_t first_index      = 0;
+    size_t locked_num       = 0;
+    int ret_lock;
+
+    memset(&target_mutex_acq_location, 0, sizeof(MTX_GRD_ACQ_LOCATION));
+
+    for(;;)
+    {
+        MTX_GRD* p_first = guards[first_index];
+
+        ret_lock = pthread_mutex_trylock(&p_first->mutex);
+
+        // Only the guard found busy last time is ever waited for, and no other guard is held meanwhile.
+        if(ret_lock == EBUSY)
+        {
+            if(!blocked)
+            {
+                blocked         = true;
+                wait_start_ns   = MutexGuardGetMonotonicNs();
+
+                if(sample_weight && __atomic_load_n(&profile_enabled, __ATOMIC_RELAXED))
+                    profile_depth = backtrace(profile_frames, __MTX_GRD_PROFILE_DEPTH__ + 1);
+            }
+
+            if(MutexGuardLockCtrlMutex(p_first, false))
+                mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+            memcpy(&target_mutex_acq_location, &p_first->mutex_acq_location, sizeof(MTX_GRD_ACQ_LOCATION));
+
+            if(MutexGuardUnlockCtrlMutex(p_first, false))
+                mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+            __atomic_add_fetch(&p_first->waiter_counter, 1, __ATOMIC_RELAXED);
+
+            if(timeout_ns)
+            {
+                // The deadline is shared by the whole set, however many times it has to be retried.
+                uint64_t elapsed_ns = MutexGuardGetMonotonicNs() - wait_start_ns;
+
+                if(elapsed_ns < timeout_ns)
+                {
+                    mtx_to_t timed_lock_timeout = MutexGuardGenTimespec(timeout_ns - elapsed_ns);
+                    ret_lock = pthread_mutex_timedlock(&p_first->mutex, &timed_lock_timeout);
+                }
+                else
+                    ret_lock = ETIMEDOUT;
+            }
+            else
+                ret_lock = pthread_mutex_lock(&p_first->mutex);
+
+            __atomic_sub_fetch(&p_first->waiter_counter, 1, __ATOMIC_RELAXED);
+        }
+
+        if(ret_lock && (ret_lock != EOWNERDEAD))
+        {
+            if(ret_lock == ETIMEDOUT)
+                MTX_GRD_PROBE4(lock__timeout, p_first, address, lock_type, MutexGuardGetMonotonicNs() - wait_start_ns);
+            else
+                MTX_GRD_PROBE5(lock__error, p_first, address, lock_type, (blocked ? (MutexGuardGetMonotonicNs() - wait_start_ns) : 0), ret_lock);
+
+            if(verbosity_level & MTX_GRD_VERBOSITY_LOCK_ERROR)
+                MutexGuardPrintLockError(&target_mutex_acq_location, &p_first->mutex, timeout_ns, ret_lock);
+
+            mutex_guard_errno           = MTX_GRD_ERR_LOCK_ERROR;
+            mutex_guard_lock_error_code = ret_lock;
+
+            __atomic_add_fetch(&MutexGuardGetStatsShard(p_first, true)->failure_counter, 1, __ATOMIC_RELAXED);
+            MutexGuardRecordLockFailure(p_first, &target_mutex_acq_location, NULL);
+
+            return ret_lock;
+        }
+
+        locked_num = 1;
+
+        while( !ret_lock && (locked_num < guard_num) )
+        {
+            ret_lock = pthread_mutex_trylock(&guards[(first_index + locked_num) % guard_num]->mutex);
+
+            if( !ret_lock || (ret_lock == EOWNERDEAD) )
+                ++locked_num;
+        }
+
+        if(!ret_lock)
+            break;
+
+        // Back off, keeping only a guard acquired from a dead owner (if any), which has to be handed to the caller to be repaired.
+        size_t keep_index = ((ret_lock == EOWNERDEAD) ? ((first_index + locked_num - 1) % guard_num) : guard_num);
+
+        for(size_t locked_index = 0; locked_index < locked_num; locked_index++)
+        {
+            size_t guard_index = ((first_index + locked_index) % guard_num);
+
+            if(guard_index == keep_index)
+                continue;
+
+            MTX_GRD* p_unlocked = guards[guard_index];
+
+            if(MutexGuardLockCtrlMutex(p_unlocked, false))
+                mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+            MutexGuardUnlockAndWake(p_unlocked);
+            bool combine_pending = (__atomic_load_n(&p_unlocked->combine_head, __ATOMIC_RELAXED) != NULL);
+
+            if(MutexGuardUnlockCtrlMutex(p_unlocked, false))
+                mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+            if(combine_pending)
+                MutexGuardCombineHandoff(p_unlocked, address);
+        }
+
+        if(ret_lock == EOWNERDEAD)
+        {
+            first_index = keep_index;
+            locked_num  = 1;
+            break;
+        }
+
+        first_index = ((first_index + locked_num) % guard_num);
+        sched_yield();
+    }
+
+    mutex_guard_lock_error_code = ret_lock;
+
+    uint64_t wait_ns = (blocked ? (MutexGuardGetMonotonicNs() - wait_start_ns) : 0);
+
+    // The whole wait is recorded once, against the guard it ended on.
+    for(size_t locked_index = 0; locked_index < locked_num; locked_index++)
+    {
+        MTX_GRD* p_locked   = guards[(first_index + locked_index) % guard_num];
+        bool waited         = (blocked && !locked_index);
+
+        MTX_GRD_PROBE5(lock__acquire, p_locked, address, lock_type, (waited ? wait_ns : 0), ret_lock);
+        MutexGuardRecordLocked(p_locked, address, ret_lock, waited, wait_start_ns, (waited ? wait_ns : 0), sample_weight, (waited ? &target_mutex_acq_location : NULL), timeout_ns);
+    }
+
+    // The innermost frames (this very function and its public wrapper) are skipped.
+    if(profile_depth > 2)
+        MutexGuardProfileRecord(profile_frames + 2, profile_depth - 2, wait_ns, sample_weight);
+
+    uint64_t slow_capture_ns = (blocked ? MutexGuardSlowCaptureThreshold(guards[first_index]) : 0);
+
+    if(slow_capture_ns && (wait_ns >= slow_capture_ns))
+    {
+        if(profile_depth <= 2)
+            profile_depth = backtrace(profile_frames, __MTX_GRD_PROFILE_DEPTH__ + 1);
+
+        MutexGuardSlowCaptureRecord(guards[first_index], address, wait_ns, slow_capture_ns, profile_frames + 2, ((profile_depth > 2) ? (profile_depth - 2) : 0), &target_mutex_acq_location);
+    }
+
+    // A guard acquired from a dead owner cannot be released without being lost, so the rest of the set is then only tried (no guard
+    // being ever waited for while holding it), past the timeout if need be, until the whole set is held.
+    for(size_t locked_index = 1; (ret_lock == EOWNERDEAD) && (locked_index < guard_num); locked_index++)
+    {
+        MTX_GRD* p_locked = guards[(first_index + locked_index) % guard_num];
+        int ret_try;
+
+        while( (ret_try = pthread_mutex_trylock(&p_locked->mutex)) == EBUSY )
+        {
+            if(MutexGuardIsOwner(p_locked))
+            {
+                ret_try = EDEADLK;
+                break;
+            }
+
+            sched_yield();
+        }
+
+        if(ret_try && (ret_try != EOWNERDEAD))
+        {
+            // The set can no longer be completed: it is released as a whole, guards acquired from dead owners included.
+            for(size_t unlocked_index = locked_index; unlocked_index > 0; unlocked_index--)
+                MutexGuardUnlockAddr(guards[(first_index + unlocked_index - 1) % guard_num], address);
+
+            MTX_GRD_PROBE5(lock__error, p_locked, address, lock_type, 0, ret_try);
+
+            mutex_guard_errno           = MTX_GRD_ERR_LOCK_ERROR;
+            mutex_guard_lock_error_code = ret_try;
+            return ret_try;
+        }
+
+        MTX_GRD_PROBE5(lock__acquire, p_locked, address, lock_type, 0, ret_try);
+        MutexGuardRecordLocked(p_locked, address, ret_try, false, 0, 0, sample_weight, NULL, timeout_ns);
+    }
+
+    return ret_lock;
+}
+
+/// @brief Locks several guards at once without deadlocking.
+/// @param guards Array of pointers to mutex guard structures (each listed once).
+/// @param guard_num Number of guards within the array.
+/// @param timeout_ns Maximum time to wait for the whole set (in nanoseconds, 0 to wait forever).
+/// @return 0 if succeeded, < 0 if arguments are invalid, > 0 (standard error code) otherwise.
+int MutexGuardLockMany(MTX_GRD** C_MUTEX_GUARD_RESTRICT guards, const size_t guard_num, const uint64_t timeout_ns)
+{
+    return MutexGuardLockManyHelper(guards, guard_num, timeout_ns, __builtin_return_address(0));
+}
+
+/// @brief MutexGuardLockMany function wrapper.
+/// @param guards Array of pointers to mutex guard structures (each listed once).
+/// @param guard_num Number of guards within the array.
+/// @param timeout_ns Maximum time to wait for the whole set (in nanoseconds, 0 to wait forever).
+/// @return Given set of guards if succeeded (or one of them was acquired after its owner died), a set with NULL guards otherwise.
+MTX_GRD_MANY MutexGuardLockManyAddr(MTX_GRD** C_MUTEX_GUARD_RESTRICT guards, const size_t guard_num, const uint64_t timeout_ns)
+{
+    // A set acquired from a dead owner is held as a whole as well, and must be returned for scoped macros to release it.
+    int ret_lock        = MutexGuardLockManyHelper(guards, guard_num, timeout_ns, __builtin_return_address(0));
+    MTX_GRD_MANY many   = { .guards = NULL, .guard_num = 0 };
+
+    if(!ret_lock || (ret_lock == EOWNERDEAD))
+    {
+        many.guards     = guards;
+        many.guard_num  = guard_num;
+    }
+
+    return many;
+}
+
+/// @brief Unlocks every guard of a set, in reverse order.
+/// @param guards Array of pointers to mutex guard structures.
+/// @param guard_num Number of guards within the array.
+/// @return 0 if succeeded, != 0 otherwise.
+int MutexGuardUnlockMany(MTX_GRD** C_MUTEX_GUARD_RESTRICT guards, const size_t guard_num)
+{
+    if(!guards)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    int ret_unlock = 0;
+
+    for(size_t guard_index = guard_num; guard_index > 0; guard_index--)
+    {
+        int ret_guard_unlock = MutexGuardUnlockAddr(guards[guard_index - 1], __builtin_return_address(0));
+
+        if(!ret_unlock)
+            ret_unlock = ret_guard_unlock;
+    }
+
+    return ret_unlock;
+}
+
+/// @brief Applies a batch of operations under a single acquisition of its guard, and accounts it. The batch is emptied beforehand,
+/// so that its operations may queue further ones, but only stops counting as pending on its guard once released.
+/// @param p_batch Pointer to target batch.
+/// @param cause Flush cause.
+/// @return 0 if succeeded, > 0 (standard error code) if the guard could not be locked (the batch is kept then).
+static int MutexGuardBatchApply(MTX_GRD_BATCH* C_MUTEX_GUARD_RESTRICT p_batch, const MTX_GRD_BATCH_FLUSH_CAUSE cause)
+{
+    MTX_GRD_BATCH_OP ops[__MTX_GRD_BATCH_OP_NUM__];
+    MTX_GRD* p_mtx_grd  = p_batch->p_mtx_grd;
+    void* address       = p_batch->address;
+    size_t op_num       = p_batch->op_num;
+
+    if(!op_num)
+        return 0;
+
+    // Operations are never applied over state left inconsistent by a dead owner.
+    int ret_lock = MutexGuardLock(p_mtx_grd, address, 0, MTX_GRD_LOCK_TYPE_PERMANENT);
+
+    if(ret_lock)
+        return ret_lock;
+
+    memcpy(ops, p_batch->ops, op_num * sizeof(MTX_GRD_BATCH_OP));
+    p_batch->op_num = 0;
+
+    for(size_t op_index = 0; op_index < op_num; op_index++)
+        ops[op_index].fn(ops[op_index].arg);
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    MTX_GRD_BATCH_STATS* p_stats = &p_mtx_grd->batch_stats;
+    unsigned int size_bucket = (unsigned int)(63 - __builtin_clzll(op_num));
+
+    ++p_stats->flush_counter;
+    p_stats->op_counter += op_num;
+    ++p_stats->batch_size_histogram[(size_bucket < MTX_GRD_BATCH_HIST_BUCKET_NUM) ? size_bucket : (MTX_GRD_BATCH_HIST_BUCKET_NUM - 1)];
+
+    if(op_num > p_stats->batch_size_max)
+        p_stats->batch_size_max = op_num;
+
+    if(cause == MTX_GRD_BATCH_FLUSH_FULL)
+        ++p_stats->full_flush_counter;
+    else if(cause == MTX_GRD_BATCH_FLUSH_TIMED)
+        ++p_stats->timed_flush_counter;
+    else if(cause == MTX_GRD_BATCH_FLUSH_EXIT)
+        ++p_stats->exit_flush_counter;
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    int ret_unlock = MutexGuardUnlockAddr(p_mtx_grd, address);
+
+    __atomic_sub_fetch(&p_mtx_grd->batch_pending_counter, 1, __ATOMIC_RELEASE);
+
+    return ret_unlock;
+}
+
+/// @brief Applies and releases an exiting thread's batches (destructor of batch_set_key).
+/// @param ptr Pointer to the thread's batches.
+static void MutexGuardBatchSetRelease(void* ptr)
+{
+    MTX_GRD_BATCH_SET* p_set = (MTX_GRD_BATCH_SET*)ptr;
+
+    for(size_t batch_index = 0; batch_index < __MTX_GRD_BATCH_GUARD_NUM__; batch_index++)
+        if(p_set->batches[batch_index].p_mtx_grd)
+            MutexGuardBatchApply(&p_set->batches[batch_index], MTX_GRD_BATCH_FLUSH_EXIT);
+
+    batch_set = NULL;
+    free(p_set);
+}
+
+/// @brief Creates the key threads' batches are released at exit with.
+static void MutexGuardBatchSetKeyCreate(void)
+{
+    pthread_key_create(&batch_set_key, MutexGuardBatchSetRelease);
+}
+
+/// @brief Queues an operation in the calling thread's batch for target guard, applying the batch if due.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param fn Operation to be applied with the guard locked.
+/// @param arg Operation's argument.
+/// @return 0 if succeeded, < 0 if arguments are invalid, > 0 (standard error code) if a batch could not be applied.
+int MutexGuardBatch(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void (*fn)(void*), void* arg)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!fn)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_OPERATION;
+        return -2;
+    }
+
+    if(!batch_set)
+    {
+        pthread_once(&batch_set_key_once, MutexGuardBatchSetKeyCreate);
+
+        batch_set = calloc(1, sizeof(MTX_GRD_BATCH_SET));
+
+        if(!batch_set)
+        {
+            mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+            mutex_guard_lock_error_code = ENOMEM;
+            return -3;
+        }
+
+        pthread_setspecific(batch_set_key, batch_set);
+    }
+
+    MTX_GRD_BATCH* p_batch          = NULL;
+    MTX_GRD_BATCH* p_oldest         = NULL;
+    unsigned long long oldest_seq   = 0;
+
+    for(size_t batch_index = 0; batch_index < __MTX_GRD_BATCH_GUARD_NUM__; batch_index++)
+    {
+        MTX_GRD_BATCH* p_candidate = &batch_set->batches[batch_index];
+
+        if(p_candidate->p_mtx_grd == p_mtx_grd)
+        {
+            p_batch = p_candidate;
+            break;
+        }
+
+        // Empty batches count as the oldest ones.
+        unsigned long long candidate_seq = (p_candidate->op_num ? p_candidate->first_seq : 0);
+
+        if( !p_oldest || (candidate_seq < oldest_seq) )
+        {
+            p_oldest    = p_candidate;
+            oldest_seq  = candidate_seq;
+        }
+    }
+
+    int ret_apply = 0;
+
+    if(!p_batch)
+    {
+        // Room is made by applying the oldest batch (empty ones are simply reused).
+        if( p_oldest->op_num && (ret_apply = MutexGuardBatchApply(p_oldest, MTX_GRD_BATCH_FLUSH_FULL)) )
+            return ret_apply;
+
+        p_batch             = p_oldest;
+        p_batch->p_mtx_grd  = p_mtx_grd;
+        p_batch->op_num     = 0;
+    }
+
+    size_t op_limit = (p_mtx_grd->batch_op_num ? p_mtx_grd->batch_op_num : __MTX_GRD_BATCH_OP_NUM__);
+
+    // Operations queued while their batch is applied may find it full.
+    if( (p_batch->op_num >= op_limit) && (ret_apply = MutexGuardBatchApply(p_batch, MTX_GRD_BATCH_FLUSH_FULL)) )
+        return ret_apply;
+
+    // Counted on the guard while non-empty, so that MutexGuardDestroy finds batches other threads still point it from.
+    if(!p_batch->op_num)
+    {
+        __atomic_add_fetch(&p_mtx_grd->batch_pending_counter, 1, __ATOMIC_RELAXED);
+
+        p_batch->address    = __builtin_return_address(0);
+        p_batch->first_ns   = (p_mtx_grd->batch_delay_ns ? MutexGuardGetMonotonicNs() : 0);
+        p_batch->first_seq  = ++batch_set->batch_seq_counter;
+    }
+
+    p_batch->ops[p_batch->op_num].fn    = fn;
+    p_batch->ops[p_batch->op_num].arg   = arg;
+    ++p_batch->op_num;
+
+    if(p_batch->op_num >= op_limit)
+        return MutexGuardBatchApply(p_batch, MTX_GRD_BATCH_FLUSH_FULL);
+
+    if( p_mtx_grd->batch_delay_ns && ((MutexGuardGetMonotonicNs() - p_batch->first_ns) >= p_mtx_grd->batch_delay_ns) )
+        return MutexGuardBatchApply(p_batch, MTX_GRD_BATCH_FLUSH_TIMED);
+
+    return 0;
+}
+
+/// @brief Applies the calling thread's batch for target guard (or all of them).
+/// @param p_mtx_grd Pointer to mutex guard structure (NULL to apply every batch).
+/// @return 0 if succeeded, > 0 (standard error code) if a batch could not be applied.
+int MutexGuardBatchFlush(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+{
+    int ret_flush = 0;
+
+    for(size_t batch_index = 0; batch_set && (batch_index < __MTX_GRD_BATCH_GUARD_NUM__); batch_index++)
+    {
+        MTX_GRD_BATCH* p_batch = &batch_set->batches[batch_index];
+
+        if( !p_batch->p_mtx_grd || (p_mtx_grd && (p_batch->p_mtx_grd != p_mtx_grd)) )
+            continue;
+
+        int ret_apply = MutexGuardBatchApply(p_batch, MTX_GRD_BATCH_FLUSH_EXPLICIT);
+
+        if(!ret_apply)
+            p_batch->p_mtx_grd = NULL;
+        else if(!ret_flush)
+            ret_flush = ret_apply;
+    }
+
+    return ret_flush;
+}
+
+/// @brief Gets a guard's operation batching statistics.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_stats Pointer to the structure statistics are meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardGetBatchStats(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, MTX_GRD_BATCH_STATS* C_MUTEX_GUARD_RESTRICT p_stats)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(!p_stats)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
+    }
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    memcpy(p_stats, &p_mtx_grd->batch_stats, sizeof(MTX_GRD_BATCH_STATS));
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    return 0;
+}
+
+/// @brief Cleanup function to release every guard of a set held by the calling thread (meant to be used alongside MTX_GRD_LOCK_MANY_SC).
+/// @param ptr Pointer to set of guards.
+void MutexGuardReleaseManyCleanup(void* ptr)
+{
+    MTX_GRD_MANY* p_many = (MTX_GRD_MANY*)ptr;
+
+    if(!p_many || !p_many->guards)
+        return;
+
+    // A set acquired after an owner died only holds that very guard.
+    for(size_t guard_index = p_many->guard_num; guard_index > 0; guard_index--)
+        if(p_many->guards[guard_index - 1] && MutexGuardIsOwner(p_many->guards[guard_index - 1]))
+            MutexGuardUnlock(p_many->guards[guard_index - 1]);
+}
+
+/// @brief Cleanup function to release a mutex (meant to be used alongside scoped mutex lock macros).
+/// @param ptr Pointer to mutex guard structure. 
+void MutexGuardReleaseMutexCleanup(void* ptr)
+{
+    if(!ptr || !(*(MTX_GRD**)ptr))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return;
+    }
+    
+    MutexGuardUnlock(*(MTX_GRD**)ptr);
+}
+
+/// @brief Destroys mutex attribute within given mutex guard.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @return 0 if succeeded, > 0 otherwise.
+int MutexGuardAttrDestroy(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+    
+    int mutex_attr_destroy = pthread_mutexattr_destroy(&p_mtx_grd->mutex_attr);
+    
+    if(mutex_attr_destroy)
+        mutex_guard_errno = MTX_GRD_ERR_STD_ERROR_CODE;
+    
+    return mutex_attr_destroy;
+}
+
+/// @brief Destroys mutex within given mutex guard, unless other threads still have batched operations for it.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @return 0 if succeeded, != 0 otherwise.
+int MutexGuardDestroy(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    if(batch_set)
+        MutexGuardBatchFlush(p_mtx_grd);
+
+    // Other threads' batches would be applied to it later on.
+    if(__atomic_load_n(&p_mtx_grd->batch_pending_counter, __ATOMIC_ACQUIRE))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_BATCH_PENDING;
+        return -4;
+    }
+
+    // The server runs whatever was submitted before stopping, and locks the guard to do so.
+    MutexGuardDelegationStop(p_mtx_grd);
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+        return -2;
+    }
+
+    MutexGuardAsyncDrop(p_mtx_grd);
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    // Released as usual, with the ctrl_mutex free: operations handed over and deferred work are run outside of it.
+    int original_lock_counter = p_mtx_grd->lock_counter;
+
+    int ret_unlock = 0;
+    for(int i = 0; i < original_lock_counter; i++)
+    {
+        ret_unlock = MutexGuardUnlock(p_mtx_grd);
+        
+        if(ret_unlock < 0)
+            return -3;
+    }
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+        return -2;
+    }
+    
+    MutexGuardUnregister(p_mtx_grd);
+
+    // Dumps can no longer reach the guard, and its owners are gone.
+    free(__atomic_exchange_n(&p_mtx_grd->stats_shards, NULL, __ATOMIC_ACQ_REL));
+
+    int mutex_destroy = pthread_mutex_destroy(&p_mtx_grd->mutex);
+    
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+    
+    if(mutex_destroy)
+        mutex_guard_errno = MTX_GRD_ERR_STD_ERROR_CODE;
+    
+    if(MutexGuardDestroyCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    return mutex_destroy;
+}
+
+/// @brief Cleanup function to destroy a mutex attribute (meant to be used alongside scoped attribute init macros).
+/// @param ptr Pointer to mutex attribute containing mutex guard structure. 
+void MutexGuardDestroyAttrCleanup(void* ptr)
+{
+    if(!ptr || !(*(MTX_GRD**)ptr))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return;
+    }
+
+    MutexGuardAttrDestroy(*(MTX_GRD**)ptr);
+}
+
+/// @brief Cleanup function to destroy a mutex (meant to be used alongside scoped mutex init macros)
+/// @param ptr Pointer to mutex guard structure.
+void MutexGuardDestroyMutexCleanup(void* ptr)
+{
+    if(!ptr || !(*(MTX_GRD**)ptr))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return;
+    }
+
+    MutexGuardDestroy(*(MTX_GRD**)ptr);
+}
+
+/// @brief dl_iterate_phdr callback looking for the loaded module an address belongs to, as well as its GNU build ID.
+/// @param info Loaded module information.
+/// @param size Size of info structure.
+/// @param data Pointer to MTX_GRD_MODULE_CACHE whose start field holds the target address.
+/// @return 1 if module was found (stops iteration), 0 otherwise.
+static int MutexGuardFindModuleCallback(struct dl_phdr_info* info, size_t size, void* data)
+{
+    MTX_GRD_MODULE_CACHE* p_module = (MTX_GRD_MODULE_CACHE*)data;
+    uintptr_t target_address = p_module->start;
+    const ElfW(Phdr)* p_load_segment = NULL;
+
+    (void)size;
+
+    for(ElfW(Half) phdr_index = 0; phdr_index < info->dlpi_phnum; phdr_index++)
+    {
+        const ElfW(Phdr)* p_phdr = &info->dlpi_phdr[phdr_index];
+        uintptr_t segment_start = info->dlpi_addr + p_phdr->p_vaddr;
+
+        if( (p_phdr->p_type == PT_LOAD) && (target_address >= segment_start) && (target_address < (segment_start + p_phdr->p_memsz)) )
+        {
+            p_load_segment = p_phdr;
+            break;
+        }
+    }
+
+    if(!p_load_segment)
+        return 0;
+
+    p_module->start     = info->dlpi_addr + p_load_segment->p_vaddr;
+    p_module->end       = p_module->start + p_load_segment->p_memsz;
+    p_module->load_base = info->dlpi_addr;
+
+    for(ElfW(Half) phdr_index = 0; phdr_index < info->dlpi_phnum; phdr_index++)
+    {
+        const ElfW(Phdr)* p_phdr = &info->dlpi_phdr[phdr_index];
+
+        if(p_phdr->p_type != PT_NOTE)
+            continue;
+
+        const char* note_ptr = (const char*)(info->dlpi_addr + p_phdr->p_vaddr);
+        const char* note_end = note_ptr + p_phdr->p_memsz;
+
+        while((note_ptr + sizeof(ElfW(Nhdr))) <= note_end)
+        {
+            const ElfW(Nhdr)* p_note = (const ElfW(Nhdr)*)note_ptr;
+            const char* note_name = note_ptr + sizeof(ElfW(Nhdr));
+            const uint8_t* note_desc = (const uint8_t*)(note_name + ((p_note->n_namesz + MTX_GRD_BUILD_ID_NOTE_ALIGN - 1) & ~(MTX_GRD_BUILD_ID_NOTE_ALIGN - 1)));
+
+            if( (p_note->n_type == NT_GNU_BUILD_ID) && (p_note->n_namesz == sizeof(MTX_GRD_BUILD_ID_NOTE_NAME)) &&
+                !memcmp(note_name, MTX_GRD_BUILD_ID_NOTE_NAME, sizeof(MTX_GRD_BUILD_ID_NOTE_NAME)) )
+            {
+                size_t build_id_len = (p_note->n_descsz < __MTX_GRD_BUILD_ID_LEN__) ? p_note->n_descsz : __MTX_GRD_BUILD_ID_LEN__;
+                memcpy(p_module->build_id, note_desc, build_id_len);
+                return 1;
+            }
+
+            note_ptr = (const char*)note_desc + ((p_note->n_descsz + MTX_GRD_BUILD_ID_NOTE_ALIGN - 1) & ~(MTX_GRD_BUILD_ID_NOTE_ALIGN - 1));
+        }
+    }
+
+    return 1;
+}
+
+/// @brief Translates an address into a process-independent callsite (module build ID + offset from module's load base).
+/// @param address Target address.
+/// @param p_callsite Pointer to the callsite to be filled.
+static void MutexGuardGetCallsite(const void* address, MTX_GRD_CALLSITE* C_MUTEX_GUARD_RESTRICT p_callsite)
+{
+    uintptr_t target_address = (uintptr_t)address;
+
+    if( (target_address < module_cache.start) || (target_address >= module_cache.end) )
+    {
+        MTX_GRD_MODULE_CACHE found_module = { .start = target_address };
+
+        if(!dl_iterate_phdr(MutexGuardFindModuleCallback, &found_module))
+        {
+            memset(p_callsite, 0, sizeof(MTX_GRD_CALLSITE));
+            p_callsite->offset = target_address;
+            return;
+        }
+
+        memcpy(&module_cache, &found_module, sizeof(MTX_GRD_MODULE_CACHE));
+    }
+
+    memcpy(p_callsite->build_id, module_cache.build_id, __MTX_GRD_BUILD_ID_LEN__);
+    p_callsite->offset = target_address - module_cache.load_base;
+}
+
+/// @brief Converts a build ID to its hexadecimal string representation.
+/// @param build_id Target build ID.
+/// @param build_id_str Output buffer (at least MTX_GRD_BUILD_ID_STR_LEN bytes long).
+static void MutexGuardBuildIdToString(const uint8_t* build_id, char* build_id_str)
+{
+    // Used by dumps, hence no snprintf (not async-signal-safe).
+    for(unsigned int byte_index = 0; byte_index < __MTX_GRD_BUILD_ID_LEN__; byte_index++)
+    {
+        build_id_str[byte_index * 2]        = MTX_GRD_DUMP_HEX_DIGITS[build_id[byte_index] >> 4];
+        build_id_str[(byte_index * 2) + 1]  = MTX_GRD_DUMP_HEX_DIGITS[build_id[byte_index] & 0xF];
+    }
+
+    build_id_str[__MTX_GRD_BUILD_ID_LEN__ * 2] = 0;
+}
+
+/// @brief Maps a named POSIX shared memory object holding a process-shared MTX_GRD followed by data_size bytes of user data (see MTX_GRD_SHM_DATA).
+/// The first process to open it creates and initializes it, the rest wait for it to be ready and attach to it.
+/// @param name Shared memory object name (as used by shm_open, e.g. "/my_cache").
+/// @param data_size Size (in bytes) of the user data placed after the MTX_GRD.
+/// @param mutex_type Mutex type (NORMAL, ERRORCHECK, RECURSIVE, DEFAULT), only used by the creating process.
+/// @return Pointer to mapped mutex guard structure if succeeded, NULL otherwise.
+MTX_GRD* MutexGuardShmOpen( const char* C_MUTEX_GUARD_RESTRICT name ,
+                            const size_t data_size                  ,
+                            const int mutex_type                    )
+{
+    if(!name)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return NULL;
+    }
+
+    size_t map_size = MTX_GRD_SHM_HEADER_SIZE + MTX_GRD_SHM_DATA_OFFSET + data_size;
+    bool is_creator = true;
+
+    int shm_fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, MTX_GRD_SHM_PERMISSIONS);
+
+    if( (shm_fd < 0) && (errno == EEXIST) )
+    {
+        is_creator = false;
+        shm_fd = shm_open(name, O_RDWR, MTX_GRD_SHM_PERMISSIONS);
+    }
+
+    if(shm_fd < 0)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_SHM_ERROR;
+        return NULL;
+    }
+
+    mtx_to_t poll_period = { .tv_sec = 0, .tv_nsec = MTX_GRD_SHM_POLL_PERIOD_NS };
+
+    if(is_creator)
+    {
+        if(ftruncate(shm_fd, map_size))
+        {
+            close(shm_fd);
+            shm_unlink(name);
+            mutex_guard_errno = MTX_GRD_ERR_SHM_ERROR;
+            return NULL;
+        }
+    }
+    else
+    {
+        // Wait for the creating process to size the object.
+        struct stat shm_stat = {0};
+        int attempts = 0;
+
+        while( !fstat(shm_fd, &shm_stat) && ((size_t)shm_stat.st_size < map_size) && (attempts++ < MTX_GRD_SHM_POLL_MAX_ATTEMPTS) )
+            nanosleep(&poll_period, NULL);
+
+        if((size_t)shm_stat.st_size < map_size)
+        {
+            close(shm_fd);
+            mutex_guard_errno = MTX_GRD_ERR_SHM_ERROR;
+            return NULL;
+        }
+    }
+
+    void* p_map = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+    close(shm_fd);
+
+    if(p_map == MAP_FAILED)
+    {
+        if(is_creator)
+            shm_unlink(name);
+
+        mutex_guard_errno = MTX_GRD_ERR_SHM_ERROR;
+        return NULL;
+    }
+
+    MTX_GRD_SHM_HEADER* p_header = (MTX_GRD_SHM_HEADER*)p_map;
+    MTX_GRD* p_mtx_grd = (MTX_GRD*)((char*)p_map + MTX_GRD_SHM_HEADER_SIZE);
+
+    if(is_creator)
+    {
+        pthread_mutexattr_init(&p_mtx_grd->mutex_attr);
+
+        if( MutexGuardAttrInit(p_mtx_grd, mutex_type, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_SHARED) || MutexGuardInit(p_mtx_grd) )
+        {
+            int init_errno = mutex_guard_errno;
+            munmap(p_map, map_size);
+            shm_unlink(name);
+            mutex_guard_errno = init_errno;
+            return NULL;
+        }
+
+        __atomic_store_n(&p_header->ready, MTX_GRD_SHM_READY_MAGIC, __ATOMIC_RELEASE);
+
+        return p_mtx_grd;
+    }
+
+    // Wait for the creating process to initialize the guard.
+    int attempts = 0;
+
+    while( (__atomic_load_n(&p_header->ready, __ATOMIC_ACQUIRE) != MTX_GRD_SHM_READY_MAGIC) && (attempts++ < MTX_GRD_SHM_POLL_MAX_ATTEMPTS) )
+        nanosleep(&poll_period, NULL);
+
+    if(__atomic_load_n(&p_header->ready, __ATOMIC_ACQUIRE) != MTX_GRD_SHM_READY_MAGIC)
+    {
+        munmap(p_map, map_size);
+        mutex_guard_errno = MTX_GRD_ERR_SHM_ERROR;
+        return NULL;
+    }
+
+    // Every process mapping the guard sees it in its own dumps and exports.
+    if(MutexGuardRegister(p_mtx_grd))
+    {
+        munmap(p_map, map_size);
+        return NULL;
+    }
+
+    return p_mtx_grd;
+}
+
+/// @brief Unmaps a MTX_GRD previously mapped by MutexGuardShmOpen. The guard itself is left as is for other processes to use it.
+/// @param p_mtx_grd Pointer to mapped mutex guard structure.
+/// @param data_size Size (in bytes) of the user data provided to MutexGuardShmOpen.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardShmClose(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const size_t data_size)
+{
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -1;
+    }
+
+    // It cannot be reached by this process' dumps once unmapped.
+    MutexGuardUnregister(p_mtx_grd);
+
+    if(munmap((char*)p_mtx_grd - MTX_GRD_SHM_HEADER_SIZE, MTX_GRD_SHM_HEADER_SIZE + MTX_GRD_SHM_DATA_OFFSET + data_size))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_SHM_ERROR;
+        return -2;
+    }
+
+    return 0;
+}
+
+/// @brief Removes a named shared memory object created by MutexGuardShmOpen (processes which already mapped it keep using it).
+/// @param name Shared memory object name.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardShmUnlink(const char* C_MUTEX_GUARD_RESTRICT name)
+{
+    if(!name)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -1;
+    }
+
+    if(shm_unlink(name))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_SHM_ERROR;
+        return -2;
+    }
+
+    return 0;
+}
+
+/// @brief Waits on a futex word for as long as it holds the expected value.
+/// @param p_futex Pointer to target futex word.
+/// @param expected Value the futex word is expected to hold.
+/// @param p_abs_timeout Absolute CLOCK_MONOTONIC deadline (NULL to wait forever).
+/// @return 0 if woken up (or value did not match), ETIMEDOUT if deadline was reached.
+static int MutexGuardFutexWait(uint32_t* p_futex, const uint32_t expected, const mtx_to_t* p_abs_timeout)
+{
+    long ret_wait = syscall(SYS_futex, p_futex, FUTEX_WAIT_BITSET_PRIVATE, expected, p_abs_timeout, NULL, FUTEX_BITSET_MATCH_ANY);
+
+    if( (ret_wait < 0) && (errno == ETIMEDOUT) )
+        return ETIMEDOUT;
+
+    return 0;
+}
+
+/// @brief Wakes up threads waiting on a futex word.
+/// @param p_futex Pointer to target futex word.
+/// @param waiter_num Maximum number of threads to be woken up.
+static void MutexGuardFutexWake(uint32_t* p_futex, const int waiter_num)
+{
+    syscall(SYS_futex, p_futex, FUTEX_WAKE_PRIVATE, waiter_num, NULL, NULL, 0);
+}
+
+/// @brief Appends a waiter to the tail of a condition wait queue.
+/// @param p_queue Pointer to target queue.
+/// @param p_waiter Pointer to waiter to be appended.
+static void MutexGuardCondQueuePush(MTX_GRD_COND_WAIT_QUEUE* p_queue, MTX_GRD_COND_WAITER* p_waiter)
+{
+    p_waiter->next = NULL;
+    p_waiter->prev = p_queue->tail;
+
+    if(p_queue->tail)
+        p_queue->tail->next = p_waiter;
+    else
+        p_queue->head = p_waiter;
+
+    p_queue->tail = p_waiter;
+}
+
+/// @brief Removes the waiter found at the head of a condition wait queue.
+/// @param p_queue Pointer to target queue.
+/// @return Pointer to removed waiter, NULL if queue was empty.
+static MTX_GRD_COND_WAITER* MutexGuardCondQueuePop(MTX_GRD_COND_WAIT_QUEUE* p_queue)
+{
+    MTX_GRD_COND_WAITER* p_waiter = p_queue->head;
+
+    if(p_waiter)
+        MutexGuardCondQueueRemove(p_queue, p_waiter);
+
+    return p_waiter;
+}
+
+/// @brief Unlinks a waiter from a condition wait queue.
+/// @param p_queue Pointer to target queue.
+/// @param p_waiter Pointer to waiter to be unlinked.
+static void MutexGuardCondQueueRemove(MTX_GRD_COND_WAIT_QUEUE* p_queue, MTX_GRD_COND_WAITER* p_waiter)
+{
+    if(p_waiter->prev)
+        p_waiter->prev->next = p_waiter->next;
+    else
+        p_queue->head = p_waiter->next;
+
+    if(p_waiter->next)
+        p_waiter->next->prev = p_waiter->prev;
+    else
+        p_queue->tail = p_waiter->prev;
+
+    p_waiter->prev = NULL;
+    p_waiter->next = NULL;
+}
+
+/// @brief Marks a waiter as woken up and wakes its thread. Caller must hold the ctrl_mutex protecting the queue the waiter was in,
+/// as the waiter does not leave the wait (nor its stack frame) until it has acquired that mutex.
+/// @param p_waiter Pointer to target waiter.
+static void MutexGuardCondWakeWaiter(MTX_GRD_COND_WAITER* p_waiter)
+{
+    __atomic_store_n(&p_waiter->state, MTX_GRD_COND_WAITER_WOKEN, __ATOMIC_RELEASE);
+    MutexGuardFutexWake(&p_waiter->state, 1);
+}
+
+/// @brief Wakes up the next condition waiter requeued onto a guard by a broadcast. Meant to be called with the guard's ctrl_mutex held, right after the guard is released.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+static void MutexGuardWakeRequeuedCondWaiter(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard)
+{
+    MTX_GRD_COND_WAITER* p_waiter = MutexGuardCondQueuePop(&p_mutex_guard->cond_requeued);
+
+    if(p_waiter)
+        MutexGuardCondWakeWaiter(p_waiter);
+}
+
+/// @brief Initializes condition variable control mutex.
+/// @param p_mtx_grd_cond Pointer to MTX_GRD_COND variable in which target control mutex is found.
+/// @param one_shot Tells whether should it be tried to init control mutex just once.
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardCondInitCtrlMutex(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond, const bool one_shot)
+{
+    MTX_GRD_CTRL_MUTEX_CONTROL_FLOW(pthread_mutex_init(&p_mtx_grd_cond->ctrl_mutex, NULL));
+}
+
+/// @brief Locks condition variable control mutex.
+/// @param p_mtx_grd_cond Pointer to MTX_GRD_COND variable in which target control mutex is found.
+/// @param one_shot Tells whether should it be tried to lock control mutex just once.
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardCondLockCtrlMutex(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond, const bool one_shot)
+{
+    MTX_GRD_CTRL_MUTEX_CONTROL_FLOW(pthread_mutex_lock(&p_mtx_grd_cond->ctrl_mutex));
+}
+
+/// @brief Unlocks condition variable control mutex.
+/// @param p_mtx_grd_cond Pointer to MTX_GRD_COND variable in which target control mutex is found.
+/// @param one_shot Tells whether should it be tried to unlock control mutex just once.
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardCondUnlockCtrlMutex(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond, const bool one_shot)
+{
+    MTX_GRD_CTRL_MUTEX_CONTROL_FLOW(pthread_mutex_unlock(&p_mtx_grd_cond->ctrl_mutex));
+}
+
+/// @brief Destroys condition variable control mutex.
+/// @param p_mtx_grd_cond Pointer to MTX_GRD_COND variable in which target control mutex is found.
+/// @param one_shot Tells whether should it be tried to destroy control mutex just once.
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardCondDestroyCtrlMutex(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond, const bool one_shot)
+{
+    MTX_GRD_CTRL_MUTEX_CONTROL_FLOW(pthread_mutex_destroy(&p_mtx_grd_cond->ctrl_mutex));
+}
+
+/// @brief Initializes condition variable.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardCondInit(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond)
+{
+    if(!p_mtx_grd_cond)
     {
-        lock_timeout.tv_nsec -= MTX_GRD_TOUT_1_SEC_AS_NS;
-        lock_timeout.tv_sec += 1;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_COND;
+        return -1;
     }
 
-    return lock_timeout;
+    memset(p_mtx_grd_cond, 0, sizeof(MTX_GRD_COND));
+
+    if(MutexGuardCondInitCtrlMutex(p_mtx_grd_cond, true))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+        return -2;
+    }
+
+    return 0;
 }
 
-/// @brief Copies lock error to a provided buffer.
-/// @param p_mutex_guard Pointer to mutex guard structure.
-/// @param timeout_ns Target timeout value (if any, in nanoseconds).
-/// @param ret_lock Value returned by pthread mutex locking function.
-/// @param lock_error_string Buffer where the error is meant to eb copied to.
-/// @param lock_error_str_size Buffer size.
+/// @brief MutexGuardCondInit function wrapper.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @return Pointer to given condition variable structure if succeeded, NULL otherwise.
+MTX_GRD_COND* MutexGuardCondInitAddr(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond)
+{
+    return (MutexGuardCondInit(p_mtx_grd_cond) ? NULL : p_mtx_grd_cond);
+}
+
+/// @brief Releases target MTX_GRD, waits on the condition variable and locks the MTX_GRD again, keeping its bookkeeping consistent.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param address Address in which the wait is performed.
+/// @param p_abs_timeout Absolute CLOCK_MONOTONIC deadline (NULL to wait forever).
+/// @return 0 if succeeded, ETIMEDOUT if timeout elapsed, < 0 if arguments or guard state are invalid, > 0 (standard error code) otherwise.
+static int MutexGuardCondWaitHelper(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond ,
+                                    MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd           ,
+                                    void* C_MUTEX_GUARD_RESTRICT address                ,
+                                    const mtx_to_t* p_abs_timeout                       )
+{
+    if(!p_mtx_grd_cond)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_COND;
+        return -1;
+    }
+
+    if(!p_mtx_grd)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        return -2;
+    }
+
+    if(p_mtx_grd->mutex_acq_location.thread_id == 0)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NOT_LOCKED;
+        return -3;
+    }
+
+    if(!MutexGuardIsOwner(p_mtx_grd))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INVALID_OWNER_TID;
+        return -4;
+    }
+
+    // Recursive guards cannot be waited on while locked more than once, as the underlying mutex would not be released.
+    if(p_mtx_grd->lock_counter != 1)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_COND_RECURSIVE_WAIT;
+        return -5;
+    }
+
+    // Waiters live on their own stacks, which are not reachable from other processes.
+    if(p_mtx_grd->process_shared)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_PROC_SHARED_UNSUPPORTED;
+        return -6;
+    }
+
+    MTX_GRD_COND_WAITER waiter = { .state = MTX_GRD_COND_WAITER_WAITING };
+    uint64_t wait_start_ns = MutexGuardGetMonotonicNs();
+
+    // Queue up before the guard is released, so that no signal sent after releasing it can get lost.
+    if(MutexGuardCondLockCtrlMutex(p_mtx_grd_cond, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    if(p_mtx_grd_cond->waiters.head && (p_mtx_grd_cond->p_mtx_grd != p_mtx_grd))
+    {
+        if(MutexGuardCondUnlockCtrlMutex(p_mtx_grd_cond, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        mutex_guard_errno = MTX_GRD_ERR_COND_GUARD_MISMATCH;
+        return -7;
+    }
+
+    p_mtx_grd_cond->p_mtx_grd = p_mtx_grd;
+    MutexGuardCondQueuePush(&p_mtx_grd_cond->waiters, &waiter);
+
+    if(MutexGuardCondUnlockCtrlMutex(p_mtx_grd_cond, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    // Operations published through MutexGuardExecute are run once queued up, so that the signals they may send are not lost.
+    if(__atomic_load_n(&p_mtx_grd->combine_head, __ATOMIC_ACQUIRE))
+        MutexGuardCombine(p_mtx_grd);
+
+    // Release the guard the same way MutexGuardUnlock does, but keep its acquisition record so that it can be restored later on.
+    MTX_GRD_ACQ_LOCATION saved_acq_location;
+
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    MutexGuardRecordHoldEnd(p_mtx_grd);
+    memcpy(&saved_acq_location, &p_mtx_grd->mutex_acq_location, sizeof(MTX_GRD_ACQ_LOCATION));
+    memset(&p_mtx_grd->mutex_acq_location, 0, sizeof(MTX_GRD_ACQ_LOCATION));
+    p_mtx_grd->lock_counter = 0;
+
+    int ret_unlock = MutexGuardUnlockAndWake(p_mtx_grd);
+
+    if(ret_unlock)
+    {
+        memcpy(&p_mtx_grd->mutex_acq_location, &saved_acq_location, sizeof(MTX_GRD_ACQ_LOCATION));
+        p_mtx_grd->lock_counter = 1;
+
+        if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        if(MutexGuardCondLockCtrlMutex(p_mtx_grd_cond, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        if(__atomic_load_n(&waiter.state, __ATOMIC_ACQUIRE) == MTX_GRD_COND_WAITER_WAITING)
+            MutexGuardCondQueueRemove(&p_mtx_grd_cond->waiters, &waiter);
+
+        if(MutexGuardCondUnlockCtrlMutex(p_mtx_grd_cond, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        mutex_guard_lock_error_code = ret_unlock;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+
+        return ret_unlock;
+    }
+
+    MutexGuardWakeRequeuedCondWaiter(p_mtx_grd);
+
+    bool combine_pending = (__atomic_load_n(&p_mtx_grd->combine_head, __ATOMIC_RELAXED) != NULL);
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    if(combine_pending)
+        MutexGuardCombineHandoff(p_mtx_grd, address);
+
+    // Already queued up, so that running deferred work before going to sleep loses no signal.
+    if(deferred_work_num)
+        MutexGuardRunDeferredWork(p_mtx_grd, true);
+
+    uint32_t waiter_state;
+    int ret_wait = 0;
+
+    while((waiter_state = __atomic_load_n(&waiter.state, __ATOMIC_ACQUIRE)) != MTX_GRD_COND_WAITER_WOKEN)
+        if((ret_wait = MutexGuardFutexWait(&waiter.state, waiter_state, p_abs_timeout)) == ETIMEDOUT)
+            break;
+
+    // Leave whichever queue the waiter is still in. Taking the ctrl_mutex also ensures the waking thread is done with the waiter.
+    bool timed_out = false;
+
+    if(MutexGuardCondLockCtrlMutex(p_mtx_grd_cond, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    waiter_state = __atomic_load_n(&waiter.state, __ATOMIC_ACQUIRE);
+
+    if(waiter_state == MTX_GRD_COND_WAITER_WAITING)
+    {
+        MutexGuardCondQueueRemove(&p_mtx_grd_cond->waiters, &waiter);
+        timed_out = true;
+    }
+    else if(waiter_state == MTX_GRD_COND_WAITER_REQUEUED)
+    {
+        if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+        if(__atomic_load_n(&waiter.state, __ATOMIC_ACQUIRE) == MTX_GRD_COND_WAITER_REQUEUED)
+        {
+            MutexGuardCondQueueRemove(&p_mtx_grd->cond_requeued, &waiter);
+            timed_out = true;
+        }
+
+        if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+    }
+
+    if(MutexGuardCondUnlockCtrlMutex(p_mtx_grd_cond, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    int ret_lock = pthread_mutex_lock(&p_mtx_grd->mutex);
+
+    if(ret_lock && (ret_lock != EOWNERDEAD))
+    {
+        mutex_guard_lock_error_code = ret_lock;
+        mutex_guard_errno           = MTX_GRD_ERR_LOCK_ERROR;
+
+        return ret_lock;
+    }
+
+    // The guard is owned by the calling thread again: restore its record, the wait being its latest acquisition address.
+    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    if(ret_lock == EOWNERDEAD)
+        MutexGuardRecordDeadOwner(p_mtx_grd);
+
+    memcpy(&p_mtx_grd->mutex_acq_location, &saved_acq_location, sizeof(MTX_GRD_ACQ_LOCATION));
+    p_mtx_grd->mutex_acq_location.thread_id = pthread_self();
+    MutexGuardRecordHoldStart(p_mtx_grd, NULL, 0, MutexGuardSampleWeight(p_mtx_grd));
+    p_mtx_grd->lock_counter = 1;
+
+    if(address)
+    {
+        MutexGuardRemoveLatestAddress(p_mtx_grd);
+        MutexGuardStoreNewAddress(p_mtx_grd, address);
+    }
+
+    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    uint64_t wait_end_ns = MutexGuardGetMonotonicNs();
+    uint64_t wait_ns = wait_end_ns - wait_start_ns;
+
+    if(MutexGuardCondLockCtrlMutex(p_mtx_grd_cond, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    MTX_GRD_COND_STATS* p_stats = &p_mtx_grd_cond->stats;
+
+    ++p_stats->wait_counter;
+    p_stats->wait_ns_total += wait_ns;
+
+    if(wait_ns > p_stats->wait_ns_max)
+        p_stats->wait_ns_max = wait_ns;
+
+    if(timed_out)
+    {
+        ++p_stats->timeout_counter;
+    }
+    else
+    {
+        uint64_t wakeup_latency_ns = (wait_end_ns > waiter.wake_ns) ? (wait_end_ns - waiter.wake_ns) : 0;
+
+        ++p_stats->wakeup_counter;
+        p_stats->wakeup_latency_ns_total += wakeup_latency_ns;
+
+        if(wakeup_latency_ns > p_stats->wakeup_latency_ns_max)
+            p_stats->wakeup_latency_ns_max = wakeup_latency_ns;
+    }
+
+    if(MutexGuardCondUnlockCtrlMutex(p_mtx_grd_cond, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    if(ret_lock == EOWNERDEAD)
+    {
+        mutex_guard_lock_error_code = EOWNERDEAD;
+        mutex_guard_errno           = MTX_GRD_ERR_OWNER_DEAD;
+        MutexGuardRecordLockFailure(p_mtx_grd, &p_mtx_grd->mutex_acq_location, &p_mtx_grd->dead_owner_location);
+
+        return EOWNERDEAD;
+    }
+
+    if(timed_out)
+    {
+        mutex_guard_lock_error_code = ETIMEDOUT;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+
+        return ETIMEDOUT;
+    }
+
+    mutex_guard_lock_error_code = 0;
+
+    return 0;
+}
+
+/// @brief Atomically releases target MTX_GRD and waits for the condition variable to be signaled, then locks the MTX_GRD again.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @param p_mtx_grd Pointer to mutex guard structure (locked exactly once by the calling thread).
+/// @param address Address in which the wait is performed (recorded as the new acquisition address).
+/// @return 0 if succeeded, < 0 if arguments or guard state are invalid, > 0 (standard error code) otherwise.
+int MutexGuardCondWait( MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond ,
+                        MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd           ,
+                        void* C_MUTEX_GUARD_RESTRICT address                )
+{
+    return MutexGuardCondWaitHelper(p_mtx_grd_cond, p_mtx_grd, address, NULL);
+}
+
+/// @brief Same as MutexGuardCondWait, but gives up waiting once the timeout (measured against CLOCK_MONOTONIC) has elapsed.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @param p_mtx_grd Pointer to mutex guard structure (locked exactly once by the calling thread).
+/// @param address Address in which the wait is performed (recorded as the new acquisition address).
+/// @param timeout_ns Target timeout value (in nanoseconds).
+/// @return 0 if succeeded, ETIMEDOUT if timeout elapsed, < 0 if arguments or guard state are invalid, > 0 (standard error code) otherwise.
+int MutexGuardCondTimedWait(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond ,
+                            MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd           ,
+                            void* C_MUTEX_GUARD_RESTRICT address                ,
+                            const uint64_t timeout_ns                           )
+{
+    mtx_to_t wait_timeout = MutexGuardGenClockTimespec(CLOCK_MONOTONIC, timeout_ns);
+
+    return MutexGuardCondWaitHelper(p_mtx_grd_cond, p_mtx_grd, address, &wait_timeout);
+}
+
+/// @brief Wakes up the longest waiting thread (if any).
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
 /// @return 0 if succeeded, < 0 otherwise.
-static int MutexGuardCopyLockError( MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard ,
-                                    const uint64_t timeout_ns       ,
-                                    const int ret_lock              ,
-                                    char* lock_error_string         ,
-                                    const size_t lock_error_str_size)
+int MutexGuardCondSignal(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond)
+{
+    if(!p_mtx_grd_cond)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_COND;
+        return -1;
+    }
+
+    if(MutexGuardCondLockCtrlMutex(p_mtx_grd_cond, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    MTX_GRD_COND_WAITER* p_waiter = MutexGuardCondQueuePop(&p_mtx_grd_cond->waiters);
+
+    if(p_waiter)
+    {
+        p_waiter->wake_ns = MutexGuardGetMonotonicNs();
+        MutexGuardCondWakeWaiter(p_waiter);
+    }
+
+    if(MutexGuardCondUnlockCtrlMutex(p_mtx_grd_cond, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    return 0;
+}
+
+/// @brief Wakes up every waiting thread. Only the first one is woken up straight away, the rest are requeued onto the
+/// associated MTX_GRD and woken up one at a time as it gets released, so no thundering herd happens.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardCondBroadcast(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond)
+{
+    if(!p_mtx_grd_cond)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_COND;
+        return -1;
+    }
+
+    if(MutexGuardCondLockCtrlMutex(p_mtx_grd_cond, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    MTX_GRD_COND_WAITER* p_first_waiter = MutexGuardCondQueuePop(&p_mtx_grd_cond->waiters);
+
+    if(p_first_waiter)
+    {
+        uint64_t wake_ns = MutexGuardGetMonotonicNs();
+        MTX_GRD* p_mtx_grd = p_mtx_grd_cond->p_mtx_grd;
+
+        // Lock order: condition ctrl_mutex first, then guard ctrl_mutex (never the other way around).
+        if(p_mtx_grd_cond->waiters.head)
+        {
+            if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+                mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+            MTX_GRD_COND_WAITER* p_waiter;
+
+            while((p_waiter = MutexGuardCondQueuePop(&p_mtx_grd_cond->waiters)))
+            {
+                p_waiter->wake_ns = wake_ns;
+                __atomic_store_n(&p_waiter->state, MTX_GRD_COND_WAITER_REQUEUED, __ATOMIC_RELEASE);
+                MutexGuardCondQueuePush(&p_mtx_grd->cond_requeued, p_waiter);
+                ++p_mtx_grd_cond->stats.requeue_counter;
+            }
+
+            if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
+                mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+        }
+
+        p_first_waiter->wake_ns = wake_ns;
+        MutexGuardCondWakeWaiter(p_first_waiter);
+    }
+
+    if(MutexGuardCondUnlockCtrlMutex(p_mtx_grd_cond, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    return 0;
+}
+
+/// @brief Copies condition variable statistics.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @param p_stats Pointer to the structure statistics are meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardCondGetStats( MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond ,
+                            MTX_GRD_COND_STATS* C_MUTEX_GUARD_RESTRICT p_stats  )
 {
-    if(!p_mutex_guard)
+    if(!p_mtx_grd_cond)
     {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_COND;
         return -1;
     }
 
-    if(!lock_error_string)
+    if(!p_stats)
     {
         mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
         return -2;
     }
 
-    MTX_GRD_ACQ_LOCATION mutex_guard_acq_location = {};
-
-    if(MutexGuardLockCtrlMutex(p_mutex_guard, false))
+    if(MutexGuardCondLockCtrlMutex(p_mtx_grd_cond, false))
         mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
 
-    memcpy(&mutex_guard_acq_location, &p_mutex_guard->mutex_acq_location, sizeof(MTX_GRD_ACQ_LOCATION));
-    
-    if(MutexGuardUnlockCtrlMutex(p_mutex_guard, false))
-        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+    memcpy(p_stats, &p_mtx_grd_cond->stats, sizeof(MTX_GRD_COND_STATS));
 
-    MutexGuardPrintLockErrorCause(  &mutex_guard_acq_location                           ,
-                                    &p_mutex_guard->mutex                               ,
-                                    timeout_ns                                          ,
-                                    ret_lock                                            ,
-                                    (lock_error_string + strlen(lock_error_string))     ,
-                                    (lock_error_str_size - strlen(lock_error_string))   );
+    if(MutexGuardCondUnlockCtrlMutex(p_mtx_grd_cond, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
 
-    MutexGuardPrintLockAddresses(   &mutex_guard_acq_location                           ,
-                                    (lock_error_string + strlen(lock_error_string))     ,
-                                    (lock_error_str_size - strlen(lock_error_string))   );
-    
     return 0;
 }
 
-/// @brief Gets lock error and copies it provided buffer.
-/// @param p_mutex_guard Pointer to mutex guard structure.
-/// @param timeout_ns Target timeout value (if any, in nanoseconds).
-/// @param lock_error_string Buffer where the error is meant to eb copied to.
-/// @param lock_error_str_size Buffer size.
-/// @return 0 if succeeded, < 0 otherwise.
-int MutexGuardGetLockError( MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard ,
-                            const uint64_t timeout_ns       ,
-                            char* lock_error_string         ,
-                            const size_t lock_error_str_size)
+/// @brief Destroys condition variable.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @return 0 if succeeded, != 0 otherwise.
+int MutexGuardCondDestroy(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond)
 {
-    if(!p_mutex_guard)
+    if(!p_mtx_grd_cond)
     {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_COND;
         return -1;
     }
 
-    if(!lock_error_string)
+    if(MutexGuardCondLockCtrlMutex(p_mtx_grd_cond, false))
     {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
         return -2;
     }
 
-    int copy_lock_error_string = MutexGuardCopyLockError(   p_mutex_guard               ,
-                                                            timeout_ns                  ,
-                                                            mutex_guard_lock_error_code ,
-                                                            lock_error_string           ,
-                                                            lock_error_str_size         );
-    
-    if(copy_lock_error_string < 0)
-    {   
-        strncat(lock_error_string                                   ,
-                MTX_GRD_GET_LAST_ERR_STR                            ,
-                (lock_error_str_size - strlen(lock_error_string))   );
-        
+    bool has_waiters = (p_mtx_grd_cond->waiters.head != NULL);
+
+    if(MutexGuardCondUnlockCtrlMutex(p_mtx_grd_cond, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    if(has_waiters)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_COND_BUSY;
         return -3;
     }
-    
+
+    if(MutexGuardCondDestroyCtrlMutex(p_mtx_grd_cond, false))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+        return -4;
+    }
+
+    p_mtx_grd_cond->p_mtx_grd = NULL;
+
     return 0;
 }
 
-/// @brief Stores lock error cause to a given buffer.
-/// @param p_mutex_guard_acq_location Pointer to mutex acquisition location struct.
-/// @param mutex_address Pointer to target mutex variable.
-/// @param timeout_ns Target timeout value (if any, in nanoseconds).
-/// @param ret_lock Value returned by pthread mutex locking function.
-/// @param lock_error_string Buffer where the error is meant to eb copied to.
-/// @param lock_error_str_size Buffer size.
-/// @return 0 if succeeded, < 0 otherwise.
-static int MutexGuardPrintLockErrorCause(   const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_mutex_guard_acq_location ,
-                                            const pthread_mutex_t* C_MUTEX_GUARD_RESTRICT mutex_address                   ,
-                                            const uint64_t timeout_ns                                       ,
-                                            const int ret_lock                                              ,
-                                            char* lock_error_string                                         ,
-                                            const size_t lock_error_str_size                                )
+/// @brief Cleanup function to destroy a condition variable (meant to be used alongside scoped condition init macros).
+/// @param ptr Pointer to condition variable structure.
+void MutexGuardCondDestroyCleanup(void* ptr)
 {
-    if(!p_mutex_guard_acq_location)
+    if(!ptr || !(*(MTX_GRD_COND**)ptr))
     {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_ACQ;
-        return -1;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_COND;
+        return;
     }
 
-    if(!lock_error_string)
+    MutexGuardCondDestroy(*(MTX_GRD_COND**)ptr);
+}
+
+/// @brief Initializes reader-writer guard control mutex.
+/// @param p_mtx_grd_rw Pointer to MTX_GRD_RW variable in which target control mutex is found.
+/// @param one_shot Tells whether should it be tried to init control mutex just once.
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardRwInitCtrlMutex(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const bool one_shot)
+{
+    MTX_GRD_CTRL_MUTEX_CONTROL_FLOW(pthread_mutex_init(&p_mtx_grd_rw->ctrl_mutex, NULL));
+}
+
+/// @brief Locks reader-writer guard control mutex.
+/// @param p_mtx_grd_rw Pointer to MTX_GRD_RW variable in which target control mutex is found.
+/// @param one_shot Tells whether should it be tried to lock control mutex just once.
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardRwLockCtrlMutex(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const bool one_shot)
+{
+    MTX_GRD_CTRL_MUTEX_CONTROL_FLOW(pthread_mutex_lock(&p_mtx_grd_rw->ctrl_mutex));
+}
+
+/// @brief Unlocks reader-writer guard control mutex.
+/// @param p_mtx_grd_rw Pointer to MTX_GRD_RW variable in which target control mutex is found.
+/// @param one_shot Tells whether should it be tried to unlock control mutex just once.
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardRwUnlockCtrlMutex(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const bool one_shot)
+{
+    MTX_GRD_CTRL_MUTEX_CONTROL_FLOW(pthread_mutex_unlock(&p_mtx_grd_rw->ctrl_mutex));
+}
+
+/// @brief Destroys reader-writer guard control mutex.
+/// @param p_mtx_grd_rw Pointer to MTX_GRD_RW variable in which target control mutex is found.
+/// @param one_shot Tells whether should it be tried to destroy control mutex just once.
+/// @return 0 if succeeded, != 0 otherwise.
+static int MutexGuardRwDestroyCtrlMutex(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const bool one_shot)
+{
+    MTX_GRD_CTRL_MUTEX_CONTROL_FLOW(pthread_mutex_destroy(&p_mtx_grd_rw->ctrl_mutex));
+}
+
+/// @brief Unregisters and releases an exiting thread's shared holds (destructor of rw_read_set_key).
+/// @param ptr Pointer to the thread's shared holds.
+static void MutexGuardRwReadSetRelease(void* ptr)
+{
+    MTX_GRD_RW_READ_SET* p_set = (MTX_GRD_RW_READ_SET*)ptr;
+
+    pthread_mutex_lock(&rw_read_sets_mutex);
+
+    if(p_set->prev)
+        p_set->prev->next = p_set->next;
+    else
+        rw_read_sets = p_set->next;
+
+    if(p_set->next)
+        p_set->next->prev = p_set->prev;
+
+    pthread_mutex_unlock(&rw_read_sets_mutex);
+
+    rw_read_set = NULL;
+    free(p_set);
+}
+
+/// @brief Creates the key threads' shared holds are released at exit with.
+static void MutexGuardRwReadSetKeyCreate(void)
+{
+    pthread_key_create(&rw_read_set_key, MutexGuardRwReadSetRelease);
+}
+
+/// @brief Gets the calling thread's shared holds, registering them on first use.
+/// @return Pointer to the calling thread's shared holds if succeeded, NULL otherwise.
+static MTX_GRD_RW_READ_SET* MutexGuardRwGetReadSet(void)
+{
+    if(rw_read_set)
+        return rw_read_set;
+
+    pthread_once(&rw_read_set_key_once, MutexGuardRwReadSetKeyCreate);
+
+    // Kept on cache lines of its own, as it is written by its thread on every shared acquisition.
+    MTX_GRD_RW_READ_SET* p_set;
+
+    if(posix_memalign((void**)&p_set, MTX_GRD_CACHE_LINE_SIZE, sizeof(MTX_GRD_RW_READ_SET)))
+        return NULL;
+
+    memset(p_set, 0, sizeof(MTX_GRD_RW_READ_SET));
+    p_set->thread_id    = pthread_self();
+    p_set->kernel_tid   = MutexGuardGetKernelTid();
+
+    pthread_mutex_lock(&rw_read_sets_mutex);
+
+    p_set->next = rw_read_sets;
+
+    if(rw_read_sets)
+        rw_read_sets->prev = p_set;
+
+    rw_read_sets = p_set;
+
+    pthread_mutex_unlock(&rw_read_sets_mutex);
+
+    pthread_setspecific(rw_read_set_key, p_set);
+    rw_read_set = p_set;
+
+    return p_set;
+}
+
+/// @brief Looks the calling thread's shared hold of a reader-writer guard up.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @return Pointer to the shared hold if found, NULL otherwise.
+static MTX_GRD_RW_READ* MutexGuardRwFindRead(const MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw)
+{
+    if(!rw_read_set)
+        return NULL;
+
+    for(size_t read_index = 0; read_index < rw_read_set->read_num; read_index++)
+        if(rw_read_set->reads[read_index].p_mtx_grd_rw == p_mtx_grd_rw)
+            return &rw_read_set->reads[read_index];
+
+    return NULL;
+}
+
+/// @brief Opens (odd sequence) or closes (even sequence) an update of the calling thread's shared holds.
+/// @param p_set Pointer to the calling thread's shared holds.
+/// @param closing Tells whether the update is being closed.
+static void MutexGuardRwReadSetUpdate(MTX_GRD_RW_READ_SET* C_MUTEX_GUARD_RESTRICT p_set, const bool closing)
+{
+    if(closing)
+        __atomic_store_n(&p_set->sequence, p_set->sequence + 1, __ATOMIC_RELEASE);
+    else
     {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
-        return -2;
+        __atomic_store_n(&p_set->sequence, p_set->sequence + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
     }
+}
 
-    if(timeout_ns > 0 && (ret_lock == ETIMEDOUT))
-        snprintf(   lock_error_string + strlen(lock_error_string)       ,
-                    (lock_error_str_size - strlen(lock_error_string))   ,
-                    MTX_GRD_MSG_ERR_MUTEX_TIMEOUT                       ,
-                    timeout_ns / MTX_GRD_TOUT_1_SEC_AS_NS               ,
-                    timeout_ns % MTX_GRD_TOUT_1_SEC_AS_NS               );
+/// @brief Records a shared hold in the calling thread's shared holds (which must have room for it).
+/// @param p_set Pointer to the calling thread's shared holds.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param address Address in which the guard was locked.
+/// @param acq_ns Acquisition time.
+/// @param bias_slot Visible readers slot the hold was published in (index + 1, 0 if the rwlock was read instead).
+static void MutexGuardRwAddRead(MTX_GRD_RW_READ_SET* C_MUTEX_GUARD_RESTRICT p_set ,
+                                MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw     ,
+                                void* C_MUTEX_GUARD_RESTRICT address                ,
+                                const uint64_t acq_ns                               ,
+                                const size_t bias_slot                              )
+{
+    MutexGuardRwReadSetUpdate(p_set, false);
+
+    MTX_GRD_RW_READ* p_read = &p_set->reads[p_set->read_num++];
+    p_read->p_mtx_grd_rw    = p_mtx_grd_rw;
+    p_read->address         = address;
+    p_read->acq_ns          = acq_ns;
+    p_read->lock_counter    = 1;
+    p_read->bias_slot       = bias_slot;
+
+    MutexGuardRwReadSetUpdate(p_set, true);
+}
+
+/// @brief Tries to hold a reader-biased guard in shared mode by publishing the calling thread in the visible readers table.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @return Slot the hold was published in (index + 1) if succeeded, 0 if the rwlock must be read instead.
+static size_t MutexGuardRwTryBiasedRead(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw)
+{
+    if(!__atomic_load_n(&p_mtx_grd_rw->bias, __ATOMIC_ACQUIRE))
+        return 0;
+
+    uint64_t slot_key   = (((uint64_t)MutexGuardGetKernelTid() << 32) ^ (uint64_t)(uintptr_t)p_mtx_grd_rw) * 0x9E3779B97F4A7C15ULL;
+    size_t slot_index   = (size_t)((slot_key >> 32) % __MTX_GRD_RW_BIAS_SLOT_NUM__);
+    MTX_GRD_RW* p_free  = NULL;
+
+    if(!__atomic_compare_exchange_n(&rw_bias_slots[slot_index].p_mtx_grd_rw, &p_free, p_mtx_grd_rw, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        return 0;
+
+    // Writers revoke the bias before scanning the table: either they find this slot, or the bias is seen revoked here.
+    if(__atomic_load_n(&p_mtx_grd_rw->bias, __ATOMIC_SEQ_CST))
+        return slot_index + 1;
+
+    __atomic_store_n(&rw_bias_slots[slot_index].p_mtx_grd_rw, NULL, __ATOMIC_RELEASE);
 
-    snprintf(   lock_error_string + strlen(lock_error_string)       ,
-                (lock_error_str_size - strlen(lock_error_string))   ,
-                MTX_GRD_MSG_ERR_MUTEX_ACQ                           ,
-                pthread_self()                                      ,
-                mutex_address                                       ,
-                strerror(ret_lock)                                  );
-    
-    if(p_mutex_guard_acq_location->addresses[0])
-        snprintf(   lock_error_string + strlen(lock_error_string)       ,
-                    (lock_error_str_size - strlen(lock_error_string))   ,
-                    MTX_GRD_MSG_ERR_MUTEX_ACQ_ADDR_HEADER               ,
-                    p_mutex_guard_acq_location->thread_id               );
-    
     return 0;
 }
 
-/// @brief Prints lock address history to a given buffer.
-/// @param p_mutex_guard_acq_location Pointer to given mutex acquisition location.
-/// @param lock_error_string Buffer where the error is meant to eb copied to.
-/// @param lock_error_str_size Buffer size.
-/// @return 0 if succeeded, < 0 otherwise.
-static int MutexGuardPrintLockAddresses(const MTX_GRD_ACQ_LOCATION* p_mutex_guard_acq_location  ,
-                                        char* lock_error_string                                 ,
-                                        const size_t lock_error_str_size                        )
+/// @brief Restores the reader bias of a guard read through its rwlock, if allowed and no longer inhibited.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure (held in shared mode through its rwlock, so no writer is revoking it).
+static void MutexGuardRwRestoreBias(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw)
 {
-    if(!p_mutex_guard_acq_location)
-    {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_ACQ;
-        return -1;
-    }
+    if( p_mtx_grd_rw->bias_allowed && !__atomic_load_n(&p_mtx_grd_rw->bias, __ATOMIC_RELAXED) &&
+        (MutexGuardGetMonotonicNs() >= p_mtx_grd_rw->bias_stats.inhibit_until_ns) )
+        __atomic_store_n(&p_mtx_grd_rw->bias, true, __ATOMIC_RELEASE);
+}
 
-    if(!lock_error_string)
-    {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
-        return -2;
-    }
+/// @brief Revokes the reader bias of a guard and waits for its biased readers to leave, then inhibits the bias for a multiple of the
+/// time that took.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure (whose rwlock is held for writing).
+/// @param lock_type Lock type (try, permanent or timed).
+/// @param p_abs_timeout Absolute CLOCK_REALTIME deadline of timed locks.
+/// @return 0 if succeeded, EBUSY or ETIMEDOUT if biased readers did not leave in time (the bias is restored then).
+static int MutexGuardRwRevokeBias(  MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw     ,
+                                    const MTX_GRD_LOCK_TYPES lock_type                  ,
+                                    const mtx_to_t* C_MUTEX_GUARD_RESTRICT p_abs_timeout)
+{
+    if(!__atomic_load_n(&p_mtx_grd_rw->bias, __ATOMIC_RELAXED))
+        return 0;
 
-    MTX_GRD_ACQ_LOCATION_DETAIL detail = {0};
+    uint64_t revocation_start_ns = MutexGuardGetMonotonicNs();
 
-    if(!p_mutex_guard_acq_location->addresses[0])
-    {
-        mutex_guard_errno = MTX_GRD_ERR_NO_STORED_LOCK_ADDRESSES;
-        return -3;
-    }
+    __atomic_store_n(&p_mtx_grd_rw->bias, false, __ATOMIC_SEQ_CST);
 
-    for(unsigned int adress_index = 0; adress_index < __MTX_GRD_ADDR_NUM__; adress_index++)
+    for(size_t slot_index = 0; slot_index < __MTX_GRD_RW_BIAS_SLOT_NUM__; slot_index++)
     {
-        if(!p_mutex_guard_acq_location->addresses[adress_index])
-            break;
-        
-        MutexGuardPrintFileAndLineFromAddr( p_mutex_guard_acq_location->addresses[adress_index] ,
-                                            lock_error_string                                   ,
-                                            adress_index                                        ,
-                                            &detail                                             ,
-                                            (lock_error_str_size - strlen(lock_error_string))   );
-        
-        memset(detail.function_name, 0, strlen(detail.function_name));
-        memset(detail.file_path, 0, strlen(detail.file_path));
-        detail.line = 0;
-        detail.relative_address = NULL;
+        while(__atomic_load_n(&rw_bias_slots[slot_index].p_mtx_grd_rw, __ATOMIC_SEQ_CST) == p_mtx_grd_rw)
+        {
+            int ret_revoke = 0;
+
+            if(lock_type == MTX_GRD_LOCK_TYPE_TRY)
+                ret_revoke = EBUSY;
+            else if(lock_type == MTX_GRD_LOCK_TYPE_TIMED)
+            {
+                mtx_to_t now;
+                clock_gettime(CLOCK_REALTIME, &now);
+
+                if( (now.tv_sec > p_abs_timeout->tv_sec) || ((now.tv_sec == p_abs_timeout->tv_sec) && (now.tv_nsec >= p_abs_timeout->tv_nsec)) )
+                    ret_revoke = ETIMEDOUT;
+            }
+
+            // Readers which missed the bias meanwhile wait for the rwlock, so those still published remain valid.
+            if(ret_revoke)
+            {
+                __atomic_store_n(&p_mtx_grd_rw->bias, true, __ATOMIC_RELEASE);
+                return ret_revoke;
+            }
+
+            sched_yield();
+        }
     }
 
+    uint64_t revocation_end_ns  = MutexGuardGetMonotonicNs();
+    uint64_t revocation_ns      = revocation_end_ns - revocation_start_ns;
+
+    if(MutexGuardRwLockCtrlMutex(p_mtx_grd_rw, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    p_mtx_grd_rw->bias_stats.inhibit_until_ns       = revocation_end_ns + (revocation_ns * __MTX_GRD_RW_BIAS_INHIBIT_FACTOR__);
+    p_mtx_grd_rw->bias_stats.revocation_ns_total    += revocation_ns;
+    ++p_mtx_grd_rw->bias_stats.revocation_counter;
+
+    if(revocation_ns > p_mtx_grd_rw->bias_stats.revocation_ns_max)
+        p_mtx_grd_rw->bias_stats.revocation_ns_max = revocation_ns;
+
+    if(MutexGuardRwUnlockCtrlMutex(p_mtx_grd_rw, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
     return 0;
 }
 
-/// @brief Directly prints mutex lock error to standard output.
-/// @param p_mutex_guard_acq_location Pointer to given mutex acquisition location.
-/// @param target_mutex_addr Pointer to target mutex variable.
-/// @param timeout_ns Target timeout value (if any, in nanoseconds).
-/// @param ret_lock Value returned by pthread mutex locking function.
-void MutexGuardPrintLockError(  const MTX_GRD_ACQ_LOCATION* C_MUTEX_GUARD_RESTRICT p_mutex_guard_acq_location ,
-                                const pthread_mutex_t* C_MUTEX_GUARD_RESTRICT target_mutex_addr               ,
-                                const uint64_t timeout_ns                                       ,
-                                const int ret_lock                                              )
+/// @brief Tells whether the calling thread holds a reader-writer guard in upgradable or exclusive mode.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @return true if it does, false otherwise.
+static bool MutexGuardRwIsWriter(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw)
 {
-    char lock_error_string[MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN] = {0};
-
-    strncat((lock_error_string + strlen(lock_error_string))                     ,
-            MTX_GRD_MSG_ERR_MUTEX_HEADER                                        ,
-            (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)));
-
-    MutexGuardPrintLockErrorCause(  p_mutex_guard_acq_location                                          ,
-                                    target_mutex_addr                                                   ,
-                                    timeout_ns                                                          ,
-                                    ret_lock                                                            ,
-                                    (lock_error_string + strlen(lock_error_string))                     ,
-                                    (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)));
+    return  __atomic_load_n(&p_mtx_grd_rw->writer.lock_counter, __ATOMIC_ACQUIRE) &&
+            pthread_equal(__atomic_load_n(&p_mtx_grd_rw->writer.thread_id, __ATOMIC_RELAXED), pthread_self());
+}
 
-    MutexGuardPrintLockAddresses(   p_mutex_guard_acq_location                                          ,
-                                    (lock_error_string + strlen(lock_error_string))                     ,
-                                    (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)));
+/// @brief Records (or forgets) the upgradable or exclusive holder of a reader-writer guard.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param p_writer Pointer to the holder to be recorded (NULL to forget the current one).
+static void MutexGuardRwSetWriter(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const MTX_GRD_RW_HOLDER* C_MUTEX_GUARD_RESTRICT p_writer)
+{
+    if(MutexGuardRwLockCtrlMutex(p_mtx_grd_rw, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
 
-    strncat((lock_error_string + strlen(lock_error_string))                     ,
-            MTX_GRD_MSG_ERR_MUTEX_FOOTER                                        ,
-            (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)));
+    if(p_writer)
+    {
+        p_mtx_grd_rw->writer.kernel_tid = p_writer->kernel_tid;
+        p_mtx_grd_rw->writer.mode       = p_writer->mode;
+        p_mtx_grd_rw->writer.address    = p_writer->address;
+        p_mtx_grd_rw->writer.acq_ns     = p_writer->acq_ns;
+        __atomic_store_n(&p_mtx_grd_rw->writer.thread_id, p_writer->thread_id, __ATOMIC_RELAXED);
+        __atomic_store_n(&p_mtx_grd_rw->writer.lock_counter, 1, __ATOMIC_RELEASE);
+    }
+    else
+        __atomic_store_n(&p_mtx_grd_rw->writer.lock_counter, 0, __ATOMIC_RELEASE);
 
-    printf("%s", lock_error_string);
+    if(MutexGuardRwUnlockCtrlMutex(p_mtx_grd_rw, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
 }
 
-/// @brief Directly prints mutex lock/unlock backtrace to standard output.
-/// @param p_locked_mutex Address of mutex to be locked/unlocked.
-/// @param is_lock true for locking operations, false for unlocking.
-static void MutexGuardShowBacktrace(const pthread_mutex_t* C_MUTEX_GUARD_RESTRICT p_locked_mutex, const bool is_lock)
+/// @brief Locks a reader-writer guard's rwlock for reading or writing.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param writing Tells whether it is locked for writing.
+/// @param lock_type Lock type (try, permanent or timed).
+/// @param p_abs_timeout Absolute CLOCK_REALTIME deadline of timed locks.
+/// @return 0 if succeeded, > 0 (standard error code) otherwise.
+static int MutexGuardRwAcquire( MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw     ,
+                                const bool writing                                  ,
+                                const MTX_GRD_LOCK_TYPES lock_type                  ,
+                                const mtx_to_t* C_MUTEX_GUARD_RESTRICT p_abs_timeout)
 {
-    void* call_stack[__MTX_GRD_FULL_BT_MAX_SIZE__ + 1] = {0};
-    int call_stack_size = backtrace(call_stack, __MTX_GRD_FULL_BT_MAX_SIZE__ + 1);
-    char** call_stack_symbols = backtrace_symbols(call_stack, call_stack_size);
+    if(lock_type == MTX_GRD_LOCK_TYPE_TRY)
+        return (writing ? pthread_rwlock_trywrlock(&p_mtx_grd_rw->rwlock) : pthread_rwlock_tryrdlock(&p_mtx_grd_rw->rwlock));
 
-    if(call_stack_symbols && call_stack_symbols[1])
-    {
-        char bt_id_str[MTX_GRD_BT_ID_LEN] = {0};
+    if(lock_type == MTX_GRD_LOCK_TYPE_TIMED)
+        return (writing ? pthread_rwlock_timedwrlock(&p_mtx_grd_rw->rwlock, p_abs_timeout) : pthread_rwlock_timedrdlock(&p_mtx_grd_rw->rwlock, p_abs_timeout));
 
-        snprintf(   bt_id_str                                                   ,
-                    MTX_GRD_BT_ID_LEN                                           ,
-                    MTX_GRD_BT_ID_FORMAT                                        ,
-                    pthread_self()                                              ,
-                    p_locked_mutex                                              ,
-                    is_lock ? MTX_GRD_BT_ID_LOCK_STR : MTX_GRD_BT_ID_UNLOCK_STR );
+    return (writing ? pthread_rwlock_wrlock(&p_mtx_grd_rw->rwlock) : pthread_rwlock_rdlock(&p_mtx_grd_rw->rwlock));
+}
 
-        printf("%s%s\r\n", bt_id_str, MTX_GRD_BT_HEADER);
+/// @brief Initializes reader-writer guard.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param preference Whether waiting writers hold new readers back or not.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardRwInit(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const MTX_GRD_RW_PREFERENCE preference)
+{
+    if(!p_mtx_grd_rw)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_RW;
+        return -1;
+    }
 
-        unsigned bt_id_str_len = strlen(bt_id_str);
+    if( (preference < MTX_GRD_RW_PREFER_MIN) || (preference > MTX_GRD_RW_PREFER_MAX) )
+    {
+        mutex_guard_errno = MTX_GRD_ERR_ATTR_SET_FAILED;
+        return -2;
+    }
 
-        char lock_error_string[MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN] = {0};
-        strncpy(lock_error_string, bt_id_str, MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string));
-        MTX_GRD_ACQ_LOCATION_DETAIL detail = {0};
+    memset(p_mtx_grd_rw, 0, sizeof(MTX_GRD_RW));
+    p_mtx_grd_rw->preference = preference;
 
-        for(unsigned long long call_stack_index = 1; call_stack_index < call_stack_size; call_stack_index++)
-        {
-            snprintf((lock_error_string + strlen(lock_error_string))                    ,
-                    (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)),
-                    MTX_GRD_BT_FRAME_INFO                                               ,
-                    (call_stack_index - 1)                                              ,
-                    call_stack_symbols[call_stack_index]                                );
+    // Shared holds are made recursive by their threads' bookkeeping, so writers can be preferred without risking recursive readers to
+    // deadlock behind them.
+    pthread_rwlockattr_t rwlock_attr;
+    int ret_init = pthread_rwlockattr_init(&rwlock_attr);
 
-            char* rel_addr_begin = strstr(call_stack_symbols[call_stack_index], MTX_GRD_BT_REL_ADDR_BEGIN_STR);
-            char* rel_addr_end = strstr(call_stack_symbols[call_stack_index], MTX_GRD_BT_REL_ADDR_END_STR);
-            
-            if(!rel_addr_begin || !rel_addr_end)
-            {
-                printf("\r\n");
-                continue;
-            }
+    if(!ret_init)
+    {
+        ret_init = pthread_rwlockattr_setkind_np(&rwlock_attr, ((preference == MTX_GRD_RW_PREFER_WRITERS) ? PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP : PTHREAD_RWLOCK_PREFER_READER_NP));
 
-            char* end_ptr;
+        if(!ret_init)
+            ret_init = pthread_rwlock_init(&p_mtx_grd_rw->rwlock, &rwlock_attr);
 
-            *rel_addr_end = 0;
-            unsigned long long rel_addr = strtoull( rel_addr_begin + strlen(MTX_GRD_BT_REL_ADDR_BEGIN_STR),
-                                                    &end_ptr,
-                                                    MTX_GRD_BT_REL_ADDR_HEX_BASE);
-            
-            if(*end_ptr)
-            {
-                printf("\r\n");
-                continue;
-            }
+        pthread_rwlockattr_destroy(&rwlock_attr);
+    }
 
-            detail.relative_address = (void*)rel_addr;
-            
-            MutexGuardGetLockDetailFromAddr(NULL, &detail);
+    if(ret_init)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INIT_FAILED;
+        return -3;
+    }
 
-            if(strcmp(detail.file_path, MTX_GRD_BT_NOT_FOUND_SYMBOL))
-                snprintf(   (lock_error_string + strlen(lock_error_string))                     ,
-                            (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)),
-                            MTX_GRD_BT_FRAME_TO_FILE_FORMAT                                     ,
-                            detail.file_path                                                    );
+    if(pthread_mutex_init(&p_mtx_grd_rw->writer_mutex, NULL))
+    {
+        pthread_rwlock_destroy(&p_mtx_grd_rw->rwlock);
 
-            if(detail.line)
-                snprintf(   (lock_error_string + strlen(lock_error_string))                     ,
-                            (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)),
-                             MTX_GRD_BT_FRAME_TO_LINE_FORMAT                                    ,
-                            detail.line                                                         );
-            
-            if(strcmp(detail.function_name, MTX_GRD_BT_NOT_FOUND_SYMBOL))
-                snprintf(   (lock_error_string + strlen(lock_error_string))                     ,
-                            (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(lock_error_string)),
-                            MTX_GRD_BT_FRAME_TO_FUNCTION_FORMAT                                 ,
-                            detail.function_name                                                );
+        mutex_guard_errno = MTX_GRD_ERR_INIT_FAILED;
+        return -3;
+    }
 
-            printf("%s\r\n", lock_error_string);
-            memset(lock_error_string + bt_id_str_len, 0, strlen(lock_error_string + bt_id_str_len));
-        }
+    if(MutexGuardRwInitCtrlMutex(p_mtx_grd_rw, true))
+    {
+        pthread_mutex_destroy(&p_mtx_grd_rw->writer_mutex);
+        pthread_rwlock_destroy(&p_mtx_grd_rw->rwlock);
 
-        printf("%s%s\r\n", bt_id_str, MTX_GRD_BT_FOOTER);
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+        return -4;
     }
+
+    return 0;
 }
 
-/// @brief Locks target mutex.
-/// @param p_mutex_guard Pointer to mutex guard structure.
-/// @param address Address in which the current mutex is being tried to be locked.
-/// @param timeout_ns Target timeout value (if any, in nanoseconds).
-/// @param lock_type Lock type (TR_LOCK, LOCK, TIMED_LOCK, PERIODIC_TIMED_LOCK).
-/// @return 0 if succeeded, != 0 otherwise.
-int MutexGuardLock(MTX_GRD* p_mutex_guard, void* C_MUTEX_GUARD_RESTRICT address, const uint64_t timeout_ns, const int lock_type)
+/// @brief MutexGuardRwInit function wrapper.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param preference Whether waiting writers hold new readers back or not.
+/// @return Pointer to given reader-writer guard structure if succeeded, NULL otherwise.
+MTX_GRD_RW* MutexGuardRwInitAddr(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const MTX_GRD_RW_PREFERENCE preference)
 {
-    if(!p_mutex_guard)
+    return (MutexGuardRwInit(p_mtx_grd_rw, preference) ? NULL : p_mtx_grd_rw);
+}
+
+/// @brief Locks reader-writer guard in given mode.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param mode Target lock mode.
+/// @param address Address in which the guard is being locked.
+/// @param timeout_ns Target timeout value (in nanoseconds, only used by timed locks).
+/// @param lock_type Lock type (try, permanent or timed).
+/// @return 0 if succeeded, < 0 if arguments are invalid, > 0 (standard error code) otherwise.
+int MutexGuardRwLock(   MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw ,
+                        const MTX_GRD_RW_MODES mode                     ,
+                        void* C_MUTEX_GUARD_RESTRICT address            ,
+                        const uint64_t timeout_ns                       ,
+                        const MTX_GRD_LOCK_TYPES lock_type              )
+{
+    if(!p_mtx_grd_rw)
     {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_RW;
         return -1;
     }
 
-    MTX_GRD_ACQ_LOCATION target_mutex_acq_location;
+    if( (mode < MTX_GRD_RW_MODE_MIN) || (mode > MTX_GRD_RW_MODE_MAX) )
+    {
+        mutex_guard_errno = MTX_GRD_ERR_RW_INVALID_MODE;
+        return -2;
+    }
 
-    // The mutex lock below is performed for other threads not to coincidentally modify the content within the provided MTX_GRD variable.
-    if(MutexGuardLockCtrlMutex(p_mutex_guard, false))
-        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+    if( (lock_type != MTX_GRD_LOCK_TYPE_TRY) && (lock_type != MTX_GRD_LOCK_TYPE_PERMANENT) && (lock_type != MTX_GRD_LOCK_TYPE_TIMED) )
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INVALID_LOCK_TYPE;
+        return -3;
+    }
 
-    memcpy(&target_mutex_acq_location, &p_mutex_guard->mutex_acq_location, sizeof(MTX_GRD_ACQ_LOCATION));
-    
-    if(MutexGuardUnlockCtrlMutex(p_mutex_guard, false))
-        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+    MTX_GRD_RW_READ* p_read = MutexGuardRwFindRead(p_mtx_grd_rw);
 
-    int ret_lock;
+    if(p_read && (mode == MTX_GRD_RW_MODE_SHARED))
+    {
+        MutexGuardRwReadSetUpdate(rw_read_set, false);
+        ++p_read->lock_counter;
+        MutexGuardRwReadSetUpdate(rw_read_set, true);
 
-    if( (lock_type < MTX_GRD_LOCK_TYPE_MIN) || (lock_type > MTX_GRD_LOCK_TYPE_MAX) )
+        return 0;
+    }
+
+    // Any other hold would wait for the calling thread itself.
+    if(p_read || MutexGuardRwIsWriter(p_mtx_grd_rw))
     {
-        mutex_guard_errno = MTX_GRD_ERR_INVALID_LOCK_TYPE;
-        return -2;
+        mutex_guard_lock_error_code = EDEADLK;
+        mutex_guard_errno           = MTX_GRD_ERR_LOCK_ERROR;
+        return EDEADLK;
     }
-    
-    mtx_to_t timed_lock_timeout;
 
-    if( (lock_type == MTX_GRD_LOCK_TYPE_TIMED) || (lock_type == MTX_GRD_LOCK_TYPE_PERIODIC) )
-        timed_lock_timeout = MutexGuardGenTimespec(timeout_ns);
-    
-    switch (lock_type)
+    MTX_GRD_RW_READ_SET* p_set = NULL;
+
+    if(mode == MTX_GRD_RW_MODE_SHARED)
     {
-        case MTX_GRD_LOCK_TYPE_TRY:
-        {
-            ret_lock = pthread_mutex_trylock(&p_mutex_guard->mutex);
-        }
-        break;
+        p_set = MutexGuardRwGetReadSet();
 
-        case MTX_GRD_LOCK_TYPE_PERMANENT:
+        if(!p_set)
         {
-            ret_lock = pthread_mutex_lock(&p_mutex_guard->mutex);
-        }
-        break;
-        
-        case MTX_GRD_LOCK_TYPE_TIMED:
-        {            
-            ret_lock = pthread_mutex_timedlock(&p_mutex_guard->mutex, &timed_lock_timeout);
+            mutex_guard_lock_error_code = ENOMEM;
+            mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+            return ENOMEM;
         }
-        break;
-
-        case MTX_GRD_LOCK_TYPE_PERIODIC:
-        {
-            do
-            {
-                ret_lock = pthread_mutex_timedlock(&p_mutex_guard->mutex, &timed_lock_timeout);
-                
-                if(ret_lock == ETIMEDOUT)
-                    if(verbosity_level & MTX_GRD_VERBOSITY_LOCK_ERROR)
-                        MutexGuardPrintLockError(&target_mutex_acq_location, &p_mutex_guard->mutex, timeout_ns, ret_lock);
-            }
-            while(ret_lock == ETIMEDOUT);
-        }   
-        break;
 
-        default:
+        if(p_set->read_num == __MTX_GRD_RW_READ_NUM__)
         {
-            mutex_guard_errno = MTX_GRD_ERR_INVALID_LOCK_TYPE;
-            return -2;
+            mutex_guard_errno = MTX_GRD_ERR_RW_READ_SET_FULL;
+            return -4;
         }
-        break;
     }
 
-    if(ret_lock)
-    {        
-        if(verbosity_level & MTX_GRD_VERBOSITY_LOCK_ERROR)
-            MutexGuardPrintLockError(&target_mutex_acq_location, &p_mutex_guard->mutex, timeout_ns, ret_lock);
+    mtx_to_t timed_lock_timeout = { 0, 0 };
 
-        mutex_guard_errno           = MTX_GRD_ERR_LOCK_ERROR;
-        mutex_guard_lock_error_code = ret_lock;
+    if(lock_type == MTX_GRD_LOCK_TYPE_TIMED)
+        timed_lock_timeout = MutexGuardGenTimespec(timeout_ns);
 
-        if(MutexGuardLockCtrlMutex(p_mutex_guard, false))
-            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+    int ret_lock;
+    size_t bias_slot = 0;
 
-        memcpy(&last_failed_mutex_guard, p_mutex_guard, sizeof(MTX_GRD));
-        
-        if(MutexGuardUnlockCtrlMutex(p_mutex_guard, false))
-            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+    if(mode == MTX_GRD_RW_MODE_SHARED)
+    {
+        bias_slot   = MutexGuardRwTryBiasedRead(p_mtx_grd_rw);
+        ret_lock    = (bias_slot ? 0 : MutexGuardRwAcquire(p_mtx_grd_rw, false, lock_type, &timed_lock_timeout));
 
-        return ret_lock;
+        if(!ret_lock && !bias_slot)
+            MutexGuardRwRestoreBias(p_mtx_grd_rw);
     }
+    else
+    {
+        // Upgradable and exclusive holders take the writer mutex first, so that no writer gets in while upgradable ones are upgraded.
+        if(lock_type == MTX_GRD_LOCK_TYPE_TRY)
+            ret_lock = pthread_mutex_trylock(&p_mtx_grd_rw->writer_mutex);
+        else if(lock_type == MTX_GRD_LOCK_TYPE_TIMED)
+            ret_lock = pthread_mutex_timedlock(&p_mtx_grd_rw->writer_mutex, &timed_lock_timeout);
+        else
+            ret_lock = pthread_mutex_lock(&p_mtx_grd_rw->writer_mutex);
 
-    mutex_guard_lock_error_code = 0;
-
-    
-    if(MutexGuardLockCtrlMutex(p_mutex_guard, false))
-        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+        if(!ret_lock)
+        {
+            ret_lock = MutexGuardRwAcquire(p_mtx_grd_rw, (mode == MTX_GRD_RW_MODE_EXCLUSIVE), lock_type, &timed_lock_timeout);
 
-    MutexGuardStoreNewAddress(p_mutex_guard, address);
+            if(!ret_lock && (mode == MTX_GRD_RW_MODE_EXCLUSIVE))
+            {
+                ret_lock = MutexGuardRwRevokeBias(p_mtx_grd_rw, lock_type, &timed_lock_timeout);
 
-    p_mutex_guard->mutex_acq_location.thread_id = pthread_self();
+                if(ret_lock)
+                    pthread_rwlock_unlock(&p_mtx_grd_rw->rwlock);
+            }
 
-    ++p_mutex_guard->lock_counter;
-    
-    if(p_mutex_guard->lock_counter > __MTX_GRD_ADDR_NUM__)
-        mutex_guard_errno = MTX_GRD_ERR_OUT_OF_ADDR_COUNTER_BOUNDARIES;
+            if(ret_lock)
+                pthread_mutex_unlock(&p_mtx_grd_rw->writer_mutex);
+        }
+    }
 
-    if(verbosity_level & MTX_GRD_VERBOSITY_BT)
-        MutexGuardShowBacktrace(&p_mutex_guard->mutex, true);
+    if(ret_lock)
+    {
+        mutex_guard_lock_error_code = ret_lock;
+        mutex_guard_errno           = MTX_GRD_ERR_LOCK_ERROR;
+        return ret_lock;
+    }
 
-    if(MutexGuardUnlockCtrlMutex(p_mutex_guard, false))
-        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+    if(mode == MTX_GRD_RW_MODE_SHARED)
+        MutexGuardRwAddRead(p_set, p_mtx_grd_rw, address, MutexGuardGetMonotonicNs(), bias_slot);
+    else
+    {
+        MTX_GRD_RW_HOLDER writer = { .thread_id = pthread_self(), .kernel_tid = MutexGuardGetKernelTid(), .mode = mode, .address = address, .acq_ns = MutexGuardGetMonotonicNs() };
+        MutexGuardRwSetWriter(p_mtx_grd_rw, &writer);
+    }
 
-    return ret_lock;
+    return 0;
 }
 
-C_MUTEX_GUARD_API MTX_GRD* MutexGuardLockAddr(  MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard ,
-                                                void* C_MUTEX_GUARD_RESTRICT address          ,
-                                                const uint64_t timeout_ns       ,
-                                                const int lock_type             )
+/// @brief MutexGuardRwLock function wrapper.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param mode Target lock mode.
+/// @param address Address in which the guard is being locked.
+/// @param timeout_ns Target timeout value (in nanoseconds, only used by timed locks).
+/// @param lock_type Lock type (try, permanent or timed).
+/// @return Pointer to given reader-writer guard structure if succeeded, NULL otherwise.
+MTX_GRD_RW* MutexGuardRwLockAddr(   MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw ,
+                                    const MTX_GRD_RW_MODES mode                     ,
+                                    void* C_MUTEX_GUARD_RESTRICT address            ,
+                                    const uint64_t timeout_ns                       ,
+                                    const MTX_GRD_LOCK_TYPES lock_type              )
 {
-    return (MutexGuardLock(p_mutex_guard, address, timeout_ns, lock_type) ? NULL : p_mutex_guard);
+    return (MutexGuardRwLock(p_mtx_grd_rw, mode, address, timeout_ns, lock_type) ? NULL : p_mtx_grd_rw);
 }
 
-/// @brief Gets base address of the executable in which a mutex lock error has happened.
-/// @return 0 if succeeded, < 0 otherwise.
-static size_t MutexGuardGetExecutableBaseddress(void)
+/// @brief Turns the calling thread's upgradable hold of a reader-writer guard into an exclusive one, once other readers left.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param address Address in which the guard is being upgraded.
+/// @param timeout_ns Target timeout value (in nanoseconds, only used by timed upgrades).
+/// @param lock_type Lock type (try, permanent or timed).
+/// @return 0 if succeeded, < 0 if arguments are invalid, > 0 (standard error code) otherwise (the upgradable hold is kept then).
+int MutexGuardRwUpgrade(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw ,
+                        void* C_MUTEX_GUARD_RESTRICT address            ,
+                        const uint64_t timeout_ns                       ,
+                        const MTX_GRD_LOCK_TYPES lock_type              )
 {
-    FILE *maps = fopen(MTX_GRD_PROC_MAPS_PATH, "r");
-    
-    if (!maps)
+    if(!p_mtx_grd_rw)
     {
-        mutex_guard_errno = MTX_GRD_ERR_COULD_NOT_FIND_PROCESS;
-        return 0;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_RW;
+        return -1;
     }
 
-    char line[MTX_GRD_PROC_MAX_LEN];
-    size_t start = 0;
+    if( (lock_type != MTX_GRD_LOCK_TYPE_TRY) && (lock_type != MTX_GRD_LOCK_TYPE_PERMANENT) && (lock_type != MTX_GRD_LOCK_TYPE_TIMED) )
+    {
+        mutex_guard_errno = MTX_GRD_ERR_INVALID_LOCK_TYPE;
+        return -2;
+    }
 
-    while (fgets(line, sizeof(line), maps))
+    if(!MutexGuardRwIsWriter(p_mtx_grd_rw) || (p_mtx_grd_rw->writer.mode != MTX_GRD_RW_MODE_UPGRADABLE))
     {
-        if (strstr(line, "/"))
-        {
-            sscanf(line, "%lx", &start);
-            break;
-        }
+        mutex_guard_errno = MTX_GRD_ERR_NOT_LOCKED;
+        return -3;
     }
 
-    int close_maps = fclose(maps);
+    mtx_to_t timed_lock_timeout = { 0, 0 };
 
-    if(close_maps)
-        mutex_guard_errno = MTX_GRD_ERR_COULD_NOT_CLOSE_PROC_FILE;
+    if(lock_type == MTX_GRD_LOCK_TYPE_TIMED)
+        timed_lock_timeout = MutexGuardGenTimespec(timeout_ns);
 
-    return start;
+    // Writers wait for the writer mutex, so only readers may get the guard in between: the read hold is taken back right away
+    // if the upgrade fails.
+    pthread_rwlock_unlock(&p_mtx_grd_rw->rwlock);
+
+    int ret_lock = MutexGuardRwAcquire(p_mtx_grd_rw, true, lock_type, &timed_lock_timeout);
+
+    if(!ret_lock && (ret_lock = MutexGuardRwRevokeBias(p_mtx_grd_rw, lock_type, &timed_lock_timeout)))
+        pthread_rwlock_unlock(&p_mtx_grd_rw->rwlock);
+
+    if(ret_lock)
+    {
+        pthread_rwlock_rdlock(&p_mtx_grd_rw->rwlock);
+
+        mutex_guard_lock_error_code = ret_lock;
+        mutex_guard_errno           = MTX_GRD_ERR_LOCK_ERROR;
+        return ret_lock;
+    }
+
+    MTX_GRD_RW_HOLDER writer    = p_mtx_grd_rw->writer;
+    writer.mode                 = MTX_GRD_RW_MODE_EXCLUSIVE;
+    writer.address              = address;
+    MutexGuardRwSetWriter(p_mtx_grd_rw, &writer);
+
+    return 0;
 }
 
-/// @brief Gets mutex lock acquisition details from the address in which a mutex was meant to be stored.
-/// @param addr Mutex lock address.
-/// @param detail Pointer to lock acquisition detail struct.
+/// @brief Turns the calling thread's exclusive or upgradable hold of a reader-writer guard into a weaker one.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param mode Target lock mode.
 /// @return 0 if succeeded, < 0 otherwise.
-static int MutexGuardGetLockDetailFromAddr(const void* C_MUTEX_GUARD_RESTRICT addr, MTX_GRD_ACQ_LOCATION_DETAIL* C_MUTEX_GUARD_RESTRICT detail)
+int MutexGuardRwDowngrade(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const MTX_GRD_RW_MODES mode)
 {
-    char cmd[MTX_GRD_ADDR2LINE_CMD_FORMAT_MAX_LEN + 1] = {0};
-    char full_path[PATH_MAX + 1] = {0};
-    
-    if(readlink(MTX_GRD_CURRENT_PROC_PATH, full_path, sizeof(full_path) - 1) < 0)
+    if(!p_mtx_grd_rw)
     {
-        mutex_guard_errno = MTX_GRD_ERR_COULD_NOT_FIND_EXE_PATH;
-        return -1;
-    }
-    
-    if(!detail->relative_address)
-        detail->relative_address = (void*)((size_t)addr - MutexGuardGetExecutableBaseddress());
-
-    snprintf(   cmd                                 ,
-                MTX_GRD_ADDR2LINE_CMD_FORMAT_MAX_LEN,
-                MTX_GRD_ADDR2LINE_CMD_FORMAT        ,
-                full_path                           ,
-                detail->relative_address            );
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_RW;
+        return -1;
+    }
 
-    FILE *fp = popen(cmd, "r");
-    
-    if (fp == NULL)
+    if(!MutexGuardRwIsWriter(p_mtx_grd_rw))
     {
-        mutex_guard_errno = MTX_GRD_ERR_COULD_NOT_EXECUTE_ADDR2LINE;
+        mutex_guard_errno = MTX_GRD_ERR_NOT_LOCKED;
         return -2;
     }
 
-    char line[PATH_MAX + 1] = {0};
-    
-    while (fgets(line, sizeof(line), fp) != NULL)
+    MTX_GRD_RW_HOLDER writer = p_mtx_grd_rw->writer;
+
+    if( (mode < MTX_GRD_RW_MODE_MIN) || (mode >= writer.mode) )
     {
-        line[strcspn(line, "\n")] = 0;
+        mutex_guard_errno = MTX_GRD_ERR_RW_INVALID_MODE;
+        return -3;
+    }
 
-        char* at_pos = strrchr(line, MTX_GRD_FN_LINE_DELIMITER);
-        if(at_pos)
-        {
-            char* acq_line_start = at_pos + sizeof(char);
-            
-            if(acq_line_start && acq_line_start[0] >= '0' && acq_line_start[0] <= '9')
-                detail->line = atol(acq_line_start);
-            else
-                detail->line = 0;
-            
-            memset(at_pos, 0, strlen(at_pos));
-            strncpy(detail->file_path, line, PATH_MAX);
-        }
-        else
+    MTX_GRD_RW_READ_SET* p_set = NULL;
+
+    if(mode == MTX_GRD_RW_MODE_SHARED)
+    {
+        p_set = MutexGuardRwGetReadSet();
+
+        if(!p_set || (p_set->read_num == __MTX_GRD_RW_READ_NUM__))
         {
-            strncpy(detail->function_name, line, MTX_GRD_ACQ_FN_NAME_LEN);
+            mutex_guard_errno = MTX_GRD_ERR_RW_READ_SET_FULL;
+            return -4;
         }
     }
 
-    int close_addr2line = pclose(fp);
-    
-    if(close_addr2line)
-        mutex_guard_errno = MTX_GRD_ERR_COULD_NOT_CLOSE_ADDR2LINE;
-
-    return 0;
-}
+    // No writer can be waiting for the rwlock while the writer mutex is held, so reading it again does not block.
+    if(writer.mode == MTX_GRD_RW_MODE_EXCLUSIVE)
+    {
+        pthread_rwlock_unlock(&p_mtx_grd_rw->rwlock);
+        pthread_rwlock_rdlock(&p_mtx_grd_rw->rwlock);
+    }
 
-/// @brief Prints file and line to a buffer given an address.
-/// @param addr Target address to be detailed.
-/// @param output_buffer Output buffer.
-/// @param address_index Address index within mutex guard.
-/// @param detail Pointer to mutex acquisition detail struct. 
-/// @param lock_error_str_size Output buffer size.
-/// @return 0 if succeeded, < 0 otherwise.
-static int MutexGuardPrintFileAndLineFromAddr(  const void* C_MUTEX_GUARD_RESTRICT addr                   ,
-                                                char* output_buffer                         ,
-                                                const unsigned int address_index            ,
-                                                MTX_GRD_ACQ_LOCATION_DETAIL* C_MUTEX_GUARD_RESTRICT detail,
-                                                const size_t lock_error_str_size            )
-{
-    int ret = MutexGuardGetLockDetailFromAddr(addr, detail);
-    if(ret < 0)
-        return ret;
-    
-    snprintf(   output_buffer + strlen(output_buffer)           ,
-                (lock_error_str_size - strlen(output_buffer))   ,
-                MTX_GRD_ACQ_LOCATION_FULL_FORMAT                ,
-                address_index                                   ,
-                addr                                            ,
-                detail->relative_address                        ,
-                detail->function_name                           ,
-                detail->file_path                               ,
-                detail->line                                    );
-    
-    if(detail->line == 0)
+    if(mode == MTX_GRD_RW_MODE_UPGRADABLE)
     {
-        char* line_delimiter_pos = strrchr(output_buffer, MTX_GRD_FN_LINE_DELIMITER);
-        if(line_delimiter_pos)
-        {
-            memset(line_delimiter_pos, 0, strlen(line_delimiter_pos));
-            strncat(output_buffer, "\r\n", (MTX_GRD_MSG_ERR_MUTEX_LOCK_ERR_STR_LEN - strlen(output_buffer)));
-        }
+        writer.mode = MTX_GRD_RW_MODE_UPGRADABLE;
+        MutexGuardRwSetWriter(p_mtx_grd_rw, &writer);
+
+        return 0;
     }
 
-    return 0;
-}
+    MutexGuardRwAddRead(p_set, p_mtx_grd_rw, writer.address, writer.acq_ns, 0);
+    MutexGuardRwSetWriter(p_mtx_grd_rw, NULL);
+    pthread_mutex_unlock(&p_mtx_grd_rw->writer_mutex);
 
-/// @brief Returns address within the program of line in which the current function was called. Meant to be used in macros.
-/// @return Current function calling address.
-C_MUTEX_GUARD_NOINLINE void* MutexGuardGetFuncRetAddr(void)
-{
-    return __builtin_return_address(0); 
+    return 0;
 }
 
-/// @brief Unlocks target mutex.
-/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @brief Releases the calling thread's hold of a reader-writer guard.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
 /// @return 0 if succeeded, != 0 otherwise.
-int MutexGuardUnlock(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+int MutexGuardRwUnlock(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw)
 {
-    if(!p_mtx_grd)
+    if(!p_mtx_grd_rw)
     {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_RW;
         return -1;
     }
 
-    if(p_mtx_grd->mutex_acq_location.thread_id == 0)
+    if(MutexGuardRwIsWriter(p_mtx_grd_rw))
+    {
+        MutexGuardRwSetWriter(p_mtx_grd_rw, NULL);
+
+        int ret_unlock = pthread_rwlock_unlock(&p_mtx_grd_rw->rwlock);
+
+        if(pthread_mutex_unlock(&p_mtx_grd_rw->writer_mutex) && !ret_unlock)
+            ret_unlock = EPERM;
+
+        if(ret_unlock)
+        {
+            mutex_guard_lock_error_code = ret_unlock;
+            mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        }
+
+        return ret_unlock;
+    }
+
+    MTX_GRD_RW_READ* p_read = MutexGuardRwFindRead(p_mtx_grd_rw);
+
+    if(!p_read)
     {
         mutex_guard_errno = MTX_GRD_ERR_NOT_LOCKED;
         return -2;
     }
 
-    if(pthread_self() != p_mtx_grd->mutex_acq_location.thread_id)
+    MutexGuardRwReadSetUpdate(rw_read_set, false);
+
+    bool releasing      = (--p_read->lock_counter == 0);
+    size_t bias_slot    = p_read->bias_slot;
+
+    if(releasing)
+        *p_read = rw_read_set->reads[--rw_read_set->read_num];
+
+    MutexGuardRwReadSetUpdate(rw_read_set, true);
+
+    if(!releasing)
+        return 0;
+
+    if(bias_slot)
     {
-        mutex_guard_errno = MTX_GRD_ERR_INVALID_OWNER_TID;
-        return -3;
+        __atomic_store_n(&rw_bias_slots[bias_slot - 1].p_mtx_grd_rw, NULL, __ATOMIC_RELEASE);
+        return 0;
     }
 
-    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
-        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+    int ret_unlock = pthread_rwlock_unlock(&p_mtx_grd_rw->rwlock);
 
-    int ret_unlock = pthread_mutex_unlock(&p_mtx_grd->mutex);
-    
     if(ret_unlock)
     {
         mutex_guard_lock_error_code = ret_unlock;
         mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
-        
-        if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
-            mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
-
-        return ret_unlock;
     }
 
-    mutex_guard_lock_error_code = 0;
+    return ret_unlock;
+}
 
-    MutexGuardRemoveLatestAddress(p_mtx_grd);
+/// @brief Enables or disables reader bias.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param enable Tells whether reader bias is meant to be enabled.
+/// @return 0 if succeeded, < 0 if arguments are invalid, > 0 (standard error code) otherwise.
+int MutexGuardRwSetReaderBias(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const bool enable)
+{
+    // Held exclusively, so that readers see the change in order and any current bias is revoked.
+    int ret_lock = MutexGuardRwLock(p_mtx_grd_rw, MTX_GRD_RW_MODE_EXCLUSIVE, __builtin_return_address(0), 0, MTX_GRD_LOCK_TYPE_PERMANENT);
 
-    if(p_mtx_grd->lock_counter > 0)
-        --p_mtx_grd->lock_counter;
-    else
-        mutex_guard_errno = MTX_GRD_ERR_OUT_OF_ADDR_COUNTER_BOUNDARIES;
+    if(ret_lock)
+        return ret_lock;
 
-    if(verbosity_level & MTX_GRD_VERBOSITY_BT)
-        MutexGuardShowBacktrace(&p_mtx_grd->mutex, false);
+    p_mtx_grd_rw->bias_allowed = enable;
 
-    if(!p_mtx_grd->lock_counter)
-        memset(&p_mtx_grd->mutex_acq_location, 0, sizeof(MTX_GRD_ACQ_LOCATION));
+    if(enable)
+        p_mtx_grd_rw->bias_stats.inhibit_until_ns = 0;
 
-    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
-        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
-    
-    return ret_unlock;
+    return MutexGuardRwUnlock(p_mtx_grd_rw);
 }
 
-/// @brief Cleanup function to release a mutex (meant to be used alongside scoped mutex lock macros).
-/// @param ptr Pointer to mutex guard structure. 
-void MutexGuardReleaseMutexCleanup(void* ptr)
+/// @brief Copies reader bias statistics of a reader-writer guard.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param p_stats Pointer to the structure statistics are meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+int MutexGuardRwGetBiasStats(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, MTX_GRD_RW_BIAS_STATS* C_MUTEX_GUARD_RESTRICT p_stats)
 {
-    if(!ptr || !(*(MTX_GRD**)ptr))
+    if(!p_mtx_grd_rw)
     {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
-        return;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_RW;
+        return -1;
     }
-    
-    MutexGuardUnlock(*(MTX_GRD**)ptr);
-}
 
-/// @brief Destroys mutex attribute within given mutex guard.
-/// @param p_mtx_grd Pointer to mutex guard structure.
-/// @return 0 if succeeded, > 0 otherwise.
-int MutexGuardAttrDestroy(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
-{
-    if(!p_mtx_grd)
+    if(!p_stats)
     {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
-        return -1;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
+        return -2;
     }
-    
-    int mutex_attr_destroy = pthread_mutexattr_destroy(&p_mtx_grd->mutex_attr);
-    
-    if(mutex_attr_destroy)
-        mutex_guard_errno = MTX_GRD_ERR_STD_ERROR_CODE;
-    
-    return mutex_attr_destroy;
+
+    if(MutexGuardRwLockCtrlMutex(p_mtx_grd_rw, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    memcpy(p_stats, &p_mtx_grd_rw->bias_stats, sizeof(MTX_GRD_RW_BIAS_STATS));
+    p_stats->biased = __atomic_load_n(&p_mtx_grd_rw->bias, __ATOMIC_RELAXED);
+
+    if(MutexGuardRwUnlockCtrlMutex(p_mtx_grd_rw, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    return 0;
 }
 
-/// @brief Destroys mutex within given mutex guard.
-/// @param p_mtx_grd Pointer to mutex guard structure.
-/// @return 0 if succeeded, > 0 otherwise.
-int MutexGuardDestroy(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd)
+/// @brief Copies the holders of a reader-writer guard: its upgradable or exclusive holder first (if any), then its readers.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param holders Array holders are meant to be copied to.
+/// @param holder_num Number of holders that fit in the array.
+/// @return Number of holders found if succeeded, < 0 otherwise.
+int MutexGuardRwGetHolders( MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw     ,
+                            MTX_GRD_RW_HOLDER* C_MUTEX_GUARD_RESTRICT holders   ,
+                            const size_t holder_num                             )
 {
-    if(!p_mtx_grd)
+    if(!p_mtx_grd_rw)
     {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_RW;
         return -1;
     }
 
-    if(MutexGuardLockCtrlMutex(p_mtx_grd, false))
+    if(!holders && holder_num)
     {
-        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_TARGET_STRING;
         return -2;
     }
 
-    int original_lock_counter = p_mtx_grd->lock_counter;
+    size_t found_num = 0;
 
-    int ret_unlock = 0;
-    for(int i = 0; i < original_lock_counter; i++)
+    if(MutexGuardRwLockCtrlMutex(p_mtx_grd_rw, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    if(p_mtx_grd_rw->writer.lock_counter)
     {
-        ret_unlock = MutexGuardUnlock(p_mtx_grd);
-        
-        if(ret_unlock < 0)
+        if(holder_num)
+            holders[0] = p_mtx_grd_rw->writer;
+
+        ++found_num;
+    }
+
+    if(MutexGuardRwUnlockCtrlMutex(p_mtx_grd_rw, false))
+        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+
+    pthread_mutex_lock(&rw_read_sets_mutex);
+
+    for(MTX_GRD_RW_READ_SET* p_set = rw_read_sets; p_set; p_set = p_set->next)
+    {
+        MTX_GRD_RW_READ reads[__MTX_GRD_RW_READ_NUM__];
+        size_t read_num;
+        unsigned long long sequence;
+
+        // Sets are only written by their own threads: their reads are copied again if the thread updated them meanwhile.
+        do
         {
-            if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
-                mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+            while((sequence = __atomic_load_n(&p_set->sequence, __ATOMIC_ACQUIRE)) & 1)
+                sched_yield();
 
-            return -3;
+            read_num = __atomic_load_n(&p_set->read_num, __ATOMIC_RELAXED);
+            memcpy(reads, p_set->reads, read_num * sizeof(MTX_GRD_RW_READ));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        }
+        while(__atomic_load_n(&p_set->sequence, __ATOMIC_RELAXED) != sequence);
+
+        for(size_t read_index = 0; read_index < read_num; read_index++)
+        {
+            if(reads[read_index].p_mtx_grd_rw != p_mtx_grd_rw)
+                continue;
+
+            if(found_num < holder_num)
+            {
+                MTX_GRD_RW_HOLDER* p_holder = &holders[found_num];
+
+                p_holder->thread_id     = p_set->thread_id;
+                p_holder->kernel_tid    = p_set->kernel_tid;
+                p_holder->mode          = MTX_GRD_RW_MODE_SHARED;
+                p_holder->address       = reads[read_index].address;
+                p_holder->acq_ns        = reads[read_index].acq_ns;
+                p_holder->lock_counter  = reads[read_index].lock_counter;
+            }
+
+            ++found_num;
         }
     }
-    
-    int mutex_destroy = pthread_mutex_destroy(&p_mtx_grd->mutex);
-    
-    if(MutexGuardUnlockCtrlMutex(p_mtx_grd, false))
-        mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
-    
-    if(mutex_destroy)
-        mutex_guard_errno = MTX_GRD_ERR_STD_ERROR_CODE;
-    
-    if(MutexGuardDestroyCtrlMutex(p_mtx_grd, false))
+
+    pthread_mutex_unlock(&rw_read_sets_mutex);
+
+    return (int)found_num;
+}
+
+/// @brief Destroys reader-writer guard.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @return 0 if succeeded, != 0 otherwise.
+int MutexGuardRwDestroy(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw)
+{
+    if(!p_mtx_grd_rw)
+    {
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_RW;
+        return -1;
+    }
+
+    if(MutexGuardRwGetHolders(p_mtx_grd_rw, NULL, 0))
+    {
+        mutex_guard_errno = MTX_GRD_ERR_RW_BUSY;
+        return -2;
+    }
+
+    int ret_destroy = pthread_rwlock_destroy(&p_mtx_grd_rw->rwlock);
+
+    if(pthread_mutex_destroy(&p_mtx_grd_rw->writer_mutex) && !ret_destroy)
+        ret_destroy = EBUSY;
+
+    if(ret_destroy)
+    {
+        mutex_guard_lock_error_code = ret_destroy;
+        mutex_guard_errno           = MTX_GRD_ERR_STD_ERROR_CODE;
+        return ret_destroy;
+    }
+
+    if(MutexGuardRwDestroyCtrlMutex(p_mtx_grd_rw, false))
+    {
         mutex_guard_errno = MTX_GRD_ERR_INTERNAL_MUTEX_ERROR;
+        return -3;
+    }
 
-    return mutex_destroy;
+    return 0;
 }
 
-/// @brief Cleanup function to destroy a mutex attribute (meant to be used alongside scoped attribute init macros).
-/// @param ptr Pointer to mutex attribute containing mutex guard structure. 
-void MutexGuardDestroyAttrCleanup(void* ptr)
+/// @brief Cleanup function to destroy a reader-writer guard (meant to be used alongside scoped reader-writer init macros).
+/// @param ptr Pointer to reader-writer guard structure.
+void MutexGuardRwDestroyCleanup(void* ptr)
 {
-    if(!ptr || !(*(MTX_GRD**)ptr))
+    if(!ptr || !(*(MTX_GRD_RW**)ptr))
     {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_RW;
         return;
     }
 
-    MutexGuardAttrDestroy(*(MTX_GRD**)ptr);
+    MutexGuardRwDestroy(*(MTX_GRD_RW**)ptr);
 }
 
-/// @brief Cleanup function to destroy a mutex (meant to be used alongside scoped mutex init macros)
-/// @param ptr Pointer to mutex guard structure.
-void MutexGuardDestroyMutexCleanup(void* ptr)
+/// @brief Cleanup function to release a reader-writer guard (meant to be used alongside scoped reader-writer lock macros).
+/// @param ptr Pointer to reader-writer guard structure.
+void MutexGuardRwReleaseCleanup(void* ptr)
 {
-    if(!ptr || !(*(MTX_GRD**)ptr))
+    if(!ptr || !(*(MTX_GRD_RW**)ptr))
     {
-        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD;
+        mutex_guard_errno = MTX_GRD_ERR_NULL_MTX_GRD_RW;
         return;
     }
 
-    MutexGuardDestroy(*(MTX_GRD**)ptr);
+    MutexGuardRwUnlock(*(MTX_GRD_RW**)ptr);
 }
 
 /*****************************************/
@@ -0,0 +1,1228 @@
+#ifndef MUTEX_GUARD_HPP
+#define MUTEX_GUARD_HPP
+
+/********** Include statements ***********/
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <system_error>
+#include <utility>
+
+#if (__cplusplus >= 202002L) && defined(__has_include)
+#if __has_include(<source_location>)
+#include <source_location>
+#endif
+#endif
+
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "MutexGuard_api.h"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define MTX_GRD_CPP_HAS_COROUTINES
+#include <condition_variable>
+#include <coroutine>
+#include <map>
+#include <thread>
+#endif
+#endif
+
+/*****************************************/
+
+/*********** Define statements ***********/
+
+#ifndef __MTX_GRD_CPP_CALLSITE_CACHE_NUM__
+#define __MTX_GRD_CPP_CALLSITE_CACHE_NUM__  64
+#endif
+
+#ifndef __MTX_GRD_CPP_SPIN_NUM__
+#define __MTX_GRD_CPP_SPIN_NUM__            100
+#endif
+
+/*****************************************/
+
+namespace mtx_grd
+{
+
+/********** Callsite definitions *********/
+
+#if defined(__cpp_lib_source_location)
+using source_location = std::source_location;
+#else
+/// @brief Minimal std::source_location stand-in for pre-C++20 compilers (captured through GCC/Clang builtins).
+struct source_location
+{
+    static constexpr source_location current(   const char* file        = __builtin_FILE()      ,
+                                                const char* function    = __builtin_FUNCTION()  ,
+                                                std::uint_least32_t line = __builtin_LINE()     ) noexcept
+    {
+        source_location location;
+
+        location.file_      = file;
+        location.function_  = function;
+        location.line_      = line;
+
+        return location;
+    }
+
+    constexpr const char* file_name() const noexcept { return file_; }
+    constexpr const char* function_name() const noexcept { return function_; }
+    constexpr std::uint_least32_t line() const noexcept { return line_; }
+    constexpr std::uint_least32_t column() const noexcept { return 0; }
+
+private:
+    const char*         file_       = "";
+    const char*         function_   = "";
+    std::uint_least32_t line_       = 0;
+};
+#endif
+
+namespace detail
+{
+
+struct callsite_cache_entry
+{
+    const char*         file;
+    const char*         function;
+    std::uint_least32_t line;
+    void*               address;
+};
+
+/// @brief Lock address standing for a source location (see MutexGuardSourceCallsite). Locations are looked up in a per-thread cache
+/// first, keyed by their (static) strings, so that the library is only called the first time a thread locks from a given place.
+/// @param location Source location.
+/// @return Lock address.
+inline void* callsite(const source_location& location) noexcept
+{
+    thread_local callsite_cache_entry cache[__MTX_GRD_CPP_CALLSITE_CACHE_NUM__];
+
+    std::uintptr_t hash             = (reinterpret_cast<std::uintptr_t>(location.file_name()) >> 4) ^ location.line();
+    callsite_cache_entry& entry     = cache[hash % __MTX_GRD_CPP_CALLSITE_CACHE_NUM__];
+
+    if( (entry.file == location.file_name()) && (entry.line == location.line()) && (entry.function == location.function_name()) )
+        return entry.address;
+
+    void* address = MutexGuardSourceCallsite(location.file_name(), location.line(), location.function_name());
+
+    // Out of room for further locations: the lock address is at least the caller's.
+    if(!address)
+        return MutexGuardGetFuncRetAddr();
+
+    entry = { location.file_name(), location.function_name(), location.line(), address };
+
+    return address;
+}
+
+/// @brief Throws the std::system_error a failed lock call stands for.
+/// @param ret_lock Lock call return value (< 0 if arguments were invalid, > 0 standard error code otherwise).
+[[noreturn]] inline void throw_lock_error(const int ret_lock)
+{
+    throw std::system_error((ret_lock > 0) ? ret_lock : EINVAL, std::generic_category(), MTX_GRD_GET_LAST_ERR_STR);
+}
+
+/// @brief Converts a duration into a lock timeout (in nanoseconds, at least 1 so that it is never taken as "wait forever").
+template<class Rep, class Period>
+inline std::uint64_t timeout_ns(const std::chrono::duration<Rep, Period>& duration) noexcept
+{
+    auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+
+    return ((duration_ns > 0) ? static_cast<std::uint64_t>(duration_ns) : 1);
+}
+
+/// @brief Monotonic time (in nanoseconds).
+inline std::uint64_t monotonic_ns() noexcept
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/// @brief Throws the std::system_error a thread locking a guard it already owns stands for.
+[[noreturn]] inline void throw_deadlock_error()
+{
+    throw std::system_error(EDEADLK, std::generic_category(), "Guard already locked by the calling thread");
+}
+
+/// @brief Tells whether spinning may pay off (it never does on a single CPU, where the owner cannot run meanwhile).
+inline bool spin_allowed() noexcept
+{
+    static const bool allowed = (sysconf(_SC_NPROCESSORS_ONLN) > 1);
+
+    return allowed;
+}
+
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield" ::: "memory");
+#endif
+}
+
+} // namespace detail
+
+/*****************************************/
+
+/************ Mutex definition ***********/
+
+/// @brief Mutex guard meeting the standard Lockable and TimedLockable requirements, so that it can be used alongside
+/// std::lock_guard, std::unique_lock, std::scoped_lock, std::lock and std::condition_variable_any. Lock calls record the caller's
+/// source location (for diagnostics, with no address symbolization at runtime) instead of its return address.
+/// @note Locked through standard wrappers, the recorded location is the wrapper's: mtx_grd::scoped_lock records the caller's.
+class mutex
+{
+public:
+    /// @brief Initializes the guard with default attributes.
+    /// @throw std::system_error if the guard could not be initialized.
+    mutex()
+    {
+        int ret_init = MutexGuardInit(&guard_);
+
+        if(ret_init)
+            detail::throw_lock_error(ret_init);
+    }
+
+    /// @brief Initializes the guard with given attributes (see MutexGuardAttrInit).
+    /// @param mutex_type Mutex type (NORMAL, ERRORCHECK, RECURSIVE, DEFAULT).
+    /// @param priority Mutex priority (NONE, INHERIT, PROTECT).
+    /// @param name Guard name (shown by dumps and exported statistics, may be NULL).
+    /// @throw std::system_error if the guard could not be initialized.
+    explicit mutex(const int mutex_type, const int priority = PTHREAD_PRIO_NONE, const char* name = nullptr)
+    {
+        int ret_init = MutexGuardAttrInit(&guard_, mutex_type, priority, PTHREAD_PROCESS_PRIVATE);
+
+        if(!ret_init)
+            ret_init = MutexGuardInit(&guard_);
+
+        MutexGuardAttrDestroy(&guard_);
+
+        if(ret_init)
+            detail::throw_lock_error(ret_init);
+
+        if(name)
+            MutexGuardSetName(&guard_, name);
+    }
+
+    ~mutex()
+    {
+        MutexGuardDestroy(&guard_);
+    }
+
+    mutex(const mutex&)             = delete;
+    mutex& operator=(const mutex&)  = delete;
+
+    /// @brief Locks the guard, waiting for as long as needed.
+    /// @throw std::system_error if the guard could not be locked.
+    void lock(const source_location& location = source_location::current())
+    {
+        int ret_lock = MutexGuardLock(&guard_, detail::callsite(location), 0, MTX_GRD_LOCK_TYPE_PERMANENT);
+
+        if(ret_lock)
+            detail::throw_lock_error(ret_lock);
+    }
+
+    /// @brief Tries to lock the guard, without waiting.
+    /// @return true if the guard was locked, false otherwise.
+    bool try_lock(const source_location& location = source_location::current()) noexcept
+    {
+        return !MutexGuardLock(&guard_, detail::callsite(location), 0, MTX_GRD_LOCK_TYPE_TRY);
+    }
+
+    /// @brief Tries to lock the guard, waiting for up to a given time.
+    /// @return true if the guard was locked, false otherwise.
+    template<class Rep, class Period>
+    bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout, const source_location& location = source_location::current()) noexcept
+    {
+        return !MutexGuardLock(&guard_, detail::callsite(location), detail::timeout_ns(timeout), MTX_GRD_LOCK_TYPE_TIMED);
+    }
+
+    /// @brief Tries to lock the guard, waiting until a given time at most.
+    /// @return true if the guard was locked, false otherwise.
+    template<class Clock, class Duration>
+    bool try_lock_until(const std::chrono::time_point<Clock, Duration>& deadline, const source_location& location = source_location::current()) noexcept
+    {
+        auto timeout = deadline - Clock::now();
+
+        if(timeout <= decltype(timeout)::zero())
+            return try_lock(location);
+
+        return try_lock_for(timeout, location);
+    }
+
+    /// @brief Unlocks the guard (running work deferred until then, see MutexGuardDeferAfterUnlock).
+    void unlock() noexcept
+    {
+        MutexGuardUnlock(&guard_);
+    }
+
+    /// @brief Underlying guard, for the rest of the C API.
+    MTX_GRD* native_handle() noexcept
+    {
+        return &guard_;
+    }
+
+private:
+    MTX_GRD guard_ = {};
+};
+
+/*****************************************/
+
+/*********** Policy definitions **********/
+
+// Policies of mtx_grd::basic_guard. Their hooks are protected (only the guard calls them), their queries public. A disabled policy
+// is an empty class whose hooks are empty inline functions, so that it takes no room (empty base) and compiles to nothing.
+
+/// @brief Lock engine wrapping a (process-private, default type) pthread mutex.
+class pthread_engine
+{
+public:
+    pthread_engine() noexcept = default;
+
+    ~pthread_engine()
+    {
+        pthread_mutex_destroy(&mutex_);
+    }
+
+    pthread_engine(const pthread_engine&)               = delete;
+    pthread_engine& operator=(const pthread_engine&)    = delete;
+
+protected:
+    bool try_lock() noexcept
+    {
+        return !pthread_mutex_trylock(&mutex_);
+    }
+
+    /// @brief Locks the engine once try_lock failed.
+    void lock_contended() noexcept
+    {
+        pthread_mutex_lock(&mutex_);
+    }
+
+    /// @brief Locks the engine once try_lock failed, waiting for up to a given time (in nanoseconds).
+    bool try_lock_contended_for(const std::uint64_t timeout_ns) noexcept
+    {
+        struct timespec deadline;
+
+        // Same clock as MutexGuardLock's timed locks.
+        clock_gettime(CLOCK_REALTIME, &deadline);
+
+        std::uint64_t deadline_ns = static_cast<std::uint64_t>(deadline.tv_nsec) + timeout_ns;
+
+        deadline.tv_sec    += static_cast<time_t>(deadline_ns / 1000000000ULL);
+        deadline.tv_nsec    = static_cast<long>(deadline_ns % 1000000000ULL);
+
+        return !pthread_mutex_timedlock(&mutex_, &deadline);
+    }
+
+    void unlock() noexcept
+    {
+        pthread_mutex_unlock(&mutex_);
+    }
+
+private:
+    pthread_mutex_t mutex_ = PTHREAD_MUTEX_INITIALIZER;
+};
+
+/// @brief Lock engine on a single futex word (unlocked, locked, locked with waiters), which spins up to SpinNum times for the owner
+/// to release it (unless there is a single CPU) before parking in the kernel. Uncontended unlocks make no system call.
+template<unsigned int SpinNum = __MTX_GRD_CPP_SPIN_NUM__>
+class spin_park_engine
+{
+public:
+    spin_park_engine() noexcept = default;
+
+    spin_park_engine(const spin_park_engine&)               = delete;
+    spin_park_engine& operator=(const spin_park_engine&)    = delete;
+
+protected:
+    bool try_lock() noexcept
+    {
+        std::uint32_t expected = UNLOCKED;
+
+        return state_.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    /// @brief Locks the engine once try_lock failed.
+    void lock_contended() noexcept
+    {
+        if(spin())
+            return;
+
+        while(state_.exchange(PARKED, std::memory_order_acquire) != UNLOCKED)
+            futex(FUTEX_WAIT_PRIVATE, PARKED, nullptr);
+    }
+
+    /// @brief Locks the engine once try_lock failed, waiting for up to a given time (in nanoseconds).
+    bool try_lock_contended_for(const std::uint64_t timeout_ns) noexcept
+    {
+        std::uint64_t deadline_ns = detail::monotonic_ns() + timeout_ns;
+
+        if(spin())
+            return true;
+
+        // A waiter timing out leaves the word parked: its owner then makes a needless (but harmless) wake-up call.
+        while(state_.exchange(PARKED, std::memory_order_acquire) != UNLOCKED)
+        {
+            std::uint64_t now_ns = detail::monotonic_ns();
+
+            if(now_ns >= deadline_ns)
+                return false;
+
+            struct timespec timeout;
+
+            timeout.tv_sec  = static_cast<time_t>((deadline_ns - now_ns) / 1000000000ULL);
+            timeout.tv_nsec = static_cast<long>((deadline_ns - now_ns) % 1000000000ULL);
+
+            futex(FUTEX_WAIT_PRIVATE, PARKED, &timeout);
+        }
+
+        return true;
+    }
+
+    void unlock() noexcept
+    {
+        if(state_.exchange(UNLOCKED, std::memory_order_release) == PARKED)
+            futex(FUTEX_WAKE_PRIVATE, 1, nullptr);
+    }
+
+private:
+    enum : std::uint32_t { UNLOCKED, LOCKED, PARKED };
+
+    bool spin() noexcept
+    {
+        if(!detail::spin_allowed())
+            return false;
+
+        for(unsigned int spin_index = 0; spin_index < SpinNum; spin_index++)
+        {
+            detail::cpu_relax();
+
+            if( (state_.load(std::memory_order_relaxed) == UNLOCKED) && try_lock() )
+                return true;
+        }
+
+        return false;
+    }
+
+    void futex(const int operation, const std::uint32_t value, const struct timespec* p_timeout) noexcept
+    {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_), operation, value, p_timeout, nullptr, 0);
+    }
+
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "futex word must be a plain 32-bit word");
+
+    std::atomic<std::uint32_t> state_{UNLOCKED};
+};
+
+/// @brief Diagnostics policy recording nothing: relocking or unlocking from the wrong thread is left to the engine (undefined).
+class no_diagnostics
+{
+protected:
+    static constexpr bool tracks_owner = false;
+
+    constexpr bool owned_by_caller() const noexcept { return false; }
+    void on_locked(const source_location&) noexcept {}
+    void on_unlocking() noexcept {}
+};
+
+/// @brief Diagnostics policy recording the owner thread: relocking from the owner throws (EDEADLK) or fails, and unlocking from
+/// another thread is ignored.
+class owner_diagnostics
+{
+public:
+    /// @brief Tells whether the guard is locked (racy unless called by the owner). Once true, the owner's records are visible.
+    bool is_locked() const noexcept
+    {
+        return locked_.load(std::memory_order_acquire);
+    }
+
+    /// @brief Owner thread (meaningful only if the guard is locked).
+    pthread_t owner() const noexcept
+    {
+        return owner_.load(std::memory_order_relaxed);
+    }
+
+protected:
+    static constexpr bool tracks_owner = true;
+
+    // Only the owner stores its own ID, and clears the lock flag before releasing: a thread cannot wrongly see itself as owner.
+    // The flag is set (release) after the owner's records, so that a reader seeing it set (acquire) sees them as well.
+    bool owned_by_caller() const noexcept
+    {
+        return is_locked() && pthread_equal(owner(), pthread_self());
+    }
+
+    void on_locked(const source_location&) noexcept
+    {
+        owner_.store(pthread_self(), std::memory_order_relaxed);
+        locked_.store(true, std::memory_order_release);
+    }
+
+    void on_unlocking() noexcept
+    {
+        locked_.store(false, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<pthread_t>  owner_{};
+    std::atomic<bool>       locked_{false};
+};
+
+/// @brief Owner's record (see full_diagnostics::holder).
+struct guard_holder
+{
+    bool            locked;
+    pthread_t       thread;
+    const char*     file;
+    const char*     function;
+    unsigned int    line;
+    std::uint64_t   held_ns;
+};
+
+/// @brief Diagnostics policy recording the owner thread (as owner_diagnostics does) along with the source location it locked the
+/// guard at and when.
+class full_diagnostics : public owner_diagnostics
+{
+public:
+    /// @brief Current owner's record (fields are read one by one: a snapshot taken while ownership changes may mix two owners').
+    guard_holder holder() const noexcept
+    {
+        guard_holder holder;
+
+        holder.locked   = is_locked();
+        holder.thread   = owner();
+        holder.file     = file_.load(std::memory_order_relaxed);
+        holder.function = function_.load(std::memory_order_relaxed);
+        holder.line     = line_.load(std::memory_order_relaxed);
+        holder.held_ns  = (holder.locked ? (detail::monotonic_ns() - locked_ns_.load(std::memory_order_relaxed)) : 0);
+
+        return holder;
+    }
+
+protected:
+    void on_locked(const source_location& location) noexcept
+    {
+        file_.store(location.file_name(), std::memory_order_relaxed);
+        function_.store(location.function_name(), std::memory_order_relaxed);
+        line_.store(location.line(), std::memory_order_relaxed);
+        locked_ns_.store(detail::monotonic_ns(), std::memory_order_relaxed);
+
+        owner_diagnostics::on_locked(location);
+    }
+
+private:
+    std::atomic<const char*>    file_{""};
+    std::atomic<const char*>    function_{""};
+    std::atomic<unsigned int>   line_{0};
+    std::atomic<std::uint64_t>  locked_ns_{0};
+};
+
+/// @brief Statistics policy counting nothing.
+class no_stats
+{
+protected:
+    constexpr std::uint64_t wait_start() const noexcept { return 0; }
+    void on_locked(const bool, const std::uint64_t) noexcept {}
+};
+
+/// @brief Guard statistics (see counting_stats::stats).
+struct guard_stats
+{
+    std::uint64_t lock_counter;         ///< Acquisitions.
+    std::uint64_t contended_counter;    ///< Acquisitions which had to wait.
+    std::uint64_t wait_ns;              ///< Total time spent waiting.
+    std::uint64_t wait_ns_max;          ///< Longest wait.
+};
+
+/// @brief Statistics policy counting acquisitions and contended waits. Counters are only written by the owner (no atomic
+/// read-modify-write) and the clock is only read by waiters.
+class counting_stats
+{
+public:
+    guard_stats stats() const noexcept
+    {
+        guard_stats stats;
+
+        stats.lock_counter      = lock_counter_.load(std::memory_order_relaxed);
+        stats.contended_counter = contended_counter_.load(std::memory_order_relaxed);
+        stats.wait_ns           = wait_ns_.load(std::memory_order_relaxed);
+        stats.wait_ns_max       = wait_ns_max_.load(std::memory_order_relaxed);
+
+        return stats;
+    }
+
+protected:
+    std::uint64_t wait_start() const noexcept
+    {
+        return detail::monotonic_ns();
+    }
+
+    void on_locked(const bool contended, const std::uint64_t wait_start_ns) noexcept
+    {
+        lock_counter_.store(lock_counter_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        if(!contended)
+            return;
+
+        std::uint64_t wait_ns = detail::monotonic_ns() - wait_start_ns;
+
+        contended_counter_.store(contended_counter_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        wait_ns_.store(wait_ns_.load(std::memory_order_relaxed) + wait_ns, std::memory_order_relaxed);
+
+        if(wait_ns > wait_ns_max_.load(std::memory_order_relaxed))
+            wait_ns_max_.store(wait_ns, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::uint64_t> lock_counter_{0};
+    std::atomic<std::uint64_t> contended_counter_{0};
+    std::atomic<std::uint64_t> wait_ns_{0};
+    std::atomic<std::uint64_t> wait_ns_max_{0};
+};
+
+/*****************************************/
+
+/********* Basic guard definition ********/
+
+/// @brief Guard whose costs are chosen at compile time: a lock engine (pthread_engine, spin_park_engine), a diagnostics policy
+/// (no_diagnostics, owner_diagnostics, full_diagnostics) and a statistics policy (no_stats, counting_stats). Policies' queries
+/// (owner, holder, stats) are members of the guard. It meets the Lockable and TimedLockable requirements as mtx_grd::mutex does,
+/// but stands on its own (no MTX_GRD underneath, so no C API diagnostics). With no diagnostics and no statistics, it is the engine.
+template<class LockEngine, class Diagnostics = no_diagnostics, class Stats = no_stats>
+class basic_guard : private LockEngine, public Diagnostics, public Stats
+{
+public:
+    basic_guard() noexcept = default;
+
+    basic_guard(const basic_guard&)             = delete;
+    basic_guard& operator=(const basic_guard&)  = delete;
+
+    /// @brief Locks the guard, waiting for as long as needed.
+    /// @throw std::system_error if the calling thread already owns the guard (only detected with owner diagnostics).
+    void lock(const source_location& location = source_location::current())
+    {
+        if(Diagnostics::owned_by_caller())
+            detail::throw_deadlock_error();
+
+        if(LockEngine::try_lock())
+        {
+            on_locked(location, false, 0);
+            return;
+        }
+
+        std::uint64_t wait_start_ns = Stats::wait_start();
+
+        LockEngine::lock_contended();
+        on_locked(location, true, wait_start_ns);
+    }
+
+    /// @brief Tries to lock the guard, without waiting.
+    /// @return true if the guard was locked, false otherwise.
+    bool try_lock(const source_location& location = source_location::current()) noexcept
+    {
+        if(Diagnostics::owned_by_caller() || !LockEngine::try_lock())
+            return false;
+
+        on_locked(location, false, 0);
+
+        return true;
+    }
+
+    /// @brief Tries to lock the guard, waiting for up to a given time.
+    /// @return true if the guard was locked, false otherwise.
+    template<class Rep, class Period>
+    bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout, const source_location& location = source_location::current()) noexcept
+    {
+        if(Diagnostics::owned_by_caller())
+            return false;
+
+        if(LockEngine::try_lock())
+        {
+            on_locked(location, false, 0);
+            return true;
+        }
+
+        std::uint64_t wait_start_ns = Stats::wait_start();
+
+        if(!LockEngine::try_lock_contended_for(detail::timeout_ns(timeout)))
+            return false;
+
+        on_locked(location, true, wait_start_ns);
+
+        return true;
+    }
+
+    /// @brief Tries to lock the guard, waiting until a given time at most.
+    /// @return true if the guard was locked, false otherwise.
+    template<class Clock, class Duration>
+    bool try_lock_until(const std::chrono::time_point<Clock, Duration>& deadline, const source_location& location = source_location::current()) noexcept
+    {
+        auto timeout = deadline - Clock::now();
+
+        if(timeout <= decltype(timeout)::zero())
+            return try_lock(location);
+
+        return try_lock_for(timeout, location);
+    }
+
+    /// @brief Unlocks the guard (ignored if called by another thread than the owner, with owner diagnostics).
+    void unlock() noexcept
+    {
+        if constexpr(Diagnostics::tracks_owner)
+        {
+            if(!Diagnostics::owned_by_caller())
+                return;
+        }
+
+        Diagnostics::on_unlocking();
+        LockEngine::unlock();
+    }
+
+private:
+    void on_locked(const source_location& location, const bool contended, const std::uint64_t wait_start_ns) noexcept
+    {
+        Stats::on_locked(contended, wait_start_ns);
+        Diagnostics::on_locked(location);
+    }
+};
+
+/// @brief Cheapest guard: spins then parks, records and counts nothing (the size of a futex word).
+using fast_guard    = basic_guard<spin_park_engine<>, no_diagnostics, no_stats>;
+
+/// @brief Most visible guard: records its owner's thread and source location, and counts acquisitions and waits.
+using debug_guard   = basic_guard<spin_park_engine<>, full_diagnostics, counting_stats>;
+
+/*****************************************/
+
+/********* Scoped lock definition ********/
+
+/// @brief Move-only owner of a locked guard (mtx_grd::mutex or mtx_grd::basic_guard, or of none), which unlocks it when destroyed.
+/// Locking records the source location the lock is constructed at.
+template<class Mutex>
+class basic_scoped_lock
+{
+public:
+    /// @brief Locks a guard, waiting for as long as needed.
+    /// @throw std::system_error if the guard could not be locked.
+    explicit basic_scoped_lock(Mutex& target_mutex, const source_location& location = source_location::current()) : mutex_(&target_mutex)
+    {
+        mutex_->lock(location);
+    }
+
+    /// @brief Tries to lock a guard, without waiting (see owns_lock).
+    basic_scoped_lock(Mutex& target_mutex, std::try_to_lock_t, const source_location& location = source_location::current()) noexcept
+        : mutex_(target_mutex.try_lock(location) ? &target_mutex : nullptr) {}
+
+    /// @brief Tries to lock a guard, waiting for up to a given time (see owns_lock).
+    template<class Rep, class Period>
+    basic_scoped_lock(Mutex& target_mutex, const std::chrono::duration<Rep, Period>& timeout, const source_location& location = source_location::current()) noexcept
+        : mutex_(target_mutex.try_lock_for(timeout, location) ? &target_mutex : nullptr) {}
+
+    /// @brief Takes over a guard already locked by the calling thread.
+    basic_scoped_lock(Mutex& target_mutex, std::adopt_lock_t) noexcept : mutex_(&target_mutex) {}
+
+    basic_scoped_lock(basic_scoped_lock&& other) noexcept : mutex_(std::exchange(other.mutex_, nullptr)) {}
+
+    basic_scoped_lock& operator=(basic_scoped_lock&& other) noexcept
+    {
+        if(this != &other)
+        {
+            unlock();
+            mutex_ = std::exchange(other.mutex_, nullptr);
+        }
+
+        return *this;
+    }
+
+    basic_scoped_lock(const basic_scoped_lock&)             = delete;
+    basic_scoped_lock& operator=(const basic_scoped_lock&)  = delete;
+
+    ~basic_scoped_lock()
+    {
+        unlock();
+    }
+
+    /// @brief Unlocks the owned guard, if any, ahead of time.
+    void unlock() noexcept
+    {
+        if(mutex_)
+            std::exchange(mutex_, nullptr)->unlock();
+    }
+
+    /// @brief Gives up the owned guard without unlocking it.
+    /// @return Formerly owned guard (nullptr if none).
+    Mutex* release() noexcept
+    {
+        return std::exchange(mutex_, nullptr);
+    }
+
+    bool owns_lock() const noexcept
+    {
+        return (mutex_ != nullptr);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return owns_lock();
+    }
+
+private:
+    Mutex* mutex_;
+};
+
+using scoped_lock = basic_scoped_lock<mutex>;
+
+/*****************************************/
+
+#if defined(MTX_GRD_CPP_HAS_COROUTINES)
+
+/********* Async mutex definition ********/
+
+namespace detail
+{
+
+/// @brief Coroutine waiting for an mtx_grd::async_mutex. Its state moves once from WAITING to OWNED (handed the mutex) or to
+/// TIMED_OUT (claimed by the timer), whichever comes first, and only the winner resumes the coroutine.
+struct async_waiter
+{
+    enum : int { WAITING, OWNED, TIMED_OUT };
+
+    explicit async_waiter(const source_location& waiter_location) noexcept : location(waiter_location) {}
+
+    async_waiter(const async_waiter&)               = delete;
+    async_waiter& operator=(const async_waiter&)    = delete;
+
+    /// @brief Resumes the coroutine on its executor (or right away, on the calling thread, if it has none).
+    void resume() noexcept
+    {
+        if(post)
+            post(executor, handle);
+        else
+            handle.resume();
+    }
+
+    std::atomic<int>                                        state{WAITING};
+    source_location                                         location;
+    std::uint64_t                                           enqueue_ns  = 0;
+    std::coroutine_handle<>                                 handle;
+    void*                                                   executor    = nullptr;
+    void                                                    (*post)(void*, std::coroutine_handle<>) = nullptr;
+    void*                                                   mutex       = nullptr;
+    void                                                    (*on_timeout)(async_waiter*) = nullptr;
+    async_waiter*                                           prev        = nullptr;
+    async_waiter*                                           next        = nullptr;
+    bool                                                    queued      = false;
+    bool                                                    timed       = false;
+    bool                                                    armed       = false;
+    std::multimap<std::uint64_t, async_waiter*>::iterator   timer_entry;
+};
+
+/// @brief Process-wide timer thread (started by the first timed wait) expiring timed async waits, as coroutines have no thread to
+/// time them out.
+class async_timer
+{
+public:
+    static async_timer& instance()
+    {
+        static async_timer timer;
+
+        return timer;
+    }
+
+    ~async_timer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+
+        cond_.notify_one();
+        thread_.join();
+    }
+
+    /// @brief Arms a waiter's deadline (monotonic time, in nanoseconds).
+    void add(async_waiter* p_waiter, const std::uint64_t deadline_ns)
+    {
+        bool is_first;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            p_waiter->timer_entry   = entries_.emplace(deadline_ns, p_waiter);
+            p_waiter->armed         = true;
+            is_first                = (p_waiter->timer_entry == entries_.begin());
+        }
+
+        if(is_first)
+            cond_.notify_one();
+    }
+
+    /// @brief Disarms a waiter handed its mutex, so that the timer never touches it again.
+    void remove(async_waiter* p_waiter) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if(p_waiter->armed)
+        {
+            entries_.erase(p_waiter->timer_entry);
+            p_waiter->armed = false;
+        }
+    }
+
+private:
+    async_timer() : thread_([this] { run(); }) {}
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while(!stop_)
+        {
+            if(entries_.empty())
+            {
+                cond_.wait(lock);
+                continue;
+            }
+
+            auto first          = entries_.begin();
+            std::uint64_t now_ns = monotonic_ns();
+
+            if(first->first > now_ns)
+            {
+                cond_.wait_for(lock, std::chrono::nanoseconds(first->first - now_ns));
+                continue;
+            }
+
+            async_waiter* p_waiter = first->second;
+            int expected            = async_waiter::WAITING;
+
+            entries_.erase(first);
+            p_waiter->armed = false;
+
+            // Claimed under the timer lock, so that a waiter handed its mutex meanwhile is disarmed (see remove) before it resumes.
+            if(!p_waiter->state.compare_exchange_strong(expected, async_waiter::TIMED_OUT, std::memory_order_acq_rel))
+                continue;
+
+            lock.unlock();
+            p_waiter->on_timeout(p_waiter);
+            lock.lock();
+        }
+    }
+
+    std::mutex                                  mutex_;
+    std::condition_variable                     cond_;
+    std::multimap<std::uint64_t, async_waiter*> entries_;
+    bool                                        stop_ = false;
+    std::thread                                 thread_;
+};
+
+} // namespace detail
+
+/// @brief Owner's record of an mtx_grd::async_mutex (see async_mutex::holder).
+struct async_holder
+{
+    bool            locked;
+    const char*     file;
+    const char*     function;
+    unsigned int    line;
+    std::uint64_t   held_ns;
+    std::size_t     waiter_num;
+};
+
+/// @brief Mutex for coroutines: co_await lock_async() suspends the calling coroutine (rather than blocking its thread) until the
+/// mutex is handed over to it by unlock, in FIFO order, and then resumes it on its executor (if any, on the unlocking thread
+/// otherwise). Ownership belongs to the coroutine, which may unlock from another thread than the one it locked on. Owners are
+/// recorded by an underlying guard, as any MTX_GRD's (dumps, statistics and exported callsites show their source location, waits and
+/// the thread which locked or handed the mutex over), and waiters' source locations by the mutex itself (see holder and
+/// for_each_waiter). The underlying guard's mutex is never locked: ownership stays with the coroutines, whichever thread they run on.
+/// @note An executor is any object callable with the std::coroutine_handle<> to resume (e.g. posting it to an event loop). It is
+/// referred to, not copied, until the coroutine resumes: a temporary living until the end of the co_await expression will do.
+class async_mutex
+{
+public:
+    /// @brief Awaitable lock request, whose co_await yields true if the mutex was locked, false if the wait timed out.
+    class [[nodiscard]] lock_awaiter : private detail::async_waiter
+    {
+    public:
+        bool await_ready() noexcept
+        {
+            if(!mutex_->try_lock(location))
+                return false;
+
+            state.store(OWNED, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        bool await_suspend(const std::coroutine_handle<> coroutine) noexcept
+        {
+            handle = coroutine;
+
+            return mutex_->enqueue(this, timeout_ns_);
+        }
+
+        bool await_resume() const noexcept
+        {
+            return (state.load(std::memory_order_acquire) == OWNED);
+        }
+
+    private:
+        friend class async_mutex;
+
+        lock_awaiter(async_mutex* p_mutex, const std::uint64_t timeout_ns, const source_location& location) noexcept
+            : detail::async_waiter(location), mutex_(p_mutex), timeout_ns_(timeout_ns)
+        {
+            mutex       = p_mutex;
+            on_timeout  = &async_mutex::expire;
+        }
+
+        template<class Executor>
+        lock_awaiter(async_mutex* p_mutex, const std::uint64_t timeout_ns, const source_location& location, Executor* p_executor) noexcept
+            : lock_awaiter(p_mutex, timeout_ns, location)
+        {
+            executor    = p_executor;
+            post        = [](void* p_target, std::coroutine_handle<> coroutine) { (*static_cast<Executor*>(p_target))(coroutine); };
+        }
+
+        async_mutex*    mutex_;
+        std::uint64_t   timeout_ns_;
+    };
+
+    /// @brief Initializes the mutex and its underlying guard (with default attributes).
+    /// @param name Guard name (shown by dumps and exported statistics, may be NULL).
+    /// @throw std::system_error if the guard could not be initialized.
+    explicit async_mutex(const char* name = nullptr)
+    {
+        int ret_init = MutexGuardInit(&guard_);
+
+        if(ret_init)
+            detail::throw_lock_error(ret_init);
+
+        if(name)
+            MutexGuardSetName(&guard_, name);
+    }
+
+    ~async_mutex()
+    {
+        MutexGuardDestroy(&guard_);
+    }
+
+    async_mutex(const async_mutex&)             = delete;
+    async_mutex& operator=(const async_mutex&)  = delete;
+
+    /// @brief Locks the mutex, suspending the calling coroutine for as long as needed. Resumes it on the unlocking thread.
+    lock_awaiter lock_async(const source_location& location = source_location::current()) noexcept
+    {
+        return lock_awaiter(this, 0, location);
+    }
+
+    /// @brief Locks the mutex, suspending the calling coroutine for up to a given time. Resumes it on the unlocking thread (or the
+    /// timer's).
+    template<class Rep, class Period>
+    lock_awaiter lock_async(const std::chrono::duration<Rep, Period>& timeout, const source_location& location = source_location::current()) noexcept
+    {
+        return lock_awaiter(this, detail::timeout_ns(timeout), location);
+    }
+
+    /// @brief Locks the mutex, suspending the calling coroutine for as long as needed. Resumes it on a given executor.
+    template<class Executor>
+    lock_awaiter lock_async_on(Executor&& executor, const source_location& location = source_location::current()) noexcept
+    {
+        return lock_awaiter(this, 0, location, &executor);
+    }
+
+    /// @brief Locks the mutex, suspending the calling coroutine for up to a given time. Resumes it on a given executor.
+    template<class Executor, class Rep, class Period>
+    lock_awaiter lock_async_on(Executor&& executor, const std::chrono::duration<Rep, Period>& timeout, const source_location& location = source_location::current()) noexcept
+    {
+        return lock_awaiter(this, detail::timeout_ns(timeout), location, &executor);
+    }
+
+    /// @brief Tries to lock the mutex, without suspending.
+    /// @return true if the mutex was locked, false otherwise.
+    bool try_lock(const source_location& location = source_location::current()) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if(locked_)
+            return false;
+
+        set_owner(location, 0);
+
+        return true;
+    }
+
+    /// @brief Unlocks the mutex, handing it over to the first waiter (if any), which then resumes.
+    void unlock() noexcept
+    {
+        detail::async_waiter* p_next = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            MutexGuardExternalReleased(&guard_);
+
+            // Waiters claimed by the timer are skipped: the timer resumes them.
+            while(head_ && !p_next)
+            {
+                detail::async_waiter* p_waiter  = unlink(head_);
+                int expected                    = detail::async_waiter::WAITING;
+
+                if(p_waiter->state.compare_exchange_strong(expected, detail::async_waiter::OWNED, std::memory_order_acq_rel))
+                    p_next = p_waiter;
+            }
+
+            if(p_next)
+                set_owner(p_next->location, detail::monotonic_ns() - p_next->enqueue_ns);
+            else
+                locked_ = false;
+        }
+
+        if(!p_next)
+            return;
+
+        if(p_next->timed)
+            detail::async_timer::instance().remove(p_next);
+
+        p_next->resume();
+    }
+
+    /// @brief Current owner's record.
+    async_holder holder() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        async_holder holder;
+
+        holder.locked       = locked_;
+        holder.file         = (locked_ ? owner_location_.file_name() : "");
+        holder.function     = (locked_ ? owner_location_.function_name() : "");
+        holder.line         = (locked_ ? owner_location_.line() : 0);
+        holder.held_ns      = (locked_ ? (detail::monotonic_ns() - locked_ns_) : 0);
+        holder.waiter_num   = waiter_num_;
+
+        return holder;
+    }
+
+    /// @brief Underlying guard, for the rest of the C API's diagnostics (statistics, names...). It must not be locked through it.
+    MTX_GRD* native_handle() noexcept
+    {
+        return &guard_;
+    }
+
+    /// @brief Calls a function with every waiter's source location, in queue order (under the mutex's internal lock, which the
+    /// function must not use the mutex under).
+    template<class Function>
+    void for_each_waiter(Function&& function) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for(const detail::async_waiter* p_waiter = head_; p_waiter; p_waiter = p_waiter->next)
+            function(p_waiter->location);
+    }
+
+private:
+    /// @brief Takes the mutex for a suspending waiter if it is free, queues the waiter (and arms its deadline) otherwise.
+    /// @return true if the waiter stays suspended, false if it was handed the mutex right away.
+    bool enqueue(detail::async_waiter* p_waiter, const std::uint64_t timeout_ns) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if(!locked_)
+        {
+            p_waiter->state.store(detail::async_waiter::OWNED, std::memory_order_relaxed);
+            set_owner(p_waiter->location, 0);
+
+            return false;
+        }
+
+        p_waiter->prev      = tail_;
+        p_waiter->next      = nullptr;
+        p_waiter->queued    = true;
+
+        if(tail_)
+            tail_->next = p_waiter;
+        else
+            head_ = p_waiter;
+
+        tail_                   = p_waiter;
+        p_waiter->enqueue_ns    = detail::monotonic_ns();
+        ++waiter_num_;
+
+        // Armed under the mutex's internal lock: a waiter timing out right away is only resumed (by expire) once it is queued.
+        if(timeout_ns)
+        {
+            p_waiter->timed = true;
+            detail::async_timer::instance().add(p_waiter, detail::monotonic_ns() + timeout_ns);
+        }
+
+        return true;
+    }
+
+    /// @brief Dequeues and resumes a waiter claimed by the timer.
+    static void expire(detail::async_waiter* p_waiter) noexcept
+    {
+        async_mutex* p_mutex = static_cast<async_mutex*>(p_waiter->mutex);
+
+        {
+            std::lock_guard<std::mutex> lock(p_mutex->mutex_);
+
+            if(p_waiter->queued)
+                p_mutex->unlink(p_waiter);
+        }
+
+        p_waiter->resume();
+    }
+
+    detail::async_waiter* unlink(detail::async_waiter* p_waiter) noexcept
+    {
+        if(p_waiter->prev)
+            p_waiter->prev->next = p_waiter->next;
+        else
+            head_ = p_waiter->next;
+
+        if(p_waiter->next)
+            p_waiter->next->prev = p_waiter->prev;
+        else
+            tail_ = p_waiter->prev;
+
+        p_waiter->queued = false;
+        --waiter_num_;
+
+        return p_waiter;
+    }
+
+    /// @brief Records a new owner, which waited for a given time (under the mutex's internal lock).
+    void set_owner(const source_location& location, const std::uint64_t wait_ns) noexcept
+    {
+        locked_         = true;
+        owner_location_ = location;
+        locked_ns_      = detail::monotonic_ns();
+
+        MutexGuardExternalAcquired(&guard_, detail::callsite(location), wait_ns);
+    }
+
+    MTX_GRD                 guard_      = {};
+    mutable std::mutex      mutex_;
+    bool                    locked_     = false;
+    detail::async_waiter*   head_       = nullptr;
+    detail::async_waiter*   tail_       = nullptr;
+    std::size_t             waiter_num_ = 0;
+    source_location         owner_location_;
+    std::uint64_t           locked_ns_  = 0;
+};
+
+/*****************************************/
+
+#endif
+
+} // namespace mtx_grd
+
+#endif
@@ -8,8 +8,10 @@ extern "C" {
 /********** Include statements ***********/
 
 #include <stdint.h>
+#include <stddef.h>
 #include <pthread.h>
 #include <stdbool.h>
+#include <sys/types.h>
 
 /*****************************************/
 
@@ -21,6 +23,10 @@ extern "C" {
 #define C_MUTEX_GUARD_DESTROY_ATTR_CLEANUP  __attribute__((cleanup(MutexGuardDestroyAttrCleanup)))
 #define C_MUTEX_GUARD_DESTROY_CLEANUP       __attribute__((cleanup(MutexGuardDestroyMutexCleanup)))
 #define C_MUTEX_GUARD_UNLOCK_CLEANUP        __attribute__((cleanup(MutexGuardReleaseMutexCleanup)))
+#define C_MUTEX_GUARD_UNLOCK_MANY_CLEANUP   __attribute__((cleanup(MutexGuardReleaseManyCleanup)))
+#define C_MUTEX_GUARD_COND_DESTROY_CLEANUP  __attribute__((cleanup(MutexGuardCondDestroyCleanup)))
+#define C_MUTEX_GUARD_RW_DESTROY_CLEANUP    __attribute__((cleanup(MutexGuardRwDestroyCleanup)))
+#define C_MUTEX_GUARD_RW_UNLOCK_CLEANUP     __attribute__((cleanup(MutexGuardRwReleaseCleanup)))
 
 #ifdef __cplusplus
 #define C_MUTEX_GUARD_RESTRICT
@@ -32,17 +38,242 @@ extern "C" {
 #define __MTX_GRD_ADDR_NUM__    10
 #endif
 
+#ifndef __MTX_GRD_BUILD_ID_LEN__
+#define __MTX_GRD_BUILD_ID_LEN__    20
+#endif
+
+#ifndef __MTX_GRD_NAME_LEN__
+#define __MTX_GRD_NAME_LEN__    32
+#endif
+
+#ifndef __MTX_GRD_CALLSITE_STATS_NUM__
+#define __MTX_GRD_CALLSITE_STATS_NUM__  8
+#endif
+
+#ifndef __MTX_GRD_EXPORT_MAX_GUARDS__
+#define __MTX_GRD_EXPORT_MAX_GUARDS__   128
+#endif
+
+#ifndef __MTX_GRD_REGISTRY_SHARED_NUM__
+#define __MTX_GRD_REGISTRY_SHARED_NUM__     64
+#endif
+
+#ifndef __MTX_GRD_STATS_SHARD_NUM__
+#define __MTX_GRD_STATS_SHARD_NUM__         16
+#endif
+
+#ifndef __MTX_GRD_SLOW_CAPTURE_NUM__
+#define __MTX_GRD_SLOW_CAPTURE_NUM__        64
+#endif
+
+#ifndef __MTX_GRD_SLOW_CAPTURE_DEPTH__
+#define __MTX_GRD_SLOW_CAPTURE_DEPTH__      32
+#endif
+
+#ifndef __MTX_GRD_DELEGATION_CLIENT_NUM__
+#define __MTX_GRD_DELEGATION_CLIENT_NUM__   64
+#endif
+
+#ifndef __MTX_GRD_BATCH_OP_NUM__
+#define __MTX_GRD_BATCH_OP_NUM__            256
+#endif
+
+#ifndef __MTX_GRD_BATCH_GUARD_NUM__
+#define __MTX_GRD_BATCH_GUARD_NUM__         8
+#endif
+
+#ifndef __MTX_GRD_DEFER_NUM__
+#define __MTX_GRD_DEFER_NUM__               32
+#endif
+
+#ifndef __MTX_GRD_SOURCE_CALLSITE_NUM__
+#define __MTX_GRD_SOURCE_CALLSITE_NUM__     1024
+#endif
+
+#ifndef __MTX_GRD_STATS_SHM_MAX_GUARDS__
+#define __MTX_GRD_STATS_SHM_MAX_GUARDS__    256
+#endif
+
+#ifndef __MTX_GRD_RW_READ_NUM__
+#define __MTX_GRD_RW_READ_NUM__             16
+#endif
+
+#ifndef __MTX_GRD_RW_BIAS_SLOT_NUM__
+#define __MTX_GRD_RW_BIAS_SLOT_NUM__        1024
+#endif
+
+#ifndef __MTX_GRD_RW_BIAS_INHIBIT_FACTOR__
+#define __MTX_GRD_RW_BIAS_INHIBIT_FACTOR__  9
+#endif
+
+/// @brief Number of latency histogram buckets (upper bounds: 1 us times powers of 4, up to ~1 s, plus +Inf).
+#define MTX_GRD_HIST_BUCKET_NUM 12
+
 /******* Private type definitions ********/
 
+/// @brief Intrusive FIFO of threads waiting on a MTX_GRD_COND (nodes live on the waiting threads' stacks).
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    struct MTX_GRD_COND_WAITER* head;
+    struct MTX_GRD_COND_WAITER* tail;
+} MTX_GRD_COND_WAIT_QUEUE;
+
+/// @brief Process-independent lock address: build ID of the module the address belongs to plus offset within that module.
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    uint8_t     build_id[__MTX_GRD_BUILD_ID_LEN__];
+    uintptr_t   offset;
+} MTX_GRD_CALLSITE;
+
 /// @brief Structure holding addresses in which target mutex was locked as well as locking thread's ID.
+/// Process and kernel thread IDs as well as callsites (only filled for process-shared guards) remain meaningful from other processes.
 typedef struct C_MUTEX_GUARD_ALIGNED
 {
-    void*           addresses[__MTX_GRD_ADDR_NUM__];
-    pthread_t       thread_id;
+    void*               addresses[__MTX_GRD_ADDR_NUM__];
+    pthread_t           thread_id;
+    pid_t               process_id;
+    pid_t               kernel_tid;
+    MTX_GRD_CALLSITE    callsites[__MTX_GRD_ADDR_NUM__];
+    uint64_t            acq_ns;
+    int                 sched_priority;
 } MTX_GRD_ACQ_LOCATION;
 
-/// @brief Mutex guard (module's main struct). Holds mutex to be locked/unlocked as well as attributes, locking data, and a free-use pointer.
+/// @brief Priority boosting statistics of PRIO_INHERIT/PRIO_PROTECT guards (durations in nanoseconds).
+/// Inheritance boosts are accounted when a higher-priority thread blocks on the guard, ceiling boosts when a lower-priority thread holds it.
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    unsigned long long  boost_counter;
+    uint64_t            boost_ns_total;
+    uint64_t            boost_ns_max;
+} MTX_GRD_PRIO_STATS;
+
+/// @brief Acquisition statistics of a lock address.
 typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    void*               address;
+    unsigned long long  acquisition_counter;
+    uint64_t            wait_ns_total;
+} MTX_GRD_CALLSITE_STATS;
+
+/// @brief Delegation server CPU values (see MTX_GRD_ATTR_SET_DELEGATION).
+#define MTX_GRD_DELEGATION_ANY_CPU  (-1)
+#define MTX_GRD_DELEGATION_OFF      (-2)
+
+/// @brief Cache line size per-CPU and per-thread data is aligned to.
+#define MTX_GRD_CACHE_LINE_SIZE 64
+
+/// @brief Slice of a guard's statistics, updated with atomics and merged on read (see MutexGuardGetStats). Private guards allocate
+/// __MTX_GRD_STATS_SHARD_NUM__ of them out of line on their first recorded acquisition, one per CPU on cache lines of its own, so that
+/// accounting never bounces a shared cache line between cores. Process-shared guards (or those whose shards could not be allocated)
+/// use the one embedded in MTX_GRD, which every process sharing them updates. Lock address counters follow the guard's address table.
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    unsigned long long      acquisition_counter;
+    unsigned long long      contention_counter;
+    unsigned long long      failure_counter;
+    unsigned long long      hold_counter;
+    uint64_t                wait_ns_total;
+    uint64_t                hold_ns_total;
+    uint64_t                hold_ns_max;
+    unsigned long long      sample_counter;
+    unsigned long long      wait_histogram[MTX_GRD_HIST_BUCKET_NUM];
+    unsigned long long      hold_histogram[MTX_GRD_HIST_BUCKET_NUM];
+    unsigned long long      callsite_acquisition_counters[__MTX_GRD_CALLSITE_STATS_NUM__];
+    uint64_t                callsite_wait_ns_totals[__MTX_GRD_CALLSITE_STATS_NUM__];
+    unsigned long long      callsite_overflow_counter;
+} MTX_GRD_STATS_SHARD;
+
+/// @brief Delegation server statistics (see MutexGuardAttrSetDelegation). Latencies go from submitting an operation to its completion,
+/// queue depths count the operations found pending by every server pass (batch), both in nanoseconds and per-bucket counts.
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    unsigned long long  request_counter;
+    unsigned long long  batch_counter;
+    unsigned long long  server_sleep_counter;
+    uint64_t            latency_ns_total;
+    uint64_t            latency_ns_max;
+    unsigned long long  latency_histogram[MTX_GRD_HIST_BUCKET_NUM];
+    unsigned long long  queue_depth_total;
+    unsigned int        queue_depth_max;
+} MTX_GRD_DELEGATION_STATS;
+
+/// @brief Number of batch size histogram buckets (powers of 2: 1, 2-3, 4-7, ..., 256 operations and beyond).
+#define MTX_GRD_BATCH_HIST_BUCKET_NUM   9
+
+/// @brief Operation batching statistics (see MutexGuardBatch). Flushes happen when a batch is full, outlives the guard's batch delay,
+/// its thread exits, or it is explicitly flushed (the remaining ones).
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    unsigned long long  flush_counter;
+    unsigned long long  op_counter;
+    unsigned long long  full_flush_counter;
+    unsigned long long  timed_flush_counter;
+    unsigned long long  exit_flush_counter;
+    unsigned int        batch_size_max;
+    unsigned long long  batch_size_histogram[MTX_GRD_BATCH_HIST_BUCKET_NUM];
+} MTX_GRD_BATCH_STATS;
+
+/// @brief Guard statistics (durations in nanoseconds). Histograms hold per-bucket (non-cumulative) counts.
+/// Lock addresses beyond the first __MTX_GRD_CALLSITE_STATS_NUM__ ones are only accounted in callsite_overflow_counter.
+/// If sampling is enabled (see MutexGuardSetSampling), counters are unbiased estimates scaled from sample_counter recorded acquisitions.
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    unsigned long long      acquisition_counter;
+    unsigned long long      contention_counter;
+    unsigned long long      failure_counter;
+    unsigned long long      hold_counter;
+    uint64_t                wait_ns_total;
+    uint64_t                hold_ns_total;
+    uint64_t                hold_ns_max;
+    unsigned long long      sample_counter;
+    unsigned long long      wait_histogram[MTX_GRD_HIST_BUCKET_NUM];
+    unsigned long long      hold_histogram[MTX_GRD_HIST_BUCKET_NUM];
+    MTX_GRD_CALLSITE_STATS  callsites[__MTX_GRD_CALLSITE_STATS_NUM__];
+    unsigned long long      callsite_overflow_counter;
+} MTX_GRD_STATS;
+
+/// @brief Stats shared memory segment magic number ("MGST") and layout version.
+#define MTX_GRD_STATS_SHM_MAGIC     0x5453474DU
+#define MTX_GRD_STATS_SHM_VERSION   1
+
+/// @brief Guard entry of the stats shared memory segment (durations in nanoseconds, owner IDs are 0 if not held).
+typedef struct
+{
+    char        name[__MTX_GRD_NAME_LEN__];
+    uint64_t    guard_address;
+    uint64_t    acquisition_counter;
+    uint64_t    contention_counter;
+    uint64_t    failure_counter;
+    uint64_t    wait_ns_total;
+    uint64_t    hold_ns_total;
+    uint64_t    hold_ns_max;
+    uint64_t    hold_ns_current;
+    uint32_t    waiter_counter;
+    int32_t     owner_pid;
+    int32_t     owner_tid;
+    uint32_t    reserved;
+} MTX_GRD_STATS_SHM_ENTRY;
+
+/// @brief Stats shared memory segment header, followed by entry_capacity entries (see MTX_GRD_STATS_SHM_ENTRIES).
+/// Entries and entry_num are protected by a seqlock: sequence is odd while the publisher updates them, so readers must copy
+/// them and retry if sequence was odd or changed meanwhile. publish_ns is measured against CLOCK_MONOTONIC.
+typedef struct
+{
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    sequence;
+    int32_t     pid;
+    uint32_t    entry_capacity;
+    uint32_t    entry_num;
+    uint64_t    publish_ns;
+    uint64_t    period_ns;
+} MTX_GRD_STATS_SHM;
+
+#define MTX_GRD_STATS_SHM_ENTRIES(p_segment)    ((MTX_GRD_STATS_SHM_ENTRY*)((MTX_GRD_STATS_SHM*)(p_segment) + 1))
+#define MTX_GRD_STATS_SHM_SIZE(entry_capacity)  (sizeof(MTX_GRD_STATS_SHM) + ((size_t)(entry_capacity) * sizeof(MTX_GRD_STATS_SHM_ENTRY)))
+
+/// @brief Mutex guard (module's main struct). Holds mutex to be locked/unlocked as well as attributes, locking data, and a free-use pointer.
+typedef struct C_MUTEX_GUARD_ALIGNED MTX_GRD
 {
     pthread_mutex_t         mutex;
     pthread_mutexattr_t     mutex_attr;
@@ -50,8 +281,151 @@ typedef struct C_MUTEX_GUARD_ALIGNED
     unsigned long long      lock_counter;
     pthread_mutex_t         ctrl_mutex;
     void*                   additional_data;
+    MTX_GRD_COND_WAIT_QUEUE cond_requeued;
+    bool                    process_shared;
+    bool                    robust;
+    bool                    owner_died;
+    MTX_GRD_ACQ_LOCATION    dead_owner_location;
+    int                     protocol;
+    int                     prio_ceiling;
+    MTX_GRD_PRIO_STATS      prio_stats;
+    char                    name[__MTX_GRD_NAME_LEN__];
+    unsigned int            waiter_counter;
+    struct MTX_GRD*         registry_next;
+    uint64_t                hold_budget_ns;
+    uint64_t                hold_deadline_ns;
+    unsigned long long      hold_violation_counter;
+    bool                    watchdog_listed;
+    struct MTX_GRD*         watchdog_prev;
+    struct MTX_GRD*         watchdog_next;
+    MTX_GRD_STATS_SHARD     stats;
+    struct MTX_GRD_STATS_SHARDS* stats_shards;
+    void*                   callsite_addresses[__MTX_GRD_CALLSITE_STATS_NUM__];
+    unsigned int            sampling_period;
+    unsigned int            hold_sample_weight;
+    uint64_t                slow_capture_threshold_ns;
+    unsigned int            slow_capture_refresh_counter;
+    uint64_t                trace_acquire_flow_id;
+    uint64_t                trace_release_flow_id;
+    struct MTX_GRD_COMBINE_SLOT* combine_head;
+    bool                    delegated;
+    int                     delegation_cpu;
+    struct MTX_GRD_DELEGATION* delegation;
+    size_t                  batch_op_num;
+    uint64_t                batch_delay_ns;
+    MTX_GRD_BATCH_STATS     batch_stats;
+    unsigned int            batch_pending_counter;
+    bool                    async_capable;
+    struct MTX_GRD_ASYNC_WAITER* async_head;
+    struct MTX_GRD_ASYNC_WAITER* async_tail;
+    struct MTX_GRD_ASYNC_WAITER* async_granted;
 } MTX_GRD;
 
+/// @brief Set of guards locked together (see MutexGuardLockManyAddr). Guards pointer is NULL if they could not be locked.
+typedef struct
+{
+    MTX_GRD**   guards;
+    size_t      guard_num;
+} MTX_GRD_MANY;
+
+/// @brief Slow acquisition captured by threshold (see MutexGuardSetSlowCapture): the waiter's stack (innermost frame first) and the lock
+/// addresses recorded by the owner it waited for. Durations are in nanoseconds, capture_ns is measured against CLOCK_MONOTONIC.
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    unsigned long long  sequence;
+    const MTX_GRD*      guard;
+    char                name[__MTX_GRD_NAME_LEN__];
+    uint64_t            capture_ns;
+    uint64_t            wait_ns;
+    uint64_t            threshold_ns;
+    void*               address;
+    pid_t               waiter_kernel_tid;
+    unsigned int        depth;
+    void*               frames[__MTX_GRD_SLOW_CAPTURE_DEPTH__];
+    pid_t               owner_process_id;
+    pid_t               owner_kernel_tid;
+    void*               owner_addresses[__MTX_GRD_ADDR_NUM__];
+} MTX_GRD_SLOW_CAPTURE;
+
+/// @brief Condition variable statistics (latencies in nanoseconds).
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    unsigned long long  wait_counter;
+    unsigned long long  timeout_counter;
+    unsigned long long  wakeup_counter;
+    unsigned long long  requeue_counter;
+    uint64_t            wait_ns_total;
+    uint64_t            wait_ns_max;
+    uint64_t            wakeup_latency_ns_total;
+    uint64_t            wakeup_latency_ns_max;
+} MTX_GRD_COND_STATS;
+
+/// @brief Condition variable bound to a MTX_GRD. Keeps the guard's owner and callsite records up to date across waits.
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    MTX_GRD_COND_WAIT_QUEUE waiters;
+    MTX_GRD*                p_mtx_grd;
+    MTX_GRD_COND_STATS      stats;
+    pthread_mutex_t         ctrl_mutex;
+} MTX_GRD_COND;
+
+/// @brief Reader-writer guard lock modes. Upgradable holders read alongside shared ones, but exclude each other as well as exclusive
+/// holders, so that they can become exclusive (see MutexGuardRwUpgrade) without any other writer getting in between.
+typedef enum
+{
+    MTX_GRD_RW_MODE_SHARED      = 0                             ,
+    MTX_GRD_RW_MODE_UPGRADABLE                                  ,
+    MTX_GRD_RW_MODE_EXCLUSIVE                                   ,
+    MTX_GRD_RW_MODE_MIN         = MTX_GRD_RW_MODE_SHARED        ,
+    MTX_GRD_RW_MODE_MAX         = MTX_GRD_RW_MODE_EXCLUSIVE     ,
+} MTX_GRD_RW_MODES;
+
+/// @brief Reader-writer guard preferences: waiting writers either hold new readers back (so that writers do not starve), or not
+/// (so that readers never wait for writers which are not holding the guard yet).
+typedef enum
+{
+    MTX_GRD_RW_PREFER_WRITERS   = 0                             ,
+    MTX_GRD_RW_PREFER_READERS                                   ,
+    MTX_GRD_RW_PREFER_MIN       = MTX_GRD_RW_PREFER_WRITERS     ,
+    MTX_GRD_RW_PREFER_MAX       = MTX_GRD_RW_PREFER_READERS     ,
+} MTX_GRD_RW_PREFERENCE;
+
+/// @brief Reader-writer guard holder (see MutexGuardRwGetHolders). Lock counter is 0 if not held, acq_ns is measured against CLOCK_MONOTONIC.
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    pthread_t           thread_id;
+    pid_t               kernel_tid;
+    MTX_GRD_RW_MODES    mode;
+    void*               address;
+    uint64_t            acq_ns;
+    unsigned long long  lock_counter;
+} MTX_GRD_RW_HOLDER;
+
+/// @brief Reader bias statistics of a reader-writer guard (see MutexGuardRwSetReaderBias, durations in nanoseconds). Biased tells
+/// whether readers currently bypass the rwlock, inhibit_until_ns (measured against CLOCK_MONOTONIC) when they may do it again.
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    bool                biased;
+    uint64_t            inhibit_until_ns;
+    unsigned long long  revocation_counter;
+    uint64_t            revocation_ns_total;
+    uint64_t            revocation_ns_max;
+} MTX_GRD_RW_BIAS_STATS;
+
+/// @brief Reader-writer guard (process-private). Upgradable and exclusive holders are recorded within the guard, whereas shared
+/// holders are only recorded by their own threads (see MutexGuardRwGetHolders), so that readers do not write to the guard.
+typedef struct C_MUTEX_GUARD_ALIGNED
+{
+    pthread_rwlock_t        rwlock;
+    pthread_mutex_t         writer_mutex;
+    pthread_mutex_t         ctrl_mutex;
+    MTX_GRD_RW_PREFERENCE   preference;
+    MTX_GRD_RW_HOLDER       writer;
+    bool                    bias_allowed;
+    bool                    bias;
+    MTX_GRD_RW_BIAS_STATS   bias_stats;
+} MTX_GRD_RW;
+
 /// @brief Lock types (to be used with MutexGuardLock).
 typedef enum
 {
@@ -96,6 +470,20 @@ typedef enum
 /// @brief Initializes Mutex Guard attribute with given parameters (MTX_GRD pointer, mutex type, mutex priority and mutex process sharing).
 #define MTX_GRD_ATTR_INIT(p_mtx_grd, mutex_type, priority, proc_sharing) (MutexGuardAttrInit(p_mtx_grd, mutex_type, priority, proc_sharing))
 
+/// @brief Sets Mutex Guard attribute robustness (PTHREAD_MUTEX_STALLED or PTHREAD_MUTEX_ROBUST). Meant to be used after MTX_GRD_ATTR_INIT.
+#define MTX_GRD_ATTR_SET_ROBUST(p_mtx_grd, robustness) (MutexGuardAttrSetRobust(p_mtx_grd, robustness))
+
+/// @brief Sets Mutex Guard attribute priority ceiling (used by PTHREAD_PRIO_PROTECT guards). Meant to be used after MTX_GRD_ATTR_INIT.
+#define MTX_GRD_ATTR_SET_PRIO_CEILING(p_mtx_grd, prio_ceiling) (MutexGuardAttrSetPrioCeiling(p_mtx_grd, prio_ceiling))
+
+/// @brief Makes Mutex Guard run operations passed to MutexGuardExecute on a server thread of its own, pinned to given CPU
+/// (MTX_GRD_DELEGATION_ANY_CPU not to pin it, MTX_GRD_DELEGATION_OFF to disable delegation). Meant to be used before MTX_GRD_INIT.
+#define MTX_GRD_ATTR_SET_DELEGATION(p_mtx_grd, cpu) (MutexGuardAttrSetDelegation(p_mtx_grd, cpu))
+
+/// @brief Sets the number of operations (up to __MTX_GRD_BATCH_OP_NUM__, 0 for that very number) and time (in nanoseconds, 0 for
+/// no limit) after which batches of operations passed to MTX_GRD_BATCH are applied.
+#define MTX_GRD_ATTR_SET_BATCHING(p_mtx_grd, op_num, delay_ns) (MutexGuardAttrSetBatching(p_mtx_grd, op_num, delay_ns))
+
 /// @brief Initializes Mutex Guard for a given MTX_GRD pointer.
 #define MTX_GRD_INIT(p_mtx_grd) MutexGuardInit(p_mtx_grd)
 
@@ -133,11 +521,43 @@ typedef enum
 /// @brief Tries to lock periodically mutex pointed by given MTX_GRD pointer with a given period (in nanoseoconds) and provides lock address automatically. It ensures mutex unlock just before the current scope is exited.
 #define MTX_GRD_PERIODIC_LOCK_SC(p_mtx_grd, tout_ns, cleanup_var_name)  MTX_GRD* cleanup_var_name C_MUTEX_GUARD_UNLOCK_CLEANUP = (MutexGuardLockAddr(p_mtx_grd, MutexGuardGetFuncRetAddr(), tout_ns, MTX_GRD_LOCK_TYPE_PERIODIC))
 
+/// @brief Locks every guard within given array of MTX_GRD pointers, waiting for them (in nanoseconds, 0 to wait forever) without
+/// risking deadlocks, and ensures they are all unlocked just before the current scope is exited (see MTX_GRD_MANY).
+#define MTX_GRD_LOCK_MANY_SC(guards, guard_num, tout_ns, cleanup_var_name)  MTX_GRD_MANY cleanup_var_name C_MUTEX_GUARD_UNLOCK_MANY_CLEANUP = (MutexGuardLockManyAddr((guards), (guard_num), (tout_ns)))
+
+/// @brief Locks mutex pointed by given MTX_GRD pointer if available, or queues the caller up and provides a file descriptor through
+/// given int pointer which becomes readable once the guard is released for it (see MutexGuardLockAsync).
+#define MTX_GRD_LOCK_ASYNC(p_mtx_grd, p_fd)                 MutexGuardLockAsync((p_mtx_grd), MutexGuardGetFuncRetAddr(), 0, (p_fd))
+
+/// @brief Same as MTX_GRD_LOCK_ASYNC, but the descriptor also becomes readable once a given time span (in nanoseconds) elapsed.
+#define MTX_GRD_TIMED_LOCK_ASYNC(p_mtx_grd, tout_ns, p_fd)  MutexGuardLockAsync((p_mtx_grd), MutexGuardGetFuncRetAddr(), tout_ns, (p_fd))
+
+/// @brief Completes an asynchronous lock request whose descriptor became readable (see MutexGuardLockAsyncComplete).
+#define MTX_GRD_LOCK_ASYNC_COMPLETE(p_mtx_grd, fd)          MutexGuardLockAsyncComplete((p_mtx_grd), (fd))
+
+/// @brief Withdraws an asynchronous lock request (see MutexGuardLockAsyncCancel).
+#define MTX_GRD_LOCK_ASYNC_CANCEL(p_mtx_grd, fd)            MutexGuardLockAsyncCancel((p_mtx_grd), (fd))
+
+/// @brief Marks the state protected by a robust MTX_GRD as consistent again after its previous owner died.
+#define MTX_GRD_MAKE_CONSISTENT(p_mtx_grd)          MutexGuardMakeConsistent(p_mtx_grd)
+
 /************ Unlock macros **************/
 
 /// @brief Unlocks mutex pointed by given MTX_GRD pointer.
 #define MTX_GRD_UNLOCK(p_mtx_grd)       MutexGuardUnlock(p_mtx_grd)
 
+/// @brief Unlocks every guard within given array of MTX_GRD pointers.
+#define MTX_GRD_UNLOCK_MANY(guards, guard_num)  MutexGuardUnlockMany((guards), (guard_num))
+
+/// @brief Queues work to be run by the calling thread once it releases given Mutex Guard (see MutexGuardDeferAfterUnlock).
+#define MTX_GRD_DEFER_AFTER_UNLOCK(p_mtx_grd, fn, arg)  MutexGuardDeferAfterUnlock((p_mtx_grd), (fn), (arg))
+
+/// @brief Queues an operation in the calling thread's batch for given Mutex Guard (see MutexGuardBatch).
+#define MTX_GRD_BATCH(p_mtx_grd, fn, arg)   MutexGuardBatch((p_mtx_grd), (fn), (arg))
+
+/// @brief Applies the calling thread's batch for given Mutex Guard (every batch of the calling thread if NULL).
+#define MTX_GRD_BATCH_FLUSH(p_mtx_grd)      MutexGuardBatchFlush(p_mtx_grd)
+
 /************ Destroy macros *************/
 
 /// @brief Destroys mutex pointed by given MTX_GRD pointer.
@@ -146,6 +566,87 @@ typedef enum
 /// @brief Destroys mutex attributes pointed by given MTX_GRD pointer.
 #define MTX_GRD_ATTR_DESTROY(p_mtx_grd) MutexGuardAttrDestroy(p_mtx_grd)
 
+/********* Shared memory macros **********/
+
+/// @brief Gets pointer to user data placed right after a MTX_GRD mapped by MutexGuardShmOpen.
+#define MTX_GRD_SHM_DATA(p_mtx_grd)     ((void*)((char*)(p_mtx_grd) + MTX_GRD_SHM_DATA_OFFSET))
+
+/// @brief Offset from a MTX_GRD mapped by MutexGuardShmOpen to its user data.
+#define MTX_GRD_SHM_DATA_OFFSET         ((sizeof(MTX_GRD) + 63) & ~(size_t)63)
+
+/********** Condition macros ************/
+
+/// @brief Creates empty MTX_GRD_COND variable.
+#define MTX_GRD_COND_CREATE(var_name) MTX_GRD_COND var_name = {0}
+
+/// @brief Initializes condition variable for a given MTX_GRD_COND pointer.
+#define MTX_GRD_COND_INIT(p_mtx_grd_cond) MutexGuardCondInit(p_mtx_grd_cond)
+
+/// @brief Initializes condition variable for a given MTX_GRD_COND pointer constraining its lifetime to the current scope.
+#define MTX_GRD_COND_INIT_SC(p_mtx_grd_cond, cleanup_var_name) MTX_GRD_COND* cleanup_var_name C_MUTEX_GUARD_COND_DESTROY_CLEANUP = (MutexGuardCondInitAddr(p_mtx_grd_cond))
+
+/// @brief Waits on a condition variable with the given MTX_GRD locked and provides wait address automatically.
+#define MTX_GRD_COND_WAIT(p_mtx_grd_cond, p_mtx_grd)                    MutexGuardCondWait((p_mtx_grd_cond), (p_mtx_grd), MutexGuardGetFuncRetAddr())
+
+/// @brief Waits on a condition variable within a given time span (in nanoseconds, CLOCK_MONOTONIC based) and provides wait address automatically.
+#define MTX_GRD_COND_TIMED_WAIT(p_mtx_grd_cond, p_mtx_grd, tout_ns)     MutexGuardCondTimedWait((p_mtx_grd_cond), (p_mtx_grd), MutexGuardGetFuncRetAddr(), tout_ns)
+
+/// @brief Wakes up a single thread waiting on a condition variable.
+#define MTX_GRD_COND_SIGNAL(p_mtx_grd_cond)     MutexGuardCondSignal(p_mtx_grd_cond)
+
+/// @brief Wakes up every thread waiting on a condition variable (one by one, as the associated MTX_GRD is released).
+#define MTX_GRD_COND_BROADCAST(p_mtx_grd_cond)  MutexGuardCondBroadcast(p_mtx_grd_cond)
+
+/// @brief Destroys condition variable pointed by given MTX_GRD_COND pointer.
+#define MTX_GRD_COND_DESTROY(p_mtx_grd_cond)    MutexGuardCondDestroy(p_mtx_grd_cond)
+
+/******** Reader-writer macros ***********/
+
+/// @brief Creates empty MTX_GRD_RW variable.
+#define MTX_GRD_RW_CREATE(var_name) MTX_GRD_RW var_name = {0}
+
+/// @brief Initializes reader-writer guard for a given MTX_GRD_RW pointer and preference (see MTX_GRD_RW_PREFERENCE).
+#define MTX_GRD_RW_INIT(p_mtx_grd_rw, preference) MutexGuardRwInit((p_mtx_grd_rw), (preference))
+
+/// @brief Initializes reader-writer guard for a given MTX_GRD_RW pointer constraining its lifetime to the current scope.
+#define MTX_GRD_RW_INIT_SC(p_mtx_grd_rw, preference, cleanup_var_name) MTX_GRD_RW* cleanup_var_name C_MUTEX_GUARD_RW_DESTROY_CLEANUP = (MutexGuardRwInitAddr((p_mtx_grd_rw), (preference)))
+
+/// @brief Tries to lock reader-writer guard in given mode (see MTX_GRD_RW_MODES) and provides lock address automatically.
+#define MTX_GRD_RW_TRY_LOCK(p_mtx_grd_rw, mode)             MutexGuardRwLock((p_mtx_grd_rw), (mode), MutexGuardGetFuncRetAddr(), 0, MTX_GRD_LOCK_TYPE_TRY)
+
+/// @brief Locks reader-writer guard in given mode (see MTX_GRD_RW_MODES) and provides lock address automatically.
+#define MTX_GRD_RW_LOCK(p_mtx_grd_rw, mode)                 MutexGuardRwLock((p_mtx_grd_rw), (mode), MutexGuardGetFuncRetAddr(), 0, MTX_GRD_LOCK_TYPE_PERMANENT)
+
+/// @brief Tries to lock reader-writer guard in given mode within a given time span (in nanoseconds) and provides lock address automatically.
+#define MTX_GRD_RW_TIMED_LOCK(p_mtx_grd_rw, mode, tout_ns)  MutexGuardRwLock((p_mtx_grd_rw), (mode), MutexGuardGetFuncRetAddr(), tout_ns, MTX_GRD_LOCK_TYPE_TIMED)
+
+/// @brief Tries to lock reader-writer guard in given mode and provides lock address automatically. It ensures the guard is released just before the current scope is exited.
+#define MTX_GRD_RW_TRY_LOCK_SC(p_mtx_grd_rw, mode, cleanup_var_name)            MTX_GRD_RW* cleanup_var_name C_MUTEX_GUARD_RW_UNLOCK_CLEANUP = (MutexGuardRwLockAddr((p_mtx_grd_rw), (mode), MutexGuardGetFuncRetAddr(), 0, MTX_GRD_LOCK_TYPE_TRY))
+
+/// @brief Locks reader-writer guard in given mode and provides lock address automatically. It ensures the guard is released just before the current scope is exited.
+#define MTX_GRD_RW_LOCK_SC(p_mtx_grd_rw, mode, cleanup_var_name)                MTX_GRD_RW* cleanup_var_name C_MUTEX_GUARD_RW_UNLOCK_CLEANUP = (MutexGuardRwLockAddr((p_mtx_grd_rw), (mode), MutexGuardGetFuncRetAddr(), 0, MTX_GRD_LOCK_TYPE_PERMANENT))
+
+/// @brief Tries to lock reader-writer guard in given mode within a given time span (in nanoseconds) and provides lock address automatically. It ensures the guard is released just before the current scope is exited.
+#define MTX_GRD_RW_TIMED_LOCK_SC(p_mtx_grd_rw, mode, tout_ns, cleanup_var_name) MTX_GRD_RW* cleanup_var_name C_MUTEX_GUARD_RW_UNLOCK_CLEANUP = (MutexGuardRwLockAddr((p_mtx_grd_rw), (mode), MutexGuardGetFuncRetAddr(), tout_ns, MTX_GRD_LOCK_TYPE_TIMED))
+
+/// @brief Turns the calling thread's upgradable hold of a reader-writer guard into an exclusive one, waiting for readers to leave.
+#define MTX_GRD_RW_UPGRADE(p_mtx_grd_rw)                    MutexGuardRwUpgrade((p_mtx_grd_rw), MutexGuardGetFuncRetAddr(), 0, MTX_GRD_LOCK_TYPE_PERMANENT)
+
+/// @brief Same as MTX_GRD_RW_UPGRADE, but gives up (keeping the upgradable hold) once a given time span (in nanoseconds) elapsed.
+#define MTX_GRD_RW_TIMED_UPGRADE(p_mtx_grd_rw, tout_ns)     MutexGuardRwUpgrade((p_mtx_grd_rw), MutexGuardGetFuncRetAddr(), tout_ns, MTX_GRD_LOCK_TYPE_TIMED)
+
+/// @brief Turns the calling thread's hold of a reader-writer guard into a weaker one (see MutexGuardRwDowngrade).
+#define MTX_GRD_RW_DOWNGRADE(p_mtx_grd_rw, mode)            MutexGuardRwDowngrade((p_mtx_grd_rw), (mode))
+
+/// @brief Enables or disables reader bias of a reader-writer guard (see MutexGuardRwSetReaderBias).
+#define MTX_GRD_RW_SET_READER_BIAS(p_mtx_grd_rw, enable)    MutexGuardRwSetReaderBias((p_mtx_grd_rw), (enable))
+
+/// @brief Releases the calling thread's hold of a reader-writer guard.
+#define MTX_GRD_RW_UNLOCK(p_mtx_grd_rw)     MutexGuardRwUnlock(p_mtx_grd_rw)
+
+/// @brief Destroys reader-writer guard pointed by given MTX_GRD_RW pointer.
+#define MTX_GRD_RW_DESTROY(p_mtx_grd_rw)    MutexGuardRwDestroy(p_mtx_grd_rw)
+
 /********* Error message macros **********/
 
 /// @brief Retrieves string associated to latest error code.
@@ -209,7 +710,36 @@ C_MUTEX_GUARD_API MTX_GRD* MutexGuardAttrInitAddr(  MTX_GRD* C_MUTEX_GUARD_RESTR
                                                     const int priority                              ,
                                                     const int proc_sharing                          );
 
-/// @brief Initializes mutex.
+/// @brief Sets mutex attribute robustness.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param robustness Mutex robustness (STALLED, ROBUST).
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardAttrSetRobust(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const int robustness);
+
+/// @brief Sets mutex attribute priority ceiling.
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param prio_ceiling Priority ceiling (within SCHED_FIFO priority range).
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardAttrSetPrioCeiling(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const int prio_ceiling);
+
+/// @brief Sets guard delegation (remote core locking): once initialized, the guard starts a server thread which runs every operation
+/// passed to MutexGuardExecute, submitted through per-client cache line mailboxes, so that the protected state stays in its cache.
+/// Operations are run in batches with the guard locked (so MTX_GRD_LOCK and friends keep excluding them), and are accounted as
+/// acquisitions from their callers' sites. The server thread is stopped by MutexGuardDestroy.
+/// @param p_mutex_guard Pointer to mutex guard structure (neither robust nor process-shared).
+/// @param cpu CPU the server thread is pinned to (MTX_GRD_DELEGATION_ANY_CPU not to pin it, MTX_GRD_DELEGATION_OFF to disable delegation).
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardAttrSetDelegation(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const int cpu);
+
+/// @brief Sets guard operation batching limits (see MutexGuardBatch).
+/// @param p_mutex_guard Pointer to mutex guard structure.
+/// @param op_num Operations a batch is applied at (up to __MTX_GRD_BATCH_OP_NUM__, 0 for that very number).
+/// @param delay_ns Time a batch is applied at, from its first operation on (in nanoseconds, 0 for no limit).
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardAttrSetBatching(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard, const size_t op_num, const uint64_t delay_ns);
+
+/// @brief Initializes mutex (its internal control mutex inherits priorities if the guard has a priority protocol) and registers it.
+/// Up to __MTX_GRD_REGISTRY_SHARED_NUM__ process-shared guards can be registered at once: past that, initialization fails.
 /// @param p_mutex_guard Pointer to mutex containing mutex guard structure.
 /// @return 0 if succeeded, != 0 otherwise.
 C_MUTEX_GUARD_API int MutexGuardInit(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard);
@@ -225,6 +755,10 @@ C_MUTEX_GUARD_API MTX_GRD* MutexGuardInitAddr(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_
 /// @param timeout_ns Target timeout value (if any, in nanoseconds).
 /// @param lock_type Lock type (TR_LOCK, LOCK, TIMED_LOCK, PERIODIC_TIMED_LOCK).
 /// @return 0 if succeeded, != 0 otherwise.
+/// @note EOWNERDEAD means a robust guard was acquired after its previous owner died holding it (whose addresses are then reported
+/// by the error string). The guard is held: protected state should be repaired and MutexGuardMakeConsistent called before unlocking it.
+/// ENOTRECOVERABLE is returned if the guard was released without being made consistent, or if the owner of a non-robust guard
+/// died while a periodic lock was waiting for it.
 C_MUTEX_GUARD_API int MutexGuardLock(   MTX_GRD* p_mutex_guard              ,
                                         void* C_MUTEX_GUARD_RESTRICT address,
                                         const uint64_t timeout_ns           ,
@@ -235,16 +769,307 @@ C_MUTEX_GUARD_API int MutexGuardLock(   MTX_GRD* p_mutex_guard              ,
 /// @param address Address in which the current mutex is being tried to be locked.
 /// @param timeout_ns Target timeout value (if any, in nanoseconds).
 /// @param lock_type Lock type (TR_LOCK, LOCK, TIMED_LOCK, PERIODIC_TIMED_LOCK).
-/// @return Pointer to given mutex guard structure if succeeded, NULL otherwise.
+/// @return Pointer to given mutex guard structure if succeeded (or acquired after its owner died, see MutexGuardIsInconsistent), NULL otherwise.
 C_MUTEX_GUARD_API MTX_GRD* MutexGuardLockAddr(  MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mutex_guard   ,
                                                 void* C_MUTEX_GUARD_RESTRICT address            ,
                                                 const uint64_t timeout_ns                       ,
                                                 const int lock_type                             );
 
+/// @brief Runs an operation on the state protected by target guard, as if it was locked around it (flat combining). Operations of
+/// threads finding the guard held are published and run by whichever thread holds it, right before releasing it, so that contended
+/// guards are handed over (and their protected state moved between caches) once per batch rather than once per operation. Each
+/// operation is accounted as an acquisition from the calling site, just like MTX_GRD_LOCK would.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param fn Operation to be run (possibly by another thread), which must neither lock target guard nor wait on it.
+/// @param arg Operation's argument.
+/// @return 0 if succeeded (fn has returned by then), != 0 otherwise (see MutexGuardLock).
+/// @note Robust and process-shared guards are just locked around the operation, whose publishers could not be trusted to outlive it.
+/// Being called by the guard's owner, the operation is run right away.
+C_MUTEX_GUARD_API int MutexGuardExecute(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void (*fn)(void*), void* arg);
+
+/// @brief Locks several guards at once, without deadlocking against threads locking them in any other order: the guard found busy
+/// is waited for with no other guard held, and the others are only tried, so they are all released and retried starting from the
+/// busy one whenever one of them is not available. The wait is recorded once (stats, profile, trace, slow capture) for the whole
+/// set, against the guard it ended on, while every guard accounts its acquisition from the calling site.
+/// @param guards Array of pointers to mutex guard structures (each listed once).
+/// @param guard_num Number of guards within the array.
+/// @param timeout_ns Maximum time to wait for the whole set (in nanoseconds, 0 to wait forever).
+/// @return 0 if succeeded, < 0 if arguments are invalid, > 0 (standard error code) otherwise.
+/// @note EOWNERDEAD means at least one of the guards was acquired from a dead owner (see MutexGuardLock, MutexGuardIsInconsistent),
+/// the whole set being held then: the rest of it is only tried from that point on, past the timeout if need be.
+C_MUTEX_GUARD_API int MutexGuardLockMany(MTX_GRD** C_MUTEX_GUARD_RESTRICT guards, const size_t guard_num, const uint64_t timeout_ns);
+
+/// @brief MutexGuardLockMany function wrapper.
+/// @param guards Array of pointers to mutex guard structures (each listed once).
+/// @param guard_num Number of guards within the array.
+/// @param timeout_ns Maximum time to wait for the whole set (in nanoseconds, 0 to wait forever).
+/// @return Given set of guards if succeeded (or one of them was acquired after its owner died), a set with NULL guards otherwise.
+C_MUTEX_GUARD_API MTX_GRD_MANY MutexGuardLockManyAddr(MTX_GRD** C_MUTEX_GUARD_RESTRICT guards, const size_t guard_num, const uint64_t timeout_ns);
+
+/// @brief Unlocks every guard of a set, in reverse order.
+/// @param guards Array of pointers to mutex guard structures.
+/// @param guard_num Number of guards within the array.
+/// @return 0 if succeeded, != 0 otherwise (first error found, every guard is unlocked anyway).
+C_MUTEX_GUARD_API int MutexGuardUnlockMany(MTX_GRD** C_MUTEX_GUARD_RESTRICT guards, const size_t guard_num);
+
+/// @brief Locks target guard without blocking, for event loops: the guard is either locked right away, or the caller is queued up
+/// and given a non-blocking file descriptor (to be polled alongside others, e.g. with epoll) which becomes readable once its owner
+/// released the guard for it, or once the timeout elapsed. MutexGuardLockAsyncComplete must then be called, which takes the guard
+/// (or MutexGuardLockAsyncCancel, at any time).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param address Address in which the guard is being locked.
+/// @param timeout_ns Time after which the descriptor becomes readable anyway (in nanoseconds, 0 to wait forever).
+/// @param p_fd Pointer to where the descriptor is provided (-1 if the guard was locked right away). Owned by the request.
+/// @return 0 if locked right away, EINPROGRESS if queued up, < 0 if arguments are invalid, > 0 (standard error code) otherwise.
+/// @note Only non-robust, process-private guards with no priority protocol (and no delegation) support it. Releases wake queued
+/// requests up one at a time, in the order they were queued in; a thread blocked in MTX_GRD_LOCK may still take the guard first,
+/// and its own release wakes the request up again. Descriptors of requests pending when the guard is destroyed are made readable
+/// but left open (they may still be in a poll set): their owners close them, without completing or withdrawing them.
+C_MUTEX_GUARD_API int MutexGuardLockAsync(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void* C_MUTEX_GUARD_RESTRICT address, const uint64_t timeout_ns, int* C_MUTEX_GUARD_RESTRICT p_fd);
+
+/// @brief Completes an asynchronous lock request whose descriptor became readable. Unless it is still queued up (spurious wake-up,
+/// or guard taken first by another thread), the request is over and its descriptor closed.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param fd Request's descriptor.
+/// @return 0 if the guard is locked by the calling thread, ETIMEDOUT if the request timed out, EINPROGRESS if it is still queued
+/// up, < 0 if arguments are invalid (e.g. unknown request).
+/// @note The guard is accounted as acquired after having waited since the request was queued up.
+C_MUTEX_GUARD_API int MutexGuardLockAsyncComplete(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const int fd);
+
+/// @brief Withdraws an asynchronous lock request and closes its descriptor. If the guard was already released for it, the next
+/// request (if any) is woken up instead.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param fd Request's descriptor.
+/// @return 0 if succeeded, < 0 if arguments are invalid (e.g. unknown request).
+C_MUTEX_GUARD_API int MutexGuardLockAsyncCancel(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const int fd);
+
+/// @brief Queues work caused by a critical section which does not need the guard (freeing memory, logging, waking other components
+/// up...) to be run by the calling thread right after it releases target guard (MTX_GRD_UNLOCK, scoped lock cleanup...), so that
+/// the guard is held for shorter. Work is run in the order it was queued in, and may lock the guard again or queue further work.
+/// @param p_mtx_grd Pointer to mutex guard structure (locked by the calling thread).
+/// @param fn Work to be run.
+/// @param arg Work's argument.
+/// @return 0 if succeeded, < 0 otherwise (nothing is queued, e.g. if __MTX_GRD_DEFER_NUM__ works are already pending).
+/// @note Work is run once recursive guards are actually released (MTX_GRD_COND_WAIT releases them too, and MutexGuardDestroy
+/// releases the calling thread's ones), and is dropped if the release fails or its thread exits before that happens.
+C_MUTEX_GUARD_API int MutexGuardDeferAfterUnlock(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void (*fn)(void*), void* arg);
+
+/// @brief Queues an operation in the calling thread's batch for target guard, so that a whole batch is applied under a single
+/// acquisition (accounted from the site of its first operation). Batches are applied, oldest operation first, once they are full,
+/// when an operation is queued after the guard's batch delay elapsed, when explicitly flushed, and when their thread exits.
+/// Each thread keeps batches for up to __MTX_GRD_BATCH_GUARD_NUM__ guards at once, the oldest one being applied to make room.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param fn Operation to be applied with the guard locked, which may queue further operations but must not flush them.
+/// @param arg Operation's argument.
+/// @return 0 if succeeded, < 0 if arguments are invalid, > 0 (standard error code) if a batch could not be applied (and was kept).
+/// EOWNERDEAD means the guard was acquired from a dead owner and is held by the calling thread (see MutexGuardLock).
+/// @note Delays are only checked when operations are queued: threads going idle should flush their batches. Batches are not
+/// applied by MutexGuardDestroy on behalf of threads other than the calling one, which must flush them beforehand: until then, the
+/// guard is refused destruction.
+C_MUTEX_GUARD_API int MutexGuardBatch(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, void (*fn)(void*), void* arg);
+
+/// @brief Applies the calling thread's batch for target guard.
+/// @param p_mtx_grd Pointer to mutex guard structure (NULL to apply every batch of the calling thread).
+/// @return 0 if succeeded, > 0 (standard error code) if a batch could not be applied (and was kept).
+C_MUTEX_GUARD_API int MutexGuardBatchFlush(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd);
+
 /// @brief Returns address within the program of line in which the current function was called. Meant to be used in macros.
 /// @return Current function calling address.
 C_MUTEX_GUARD_API C_MUTEX_GUARD_NOINLINE void* MutexGuardGetFuncRetAddr(void);
 
+/// @brief Returns a stable address standing for a source location, to be given to functions taking lock addresses (MutexGuardLock
+/// and friends) instead of a return address. Lock errors and exported statistics then show the location as is, with no address
+/// symbolization (e.g. for C++ callers capturing std::source_location). The same location always yields the same address.
+/// @param file Source file (must outlive the process, e.g. a string literal).
+/// @param line Source line.
+/// @param function Function name (must outlive the process, may be NULL).
+/// @return Location's address if succeeded, NULL otherwise (e.g. if __MTX_GRD_SOURCE_CALLSITE_NUM__ locations are already known).
+C_MUTEX_GUARD_API void* MutexGuardSourceCallsite(const char* file, const unsigned int line, const char* function);
+
+/// @brief Records an acquisition of target guard made by another locking scheme (e.g. a coroutine mutex), without locking its mutex:
+/// dumps, statistics and exported callsites then show the acquirer (the calling thread) as the guard's owner until
+/// MutexGuardExternalReleased is called. Such a guard must not be locked through MutexGuardLock and friends meanwhile.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param address Address in which the guard was acquired (e.g. from MutexGuardSourceCallsite).
+/// @param wait_ns Time the new owner spent waiting for the guard (0 if it did not, accounted as a contended acquisition otherwise).
+/// @return 0 if succeeded, < 0 if arguments are invalid, EBUSY if the guard is already recorded as held.
+C_MUTEX_GUARD_API int MutexGuardExternalAcquired(   MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd   ,
+                                                    void* C_MUTEX_GUARD_RESTRICT address        ,
+                                                    const uint64_t wait_ns                      );
+
+/// @brief Records the release of a guard acquired through MutexGuardExternalAcquired, from any thread (ownership belongs to the
+/// external scheme, which may hand it over across threads).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @return 0 if succeeded, < 0 otherwise (e.g. if the guard was not recorded as held).
+C_MUTEX_GUARD_API int MutexGuardExternalReleased(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd);
+
+/// @brief Marks the state protected by a robust guard as consistent again after its previous owner died, and drops dead owner's record.
+/// @param p_mtx_grd Pointer to mutex guard structure (locked by the calling thread).
+/// @return 0 if succeeded, < 0 if guard state is invalid, > 0 (standard error code) otherwise.
+C_MUTEX_GUARD_API int MutexGuardMakeConsistent(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd);
+
+/// @brief Tells whether a guard was acquired after its previous owner died and has not been made consistent yet.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @return true if guard needs to be made consistent, false otherwise.
+C_MUTEX_GUARD_API bool MutexGuardIsInconsistent(const MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd);
+
+/// @brief Gets priority boosting statistics of a PRIO_INHERIT/PRIO_PROTECT guard.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_stats Pointer to the structure statistics are meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardGetPrioStats(   MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd               ,
+                                                MTX_GRD_PRIO_STATS* C_MUTEX_GUARD_RESTRICT p_stats      );
+
+/// @brief Names a guard (shown by MutexGuardDumpAll).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param name Guard name (truncated to __MTX_GRD_NAME_LEN__ - 1 characters).
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardSetName(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const char* C_MUTEX_GUARD_RESTRICT name);
+
+/// @brief Sets a guard's maximum expected hold time. Holds exceeding it are flagged by a watchdog thread (started on first use),
+/// which counts them and reports the owner and its lock addresses through MutexGuardPrintError (if lock errors are meant to be printed).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param hold_budget_ns Hold budget in nanoseconds (0 disables it). Applies from the guard's next hold onwards.
+/// @return 0 if succeeded, < 0 otherwise.
+/// @note Budgets are checked with the watchdog's resolution (10 ms), and are not supported by process-shared guards.
+C_MUTEX_GUARD_API int MutexGuardSetHoldBudget(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const uint64_t hold_budget_ns);
+
+/// @brief Gets the number of holds which exceeded a guard's hold budget.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_violations Pointer to the variable the number of violations is meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardGetHoldViolations(  MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd           ,
+                                                    unsigned long long* C_MUTEX_GUARD_RESTRICT p_violations );
+
+/// @brief Gets a snapshot of a guard's acquisition statistics (its per-CPU shards merged).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_stats Pointer to the structure statistics are meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardGetStats(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, MTX_GRD_STATS* C_MUTEX_GUARD_RESTRICT p_stats);
+
+/// @brief Gets a delegated guard's server statistics (see MutexGuardAttrSetDelegation).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_stats Pointer to the structure statistics are meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardGetDelegationStats(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, MTX_GRD_DELEGATION_STATS* C_MUTEX_GUARD_RESTRICT p_stats);
+
+/// @brief Gets a guard's operation batching statistics (see MutexGuardBatch).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_stats Pointer to the structure statistics are meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardGetBatchStats(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, MTX_GRD_BATCH_STATS* C_MUTEX_GUARD_RESTRICT p_stats);
+
+/// @brief Gets what a guard's statistics grew by since a previous snapshot, and replaces that snapshot with the current one,
+/// so that calling it periodically yields per-interval statistics. A zeroed snapshot yields the whole statistics.
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param p_snapshot Pointer to the previous snapshot (updated to the current one).
+/// @param p_delta Pointer to the structure differences are meant to be copied to (hold_ns_max is the lifetime maximum, though).
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardGetStatsDelta(  MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd           ,
+                                                MTX_GRD_STATS* C_MUTEX_GUARD_RESTRICT p_snapshot    ,
+                                                MTX_GRD_STATS* C_MUTEX_GUARD_RESTRICT p_delta       );
+
+/// @brief Sets how many lock calls are recorded. Only a random 1-in-period of them (plus every one which waited for slow_threshold_ns
+/// or longer) pay for timestamps, stats, profiling backtraces and trace events, and they are accounted as many calls as they stand for,
+/// so that statistics and profiles remain unbiased estimates. Unsampled holds are not timed (dumps report them as 0 ns long), unless the
+/// guard has a hold budget or a priority protocol.
+/// @param period Sampling period (1 records every call, which is the default).
+/// @param slow_threshold_ns Wait time from which calls are always recorded (0 to disable).
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardSetSampling(const unsigned int period, const uint64_t slow_threshold_ns);
+
+/// @brief Overrides the sampling period for a single guard (see MutexGuardSetSampling).
+/// @param p_mtx_grd Pointer to mutex guard structure.
+/// @param period Sampling period (0 follows the global one).
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardSetGuardSampling(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const unsigned int period);
+
+/// @brief Enables threshold-triggered capture of slow acquisitions: every lock call which waited for longer than the threshold
+/// records the waiter's stack and the lock addresses of the owner it waited for into a ring of the latest __MTX_GRD_SLOW_CAPTURE_NUM__
+/// captures. Calls which did not wait pay nothing, and those which did only pay for the timestamps they already take.
+/// @param threshold_ns Fixed wait threshold (0 for none).
+/// @param percentile Wait time percentile (e.g. 99.0) beyond which acquisitions are captured, estimated per guard from its wait histogram
+/// (0 for none). If both are given, the higher one applies. Both being 0 disables capturing.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardSetSlowCapture(const uint64_t threshold_ns, const double percentile);
+
+/// @brief Copies the latest slow acquisition captures (see MutexGuardSetSlowCapture), oldest first.
+/// @param captures Target array.
+/// @param capture_num Target array's capacity.
+/// @return Number of captures copied if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardGetSlowCaptures(MTX_GRD_SLOW_CAPTURE* C_MUTEX_GUARD_RESTRICT captures, const size_t capture_num);
+
+/// @brief Writes the latest slow acquisition captures (oldest first) in human-readable form, with symbolized stacks.
+/// @param fd Target file descriptor.
+/// @return Number of captures written if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardWriteSlowCaptures(const int fd);
+
+/// @brief Writes every registered guard's statistics in Prometheus text exposition format. Guard names (or addresses, if unnamed)
+/// and lock addresses are used as labels. Guards beyond the first __MTX_GRD_EXPORT_MAX_GUARDS__ ones are aggregated as "other".
+/// @param fd Target file descriptor.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardExportPrometheus(const int fd);
+
+/// @brief Starts a thread which periodically exports statistics to a file (atomically replaced, as textfile collectors expect).
+/// @param path Target file path.
+/// @param period_ns Export period in nanoseconds.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardExporterStartFile(const char* C_MUTEX_GUARD_RESTRICT path, const uint64_t period_ns);
+
+/// @brief Starts a thread which serves statistics (as an HTTP/1.0 response) to every connection accepted on a local Unix socket.
+/// @param socket_path Unix socket path (replaced if it already exists).
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardExporterStartSocket(const char* C_MUTEX_GUARD_RESTRICT socket_path);
+
+/// @brief Starts a thread which periodically publishes every guard's statistics into a named shared memory segment
+/// (see MTX_GRD_STATS_SHM), so that they can be watched live (e.g. with mgtop) without the process doing any I/O.
+/// @param name Shared memory object name (as used by shm_open, e.g. "/my_app_mtx_grd").
+/// @param period_ns Publishing period in nanoseconds.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardExporterStartShm(const char* C_MUTEX_GUARD_RESTRICT name, const uint64_t period_ns);
+
+/// @brief Stops every exporter thread started by MutexGuardExporterStartFile/MutexGuardExporterStartSocket/MutexGuardExporterStartShm
+/// (removing the stats segment, if any).
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardExporterStop(void);
+
+/// @brief Enables or disables contention profiling. While enabled, every lock which has to wait for another owner records
+/// the waiter's stack, so that contended acquisitions and wait times can be aggregated per stack. Enabling it clears previous samples.
+/// @param enable Tells whether profiling is meant to be enabled.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardSetContentionProfiling(const bool enable);
+
+/// @brief Writes the contention profile (contentions/count and delay/nanoseconds per waiter stack) in pprof protobuf format,
+/// so that it can be inspected or diffed with "pprof" (e.g. pprof -http=: -diff_base=old.pb new.pb).
+/// @param fd Target file descriptor.
+/// @return Number of samples written if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardWriteContentionProfile(const int fd);
+
+/// @brief Enables or disables lock timeline tracing. While enabled, waits for and holds of every guard are recorded into a ring
+/// of the latest events. Enabling it clears previous events.
+/// @param enable Tells whether tracing is meant to be enabled.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardSetTracing(const bool enable);
+
+/// @brief Writes the traced lock timeline as Chrome trace event JSON (loadable by Perfetto or chrome://tracing): a track per thread,
+/// "waiting for" and "holding" spans per guard, and flow arrows from every release to the next owner's acquisition.
+/// @param fd Target file descriptor.
+/// @return Number of spans written if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardWriteTrace(const int fd);
+
+/// @brief Writes the state of every held guard (owner, hold duration, waiters and lock addresses) to a file descriptor.
+/// Guards are walked without taking any lock, so lockers are never blocked, and formatted without stdio, so it can be called from a signal handler.
+/// @param fd Target file descriptor.
+/// @return Number of held guards found if succeeded, < 0 otherwise.
+/// @note Lock addresses are printed raw (alongside the executable's base address), as resolving them is not async-signal-safe.
+C_MUTEX_GUARD_API int MutexGuardDumpAll(const int fd);
+
+/// @brief Installs a handler which calls MutexGuardDumpAll whenever a given signal is received.
+/// @param signum Target signal (e.g. SIGUSR1).
+/// @param fd Target file descriptor.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardSetDumpSignal(const int signum, const int fd);
+
 /// @brief Unlocks target mutex.
 /// @param p_mtx_grd Pointer to mutex guard structure.
 /// @return 0 if succeeded, != 0 otherwise.
@@ -255,15 +1080,20 @@ C_MUTEX_GUARD_API int MutexGuardUnlock(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd
 /// @return 0 if succeeded, > 0 otherwise.
 C_MUTEX_GUARD_API int MutexGuardAttrDestroy(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd);
 
-/// @brief Destroys mutex within given mutex guard.
+/// @brief Destroys mutex within given mutex guard. The calling thread's batched operations for it are applied first, while other
+/// threads' ones make it fail (see MutexGuardBatch).
 /// @param p_mtx_grd Pointer to mutex guard structure.
-/// @return 0 if succeeded, > 0 otherwise.
+/// @return 0 if succeeded, != 0 otherwise.
 C_MUTEX_GUARD_API int MutexGuardDestroy(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd);
 
 /// @brief Cleanup function to release a mutex (meant to be used alongside scoped mutex lock macros).
 /// @param ptr Pointer to mutex guard structure. 
 C_MUTEX_GUARD_API void MutexGuardReleaseMutexCleanup(void* ptr);
 
+/// @brief Cleanup function to release every guard of a set held by the calling thread (meant to be used alongside MTX_GRD_LOCK_MANY_SC).
+/// @param ptr Pointer to set of guards.
+C_MUTEX_GUARD_API void MutexGuardReleaseManyCleanup(void* ptr);
+
 /// @brief Cleanup function to destroy a mutex attribute (meant to be used alongside scoped attribute init macros).
 /// @param ptr Pointer to mutex attribute containing mutex guard structure. 
 C_MUTEX_GUARD_API void MutexGuardDestroyAttrCleanup(void* ptr);
@@ -272,6 +1102,191 @@ C_MUTEX_GUARD_API void MutexGuardDestroyAttrCleanup(void* ptr);
 /// @param ptr Pointer to mutex guard structure.
 C_MUTEX_GUARD_API void MutexGuardDestroyMutexCleanup(void* ptr);
 
+/// @brief Maps a named POSIX shared memory object holding a process-shared MTX_GRD followed by data_size bytes of user data (see MTX_GRD_SHM_DATA).
+/// The first process to open it creates and initializes it, the rest wait for it to be ready and attach to it.
+/// @param name Shared memory object name (as used by shm_open, e.g. "/my_cache").
+/// @param data_size Size (in bytes) of the user data placed after the MTX_GRD.
+/// @param mutex_type Mutex type (NORMAL, ERRORCHECK, RECURSIVE, DEFAULT), only used by the creating process.
+/// @return Pointer to mapped mutex guard structure if succeeded, NULL otherwise.
+C_MUTEX_GUARD_API MTX_GRD* MutexGuardShmOpen(   const char* C_MUTEX_GUARD_RESTRICT name ,
+                                                const size_t data_size                  ,
+                                                const int mutex_type                    );
+
+/// @brief Unmaps a MTX_GRD previously mapped by MutexGuardShmOpen. The guard itself is left as is for other processes to use it.
+/// @param p_mtx_grd Pointer to mapped mutex guard structure.
+/// @param data_size Size (in bytes) of the user data provided to MutexGuardShmOpen.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardShmClose(MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd, const size_t data_size);
+
+/// @brief Removes a named shared memory object created by MutexGuardShmOpen (processes which already mapped it keep using it).
+/// @param name Shared memory object name.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardShmUnlink(const char* C_MUTEX_GUARD_RESTRICT name);
+
+/// @brief Initializes condition variable.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardCondInit(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond);
+
+/// @brief MutexGuardCondInit function wrapper.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @return Pointer to given condition variable structure if succeeded, NULL otherwise.
+C_MUTEX_GUARD_API MTX_GRD_COND* MutexGuardCondInitAddr(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond);
+
+/// @brief Atomically releases target MTX_GRD and waits for the condition variable to be signaled, then locks the MTX_GRD again.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @param p_mtx_grd Pointer to mutex guard structure (locked exactly once by the calling thread).
+/// @param address Address in which the wait is performed (recorded as the new acquisition address).
+/// @return 0 if succeeded, < 0 if arguments or guard state are invalid, > 0 (standard error code) otherwise.
+C_MUTEX_GUARD_API int MutexGuardCondWait(   MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond ,
+                                            MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd           ,
+                                            void* C_MUTEX_GUARD_RESTRICT address                );
+
+/// @brief Same as MutexGuardCondWait, but gives up waiting once the timeout (measured against CLOCK_MONOTONIC) has elapsed.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @param p_mtx_grd Pointer to mutex guard structure (locked exactly once by the calling thread).
+/// @param address Address in which the wait is performed (recorded as the new acquisition address).
+/// @param timeout_ns Target timeout value (in nanoseconds).
+/// @return 0 if succeeded, ETIMEDOUT if timeout elapsed, < 0 if arguments or guard state are invalid, > 0 (standard error code) otherwise.
+/// @note The MTX_GRD is locked again on return, even if the timeout elapsed.
+C_MUTEX_GUARD_API int MutexGuardCondTimedWait(  MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond ,
+                                                MTX_GRD* C_MUTEX_GUARD_RESTRICT p_mtx_grd           ,
+                                                void* C_MUTEX_GUARD_RESTRICT address                ,
+                                                const uint64_t timeout_ns                           );
+
+/// @brief Wakes up the longest waiting thread (if any).
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardCondSignal(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond);
+
+/// @brief Wakes up every waiting thread. Only the first one is woken up straight away, the rest are requeued onto the
+/// associated MTX_GRD and woken up one at a time as it gets released, so no thundering herd happens.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardCondBroadcast(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond);
+
+/// @brief Copies condition variable statistics.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @param p_stats Pointer to the structure statistics are meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardCondGetStats(   MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond ,
+                                                MTX_GRD_COND_STATS* C_MUTEX_GUARD_RESTRICT p_stats  );
+
+/// @brief Destroys condition variable.
+/// @param p_mtx_grd_cond Pointer to condition variable structure.
+/// @return 0 if succeeded, != 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardCondDestroy(MTX_GRD_COND* C_MUTEX_GUARD_RESTRICT p_mtx_grd_cond);
+
+/// @brief Cleanup function to destroy a condition variable (meant to be used alongside scoped condition init macros).
+/// @param ptr Pointer to condition variable structure.
+C_MUTEX_GUARD_API void MutexGuardCondDestroyCleanup(void* ptr);
+
+/// @brief Initializes reader-writer guard.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param preference Whether waiting writers hold new readers back or not.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardRwInit(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const MTX_GRD_RW_PREFERENCE preference);
+
+/// @brief MutexGuardRwInit function wrapper.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param preference Whether waiting writers hold new readers back or not.
+/// @return Pointer to given reader-writer guard structure if succeeded, NULL otherwise.
+C_MUTEX_GUARD_API MTX_GRD_RW* MutexGuardRwInitAddr(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const MTX_GRD_RW_PREFERENCE preference);
+
+/// @brief Locks reader-writer guard in given mode. Shared holds are recursive (and only cost the calling thread's bookkeeping then),
+/// whereas asking for any other hold of a guard already held by the calling thread fails with EDEADLK.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param mode Target lock mode.
+/// @param address Address in which the guard is being locked.
+/// @param timeout_ns Target timeout value (in nanoseconds, only used by timed locks).
+/// @param lock_type Lock type (try, permanent or timed).
+/// @return 0 if succeeded, < 0 if arguments are invalid, > 0 (standard error code) otherwise.
+/// @note A thread can hold up to __MTX_GRD_RW_READ_NUM__ guards in shared mode at once.
+C_MUTEX_GUARD_API int MutexGuardRwLock( MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw ,
+                                        const MTX_GRD_RW_MODES mode                     ,
+                                        void* C_MUTEX_GUARD_RESTRICT address            ,
+                                        const uint64_t timeout_ns                       ,
+                                        const MTX_GRD_LOCK_TYPES lock_type              );
+
+/// @brief MutexGuardRwLock function wrapper.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param mode Target lock mode.
+/// @param address Address in which the guard is being locked.
+/// @param timeout_ns Target timeout value (in nanoseconds, only used by timed locks).
+/// @param lock_type Lock type (try, permanent or timed).
+/// @return Pointer to given reader-writer guard structure if succeeded, NULL otherwise.
+C_MUTEX_GUARD_API MTX_GRD_RW* MutexGuardRwLockAddr( MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw ,
+                                                    const MTX_GRD_RW_MODES mode                     ,
+                                                    void* C_MUTEX_GUARD_RESTRICT address            ,
+                                                    const uint64_t timeout_ns                       ,
+                                                    const MTX_GRD_LOCK_TYPES lock_type              );
+
+/// @brief Turns the calling thread's upgradable hold of a reader-writer guard into an exclusive one, once other readers left.
+/// No writer can get in between, as upgradable holders exclude them.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param address Address in which the guard is being upgraded.
+/// @param timeout_ns Target timeout value (in nanoseconds, only used by timed upgrades).
+/// @param lock_type Lock type (try, permanent or timed).
+/// @return 0 if succeeded, < 0 if arguments are invalid, > 0 (standard error code) otherwise (the upgradable hold is kept then).
+C_MUTEX_GUARD_API int MutexGuardRwUpgrade(  MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw ,
+                                            void* C_MUTEX_GUARD_RESTRICT address            ,
+                                            const uint64_t timeout_ns                       ,
+                                            const MTX_GRD_LOCK_TYPES lock_type              );
+
+/// @brief Turns the calling thread's exclusive or upgradable hold of a reader-writer guard into a weaker one (exclusive into
+/// upgradable or shared, upgradable into shared) without releasing it meanwhile.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param mode Target lock mode.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardRwDowngrade(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const MTX_GRD_RW_MODES mode);
+
+/// @brief Releases the calling thread's hold of a reader-writer guard (one level of it, if held in shared mode recursively).
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @return 0 if succeeded, != 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardRwUnlock(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw);
+
+/// @brief Copies the holders of a reader-writer guard: its upgradable or exclusive holder first (if any), then its readers, as
+/// published by their threads.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param holders Array holders are meant to be copied to.
+/// @param holder_num Number of holders that fit in the array.
+/// @return Number of holders found (which may exceed holder_num, only the first ones being copied then) if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardRwGetHolders(   MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw     ,
+                                                MTX_GRD_RW_HOLDER* C_MUTEX_GUARD_RESTRICT holders   ,
+                                                const size_t holder_num                             );
+
+/// @brief Enables or disables reader bias, meant for guards read far more often than written. While biased, shared holders publish
+/// themselves in a table of visible readers, a slot per cache line hashed from the reader thread and guard, and do not touch the
+/// rwlock at all. Writers revoke the bias once they hold the rwlock, waiting for biased readers to leave, and it is only restored
+/// by a later reader after __MTX_GRD_RW_BIAS_INHIBIT_FACTOR__ times as long as the revocation took, so that guards written often
+/// fall back to plain reader-writer locking. Readers whose slot is taken fall back to the rwlock as well.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param enable Tells whether reader bias is meant to be enabled.
+/// @return 0 if succeeded, < 0 if arguments are invalid, > 0 (standard error code) otherwise.
+/// @note The guard is taken in exclusive mode meanwhile. Try and timed exclusive locks and upgrades give up (EBUSY or ETIMEDOUT) if
+/// biased readers do not leave in time, the bias being kept then.
+C_MUTEX_GUARD_API int MutexGuardRwSetReaderBias(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw, const bool enable);
+
+/// @brief Copies reader bias statistics of a reader-writer guard.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @param p_stats Pointer to the structure statistics are meant to be copied to.
+/// @return 0 if succeeded, < 0 otherwise.
+C_MUTEX_GUARD_API int MutexGuardRwGetBiasStats( MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw         ,
+                                                MTX_GRD_RW_BIAS_STATS* C_MUTEX_GUARD_RESTRICT p_stats   );
+
+/// @brief Destroys reader-writer guard.
+/// @param p_mtx_grd_rw Pointer to reader-writer guard structure.
+/// @return 0 if succeeded, != 0 otherwise (e.g. still held).
+C_MUTEX_GUARD_API int MutexGuardRwDestroy(MTX_GRD_RW* C_MUTEX_GUARD_RESTRICT p_mtx_grd_rw);
+
+/// @brief Cleanup function to destroy a reader-writer guard (meant to be used alongside scoped reader-writer init macros).
+/// @param ptr Pointer to reader-writer guard structure.
+C_MUTEX_GUARD_API void MutexGuardRwDestroyCleanup(void* ptr);
+
+/// @brief Cleanup function to release a reader-writer guard (meant to be used alongside scoped reader-writer lock macros).
+/// @param ptr Pointer to reader-writer guard structure.
+C_MUTEX_GUARD_API void MutexGuardRwReleaseCleanup(void* ptr);
+
 /*****************************************/
 
 #ifdef __cplusplus
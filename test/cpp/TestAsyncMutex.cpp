@@ -0,0 +1,419 @@
+/********** Include statements ***********/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "TestAsyncMutex.hpp"
+
+/*****************************************/
+
+#if defined(MTX_GRD_CPP_HAS_COROUTINES)
+
+/********** Define statements ***********/
+
+#define TEST_TIMEOUT_MS         10
+#define TEST_RACE_ROUND_NUM     500
+#define TEST_RACE_TIMEOUT_US    50
+#define TEST_WAIT_MS            5000
+
+/*****************************************/
+
+/******** Test type definitions **********/
+
+/// @brief Fire-and-forget coroutine, run right away until its first suspension.
+struct TestTask
+{
+    struct promise_type
+    {
+        TestTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+/// @brief Event loop thread, resuming coroutines posted to it (an executor).
+class TestLoop
+{
+public:
+    TestLoop() : thread_([this] { run(); }) {}
+
+    ~TestLoop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+
+        cond_.notify_one();
+        thread_.join();
+    }
+
+    void operator()(const std::coroutine_handle<> coroutine)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(coroutine);
+        }
+
+        cond_.notify_one();
+    }
+
+    std::thread::id id() const noexcept
+    {
+        return thread_.get_id();
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while(!stop_ || !queue_.empty())
+        {
+            if(queue_.empty())
+            {
+                cond_.wait(lock);
+                continue;
+            }
+
+            std::coroutine_handle<> coroutine = queue_.front();
+            queue_.pop_front();
+
+            lock.unlock();
+            coroutine.resume();
+            lock.lock();
+        }
+    }
+
+    std::mutex                          mutex_;
+    std::condition_variable             cond_;
+    std::deque<std::coroutine_handle<>> queue_;
+    bool                                stop_ = false;
+    std::thread                         thread_;
+};
+
+/// @brief Awaitable moving the awaiting coroutine over to a loop.
+struct TestSwitchTo
+{
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(const std::coroutine_handle<> coroutine) { loop(coroutine); }
+    void await_resume() const noexcept {}
+
+    TestLoop& loop;
+};
+
+/// @brief What a test coroutine saw.
+struct TestOutcome
+{
+    std::atomic<bool>   done{false};
+    std::atomic<int>    resume_num{0};
+    bool                locked          = false;
+    pthread_t           recorded_owner  = 0;
+    std::thread::id     thread;
+};
+
+/*****************************************/
+
+/********** Helper definitions ***********/
+
+/// @brief Waits for a test coroutine to be over (for up to TEST_WAIT_MS).
+static bool TestWaitDone(const TestOutcome& outcome)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_WAIT_MS);
+
+    while(!outcome.done.load(std::memory_order_acquire))
+    {
+        if(std::chrono::steady_clock::now() > deadline)
+            return false;
+
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    return true;
+}
+
+/// @brief Owner thread recorded by the underlying guard (the one which locked the mutex or handed it over).
+static pthread_t TestRecordedOwner(mtx_grd::async_mutex& test_mutex)
+{
+    return test_mutex.native_handle()->mutex_acq_location.thread_id;
+}
+
+static TestTask TestLockUnlock(mtx_grd::async_mutex& test_mutex, std::vector<int>& order, const int id, TestOutcome& outcome)
+{
+    bool locked = co_await test_mutex.lock_async();
+
+    outcome.locked          = locked;
+    outcome.recorded_owner  = TestRecordedOwner(test_mutex);
+    outcome.thread          = std::this_thread::get_id();
+    order.push_back(id);
+
+    test_mutex.unlock();
+    outcome.done.store(true, std::memory_order_release);
+}
+
+static TestTask TestTimedLock(mtx_grd::async_mutex& test_mutex, const std::chrono::microseconds timeout, TestOutcome& outcome)
+{
+    bool locked = co_await test_mutex.lock_async(timeout);
+
+    outcome.resume_num.fetch_add(1, std::memory_order_relaxed);
+    outcome.locked = locked;
+
+    if(locked)
+        test_mutex.unlock();
+
+    outcome.done.store(true, std::memory_order_release);
+}
+
+static TestTask TestLockOn(mtx_grd::async_mutex& test_mutex, TestLoop& loop, TestOutcome& outcome)
+{
+    bool locked = co_await test_mutex.lock_async_on(loop);
+
+    outcome.locked          = locked;
+    outcome.recorded_owner  = TestRecordedOwner(test_mutex);
+    outcome.thread          = std::this_thread::get_id();
+
+    test_mutex.unlock();
+    outcome.done.store(true, std::memory_order_release);
+}
+
+static TestTask TestLockThenMove(mtx_grd::async_mutex& test_mutex, TestLoop& loop, TestOutcome& outcome)
+{
+    bool locked = co_await test_mutex.lock_async();
+
+    outcome.locked = locked;
+
+    co_await TestSwitchTo{loop};
+
+    outcome.thread = std::this_thread::get_id();
+
+    test_mutex.unlock();
+    outcome.done.store(true, std::memory_order_release);
+}
+
+/*****************************************/
+
+/*********** Async Mutex Tests ***********/
+
+static void TestAsyncMutexRecords()
+{
+    mtx_grd::async_mutex test_mutex("test_async_mtx");
+
+    mtx_grd::source_location test_location = mtx_grd::source_location::current();
+
+    CU_ASSERT_TRUE(test_mutex.try_lock(test_location));
+    CU_ASSERT_FALSE(test_mutex.try_lock());
+    CU_ASSERT_TRUE(pthread_equal(TestRecordedOwner(test_mutex), pthread_self()));
+
+    int test_pipe[2];
+    CU_ASSERT_EQUAL(pipe(test_pipe), 0);
+
+    char dump_string[4096] = {0};
+
+    CU_ASSERT(MutexGuardDumpAll(test_pipe[1]) >= 1);
+    CU_ASSERT(read(test_pipe[0], dump_string, sizeof(dump_string) - 1) > 0);
+    CU_ASSERT_PTR_NOT_NULL(strstr(dump_string, "MTX_GRD <test_async_mtx>"));
+
+    close(test_pipe[0]);
+    close(test_pipe[1]);
+
+    test_mutex.unlock();
+
+    CU_ASSERT_EQUAL(test_mutex.native_handle()->mutex_acq_location.thread_id, (pthread_t)0);
+
+    MTX_GRD_STATS test_stats;
+
+    CU_ASSERT_EQUAL(MutexGuardGetStats(test_mutex.native_handle(), &test_stats), 0);
+    CU_ASSERT_EQUAL(test_stats.acquisition_counter, 1);
+    CU_ASSERT_PTR_EQUAL(test_stats.callsites[0].address,
+                        MutexGuardSourceCallsite(test_location.file_name(), test_location.line(), test_location.function_name()));
+}
+
+static void TestAsyncMutexHandover()
+{
+    mtx_grd::async_mutex test_mutex;
+    std::vector<int> test_order;
+    TestOutcome test_outcomes[3];
+
+    CU_ASSERT_TRUE(test_mutex.try_lock());
+
+    for(int coroutine_index = 0; coroutine_index < 3; coroutine_index++)
+        TestLockUnlock(test_mutex, test_order, coroutine_index, test_outcomes[coroutine_index]);
+
+    CU_ASSERT_EQUAL(test_mutex.holder().waiter_num, 3);
+
+    unsigned int test_line      = 0;
+    std::size_t test_waiter_num = 0;
+
+    test_mutex.for_each_waiter([&](const mtx_grd::source_location& location)
+    {
+        test_line = location.line();
+        ++test_waiter_num;
+    });
+
+    CU_ASSERT_EQUAL(test_waiter_num, 3);
+    CU_ASSERT(test_line > 0);
+
+    // Handed over in FIFO order, each waiter resuming on the thread unlocking (here, this one).
+    test_mutex.unlock();
+
+    CU_ASSERT_EQUAL(test_order.size(), 3);
+
+    for(int coroutine_index = 0; coroutine_index < 3; coroutine_index++)
+    {
+        CU_ASSERT_EQUAL(test_order[coroutine_index], coroutine_index);
+        CU_ASSERT_TRUE(test_outcomes[coroutine_index].done.load());
+        CU_ASSERT_TRUE(test_outcomes[coroutine_index].locked);
+        CU_ASSERT_TRUE(pthread_equal(test_outcomes[coroutine_index].recorded_owner, pthread_self()));
+        CU_ASSERT(test_outcomes[coroutine_index].thread == std::this_thread::get_id());
+    }
+
+    CU_ASSERT_FALSE(test_mutex.holder().locked);
+    CU_ASSERT_EQUAL(test_mutex.holder().waiter_num, 0);
+
+    MTX_GRD_STATS test_stats;
+
+    CU_ASSERT_EQUAL(MutexGuardGetStats(test_mutex.native_handle(), &test_stats), 0);
+    CU_ASSERT_EQUAL(test_stats.acquisition_counter, 4);
+
+    // Waits are the coroutines', accounted from their queuing to their handover.
+    CU_ASSERT_EQUAL(test_stats.contention_counter, 3);
+    CU_ASSERT(test_stats.wait_ns_total > 0);
+}
+
+static void TestAsyncMutexTimeout()
+{
+    mtx_grd::async_mutex test_mutex;
+
+    // Timed out while held: resumed (by the timer) with false.
+    {
+        TestOutcome test_outcome;
+
+        CU_ASSERT_TRUE(test_mutex.try_lock());
+
+        TestTimedLock(test_mutex, std::chrono::milliseconds(TEST_TIMEOUT_MS), test_outcome);
+
+        CU_ASSERT_TRUE(TestWaitDone(test_outcome));
+        CU_ASSERT_FALSE(test_outcome.locked);
+        CU_ASSERT_EQUAL(test_mutex.holder().waiter_num, 0);
+
+        test_mutex.unlock();
+    }
+
+    // Handed over before its deadline: resumed once, with true, and never touched by the timer again.
+    {
+        TestOutcome test_outcome;
+
+        CU_ASSERT_TRUE(test_mutex.try_lock());
+
+        TestTimedLock(test_mutex, std::chrono::seconds(10), test_outcome);
+        test_mutex.unlock();
+
+        CU_ASSERT_TRUE(test_outcome.done.load());
+        CU_ASSERT_TRUE(test_outcome.locked);
+        CU_ASSERT_EQUAL(test_outcome.resume_num.load(), 1);
+    }
+
+    CU_ASSERT_TRUE(test_mutex.try_lock());
+    test_mutex.unlock();
+}
+
+static void TestAsyncMutexTimeoutRace()
+{
+    mtx_grd::async_mutex test_mutex;
+    int test_failure_num = 0;
+
+    // Deadlines expiring right as the mutex is handed over: each waiter is resumed exactly once, either owning it or not.
+    for(int round_index = 0; round_index < TEST_RACE_ROUND_NUM; round_index++)
+    {
+        TestOutcome test_outcome;
+
+        if(!test_mutex.try_lock())
+        {
+            ++test_failure_num;
+            break;
+        }
+
+        TestTimedLock(test_mutex, std::chrono::microseconds(TEST_RACE_TIMEOUT_US), test_outcome);
+
+        std::this_thread::sleep_for(std::chrono::microseconds(round_index % (2 * TEST_RACE_TIMEOUT_US)));
+        test_mutex.unlock();
+
+        if(!TestWaitDone(test_outcome) || (test_outcome.resume_num.load() != 1))
+            ++test_failure_num;
+    }
+
+    CU_ASSERT_EQUAL(test_failure_num, 0);
+    CU_ASSERT_EQUAL(test_mutex.holder().waiter_num, 0);
+    CU_ASSERT_TRUE(test_mutex.try_lock());
+    test_mutex.unlock();
+}
+
+static void TestAsyncMutexExecutor()
+{
+    mtx_grd::async_mutex test_mutex;
+    TestLoop test_loop;
+
+    // Handed over by this thread (which the guard records as owner), resumed on the loop (which unlocks it).
+    {
+        TestOutcome test_outcome;
+
+        CU_ASSERT_TRUE(test_mutex.try_lock());
+
+        TestLockOn(test_mutex, test_loop, test_outcome);
+        test_mutex.unlock();
+
+        CU_ASSERT_TRUE(TestWaitDone(test_outcome));
+        CU_ASSERT_TRUE(test_outcome.locked);
+        CU_ASSERT_TRUE(pthread_equal(test_outcome.recorded_owner, pthread_self()));
+        CU_ASSERT(test_outcome.thread == test_loop.id());
+        CU_ASSERT_EQUAL(TestRecordedOwner(test_mutex), (pthread_t)0);
+    }
+
+    // Locked right away here, then unlocked from the loop.
+    {
+        TestOutcome test_outcome;
+
+        TestLockThenMove(test_mutex, test_loop, test_outcome);
+
+        CU_ASSERT_TRUE(TestWaitDone(test_outcome));
+        CU_ASSERT_TRUE(test_outcome.locked);
+        CU_ASSERT(test_outcome.thread == test_loop.id());
+        CU_ASSERT_EQUAL(test_mutex.native_handle()->mutex_acq_location.thread_id, (pthread_t)0);
+    }
+
+    CU_ASSERT_TRUE(test_mutex.try_lock());
+    test_mutex.unlock();
+}
+
+/*****************************************/
+
+#endif
+
+/************ Test Suite Setup ***********/
+
+int CreateAsyncMutexTestsSuite()
+{
+#if defined(MTX_GRD_CPP_HAS_COROUTINES)
+    CU_pSuite pAsyncMutexTestsSuite = NULL;
+
+    ADD_SUITE(pAsyncMutexTestsSuite, "Async mutex tests");
+
+    ADD_TEST_2_SUITE(pAsyncMutexTestsSuite, TestAsyncMutexRecords);
+    ADD_TEST_2_SUITE(pAsyncMutexTestsSuite, TestAsyncMutexHandover);
+    ADD_TEST_2_SUITE(pAsyncMutexTestsSuite, TestAsyncMutexTimeout);
+    ADD_TEST_2_SUITE(pAsyncMutexTestsSuite, TestAsyncMutexTimeoutRace);
+    ADD_TEST_2_SUITE(pAsyncMutexTestsSuite, TestAsyncMutexExecutor);
+#endif
+
+    return 0;
+}
+
+/*****************************************/
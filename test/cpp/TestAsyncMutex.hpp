@@ -0,0 +1,18 @@
+#ifndef TEST_ASYNC_MUTEX_HPP
+#define TEST_ASYNC_MUTEX_HPP
+
+/********** Include statements ***********/
+
+#include <CUnit/Basic.h>
+#include "MutexGuard.hpp"
+#include "TestCommonDefs.h"
+
+/*****************************************/
+
+/******** Test adding functions **********/
+
+int CreateAsyncMutexTestsSuite();
+
+/*****************************************/
+
+#endif
@@ -0,0 +1,377 @@
+/********** Include statements ***********/
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "TestGuards.hpp"
+
+/*****************************************/
+
+/******** Test type definitions **********/
+
+using pthread_guard         = mtx_grd::basic_guard<mtx_grd::pthread_engine>;
+using pthread_owner_guard   = mtx_grd::basic_guard<mtx_grd::pthread_engine, mtx_grd::owner_diagnostics, mtx_grd::counting_stats>;
+using spin_owner_guard      = mtx_grd::basic_guard<mtx_grd::spin_park_engine<>, mtx_grd::owner_diagnostics, mtx_grd::counting_stats>;
+using no_spin_guard         = mtx_grd::basic_guard<mtx_grd::spin_park_engine<0>>;
+using fast_guard            = mtx_grd::fast_guard;
+using debug_guard           = mtx_grd::debug_guard;
+
+/*****************************************/
+
+/********** Define statements ***********/
+
+#define TEST_THREAD_NUM         4
+#define TEST_INCREMENT_NUM      20000
+#define TEST_TIMEOUT_MS         20
+#define TEST_HOLD_MS            20
+
+/*****************************************/
+
+/********** Helper definitions ***********/
+
+/// @brief Runs a function in another thread and waits for it.
+template<class Function>
+static void TestRunInThread(Function function)
+{
+    std::thread test_thread(function);
+    test_thread.join();
+}
+
+/// @brief Locks a guard in another thread, holding it until released.
+template<class Guard>
+class TestHolder
+{
+public:
+    explicit TestHolder(Guard& guard) : thread_([this, &guard]
+    {
+        guard.lock();
+        locked_.store(true, std::memory_order_release);
+
+        while(!released_.load(std::memory_order_acquire))
+            std::this_thread::yield();
+
+        guard.unlock();
+    })
+    {
+        while(!locked_.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+    ~TestHolder()
+    {
+        release();
+    }
+
+    void release()
+    {
+        released_.store(true, std::memory_order_release);
+
+        if(thread_.joinable())
+            thread_.join();
+    }
+
+private:
+    std::atomic<bool>   locked_{false};
+    std::atomic<bool>   released_{false};
+    std::thread         thread_;
+};
+
+/*****************************************/
+
+/************* Guard Tests ***************/
+
+static void TestGuardSizes()
+{
+    CU_ASSERT_EQUAL(sizeof(fast_guard), sizeof(std::uint32_t));
+    CU_ASSERT_EQUAL(sizeof(pthread_guard), sizeof(pthread_mutex_t));
+}
+
+template<class Guard>
+static void TestGuardLock()
+{
+    Guard test_guard;
+
+    test_guard.lock();
+    test_guard.unlock();
+
+    {
+        mtx_grd::basic_scoped_lock<Guard> test_lock(test_guard);
+        CU_ASSERT_TRUE(test_lock.owns_lock());
+    }
+
+    {
+        std::lock_guard<Guard> test_lock(test_guard);
+    }
+
+    CU_ASSERT_TRUE(test_guard.try_lock());
+    test_guard.unlock();
+}
+
+template<class Guard>
+static void TestGuardTryLock()
+{
+    Guard test_guard;
+    bool test_locked = true;
+
+    {
+        TestHolder<Guard> test_holder(test_guard);
+
+        TestRunInThread([&]
+        {
+            test_locked = test_guard.try_lock();
+        });
+
+        CU_ASSERT_FALSE(test_locked);
+    }
+
+    TestRunInThread([&]
+    {
+        test_locked = test_guard.try_lock();
+
+        if(test_locked)
+            test_guard.unlock();
+    });
+
+    CU_ASSERT_TRUE(test_locked);
+}
+
+template<class Guard>
+static void TestGuardTimeout()
+{
+    Guard test_guard;
+    bool test_locked = true;
+    auto test_elapsed = std::chrono::steady_clock::duration::zero();
+
+    {
+        TestHolder<Guard> test_holder(test_guard);
+
+        TestRunInThread([&]
+        {
+            auto test_start = std::chrono::steady_clock::now();
+            test_locked     = test_guard.try_lock_for(std::chrono::milliseconds(TEST_TIMEOUT_MS));
+            test_elapsed    = std::chrono::steady_clock::now() - test_start;
+        });
+
+        CU_ASSERT_FALSE(test_locked);
+        CU_ASSERT(test_elapsed >= std::chrono::milliseconds(TEST_TIMEOUT_MS));
+
+        TestRunInThread([&]
+        {
+            test_locked = test_guard.try_lock_until(std::chrono::steady_clock::now() - std::chrono::milliseconds(1));
+        });
+
+        CU_ASSERT_FALSE(test_locked);
+    }
+
+    // Released while waiting: the waiter gets the guard before its timeout.
+    {
+        TestHolder<Guard> test_holder(test_guard);
+
+        std::thread test_thread([&]
+        {
+            test_locked = test_guard.try_lock_for(std::chrono::seconds(10));
+
+            if(test_locked)
+                test_guard.unlock();
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_HOLD_MS));
+        test_holder.release();
+        test_thread.join();
+
+        CU_ASSERT_TRUE(test_locked);
+    }
+}
+
+template<class Guard>
+static void TestGuardContention()
+{
+    Guard test_guard;
+    unsigned long test_counter = 0;
+    std::vector<std::thread> test_threads;
+
+    for(int thread_index = 0; thread_index < TEST_THREAD_NUM; thread_index++)
+        test_threads.emplace_back([&]
+        {
+            for(int increment_index = 0; increment_index < TEST_INCREMENT_NUM; increment_index++)
+            {
+                std::lock_guard<Guard> test_lock(test_guard);
+                ++test_counter;
+            }
+        });
+
+    for(auto& test_thread : test_threads)
+        test_thread.join();
+
+    CU_ASSERT_EQUAL(test_counter, (unsigned long)(TEST_THREAD_NUM * TEST_INCREMENT_NUM));
+}
+
+template<class Guard>
+static void TestGuardDeadlock()
+{
+    Guard test_guard;
+
+    CU_ASSERT_FALSE(test_guard.is_locked());
+
+    test_guard.lock();
+
+    CU_ASSERT_TRUE(test_guard.is_locked());
+    CU_ASSERT_TRUE(pthread_equal(test_guard.owner(), pthread_self()));
+
+    int test_error_code = 0;
+
+    try
+    {
+        test_guard.lock();
+    }
+    catch(const std::system_error& test_error)
+    {
+        test_error_code = test_error.code().value();
+    }
+
+    CU_ASSERT_EQUAL(test_error_code, EDEADLK);
+    CU_ASSERT_FALSE(test_guard.try_lock());
+    CU_ASSERT_FALSE(test_guard.try_lock_for(std::chrono::milliseconds(1)));
+
+    // Unlocking from another thread than the owner is ignored.
+    TestRunInThread([&]
+    {
+        test_guard.unlock();
+    });
+
+    CU_ASSERT_TRUE(test_guard.is_locked());
+
+    test_guard.unlock();
+
+    CU_ASSERT_FALSE(test_guard.is_locked());
+}
+
+template<class Guard>
+static void TestGuardStats()
+{
+    Guard test_guard;
+
+    for(int lock_index = 0; lock_index < 3; lock_index++)
+    {
+        test_guard.lock();
+        test_guard.unlock();
+    }
+
+    CU_ASSERT_TRUE(test_guard.try_lock());
+    test_guard.unlock();
+
+    mtx_grd::guard_stats test_stats = test_guard.stats();
+
+    CU_ASSERT_EQUAL(test_stats.lock_counter, 4);
+    CU_ASSERT_EQUAL(test_stats.contended_counter, 0);
+    CU_ASSERT_EQUAL(test_stats.wait_ns, 0);
+
+    {
+        TestHolder<Guard> test_holder(test_guard);
+
+        std::thread test_thread([&]
+        {
+            test_guard.lock();
+            test_guard.unlock();
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_HOLD_MS));
+        test_holder.release();
+        test_thread.join();
+    }
+
+    test_stats = test_guard.stats();
+
+    // The holder's acquisition is uncontended, the waiter's is not.
+    CU_ASSERT_EQUAL(test_stats.lock_counter, 6);
+    CU_ASSERT_EQUAL(test_stats.contended_counter, 1);
+    CU_ASSERT(test_stats.wait_ns > 0);
+    CU_ASSERT_EQUAL(test_stats.wait_ns_max, test_stats.wait_ns);
+
+    // Timed out waits are neither acquisitions nor contended ones.
+    {
+        TestHolder<Guard> test_holder(test_guard);
+
+        TestRunInThread([&]
+        {
+            CU_ASSERT_FALSE(test_guard.try_lock_for(std::chrono::milliseconds(1)));
+        });
+    }
+
+    CU_ASSERT_EQUAL(test_guard.stats().lock_counter, 7);
+    CU_ASSERT_EQUAL(test_guard.stats().contended_counter, 1);
+}
+
+static void TestGuardHolder()
+{
+    debug_guard test_guard;
+
+    mtx_grd::guard_holder test_holder = test_guard.holder();
+
+    CU_ASSERT_FALSE(test_holder.locked);
+    CU_ASSERT_EQUAL(test_holder.held_ns, 0);
+
+    unsigned int test_line = __LINE__ + 1;
+    test_guard.lock();
+
+    test_holder = test_guard.holder();
+
+    CU_ASSERT_TRUE(test_holder.locked);
+    CU_ASSERT_TRUE(pthread_equal(test_holder.thread, pthread_self()));
+    CU_ASSERT_PTR_NOT_NULL(strstr(test_holder.file, "TestGuards.cpp"));
+    CU_ASSERT_EQUAL(test_holder.line, test_line);
+
+    // Seen from another thread, the owner's records are complete once the guard is seen as locked.
+    TestRunInThread([&]
+    {
+        mtx_grd::guard_holder test_other_holder = test_guard.holder();
+
+        CU_ASSERT_TRUE(test_other_holder.locked);
+        CU_ASSERT_EQUAL(test_other_holder.line, test_line);
+    });
+
+    test_guard.unlock();
+
+    CU_ASSERT_FALSE(test_guard.holder().locked);
+}
+
+/*****************************************/
+
+/************ Test Suite Setup ***********/
+
+int CreateGuardTestsSuite()
+{
+    CU_pSuite pGuardTestsSuite = NULL;
+
+    ADD_SUITE(pGuardTestsSuite, "Guard tests");
+
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardSizes);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardLock<pthread_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardLock<fast_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardLock<pthread_owner_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardLock<debug_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardTryLock<pthread_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardTryLock<fast_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardTryLock<debug_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardTimeout<pthread_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardTimeout<fast_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardTimeout<no_spin_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardContention<pthread_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardContention<fast_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardContention<no_spin_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardContention<debug_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardDeadlock<pthread_owner_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardDeadlock<spin_owner_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardDeadlock<debug_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardStats<pthread_owner_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardStats<spin_owner_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardStats<debug_guard>);
+    ADD_TEST_2_SUITE(pGuardTestsSuite, TestGuardHolder);
+
+    return 0;
+}
+
+/*****************************************/
@@ -0,0 +1,18 @@
+#ifndef TEST_GUARDS_HPP
+#define TEST_GUARDS_HPP
+
+/********** Include statements ***********/
+
+#include <CUnit/Basic.h>
+#include "MutexGuard.hpp"
+#include "TestCommonDefs.h"
+
+/*****************************************/
+
+/******** Test adding functions **********/
+
+int CreateGuardTestsSuite();
+
+/*****************************************/
+
+#endif
@@ -0,0 +1,404 @@
+/********** Include statements ***********/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "TestMutex.hpp"
+
+/*****************************************/
+
+/********** Define statements ***********/
+
+#define TEST_THREAD_NUM         4
+#define TEST_INCREMENT_NUM      10000
+#define TEST_TIMEOUT_MS         20
+
+/*****************************************/
+
+/********** Helper definitions ***********/
+
+/// @brief Runs a function in another thread and waits for it.
+template<class Function>
+static void TestRunInThread(Function function)
+{
+    std::thread test_thread(function);
+    test_thread.join();
+}
+
+/// @brief Locks a mutex in another thread, holding it until released.
+class TestMutexHolder
+{
+public:
+    explicit TestMutexHolder(mtx_grd::mutex& test_mutex) : thread_([this, &test_mutex]
+    {
+        test_mutex.lock();
+        locked_.store(true, std::memory_order_release);
+
+        while(!released_.load(std::memory_order_acquire))
+            std::this_thread::yield();
+
+        test_mutex.unlock();
+    })
+    {
+        while(!locked_.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+    ~TestMutexHolder()
+    {
+        release();
+    }
+
+    void release()
+    {
+        released_.store(true, std::memory_order_release);
+
+        if(thread_.joinable())
+            thread_.join();
+    }
+
+private:
+    std::atomic<bool>   locked_{false};
+    std::atomic<bool>   released_{false};
+    std::thread         thread_;
+};
+
+/// @brief Tells whether a mutex is locked, as seen from another thread.
+static bool TestIsLocked(MTX_GRD* p_test_mtx_grd)
+{
+    bool test_locked = false;
+
+    TestRunInThread([&]
+    {
+        test_locked = (MutexGuardLock(p_test_mtx_grd, MutexGuardGetFuncRetAddr(), 0, MTX_GRD_LOCK_TYPE_TRY) != 0);
+
+        if(!test_locked)
+            MutexGuardUnlock(p_test_mtx_grd);
+    });
+
+    return test_locked;
+}
+
+/// @brief Tells whether a guard's current owner locked it from a given line of the calling function.
+static bool TestIsLockedFrom(mtx_grd::mutex& test_mutex, const unsigned int line, const mtx_grd::source_location& location = mtx_grd::source_location::current())
+{
+    return (test_mutex.native_handle()->mutex_acq_location.addresses[0] == MutexGuardSourceCallsite(location.file_name(), line, location.function_name()));
+}
+
+/*****************************************/
+
+/************* Mutex Tests ***************/
+
+static void TestMutexLockable()
+{
+    mtx_grd::mutex test_mutex;
+
+    test_mutex.lock();
+    CU_ASSERT_TRUE(TestIsLocked(test_mutex.native_handle()));
+    test_mutex.unlock();
+
+    CU_ASSERT_TRUE(test_mutex.try_lock());
+    test_mutex.unlock();
+
+    {
+        std::lock_guard<mtx_grd::mutex> test_lock(test_mutex);
+        CU_ASSERT_TRUE(TestIsLocked(test_mutex.native_handle()));
+    }
+
+    CU_ASSERT_FALSE(TestIsLocked(test_mutex.native_handle()));
+
+    {
+        std::unique_lock<mtx_grd::mutex> test_lock(test_mutex, std::defer_lock);
+        CU_ASSERT_FALSE(test_lock.owns_lock());
+
+        CU_ASSERT_TRUE(test_lock.try_lock());
+        test_lock.unlock();
+
+        test_lock.lock();
+        CU_ASSERT_TRUE(test_lock.owns_lock());
+    }
+
+    CU_ASSERT_TRUE(test_mutex.try_lock());
+    test_mutex.unlock();
+}
+
+static void TestMutexScopedLockStd()
+{
+    mtx_grd::mutex test_mutex_1;
+    mtx_grd::mutex test_mutex_2;
+
+    {
+        std::scoped_lock test_lock(test_mutex_1, test_mutex_2);
+
+        CU_ASSERT_TRUE(TestIsLocked(test_mutex_1.native_handle()));
+        CU_ASSERT_TRUE(TestIsLocked(test_mutex_2.native_handle()));
+    }
+
+    CU_ASSERT_FALSE(TestIsLocked(test_mutex_1.native_handle()));
+    CU_ASSERT_FALSE(TestIsLocked(test_mutex_2.native_handle()));
+
+    // Opposite locking orders in contending threads: std::lock's avoidance algorithm (through try_lock) must not deadlock.
+    unsigned long test_counter = 0;
+    std::vector<std::thread> test_threads;
+
+    for(int thread_index = 0; thread_index < TEST_THREAD_NUM; thread_index++)
+        test_threads.emplace_back([&, thread_index]
+        {
+            for(int increment_index = 0; increment_index < TEST_INCREMENT_NUM; increment_index++)
+            {
+                if(thread_index % 2)
+                {
+                    std::scoped_lock test_lock(test_mutex_1, test_mutex_2);
+                    ++test_counter;
+                }
+                else
+                {
+                    std::lock(test_mutex_2, test_mutex_1);
+                    std::lock_guard<mtx_grd::mutex> test_lock_2(test_mutex_2, std::adopt_lock);
+                    std::lock_guard<mtx_grd::mutex> test_lock_1(test_mutex_1, std::adopt_lock);
+                    ++test_counter;
+                }
+            }
+        });
+
+    for(auto& test_thread : test_threads)
+        test_thread.join();
+
+    CU_ASSERT_EQUAL(test_counter, (unsigned long)(TEST_THREAD_NUM * TEST_INCREMENT_NUM));
+}
+
+static void TestMutexTimedLockable()
+{
+    mtx_grd::mutex test_mutex;
+    bool test_locked = true;
+    auto test_elapsed = std::chrono::steady_clock::duration::zero();
+
+    {
+        TestMutexHolder test_holder(test_mutex);
+
+        TestRunInThread([&]
+        {
+            CU_ASSERT_FALSE(test_mutex.try_lock());
+
+            auto test_start = std::chrono::steady_clock::now();
+            test_locked     = test_mutex.try_lock_for(std::chrono::milliseconds(TEST_TIMEOUT_MS));
+            test_elapsed    = std::chrono::steady_clock::now() - test_start;
+        });
+
+        CU_ASSERT_FALSE(test_locked);
+        CU_ASSERT(test_elapsed >= std::chrono::milliseconds(TEST_TIMEOUT_MS));
+
+        TestRunInThread([&]
+        {
+            test_locked = test_mutex.try_lock_until(std::chrono::steady_clock::now() - std::chrono::milliseconds(1));
+        });
+
+        CU_ASSERT_FALSE(test_locked);
+
+        TestRunInThread([&]
+        {
+            std::unique_lock<mtx_grd::mutex> test_lock(test_mutex, std::chrono::milliseconds(1));
+            test_locked = test_lock.owns_lock();
+        });
+
+        CU_ASSERT_FALSE(test_locked);
+    }
+
+    {
+        std::unique_lock<mtx_grd::mutex> test_lock(test_mutex, std::chrono::milliseconds(TEST_TIMEOUT_MS));
+        CU_ASSERT_TRUE(test_lock.owns_lock());
+    }
+
+    {
+        std::unique_lock<mtx_grd::mutex> test_lock(test_mutex, std::chrono::system_clock::now() + std::chrono::milliseconds(TEST_TIMEOUT_MS));
+        CU_ASSERT_TRUE(test_lock.owns_lock());
+    }
+}
+
+static void TestMutexConditionVariable()
+{
+    mtx_grd::mutex test_mutex;
+    std::condition_variable_any test_cond;
+    bool test_ready = false;
+    bool test_done  = false;
+
+    std::thread test_thread([&]
+    {
+        std::unique_lock<mtx_grd::mutex> test_lock(test_mutex);
+
+        test_cond.wait(test_lock, [&] { return test_ready; });
+        test_done = true;
+        test_cond.notify_one();
+    });
+
+    {
+        std::unique_lock<mtx_grd::mutex> test_lock(test_mutex);
+
+        test_ready = true;
+        test_cond.notify_one();
+
+        CU_ASSERT_TRUE(test_cond.wait_for(test_lock, std::chrono::seconds(10), [&] { return test_done; }));
+        CU_ASSERT_TRUE(TestIsLocked(test_mutex.native_handle()));
+    }
+
+    test_thread.join();
+}
+
+static void TestMutexScopedLock()
+{
+    mtx_grd::mutex test_mutex;
+
+    {
+        unsigned int test_line = __LINE__ + 1;
+        mtx_grd::scoped_lock test_lock(test_mutex);
+
+        CU_ASSERT_TRUE(test_lock.owns_lock());
+        CU_ASSERT_TRUE(TestIsLocked(test_mutex.native_handle()));
+
+        // The caller's source location is recorded, not the wrapper's.
+        CU_ASSERT_TRUE(TestIsLockedFrom(test_mutex, test_line));
+
+        test_lock.unlock();
+
+        CU_ASSERT_FALSE(test_lock.owns_lock());
+        CU_ASSERT_FALSE(TestIsLocked(test_mutex.native_handle()));
+    }
+
+    {
+        TestMutexHolder test_holder(test_mutex);
+
+        TestRunInThread([&]
+        {
+            mtx_grd::scoped_lock test_try_lock(test_mutex, std::try_to_lock);
+            CU_ASSERT_FALSE(test_try_lock);
+
+            mtx_grd::scoped_lock test_timed_lock(test_mutex, std::chrono::milliseconds(1));
+            CU_ASSERT_FALSE(test_timed_lock);
+        });
+    }
+
+    {
+        mtx_grd::scoped_lock test_lock(test_mutex, std::try_to_lock);
+        CU_ASSERT_TRUE(test_lock);
+
+        // Moving hands ownership over, only the new owner unlocks.
+        mtx_grd::scoped_lock test_moved_lock(std::move(test_lock));
+
+        CU_ASSERT_FALSE(test_lock.owns_lock());
+        CU_ASSERT_TRUE(test_moved_lock.owns_lock());
+
+        mtx_grd::mutex* p_test_mutex = test_moved_lock.release();
+
+        CU_ASSERT_PTR_EQUAL(p_test_mutex, &test_mutex);
+        CU_ASSERT_FALSE(test_moved_lock.owns_lock());
+        CU_ASSERT_TRUE(TestIsLocked(test_mutex.native_handle()));
+
+        mtx_grd::scoped_lock test_adopted_lock(test_mutex, std::adopt_lock);
+        CU_ASSERT_TRUE(test_adopted_lock.owns_lock());
+    }
+
+    CU_ASSERT_FALSE(TestIsLocked(test_mutex.native_handle()));
+
+    // Acquisitions are accounted to the lock's source location.
+    MTX_GRD_STATS test_stats;
+    unsigned int test_line = __LINE__ + 1;
+    { mtx_grd::scoped_lock test_lock(test_mutex, std::chrono::milliseconds(TEST_TIMEOUT_MS)); }
+
+    CU_ASSERT_EQUAL(MutexGuardGetStats(test_mutex.native_handle(), &test_stats), 0);
+
+    bool test_callsite_found = false;
+    void* p_test_callsite = MutexGuardSourceCallsite(__FILE__, test_line, mtx_grd::source_location::current().function_name());
+
+    for(size_t callsite_index = 0; callsite_index < __MTX_GRD_CALLSITE_STATS_NUM__; callsite_index++)
+        if(test_stats.callsites[callsite_index].address == p_test_callsite)
+            test_callsite_found = (test_stats.callsites[callsite_index].acquisition_counter == 1);
+
+    CU_ASSERT_TRUE(test_callsite_found);
+}
+
+static void TestMutexErrors()
+{
+    mtx_grd::mutex test_mutex(PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_NONE, "test_mutex");
+
+    CU_ASSERT_STRING_EQUAL(test_mutex.native_handle()->name, "test_mutex");
+
+    test_mutex.lock();
+
+    int test_error_code = 0;
+
+    try
+    {
+        test_mutex.lock();
+    }
+    catch(const std::system_error& test_error)
+    {
+        test_error_code = test_error.code().value();
+    }
+
+    CU_ASSERT_EQUAL(test_error_code, EDEADLK);
+    CU_ASSERT_FALSE(test_mutex.try_lock_for(std::chrono::milliseconds(1)));
+
+    test_mutex.unlock();
+
+    test_error_code = 0;
+
+    try
+    {
+        mtx_grd::mutex test_invalid_mutex(-1);
+    }
+    catch(const std::system_error& test_error)
+    {
+        test_error_code = test_error.code().value();
+    }
+
+    CU_ASSERT_EQUAL(test_error_code, EINVAL);
+}
+
+static void TestMutexContention()
+{
+    mtx_grd::mutex test_mutex;
+    unsigned long test_counter = 0;
+    std::vector<std::thread> test_threads;
+
+    for(int thread_index = 0; thread_index < TEST_THREAD_NUM; thread_index++)
+        test_threads.emplace_back([&]
+        {
+            for(int increment_index = 0; increment_index < TEST_INCREMENT_NUM; increment_index++)
+            {
+                mtx_grd::scoped_lock test_lock(test_mutex);
+                ++test_counter;
+            }
+        });
+
+    for(auto& test_thread : test_threads)
+        test_thread.join();
+
+    CU_ASSERT_EQUAL(test_counter, (unsigned long)(TEST_THREAD_NUM * TEST_INCREMENT_NUM));
+}
+
+/*****************************************/
+
+/************ Test Suite Setup ***********/
+
+int CreateMutexTestsSuite()
+{
+    CU_pSuite pMutexTestsSuite = NULL;
+
+    ADD_SUITE(pMutexTestsSuite, "Mutex tests");
+
+    ADD_TEST_2_SUITE(pMutexTestsSuite, TestMutexLockable);
+    ADD_TEST_2_SUITE(pMutexTestsSuite, TestMutexScopedLockStd);
+    ADD_TEST_2_SUITE(pMutexTestsSuite, TestMutexTimedLockable);
+    ADD_TEST_2_SUITE(pMutexTestsSuite, TestMutexConditionVariable);
+    ADD_TEST_2_SUITE(pMutexTestsSuite, TestMutexScopedLock);
+    ADD_TEST_2_SUITE(pMutexTestsSuite, TestMutexErrors);
+    ADD_TEST_2_SUITE(pMutexTestsSuite, TestMutexContention);
+
+    return 0;
+}
+
+/*****************************************/
@@ -0,0 +1,18 @@
+#ifndef TEST_MUTEX_HPP
+#define TEST_MUTEX_HPP
+
+/********** Include statements ***********/
+
+#include <CUnit/Basic.h>
+#include "MutexGuard.hpp"
+#include "TestCommonDefs.h"
+
+/*****************************************/
+
+/******** Test adding functions **********/
+
+int CreateMutexTestsSuite();
+
+/*****************************************/
+
+#endif
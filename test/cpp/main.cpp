@@ -0,0 +1,35 @@
+/********** Include statements ***********/
+
+#include <CUnit/Basic.h>
+#include "TestMutex.hpp"
+#include "TestGuards.hpp"
+#include "TestAsyncMutex.hpp"
+
+/*****************************************/
+
+
+/*********** Define statements ***********/
+
+#define TEST_UNIT_TESTS_HEADER  "\r\n**************\r\nC++ UNIT TESTS\r\n**************\r\n"
+
+/*****************************************/
+
+/********** Function definitions *********/
+
+int main()
+{
+    if(CU_initialize_registry() != CUE_SUCCESS)
+        return CU_get_error();
+
+    CreateMutexTestsSuite();
+    CreateGuardTestsSuite();
+    CreateAsyncMutexTestsSuite();
+
+    printf(TEST_UNIT_TESTS_HEADER);
+    CU_basic_run_tests();
+    CU_cleanup_registry();
+
+    return 0;
+}
+
+/*****************************************/
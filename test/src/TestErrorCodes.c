@@ -1,6 +1,7 @@
 /********** Include statements ***********/
 
 #include <pthread.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include "TestCommonDefs.h"
 #include "TestErrorCodes.h"
@@ -282,6 +283,8 @@ static void TestAttrDestroy()
     MTX_GRD_INIT(&test_mtx_grd);
 
     CU_ASSERT_EQUAL(MutexGuardAttrDestroy(&test_mtx_grd), 0);
+
+    MTX_GRD_DESTROY(&test_mtx_grd);
 }
 
 static void TestDestroy()
@@ -340,6 +343,401 @@ static void TestSetInternalErrMode()
     CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "Provided invalid internal mutex management mode");
 }
 
+static void TestRegistryFull()
+{
+    MTX_GRD* p_test_mtx_grds = calloc(__MTX_GRD_REGISTRY_SHARED_NUM__ + 1, sizeof(MTX_GRD));
+    size_t test_init_num = 0;
+
+    while(test_init_num <= __MTX_GRD_REGISTRY_SHARED_NUM__)
+    {
+        MTX_GRD_ATTR_INIT(&p_test_mtx_grds[test_init_num], PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_SHARED);
+
+        if(MTX_GRD_INIT(&p_test_mtx_grds[test_init_num]))
+            break;
+
+        test_init_num++;
+    }
+
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1044);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "MTX_GRD registry is full");
+
+    for(size_t test_index = 0; test_index <= test_init_num; test_index++)
+    {
+        if(test_index < test_init_num)
+            MTX_GRD_DESTROY(&p_test_mtx_grds[test_index]);
+
+        MTX_GRD_ATTR_DESTROY(&p_test_mtx_grds[test_index]);
+    }
+
+    free(p_test_mtx_grds);
+}
+
+static void TestShmOpen()
+{
+    MutexGuardShmUnlink("/test_mtx_grd_shm_missing");
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1026);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "Could not map shared memory MTX_GRD");
+
+    MTX_GRD* p_test_mtx_grd = MutexGuardShmOpen("/test_mtx_grd_shm_cond", 0, PTHREAD_MUTEX_ERRORCHECK);
+    CU_ASSERT_PTR_NOT_NULL(p_test_mtx_grd);
+
+    if(!p_test_mtx_grd)
+        return;
+
+    MTX_GRD_COND_CREATE(test_mtx_grd_cond);
+    MTX_GRD_COND_INIT_SC(&test_mtx_grd_cond, dummy_cond);
+
+    MTX_GRD_LOCK(p_test_mtx_grd);
+    MTX_GRD_COND_TIMED_WAIT(&test_mtx_grd_cond, p_test_mtx_grd, 1000000);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1025);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "Not supported by process-shared MTX_GRD");
+    MTX_GRD_UNLOCK(p_test_mtx_grd);
+
+    MutexGuardSetHoldBudget(p_test_mtx_grd, 1000000);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1025);
+
+    MutexGuardShmClose(p_test_mtx_grd, 0);
+    MutexGuardShmUnlink("/test_mtx_grd_shm_cond");
+}
+
+static void* TestRobustLockHelper(void* arg)
+{
+    MTX_GRD_LOCK((MTX_GRD*)arg);
+
+    return NULL;
+}
+
+static void TestRobustLock()
+{
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_ATTR_INIT_SC(&test_mtx_grd, PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_PRIVATE, dummy_attr);
+    MTX_GRD_ATTR_SET_ROBUST(&test_mtx_grd, PTHREAD_MUTEX_ROBUST);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+
+    pthread_t thread_0;
+    pthread_create(&thread_0, NULL, TestRobustLockHelper, &test_mtx_grd);
+    pthread_join(thread_0, NULL);
+
+    MTX_GRD_LOCK(&test_mtx_grd);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1027);
+    CU_ASSERT_PTR_NOT_NULL(strstr(MTX_GRD_GET_LAST_ERR_STR, "Previous owner died while holding MTX_GRD. "));
+
+    MTX_GRD_MAKE_CONSISTENT(&test_mtx_grd);
+    MTX_GRD_MAKE_CONSISTENT(&test_mtx_grd);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1028);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "MTX_GRD does not need to be made consistent");
+
+    MTX_GRD_UNLOCK(&test_mtx_grd);
+}
+
+static void TestDumpAll()
+{
+    MTX_GRD_CREATE(test_mtx_grd);
+    MutexGuardSetName(&test_mtx_grd, NULL);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1004);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "Target string to write is null");
+
+    MutexGuardDumpAll(-1);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1010);
+    CU_ASSERT_PTR_NOT_NULL(strstr(MTX_GRD_GET_LAST_ERR_STR, "Standard error code. "));
+}
+
+static void TestGetStatsDelta()
+{
+    MTX_GRD_STATS test_snapshot = {0};
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MutexGuardGetStatsDelta(&test_mtx_grd, &test_snapshot, NULL);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1004);
+}
+
+static void TestSampling()
+{
+    MutexGuardSetSampling(0, 0);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1030);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "Invalid MTX_GRD sampling period");
+}
+
+static void TestSlowCapture()
+{
+    MutexGuardSetSlowCapture(0, 100.0);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1031);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "Invalid MTX_GRD slow capture threshold");
+}
+
+static void TestIncrement(void* arg)
+{
+    ++*(int*)arg;
+}
+
+static void TestExecute()
+{
+    int test_value = 0;
+
+    MutexGuardExecute(NULL, TestIncrement, &test_value);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1001);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+
+    MutexGuardExecute(&test_mtx_grd, NULL, &test_value);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1032);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "MTX_GRD operation to execute is null");
+    CU_ASSERT_EQUAL(test_value, 0);
+}
+
+static void TestLockMany()
+{
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD* test_guards[2] = { &test_mtx_grd, &test_mtx_grd };
+
+    MutexGuardLockMany(NULL, 1, 0);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1001);
+
+    MutexGuardLockMany(test_guards, 0, 0);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1033);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "Invalid number of MTX_GRD to lock");
+
+    MutexGuardLockMany(test_guards, 2, 0);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1034);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "MTX_GRD listed more than once");
+}
+
+static void TestDelegation()
+{
+    MTX_GRD_DELEGATION_STATS test_stats;
+
+    MTX_GRD_ATTR_SET_DELEGATION(NULL, MTX_GRD_DELEGATION_ANY_CPU);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1001);
+
+    MTX_GRD_CREATE(test_mtx_grd_0);
+
+    MTX_GRD_ATTR_SET_DELEGATION(&test_mtx_grd_0, -3);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1006);
+
+    MTX_GRD_INIT_SC(&test_mtx_grd_0, dummy_0);
+
+    MutexGuardGetDelegationStats(&test_mtx_grd_0, &test_stats);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1035);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "Could not set up MTX_GRD delegation");
+
+    MTX_GRD_CREATE(test_mtx_grd_1);
+    MTX_GRD_ATTR_INIT_SC(&test_mtx_grd_1, PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_SHARED, dummy_mtx_grd_attr_1);
+    MTX_GRD_ATTR_SET_DELEGATION(&test_mtx_grd_1, MTX_GRD_DELEGATION_ANY_CPU);
+
+    CU_ASSERT_EQUAL(MTX_GRD_INIT(&test_mtx_grd_1), -4);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1035);
+    CU_ASSERT_PTR_NULL(test_mtx_grd_1.delegation);
+}
+
+static pthread_barrier_t test_batch_barrier;
+static int test_batch_value;
+
+static void* TestPendingBatchHelper(void* arg)
+{
+    MTX_GRD_BATCH((MTX_GRD*)arg, TestIncrement, &test_batch_value);
+    pthread_barrier_wait(&test_batch_barrier);
+    pthread_barrier_wait(&test_batch_barrier);
+    MTX_GRD_BATCH_FLUSH((MTX_GRD*)arg);
+
+    return NULL;
+}
+
+static void TestBatch()
+{
+    MTX_GRD_BATCH(NULL, TestIncrement, NULL);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1001);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+
+    MTX_GRD_BATCH(&test_mtx_grd, NULL, NULL);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1032);
+
+    MTX_GRD_ATTR_SET_BATCHING(&test_mtx_grd, __MTX_GRD_BATCH_OP_NUM__ + 1, 0);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1006);
+
+    MutexGuardGetBatchStats(&test_mtx_grd, NULL);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1004);
+
+    MTX_GRD_INIT(&test_mtx_grd);
+
+    pthread_t thread_0;
+    pthread_barrier_init(&test_batch_barrier, NULL, 2);
+    pthread_create(&thread_0, NULL, TestPendingBatchHelper, &test_mtx_grd);
+    pthread_barrier_wait(&test_batch_barrier);
+
+    MTX_GRD_DESTROY(&test_mtx_grd);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1043);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "MTX_GRD has operations batched by other threads");
+
+    pthread_barrier_wait(&test_batch_barrier);
+    pthread_join(thread_0, NULL);
+    pthread_barrier_destroy(&test_batch_barrier);
+
+    MTX_GRD_DESTROY(&test_mtx_grd);
+}
+
+static void TestDeferAfterUnlock()
+{
+    MTX_GRD_DEFER_AFTER_UNLOCK(NULL, TestIncrement, NULL);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1001);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+
+    MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd, TestIncrement, NULL);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1011);
+
+    int test_value = 0;
+    MTX_GRD_LOCK_SC(&test_mtx_grd, dummy_lock);
+
+    for(int defer_index = 0; defer_index < __MTX_GRD_DEFER_NUM__; defer_index++)
+        MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd, TestIncrement, &test_value);
+
+    MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd, TestIncrement, &test_value);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1036);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "MTX_GRD deferred work queue is full");
+}
+
+static void TestLockAsync()
+{
+    int fd;
+
+    MTX_GRD_LOCK_ASYNC(NULL, &fd);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1001);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+
+    MTX_GRD_LOCK_ASYNC(&test_mtx_grd, NULL);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1004);
+
+    MTX_GRD_LOCK_ASYNC_COMPLETE(&test_mtx_grd, 0);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1038);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "Unknown MTX_GRD asynchronous lock request");
+
+    MTX_GRD_CREATE(test_err_mtx_grd);
+    MTX_GRD_ATTR_INIT_SC(&test_err_mtx_grd, PTHREAD_MUTEX_RECURSIVE_NP, PTHREAD_PRIO_INHERIT, PTHREAD_PROCESS_PRIVATE, dummy_mtx_grd_attr);
+    MTX_GRD_INIT_SC(&test_err_mtx_grd, dummy_err_mtx);
+
+    MTX_GRD_LOCK_ASYNC(&test_err_mtx_grd, &fd);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1037);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "MTX_GRD does not support asynchronous locking");
+}
+
+static void TestSourceCallsite()
+{
+    MutexGuardSourceCallsite(NULL, 42, NULL);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1004);
+}
+
+static void TestExternalOwner()
+{
+    MutexGuardExternalAcquired(NULL, NULL, 0);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1001);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+
+    MutexGuardExternalReleased(&test_mtx_grd);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1011);
+
+    MutexGuardExternalAcquired(&test_mtx_grd, NULL, 0);
+    MutexGuardExternalAcquired(&test_mtx_grd, NULL, 0);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1009);
+    CU_ASSERT_EQUAL(MutexGuardExternalReleased(&test_mtx_grd), 0);
+}
+
+static void TestExportPrometheus()
+{
+    MutexGuardExporterStartFile("/tmp/test_mtx_grd.prom", 0);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1029);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "Could not start or stop MTX_GRD exporter");
+
+    MutexGuardExporterStop();
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1029);
+
+    MutexGuardExporterStartShm("/test_mtx_grd_stats", 0);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1029);
+}
+
+static void TestRwLock()
+{
+    MTX_GRD_RW_LOCK(NULL, MTX_GRD_RW_MODE_SHARED);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1039);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "MTX_GRD_RW null pointer");
+
+    MTX_GRD_RW test_mtx_grd_rws[__MTX_GRD_RW_READ_NUM__ + 1];
+
+    for(int rw_index = 0; rw_index <= __MTX_GRD_RW_READ_NUM__; rw_index++)
+        MTX_GRD_RW_INIT(&test_mtx_grd_rws[rw_index], MTX_GRD_RW_PREFER_READERS);
+
+    MTX_GRD_RW_LOCK(&test_mtx_grd_rws[0], MTX_GRD_RW_MODE_MAX + 1);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1040);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "Invalid MTX_GRD_RW lock mode");
+
+    MTX_GRD_RW_UNLOCK(&test_mtx_grd_rws[0]);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1011);
+
+    for(int rw_index = 0; rw_index < __MTX_GRD_RW_READ_NUM__; rw_index++)
+        MTX_GRD_RW_LOCK(&test_mtx_grd_rws[rw_index], MTX_GRD_RW_MODE_SHARED);
+
+    MTX_GRD_RW_LOCK(&test_mtx_grd_rws[__MTX_GRD_RW_READ_NUM__], MTX_GRD_RW_MODE_SHARED);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1041);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "Too many MTX_GRD_RW held in shared mode");
+
+    MTX_GRD_RW_DESTROY(&test_mtx_grd_rws[0]);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1042);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "MTX_GRD_RW is still held");
+
+    MTX_GRD_RW_SET_READER_BIAS(&test_mtx_grd_rws[0], true);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1009);
+
+    MutexGuardRwGetBiasStats(&test_mtx_grd_rws[0], NULL);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1004);
+
+    MutexGuardRwGetBiasStats(NULL, NULL);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1039);
+
+    for(int rw_index = 0; rw_index < __MTX_GRD_RW_READ_NUM__; rw_index++)
+        MTX_GRD_RW_UNLOCK(&test_mtx_grd_rws[rw_index]);
+
+    for(int rw_index = 0; rw_index <= __MTX_GRD_RW_READ_NUM__; rw_index++)
+        MTX_GRD_RW_DESTROY(&test_mtx_grd_rws[rw_index]);
+}
+
+static void TestCondWait()
+{
+    MutexGuardCondWait(NULL, NULL, NULL);
+    CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1021);
+    CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "MTX_GRD_COND null pointer");
+
+    MTX_GRD_COND_CREATE(test_mtx_grd_cond);
+    MTX_GRD_COND_INIT_SC(&test_mtx_grd_cond, dummy_cond);
+
+    {
+        MTX_GRD_CREATE(test_mtx_grd_0);
+        MTX_GRD_ATTR_INIT_SC(&test_mtx_grd_0, PTHREAD_MUTEX_RECURSIVE_NP, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_PRIVATE, dummy_mtx_grd_attr_0);
+        MTX_GRD_INIT_SC(&test_mtx_grd_0, dummy_0);
+        MTX_GRD_LOCK_SC(&test_mtx_grd_0, dummy_lock_0_0);
+        MTX_GRD_LOCK_SC(&test_mtx_grd_0, dummy_lock_0_1);
+
+        MTX_GRD_COND_WAIT(&test_mtx_grd_cond, &test_mtx_grd_0);
+        CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1022);
+        CU_ASSERT_STRING_EQUAL(MTX_GRD_GET_LAST_ERR_STR, "MTX_GRD must be locked exactly once to wait");
+    }
+
+    {
+        MTX_GRD_CREATE(test_mtx_grd_1);
+        MTX_GRD_INIT_SC(&test_mtx_grd_1, dummy_1);
+        MTX_GRD_LOCK_SC(&test_mtx_grd_1, dummy_lock_1);
+
+        MTX_GRD_COND_TIMED_WAIT(&test_mtx_grd_cond, &test_mtx_grd_1, 1000000);
+        CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1010);
+        CU_ASSERT_PTR_NOT_NULL(strstr(MTX_GRD_GET_LAST_ERR_STR, "Standard error code. "));
+    }
+}
+
 int CreateErrorCodeTestsSuite()
 {
     CU_pSuite pErrorCodeTestsSuite;
@@ -357,6 +755,24 @@ int CreateErrorCodeTestsSuite()
     ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestAttrDestroy);
     ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestDestroy);
     ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestSetInternalErrMode);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestRobustLock);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestDumpAll);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestGetStatsDelta);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestSampling);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestSlowCapture);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestExecute);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestLockMany);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestDelegation);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestBatch);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestDeferAfterUnlock);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestLockAsync);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestSourceCallsite);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestExternalOwner);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestExportPrometheus);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestCondWait);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestRwLock);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestRegistryFull);
+    ADD_TEST_2_SUITE(pErrorCodeTestsSuite, TestShmOpen);
 
     return 0;
 }
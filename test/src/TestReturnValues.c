@@ -1,5 +1,17 @@
 /********** Include statements ***********/
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include "TestCommonDefs.h"
 #include "TestReturnValues.h"
 
@@ -64,6 +76,38 @@ static void TestInit()
     MTX_GRD_CREATE(test_mtx_grd);
 
     CU_ASSERT_EQUAL(MutexGuardInit(&test_mtx_grd), 0);
+
+    MTX_GRD_DESTROY(&test_mtx_grd);
+
+    // Process-shared guards can only be initialized while the registry has a free slot left for them.
+    MTX_GRD* p_test_mtx_grds = calloc(__MTX_GRD_REGISTRY_SHARED_NUM__ + 1, sizeof(MTX_GRD));
+    size_t test_init_num = 0;
+    int test_init_ret = 0;
+
+    while(test_init_num <= __MTX_GRD_REGISTRY_SHARED_NUM__)
+    {
+        MTX_GRD_ATTR_INIT(&p_test_mtx_grds[test_init_num], PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_SHARED);
+
+        if((test_init_ret = MutexGuardInit(&p_test_mtx_grds[test_init_num])))
+            break;
+
+        test_init_num++;
+    }
+
+    CU_ASSERT_EQUAL(test_init_ret, -5);
+    CU_ASSERT(test_init_num > 0);
+
+    // Destroying one of them frees its slot.
+    MTX_GRD_DESTROY(&p_test_mtx_grds[0]);
+    CU_ASSERT_EQUAL(MutexGuardInit(&p_test_mtx_grds[test_init_num]), 0);
+
+    for(size_t test_index = 1; test_index <= test_init_num; test_index++)
+        MTX_GRD_DESTROY(&p_test_mtx_grds[test_index]);
+
+    for(size_t test_index = 0; test_index <= test_init_num; test_index++)
+        MTX_GRD_ATTR_DESTROY(&p_test_mtx_grds[test_index]);
+
+    free(p_test_mtx_grds);
 }
 
 static void TestInitAddr()
@@ -73,6 +117,8 @@ static void TestInitAddr()
     MTX_GRD_CREATE(test_mtx_grd);
 
     CU_ASSERT_PTR_NOT_NULL(MutexGuardInitAddr(&test_mtx_grd));
+
+    MTX_GRD_DESTROY(&test_mtx_grd);
 }
 
 static void TestLock()
@@ -140,60 +186,1673 @@ static void TestUnlock()
     CU_ASSERT_EQUAL(MutexGuardUnlock(&test_mtx_grd), 0);
 }
 
-static void TestAttrDestroy()
+static void* TestRobustLockHelper(void* arg)
 {
-    CU_ASSERT_EQUAL(MutexGuardAttrDestroy(NULL), -1);
+    MTX_GRD_LOCK((MTX_GRD*)arg);
+
+    return NULL;
+}
+
+static void TestRobustLock()
+{
+    CU_ASSERT_EQUAL(MutexGuardAttrSetRobust(NULL, PTHREAD_MUTEX_ROBUST), -1);
+    CU_ASSERT_EQUAL(MutexGuardMakeConsistent(NULL), -1);
 
     MTX_GRD_CREATE(test_mtx_grd);
-    MTX_GRD_ATTR_INIT(&test_mtx_grd, 0, 0, 0);
-    MTX_GRD_INIT(&test_mtx_grd);
+    MTX_GRD_ATTR_INIT_SC(&test_mtx_grd, PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_PRIVATE, dummy_attr);
+    CU_ASSERT_EQUAL(MTX_GRD_ATTR_SET_ROBUST(&test_mtx_grd, PTHREAD_MUTEX_ROBUST), 0);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
 
-    CU_ASSERT_EQUAL(MutexGuardAttrDestroy(&test_mtx_grd), 0);
+    CU_ASSERT_EQUAL(MutexGuardMakeConsistent(&test_mtx_grd), -2);
+
+    pthread_t thread_0;
+    pthread_create(&thread_0, NULL, TestRobustLockHelper, &test_mtx_grd);
+    pthread_join(thread_0, NULL);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd), EOWNERDEAD);
+    CU_ASSERT_TRUE(MutexGuardIsInconsistent(&test_mtx_grd));
+    CU_ASSERT_EQUAL(MutexGuardMakeConsistent(&test_mtx_grd), 0);
+    CU_ASSERT_FALSE(MutexGuardIsInconsistent(&test_mtx_grd));
+    CU_ASSERT_EQUAL(MutexGuardMakeConsistent(&test_mtx_grd), -4);
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_mtx_grd), 0);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd), 0);
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_mtx_grd), 0);
 }
 
-static void TestDestroy()
+static void TestPrioStats()
 {
-    CU_ASSERT_EQUAL(MutexGuardDestroy(NULL), -1);
+    MTX_GRD_PRIO_STATS test_prio_stats;
 
-    {
-        TEST_UNLOCK_HELPER_STRUCT test_unlock_helper_struct = { .fnMutexGuard = &MutexGuardDestroy };
-        MTX_GRD_INIT_SC(&test_unlock_helper_struct.mtx_grd, dummy_unlock_helper);
-        MTX_GRD_LOCK_SC(&test_unlock_helper_struct.mtx_grd, test_lock_dummy);
-        pthread_t thread_0;
-        pthread_create(&thread_0, NULL, TestEvalHelper, &test_unlock_helper_struct);
+    CU_ASSERT_EQUAL(MutexGuardAttrSetPrioCeiling(NULL, 1), -1);
+    CU_ASSERT_EQUAL(MutexGuardGetPrioStats(NULL, &test_prio_stats), -1);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_ATTR_INIT_SC(&test_mtx_grd, PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_INHERIT, PTHREAD_PROCESS_PRIVATE, dummy_attr);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+
+    CU_ASSERT_EQUAL(MutexGuardGetPrioStats(&test_mtx_grd, NULL), -2);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd), 0);
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_mtx_grd), 0);
+
+    CU_ASSERT_EQUAL(MutexGuardGetPrioStats(&test_mtx_grd, &test_prio_stats), 0);
+    CU_ASSERT_EQUAL(test_prio_stats.boost_counter, 0);
+}
+
+static void* TestPrioCeilingHelper(void* arg)
+{
+    MTX_GRD* p_mtx_grd = (MTX_GRD*)arg;
 
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(p_mtx_grd), EINVAL);
+    CU_ASSERT_EQUAL(MTX_GRD_TRY_LOCK(p_mtx_grd), EINVAL);
+    CU_ASSERT_EQUAL(MTX_GRD_TIMED_LOCK(p_mtx_grd, 1000000), EINVAL);
+    CU_ASSERT_EQUAL(p_mtx_grd->lock_counter, 0);
+
+    return NULL;
+}
+
+static void TestPrioCeiling()
+{
+    int min_fifo_prio = sched_get_priority_min(SCHED_FIFO);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_ATTR_INIT_SC(&test_mtx_grd, PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_PROTECT, PTHREAD_PROCESS_PRIVATE, dummy_attr);
+    CU_ASSERT_EQUAL(MutexGuardAttrSetPrioCeiling(&test_mtx_grd, min_fifo_prio), 0);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+
+    // Lockers above the ceiling get the error back instead of retrying bookkeeping forever (skipped if RT scheduling is not allowed).
+    pthread_attr_t thread_attr;
+    struct sched_param thread_sched_param = { .sched_priority = min_fifo_prio + 1 };
+    pthread_t thread_0;
+
+    pthread_attr_init(&thread_attr);
+    pthread_attr_setinheritsched(&thread_attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&thread_attr, SCHED_FIFO);
+    pthread_attr_setschedparam(&thread_attr, &thread_sched_param);
+
+    MTX_GRD_INT_ERR_MGMT err_mgmt_mode = MutexGuardGetInternalErrMode();
+    MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_KEEP_TRYING);
+
+    if(!pthread_create(&thread_0, &thread_attr, TestPrioCeilingHelper, &test_mtx_grd))
         pthread_join(thread_0, NULL);
 
-        CU_ASSERT_EQUAL(test_unlock_helper_struct.test_value, -3);
+    MutexGuardSetInternalErrMode(err_mgmt_mode);
+    pthread_attr_destroy(&thread_attr);
+}
+
+static void TestDumpAll()
+{
+    CU_ASSERT_EQUAL(MutexGuardSetName(NULL, "test_dump_mtx_grd"), -1);
+    CU_ASSERT_EQUAL(MutexGuardDumpAll(-1), -1);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+
+    CU_ASSERT_EQUAL(MutexGuardSetName(&test_mtx_grd, NULL), -2);
+    CU_ASSERT_EQUAL(MutexGuardSetName(&test_mtx_grd, "test_dump_mtx_grd"), 0);
+
+    int test_pipe[2];
+    CU_ASSERT_EQUAL(pipe(test_pipe), 0);
+
+    char dump_string[4096] = {0};
+
+    {
+        MTX_GRD_LOCK_SC(&test_mtx_grd, dummy_lock);
+
+        CU_ASSERT(MutexGuardDumpAll(test_pipe[1]) >= 1);
+        CU_ASSERT(read(test_pipe[0], dump_string, sizeof(dump_string) - 1) > 0);
+        CU_ASSERT_PTR_NOT_NULL(strstr(dump_string, "MTX_GRD <test_dump_mtx_grd>"));
+
+        char expected_string[128] = {0};
+        snprintf(expected_string, sizeof(expected_string), "at <%p> held by thread with ID: <0x%lx> (PID: <%d>",
+                 (void*)&test_mtx_grd, (unsigned long)pthread_self(), getpid());
+        CU_ASSERT_PTR_NOT_NULL(strstr(dump_string, expected_string));
     }
 
+    memset(dump_string, 0, sizeof(dump_string));
+
+    CU_ASSERT_EQUAL(MutexGuardSetDumpSignal(SIGUSR1, test_pipe[1]), 0);
+    raise(SIGUSR1);
+    signal(SIGUSR1, SIG_DFL);
+
+    CU_ASSERT(read(test_pipe[0], dump_string, sizeof(dump_string) - 1) > 0);
+    CU_ASSERT_PTR_NOT_NULL(strstr(dump_string, "MTX_GRD dump"));
+    CU_ASSERT_PTR_NULL(strstr(dump_string, "MTX_GRD <test_dump_mtx_grd>"));
+
+    close(test_pipe[0]);
+    close(test_pipe[1]);
+}
+
+static void TestHoldBudget()
+{
+    unsigned long long test_violations = 0;
+
+    CU_ASSERT_EQUAL(MutexGuardSetHoldBudget(NULL, 1000000), -1);
+    CU_ASSERT_EQUAL(MutexGuardGetHoldViolations(NULL, &test_violations), -1);
+
     MTX_GRD_CREATE(test_mtx_grd);
-    MTX_GRD_INIT(&test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
 
-    CU_ASSERT_EQUAL(MutexGuardDestroy(&test_mtx_grd), 0);
+    CU_ASSERT_EQUAL(MutexGuardGetHoldViolations(&test_mtx_grd, NULL), -2);
+    CU_ASSERT_EQUAL(MutexGuardSetHoldBudget(&test_mtx_grd, 20000000), 0);
+
+    // Violations are reported on stderr, through MutexGuardPrintError.
+    int test_pipe[2];
+    char test_report[1024] = {0};
+    MTX_GRD_VERBOSITY_LEVEL test_verbosity = MutexGuardGetPrintStatus();
+    int test_stderr = dup(STDERR_FILENO);
+
+    CU_ASSERT_EQUAL(pipe(test_pipe), 0);
+    fflush(stderr);
+    dup2(test_pipe[1], STDERR_FILENO);
+    MutexGuardSetPrintStatus(MTX_GRD_VERBOSITY_LOCK_ERROR);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd), 0);
+    usleep(100000);
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_mtx_grd), 0);
+
+    struct pollfd test_poll_fd = { .fd = test_pipe[0], .events = POLLIN };
+    CU_ASSERT_EQUAL(poll(&test_poll_fd, 1, 1000), 1);
+
+    MutexGuardSetPrintStatus(test_verbosity);
+    fflush(stderr);
+    dup2(test_stderr, STDERR_FILENO);
+    close(test_stderr);
+    close(test_pipe[1]);
+
+    CU_ASSERT(read(test_pipe[0], test_report, sizeof(test_report) - 1) > 0);
+    CU_ASSERT_PTR_NOT_NULL(strstr(test_report, "MTX_GRD hold budget exceeded"));
+    close(test_pipe[0]);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd), 0);
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_mtx_grd), 0);
+
+    CU_ASSERT_EQUAL(MutexGuardGetHoldViolations(&test_mtx_grd, &test_violations), 0);
+    CU_ASSERT_EQUAL(test_violations, 1);
 }
 
-static void TestSetInternalErrMode()
+static void TestGetStats()
 {
-    CU_ASSERT_EQUAL(MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_MIN - 1), -1);
-    CU_ASSERT_EQUAL(MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_MAX + 1), -1);
+    MTX_GRD_STATS test_stats;
 
-    CU_ASSERT_EQUAL(MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_KEEP_TRYING),     0);
-    CU_ASSERT_EQUAL(MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_ABORT_ON_ERROR),  0);
-    CU_ASSERT_EQUAL(MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_FORCE_ONE_SHOT),  0);
+    CU_ASSERT_EQUAL(MutexGuardGetStats(NULL, &test_stats), -1);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+
+    CU_ASSERT_EQUAL(MutexGuardGetStats(&test_mtx_grd, NULL), -2);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd), 0);
+    CU_ASSERT_NOT_EQUAL(MTX_GRD_TRY_LOCK(&test_mtx_grd), 0);
+
+    // The failure is described from what was found when it happened, naming the guard's own mutex.
+    char test_mutex_address[32];
+    snprintf(test_mutex_address, sizeof(test_mutex_address), "<%p>", (void*)&test_mtx_grd.mutex);
+    CU_ASSERT_PTR_NOT_NULL(strstr(MutexGuardGetErrorString(MutexGuardGetErrorCode()), test_mutex_address));
+
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_mtx_grd), 0);
+
+    // Per-CPU shards live out of line, so that guards need no more than their members' alignment (e.g. when allocated with malloc).
+    CU_ASSERT_PTR_NOT_NULL(test_mtx_grd.stats_shards);
+    CU_ASSERT(_Alignof(MTX_GRD) <= sizeof(size_t));
+
+    CU_ASSERT_EQUAL(MutexGuardGetStats(&test_mtx_grd, &test_stats), 0);
+    CU_ASSERT_EQUAL(test_stats.acquisition_counter, 1);
+    CU_ASSERT_EQUAL(test_stats.contention_counter, 0);
+    CU_ASSERT_EQUAL(test_stats.failure_counter, 1);
+    CU_ASSERT_EQUAL(test_stats.hold_counter, 1);
+    CU_ASSERT_PTR_NOT_NULL(test_stats.callsites[0].address);
 }
 
-static void TestGetInternalErrMode()
+static void* TestStatsDeltaHelper(void* arg)
 {
-    CU_ASSERT_EQUAL(MutexGuardGetInternalErrMode(), MTX_GRD_INT_ERR_MGMT_FORCE_ONE_SHOT);
+    for(int lock_index = 0; lock_index < 1000; lock_index++)
+    {
+        MTX_GRD_LOCK((MTX_GRD*)arg);
+        MutexGuardUnlock((MTX_GRD*)arg);
+    }
 
-    for(int int_err_mgmt_mode = MTX_GRD_INT_ERR_MGMT_MIN; int_err_mgmt_mode <= MTX_GRD_INT_ERR_MGMT_MAX; int_err_mgmt_mode++)
+    return NULL;
+}
+
+static void TestGetStatsDelta()
+{
+    MTX_GRD_STATS test_snapshot = {0};
+    MTX_GRD_STATS test_delta;
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+
+    CU_ASSERT_EQUAL(MutexGuardGetStatsDelta(&test_mtx_grd, NULL, &test_delta), -2);
+    CU_ASSERT_EQUAL(MutexGuardGetStatsDelta(NULL, &test_snapshot, &test_delta), -1);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd), 0);
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_mtx_grd), 0);
+
+    CU_ASSERT_EQUAL(MutexGuardGetStatsDelta(&test_mtx_grd, &test_snapshot, &test_delta), 0);
+    CU_ASSERT_EQUAL(test_delta.acquisition_counter, 1);
+    CU_ASSERT_EQUAL(test_snapshot.acquisition_counter, 1);
+
+    // Lockers spread over several CPUs must all be accounted once shards are merged.
+    pthread_t threads[4];
+
+    for(int thread_index = 0; thread_index < 4; thread_index++)
+        pthread_create(&threads[thread_index], NULL, TestStatsDeltaHelper, &test_mtx_grd);
+
+    for(int thread_index = 0; thread_index < 4; thread_index++)
+        pthread_join(threads[thread_index], NULL);
+
+    CU_ASSERT_EQUAL(MutexGuardGetStatsDelta(&test_mtx_grd, &test_snapshot, &test_delta), 0);
+    CU_ASSERT_EQUAL(test_delta.acquisition_counter, 4000);
+    CU_ASSERT_EQUAL(test_delta.hold_counter, 4000);
+    CU_ASSERT_EQUAL(test_delta.callsites[0].acquisition_counter, 0);
+    CU_ASSERT_EQUAL(test_delta.callsites[1].acquisition_counter, 4000);
+    CU_ASSERT_EQUAL(test_snapshot.acquisition_counter, 4001);
+
+    CU_ASSERT_EQUAL(MutexGuardGetStatsDelta(&test_mtx_grd, &test_snapshot, &test_delta), 0);
+    CU_ASSERT_EQUAL(test_delta.acquisition_counter, 0);
+}
+
+static void TestSampling()
+{
+    CU_ASSERT_EQUAL(MutexGuardSetSampling(0, 0), -1);
+    CU_ASSERT_EQUAL(MutexGuardSetGuardSampling(NULL, 4), -1);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+    CU_ASSERT_EQUAL(MutexGuardSetGuardSampling(&test_mtx_grd, 4), 0);
+
+    for(int lock_index = 0; lock_index < 40000; lock_index++)
     {
-        MutexGuardSetInternalErrMode(int_err_mgmt_mode);
-        CU_ASSERT_EQUAL(MutexGuardGetInternalErrMode(), int_err_mgmt_mode);
+        MTX_GRD_LOCK(&test_mtx_grd);
+        MutexGuardUnlock(&test_mtx_grd);
     }
 
-    MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_FORCE_ONE_SHOT);
+    // Only about a quarter of the calls are recorded, but they stand for all of them.
+    MTX_GRD_STATS test_stats;
+    CU_ASSERT_EQUAL(MutexGuardGetStats(&test_mtx_grd, &test_stats), 0);
+    CU_ASSERT(test_stats.sample_counter > 8000);
+    CU_ASSERT(test_stats.sample_counter < 12000);
+    CU_ASSERT(test_stats.acquisition_counter > 36000);
+    CU_ASSERT(test_stats.acquisition_counter < 44000);
+    CU_ASSERT_EQUAL(test_stats.acquisition_counter, test_stats.sample_counter * 4);
+
+    CU_ASSERT_EQUAL(MutexGuardSetGuardSampling(&test_mtx_grd, 0), 0);
+    CU_ASSERT_EQUAL(MutexGuardSetSampling(1, 0), 0);
+}
+
+static void* TestExportHelper(void* arg)
+{
+    int* test_pipe = (int*)arg;
+
+    MutexGuardExportPrometheus(test_pipe[1]);
+    close(test_pipe[1]);
+
+    return NULL;
+}
+
+static void TestExportPrometheus()
+{
+    CU_ASSERT_EQUAL(MutexGuardExportPrometheus(-1), -1);
+    CU_ASSERT_EQUAL(MutexGuardExporterStartFile(NULL, 1000000), -1);
+    CU_ASSERT_EQUAL(MutexGuardExporterStartFile("/tmp/test_mtx_grd.prom", 0), -2);
+    CU_ASSERT_EQUAL(MutexGuardExporterStartSocket(NULL), -1);
+    CU_ASSERT_EQUAL(MutexGuardExporterStop(), -1);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+    CU_ASSERT_EQUAL(MutexGuardSetName(&test_mtx_grd, "test_export_mtx_grd"), 0);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd), 0);
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_mtx_grd), 0);
+
+    int test_pipe[2];
+    CU_ASSERT_EQUAL(pipe(test_pipe), 0);
+
+    char export_string[65536] = {0};
+
+    CU_ASSERT_EQUAL(MutexGuardExportPrometheus(test_pipe[1]), 0);
+    close(test_pipe[1]);
+
+    size_t export_len = 0;
+    ssize_t read_len;
+
+    while((read_len = read(test_pipe[0], export_string + export_len, sizeof(export_string) - export_len - 1)) > 0)
+        export_len += read_len;
+
+    close(test_pipe[0]);
+
+    CU_ASSERT_PTR_NOT_NULL(strstr(export_string, "mtx_grd_acquisitions_total{guard=\"test_export_mtx_grd\"} 1\n"));
+    CU_ASSERT_PTR_NOT_NULL(strstr(export_string, "mtx_grd_hold_seconds_count{guard=\"test_export_mtx_grd\"} 1\n"));
+    CU_ASSERT_PTR_NOT_NULL(strstr(export_string, "mtx_grd_wait_seconds_bucket{guard=\"test_export_mtx_grd\",le=\"+Inf\"} 1\n"));
+
+    unlink("/tmp/test_mtx_grd.prom");
+
+    CU_ASSERT_EQUAL(MutexGuardExporterStartFile("/tmp/test_mtx_grd.prom", 1000000), 0);
+    CU_ASSERT_EQUAL(MutexGuardExporterStartFile("/tmp/test_mtx_grd.prom", 1000000), -2);
+    usleep(50000);
+    CU_ASSERT_EQUAL(MutexGuardExporterStop(), 0);
+
+    CU_ASSERT_EQUAL(access("/tmp/test_mtx_grd.prom", R_OK), 0);
+    unlink("/tmp/test_mtx_grd.prom");
+
+    // Guards are destroyed while an export is stuck writing to a full descriptor.
+    CU_ASSERT_EQUAL(pipe(test_pipe), 0);
+    fcntl(test_pipe[1], F_SETFL, O_NONBLOCK);
+
+    while(write(test_pipe[1], export_string, sizeof(export_string)) > 0);
+
+    fcntl(test_pipe[1], F_SETFL, 0);
+
+    pthread_t thread_0;
+    pthread_create(&thread_0, NULL, TestExportHelper, test_pipe);
+    usleep(20000);
+
+    MTX_GRD_CREATE(test_destroyed_mtx_grd);
+    CU_ASSERT_EQUAL(MTX_GRD_INIT(&test_destroyed_mtx_grd), 0);
+    CU_ASSERT_EQUAL(MutexGuardDestroy(&test_destroyed_mtx_grd), 0);
+
+    while(read(test_pipe[0], export_string, sizeof(export_string)) > 0);
+
+    pthread_join(thread_0, NULL);
+    close(test_pipe[0]);
+}
+
+static void TestExportShm()
+{
+    CU_ASSERT_EQUAL(MutexGuardExporterStartShm(NULL, 1000000), -1);
+    CU_ASSERT_EQUAL(MutexGuardExporterStartShm("/test_mtx_grd_stats", 0), -2);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+    CU_ASSERT_EQUAL(MutexGuardSetName(&test_mtx_grd, "test_shm_mtx_grd"), 0);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd), 0);
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_mtx_grd), 0);
+
+    CU_ASSERT_EQUAL(MutexGuardExporterStartShm("/test_mtx_grd_stats", 1000000), 0);
+    CU_ASSERT_EQUAL(MutexGuardExporterStartShm("/test_mtx_grd_stats", 1000000), -2);
+    usleep(50000);
+
+    int shm_fd = shm_open("/test_mtx_grd_stats", O_RDONLY, 0);
+    CU_ASSERT(shm_fd >= 0);
+
+    const MTX_GRD_STATS_SHM* p_segment = mmap(NULL, MTX_GRD_STATS_SHM_SIZE(__MTX_GRD_STATS_SHM_MAX_GUARDS__), PROT_READ, MAP_SHARED, shm_fd, 0);
+    close(shm_fd);
+    CU_ASSERT_NOT_EQUAL(p_segment, MAP_FAILED);
+
+    if(p_segment != MAP_FAILED)
+    {
+        CU_ASSERT_EQUAL(p_segment->magic, MTX_GRD_STATS_SHM_MAGIC);
+        CU_ASSERT_EQUAL(p_segment->version, MTX_GRD_STATS_SHM_VERSION);
+        CU_ASSERT_EQUAL(p_segment->sequence % 2, 0);
+        CU_ASSERT(p_segment->entry_num >= 1);
+
+        bool guard_found = false;
+
+        for(uint32_t entry_index = 0; entry_index < p_segment->entry_num; entry_index++)
+        {
+            const MTX_GRD_STATS_SHM_ENTRY* p_entry = &MTX_GRD_STATS_SHM_ENTRIES(p_segment)[entry_index];
+
+            if(!strcmp(p_entry->name, "test_shm_mtx_grd"))
+            {
+                guard_found = true;
+                CU_ASSERT_EQUAL(p_entry->acquisition_counter, 1);
+                CU_ASSERT_EQUAL(p_entry->owner_tid, 0);
+            }
+        }
+
+        CU_ASSERT(guard_found);
+        munmap((void*)p_segment, MTX_GRD_STATS_SHM_SIZE(__MTX_GRD_STATS_SHM_MAX_GUARDS__));
+    }
+
+    CU_ASSERT_EQUAL(MutexGuardExporterStop(), 0);
+    CU_ASSERT_EQUAL(shm_open("/test_mtx_grd_stats", O_RDONLY, 0), -1);
+}
+
+static int TestContentionProfileHelper(MTX_GRD* p_mtx_grd)
+{
+    int ret_lock = MTX_GRD_LOCK(p_mtx_grd);
+    MutexGuardUnlock(p_mtx_grd);
+
+    return ret_lock;
+}
+
+static void TestContentionProfile()
+{
+    CU_ASSERT_EQUAL(MutexGuardSetContentionProfiling(true), 0);
+    CU_ASSERT_EQUAL(MutexGuardWriteContentionProfile(-1), -1);
+
+    TEST_UNLOCK_HELPER_STRUCT test_profile_helper_struct = { .fnMutexGuard = &TestContentionProfileHelper };
+    MTX_GRD_INIT_SC(&test_profile_helper_struct.mtx_grd, dummy_mtx);
+
+    {
+        MTX_GRD_LOCK_SC(&test_profile_helper_struct.mtx_grd, dummy_lock);
+
+        pthread_t thread_0;
+        pthread_create(&thread_0, NULL, TestEvalHelper, &test_profile_helper_struct);
+        usleep(20000);
+
+        MutexGuardUnlock(&test_profile_helper_struct.mtx_grd);
+        pthread_join(thread_0, NULL);
+    }
+
+    CU_ASSERT_EQUAL(test_profile_helper_struct.test_value, 0);
+
+    int test_pipe[2];
+    CU_ASSERT_EQUAL(pipe(test_pipe), 0);
+
+    char profile_data[65536] = {0};
+
+    CU_ASSERT_EQUAL(MutexGuardWriteContentionProfile(test_pipe[1]), 1);
+    close(test_pipe[1]);
+
+    ssize_t profile_len = read(test_pipe[0], profile_data, sizeof(profile_data));
+    close(test_pipe[0]);
+
+    CU_ASSERT(profile_len > 0);
+    CU_ASSERT_PTR_NOT_NULL(memmem(profile_data, profile_len, "contentions", strlen("contentions")));
+    CU_ASSERT_PTR_NOT_NULL(memmem(profile_data, profile_len, "nanoseconds", strlen("nanoseconds")));
+
+    CU_ASSERT_EQUAL(MutexGuardSetContentionProfiling(false), 0);
+}
+
+static void TestSlowCapture()
+{
+    MTX_GRD_SLOW_CAPTURE test_captures[__MTX_GRD_SLOW_CAPTURE_NUM__];
+
+    CU_ASSERT_EQUAL(MutexGuardSetSlowCapture(0, 100.0), -1);
+    CU_ASSERT_EQUAL(MutexGuardSetSlowCapture(0, -1.0), -1);
+    CU_ASSERT_EQUAL(MutexGuardGetSlowCaptures(NULL, 1), -1);
+    CU_ASSERT_EQUAL(MutexGuardSetSlowCapture(1000000, 0), 0);
+
+    TEST_UNLOCK_HELPER_STRUCT test_capture_helper_struct = { .fnMutexGuard = &TestContentionProfileHelper };
+    MTX_GRD_INIT_SC(&test_capture_helper_struct.mtx_grd, dummy_mtx);
+
+    int previous_num = MutexGuardGetSlowCaptures(test_captures, __MTX_GRD_SLOW_CAPTURE_NUM__);
+
+    {
+        MTX_GRD_LOCK_SC(&test_capture_helper_struct.mtx_grd, dummy_lock);
+
+        pthread_t thread_0;
+        pthread_create(&thread_0, NULL, TestEvalHelper, &test_capture_helper_struct);
+        usleep(20000);
+
+        MutexGuardUnlock(&test_capture_helper_struct.mtx_grd);
+        pthread_join(thread_0, NULL);
+    }
+
+    // Uncontended acquisitions are never captured.
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_capture_helper_struct.mtx_grd), 0);
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_capture_helper_struct.mtx_grd), 0);
+
+    int capture_num = MutexGuardGetSlowCaptures(test_captures, __MTX_GRD_SLOW_CAPTURE_NUM__);
+    CU_ASSERT(capture_num >= 1);
+    CU_ASSERT((capture_num == __MTX_GRD_SLOW_CAPTURE_NUM__) || (capture_num == (previous_num + 1)));
+
+    if(capture_num >= 1)
+    {
+        const MTX_GRD_SLOW_CAPTURE* p_capture = &test_captures[capture_num - 1];
+
+        CU_ASSERT_PTR_EQUAL(p_capture->guard, &test_capture_helper_struct.mtx_grd);
+        CU_ASSERT(p_capture->wait_ns >= 1000000);
+        CU_ASSERT(p_capture->depth > 0);
+        CU_ASSERT_NOT_EQUAL(p_capture->owner_kernel_tid, 0);
+        CU_ASSERT_PTR_NOT_NULL(p_capture->owner_addresses[0]);
+    }
+
+    int test_pipe[2];
+    CU_ASSERT_EQUAL(pipe(test_pipe), 0);
+
+    char capture_string[65536] = {0};
+
+    CU_ASSERT_EQUAL(MutexGuardWriteSlowCaptures(test_pipe[1]), capture_num);
+    close(test_pipe[1]);
+
+    CU_ASSERT(read(test_pipe[0], capture_string, sizeof(capture_string) - 1) > 0);
+    close(test_pipe[0]);
+
+    CU_ASSERT_PTR_NOT_NULL(strstr(capture_string, "Owner (PID <"));
+
+    CU_ASSERT_EQUAL(MutexGuardSetSlowCapture(0, 0), 0);
+}
+
+static void TestExecuteIncrement(void* arg)
+{
+    ++*(unsigned long*)arg;
+}
+
+static unsigned long test_execute_counter;
+static MTX_GRD test_execute_mtx_grd;
+
+static void* TestExecuteHelper(void* arg)
+{
+    for(int execute_index = 0; execute_index < *(int*)arg; execute_index++)
+        MutexGuardExecute(&test_execute_mtx_grd, TestExecuteIncrement, &test_execute_counter);
+
+    return NULL;
+}
+
+static void* TestExecuteFreeHelper(void* arg)
+{
+    MTX_GRD* p_test_mtx_grd = (MTX_GRD*)arg;
+
+    // Gets the guard as soon as it is released and frees it, while its previous owner may still be within MutexGuardUnlock.
+    while(MTX_GRD_TRY_LOCK(p_test_mtx_grd));
+
+    MutexGuardUnlock(p_test_mtx_grd);
+
+    MutexGuardDestroy(p_test_mtx_grd);
+    free(p_test_mtx_grd);
+
+    return NULL;
+}
+
+static void TestExecute()
+{
+    MTX_GRD_STATS test_snapshot = {0};
+    MTX_GRD_STATS test_delta;
+
+    CU_ASSERT_EQUAL(MutexGuardExecute(NULL, TestExecuteIncrement, &test_execute_counter), -1);
+    CU_ASSERT_EQUAL(MutexGuardExecute(&test_execute_mtx_grd, NULL, NULL), -2);
+
+    MTX_GRD_INIT_SC(&test_execute_mtx_grd, dummy_mtx);
+    test_execute_counter = 0;
+
+    CU_ASSERT_EQUAL(MutexGuardExecute(&test_execute_mtx_grd, TestExecuteIncrement, &test_execute_counter), 0);
+    CU_ASSERT_EQUAL(test_execute_counter, 1);
+    CU_ASSERT_EQUAL(test_execute_mtx_grd.lock_counter, 0);
+
+    // Run right away when called by the owner.
+    {
+        MTX_GRD_LOCK_SC(&test_execute_mtx_grd, dummy_lock);
+
+        CU_ASSERT_EQUAL(MutexGuardExecute(&test_execute_mtx_grd, TestExecuteIncrement, &test_execute_counter), 0);
+        CU_ASSERT_EQUAL(test_execute_counter, 2);
+    }
+
+    // Published while the guard is held: run by the owner before releasing it.
+    int execute_num = 1;
+    pthread_t thread_0;
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_execute_mtx_grd), 0);
+
+    pthread_create(&thread_0, NULL, TestExecuteHelper, &execute_num);
+
+    // Waits for the operation to be published (the publisher counts itself as a waiter beforehand).
+    while(!__atomic_load_n(&test_execute_mtx_grd.combine_head, __ATOMIC_ACQUIRE))
+        sched_yield();
+
+    CU_ASSERT_EQUAL(test_execute_counter, 2);
+    CU_ASSERT_EQUAL(__atomic_load_n(&test_execute_mtx_grd.waiter_counter, __ATOMIC_RELAXED), 1);
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_execute_mtx_grd), 0);
+    CU_ASSERT_EQUAL(test_execute_counter, 3);
+
+    pthread_join(thread_0, NULL);
+
+    CU_ASSERT_EQUAL(MutexGuardGetStatsDelta(&test_execute_mtx_grd, &test_snapshot, &test_delta), 0);
+    CU_ASSERT_EQUAL(test_delta.acquisition_counter, 4);
+    CU_ASSERT_EQUAL(test_delta.contention_counter, 1);
+
+    // Every operation is run exactly once and accounted as an acquisition, whichever thread runs it.
+    pthread_t threads[4];
+    execute_num = 10000;
+
+    for(int thread_index = 0; thread_index < 4; thread_index++)
+        pthread_create(&threads[thread_index], NULL, TestExecuteHelper, &execute_num);
+
+    for(int thread_index = 0; thread_index < 4; thread_index++)
+        pthread_join(threads[thread_index], NULL);
+
+    CU_ASSERT_EQUAL(test_execute_counter, 40003);
+    CU_ASSERT_EQUAL(__atomic_load_n(&test_execute_mtx_grd.waiter_counter, __ATOMIC_RELAXED), 0);
+    CU_ASSERT_PTR_NULL(test_execute_mtx_grd.combine_head);
+
+    CU_ASSERT_EQUAL(MutexGuardGetStatsDelta(&test_execute_mtx_grd, &test_snapshot, &test_delta), 0);
+    CU_ASSERT_EQUAL(test_delta.acquisition_counter, 40000);
+
+    // Guards released with nothing published are left alone, as whoever gets them next may free them right away.
+    int free_fail_num = 0;
+
+    for(int free_index = 0; free_index < 1000; free_index++)
+    {
+        MTX_GRD* p_test_mtx_grd = calloc(1, sizeof(MTX_GRD));
+
+        MTX_GRD_INIT(p_test_mtx_grd);
+        free_fail_num += (MTX_GRD_LOCK(p_test_mtx_grd) != 0);
+
+        pthread_create(&thread_0, NULL, TestExecuteFreeHelper, p_test_mtx_grd);
+        usleep(10);
+
+        free_fail_num += (MutexGuardUnlock(p_test_mtx_grd) != 0);
+        pthread_join(thread_0, NULL);
+    }
+
+    CU_ASSERT_EQUAL(free_fail_num, 0);
+}
+
+static MTX_GRD test_many_mtx_grd[2];
+static long test_many_balance[2];
+
+static void* TestLockManyHelper(void* arg)
+{
+    // Each thread lists the guards in a different order, which would deadlock if they were locked one after the other.
+    MTX_GRD* test_guards[2] = { &test_many_mtx_grd[*(int*)arg], &test_many_mtx_grd[1 - *(int*)arg] };
+
+    for(int transfer_index = 0; transfer_index < 10000; transfer_index++)
+    {
+        MTX_GRD_LOCK_MANY_SC(test_guards, 2, 0, test_many);
+
+        if(!test_many.guards)
+            return (void*)-1;
+
+        --test_many_balance[*(int*)arg];
+        ++test_many_balance[1 - *(int*)arg];
+    }
+
+    return NULL;
+}
+
+static void TestLockMany()
+{
+    MTX_GRD* test_guards[2] = { &test_many_mtx_grd[0], &test_many_mtx_grd[1] };
+    MTX_GRD* test_duplicate_guards[2] = { &test_many_mtx_grd[0], &test_many_mtx_grd[0] };
+
+    CU_ASSERT_EQUAL(MutexGuardLockMany(NULL, 2, 0), -1);
+    CU_ASSERT_EQUAL(MutexGuardLockMany(test_guards, 0, 0), -2);
+    CU_ASSERT_EQUAL(MutexGuardLockMany(test_duplicate_guards, 2, 0), -3);
+    CU_ASSERT_EQUAL(MutexGuardUnlockMany(NULL, 2), -1);
+
+    MTX_GRD_INIT_SC(&test_many_mtx_grd[0], dummy_mtx_0);
+    MTX_GRD_INIT_SC(&test_many_mtx_grd[1], dummy_mtx_1);
+
+    CU_ASSERT_EQUAL(MutexGuardLockMany(test_guards, 2, 0), 0);
+    CU_ASSERT_EQUAL(test_many_mtx_grd[0].lock_counter, 1);
+    CU_ASSERT_EQUAL(test_many_mtx_grd[1].lock_counter, 1);
+    CU_ASSERT_EQUAL(MutexGuardUnlockMany(test_guards, 2), 0);
+    CU_ASSERT_EQUAL(test_many_mtx_grd[0].lock_counter, 0);
+    CU_ASSERT_EQUAL(test_many_mtx_grd[1].lock_counter, 0);
+
+    {
+        MTX_GRD_LOCK_MANY_SC(test_guards, 2, 0, test_many);
+
+        CU_ASSERT_PTR_EQUAL(test_many.guards, test_guards);
+        CU_ASSERT_EQUAL(test_many.guard_num, 2);
+        CU_ASSERT_EQUAL(test_many_mtx_grd[1].lock_counter, 1);
+    }
+
+    CU_ASSERT_EQUAL(test_many_mtx_grd[0].lock_counter, 0);
+    CU_ASSERT_EQUAL(test_many_mtx_grd[1].lock_counter, 0);
+
+    // The deadline is shared: with one guard held elsewhere, nothing is kept locked once it has elapsed.
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_many_mtx_grd[1]), 0);
+
+    {
+        MTX_GRD_LOCK_MANY_SC(test_guards, 2, 10000000, test_many);
+
+        CU_ASSERT_PTR_NULL(test_many.guards);
+        CU_ASSERT_EQUAL(MutexGuardGetErrorCode(), 1009);
+    }
+
+    CU_ASSERT_EQUAL(MutexGuardLockMany(test_guards, 2, 10000000), ETIMEDOUT);
+
+    CU_ASSERT_EQUAL(test_many_mtx_grd[0].lock_counter, 0);
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_many_mtx_grd[1]), 0);
+
+    int thread_args[2] = { 0, 1 };
+    pthread_t threads[2];
+    void* thread_rets[2];
+
+    for(int thread_index = 0; thread_index < 2; thread_index++)
+        pthread_create(&threads[thread_index], NULL, TestLockManyHelper, &thread_args[thread_index]);
+
+    for(int thread_index = 0; thread_index < 2; thread_index++)
+    {
+        pthread_join(threads[thread_index], &thread_rets[thread_index]);
+        CU_ASSERT_PTR_NULL(thread_rets[thread_index]);
+    }
+
+    CU_ASSERT_EQUAL(test_many_balance[0] + test_many_balance[1], 0);
+
+    MTX_GRD_STATS test_stats;
+
+    CU_ASSERT_EQUAL(MutexGuardGetStats(&test_many_mtx_grd[0], &test_stats), 0);
+    CU_ASSERT_EQUAL(test_stats.acquisition_counter, 20002);
+    CU_ASSERT_EQUAL(test_stats.failure_counter, 0);
+}
+
+static void* TestLockManyOwnerDeadHelper(void* arg)
+{
+    return (void*)(intptr_t)MTX_GRD_TRY_LOCK((MTX_GRD*)arg);
+}
+
+static void TestLockManyOwnerDead()
+{
+    MTX_GRD test_robust_mtx_grd[2];
+    MTX_GRD* test_guards[2] = { &test_robust_mtx_grd[0], &test_robust_mtx_grd[1] };
+    MTX_GRD* test_reversed_guards[2] = { &test_robust_mtx_grd[1], &test_robust_mtx_grd[0] };
+
+    memset(test_robust_mtx_grd, 0, sizeof(test_robust_mtx_grd));
+
+    for(int guard_index = 0; guard_index < 2; guard_index++)
+    {
+        MutexGuardAttrInit(&test_robust_mtx_grd[guard_index], PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_PRIVATE);
+        MTX_GRD_ATTR_SET_ROBUST(&test_robust_mtx_grd[guard_index], PTHREAD_MUTEX_ROBUST);
+        MTX_GRD_INIT(&test_robust_mtx_grd[guard_index]);
+    }
+
+    pthread_t thread_0;
+    void* thread_ret;
+
+    // The guard acquired from a dead owner is kept while the rest of the set is acquired, whichever position it has.
+    for(int order_index = 0; order_index < 2; order_index++)
+    {
+        MTX_GRD** p_guards = (order_index ? test_reversed_guards : test_guards);
+
+        pthread_create(&thread_0, NULL, TestRobustLockHelper, &test_robust_mtx_grd[0]);
+        pthread_join(thread_0, NULL);
+
+        {
+            MTX_GRD_LOCK_MANY_SC(p_guards, 2, 10000000, test_many);
+
+            CU_ASSERT_PTR_EQUAL(test_many.guards, p_guards);
+            CU_ASSERT_TRUE(MutexGuardIsInconsistent(&test_robust_mtx_grd[0]));
+            CU_ASSERT_FALSE(MutexGuardIsInconsistent(&test_robust_mtx_grd[1]));
+            CU_ASSERT_EQUAL(test_robust_mtx_grd[1].lock_counter, 1);
+
+            pthread_create(&thread_0, NULL, TestLockManyOwnerDeadHelper, &test_robust_mtx_grd[1]);
+            pthread_join(thread_0, &thread_ret);
+            CU_ASSERT_EQUAL((intptr_t)thread_ret, EBUSY);
+
+            CU_ASSERT_EQUAL(MutexGuardMakeConsistent(&test_robust_mtx_grd[0]), 0);
+        }
+
+        CU_ASSERT_EQUAL(test_robust_mtx_grd[0].lock_counter, 0);
+        CU_ASSERT_EQUAL(test_robust_mtx_grd[1].lock_counter, 0);
+    }
+
+    pthread_create(&thread_0, NULL, TestRobustLockHelper, &test_robust_mtx_grd[1]);
+    pthread_join(thread_0, NULL);
+
+    CU_ASSERT_EQUAL(MutexGuardLockMany(test_guards, 2, 0), EOWNERDEAD);
+    CU_ASSERT_EQUAL(test_robust_mtx_grd[0].lock_counter, 1);
+    CU_ASSERT_EQUAL(MutexGuardMakeConsistent(&test_robust_mtx_grd[1]), 0);
+    CU_ASSERT_EQUAL(MutexGuardUnlockMany(test_guards, 2), 0);
+
+    // A guard already held by the caller still makes the set fail, the one acquired from a dead owner being released as well.
+    pthread_create(&thread_0, NULL, TestRobustLockHelper, &test_robust_mtx_grd[0]);
+    pthread_join(thread_0, NULL);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_robust_mtx_grd[1]), 0);
+    CU_ASSERT_EQUAL(MutexGuardLockMany(test_guards, 2, 0), EDEADLK);
+    CU_ASSERT_EQUAL(test_robust_mtx_grd[0].lock_counter, 0);
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_robust_mtx_grd[1]), 0);
+
+    for(int guard_index = 0; guard_index < 2; guard_index++)
+        MTX_GRD_DESTROY(&test_robust_mtx_grd[guard_index]);
+}
+
+static unsigned long test_delegation_counter;
+static MTX_GRD test_delegation_mtx_grd;
+
+static void* TestDelegationHelper(void* arg)
+{
+    for(int execute_index = 0; execute_index < *(int*)arg; execute_index++)
+    {
+        // Direct lockers are still excluded from the operations the server runs.
+        if(!(execute_index % 100))
+        {
+            MTX_GRD_LOCK_SC(&test_delegation_mtx_grd, dummy_lock);
+            ++test_delegation_counter;
+        }
+        else
+            MutexGuardExecute(&test_delegation_mtx_grd, TestExecuteIncrement, &test_delegation_counter);
+    }
+
+    return NULL;
+}
+
+static void TestDelegation()
+{
+    MTX_GRD_DELEGATION_STATS test_stats;
+
+    CU_ASSERT_EQUAL(MTX_GRD_ATTR_SET_DELEGATION(NULL, MTX_GRD_DELEGATION_ANY_CPU), -1);
+    CU_ASSERT_EQUAL(MTX_GRD_ATTR_SET_DELEGATION(&test_delegation_mtx_grd, -3), -2);
+    CU_ASSERT_EQUAL(MutexGuardGetDelegationStats(NULL, &test_stats), -1);
+    CU_ASSERT_EQUAL(MutexGuardGetDelegationStats(&test_delegation_mtx_grd, NULL), -2);
+
+    CU_ASSERT_EQUAL(MTX_GRD_ATTR_INIT(&test_delegation_mtx_grd, PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_PRIVATE), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_ATTR_SET_DELEGATION(&test_delegation_mtx_grd, MTX_GRD_DELEGATION_ANY_CPU), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_INIT(&test_delegation_mtx_grd), 0);
+    CU_ASSERT_PTR_NOT_NULL(test_delegation_mtx_grd.delegation);
+
+    test_delegation_counter = 0;
+
+    CU_ASSERT_EQUAL(MutexGuardExecute(&test_delegation_mtx_grd, TestExecuteIncrement, &test_delegation_counter), 0);
+    CU_ASSERT_EQUAL(test_delegation_counter, 1);
+
+    // Run right away when called by the owner.
+    {
+        MTX_GRD_LOCK_SC(&test_delegation_mtx_grd, dummy_lock);
+
+        CU_ASSERT_EQUAL(MutexGuardExecute(&test_delegation_mtx_grd, TestExecuteIncrement, &test_delegation_counter), 0);
+        CU_ASSERT_EQUAL(test_delegation_counter, 2);
+    }
+
+    int execute_num = 5000;
+    pthread_t threads[4];
+
+    for(int thread_index = 0; thread_index < 4; thread_index++)
+        pthread_create(&threads[thread_index], NULL, TestDelegationHelper, &execute_num);
+
+    for(int thread_index = 0; thread_index < 4; thread_index++)
+        pthread_join(threads[thread_index], NULL);
+
+    CU_ASSERT_EQUAL(test_delegation_counter, 20002);
+
+    CU_ASSERT_EQUAL(MutexGuardGetDelegationStats(&test_delegation_mtx_grd, &test_stats), 0);
+    CU_ASSERT_EQUAL(test_stats.request_counter, 19801);
+    CU_ASSERT(test_stats.batch_counter >= 1);
+    CU_ASSERT(test_stats.batch_counter <= test_stats.request_counter);
+    CU_ASSERT(test_stats.queue_depth_max >= 1);
+    CU_ASSERT(test_stats.queue_depth_max <= 4);
+    CU_ASSERT(test_stats.latency_ns_max > 0);
+
+    MTX_GRD_STATS test_guard_stats;
+
+    CU_ASSERT_EQUAL(MutexGuardGetStats(&test_delegation_mtx_grd, &test_guard_stats), 0);
+    CU_ASSERT_EQUAL(test_guard_stats.acquisition_counter, 20002);
+
+    CU_ASSERT_EQUAL(MTX_GRD_DESTROY(&test_delegation_mtx_grd), 0);
+    CU_ASSERT_PTR_NULL(test_delegation_mtx_grd.delegation);
+}
+
+static unsigned long test_batch_counter;
+static MTX_GRD test_batch_mtx_grd;
+
+static void* TestBatchHelper(void* arg)
+{
+    // Left for thread exit to apply.
+    for(int batch_index = 0; batch_index < *(int*)arg; batch_index++)
+        MTX_GRD_BATCH(&test_batch_mtx_grd, TestExecuteIncrement, &test_batch_counter);
+
+    return NULL;
+}
+
+static pthread_barrier_t test_batch_barrier;
+
+static void* TestPendingBatchHelper(void* arg)
+{
+    (void)arg;
+
+    // Kept pending until the main thread tried to destroy the guard.
+    MTX_GRD_BATCH(&test_batch_mtx_grd, TestExecuteIncrement, &test_batch_counter);
+    pthread_barrier_wait(&test_batch_barrier);
+    pthread_barrier_wait(&test_batch_barrier);
+    MTX_GRD_BATCH_FLUSH(&test_batch_mtx_grd);
+
+    return NULL;
+}
+
+static void TestBatch()
+{
+    MTX_GRD_BATCH_STATS test_stats;
+
+    CU_ASSERT_EQUAL(MTX_GRD_BATCH(NULL, TestExecuteIncrement, &test_batch_counter), -1);
+    CU_ASSERT_EQUAL(MTX_GRD_BATCH(&test_batch_mtx_grd, NULL, NULL), -2);
+    CU_ASSERT_EQUAL(MTX_GRD_ATTR_SET_BATCHING(NULL, 4, 0), -1);
+    CU_ASSERT_EQUAL(MTX_GRD_ATTR_SET_BATCHING(&test_batch_mtx_grd, __MTX_GRD_BATCH_OP_NUM__ + 1, 0), -2);
+    CU_ASSERT_EQUAL(MutexGuardGetBatchStats(NULL, &test_stats), -1);
+    CU_ASSERT_EQUAL(MutexGuardGetBatchStats(&test_batch_mtx_grd, NULL), -2);
+    CU_ASSERT_EQUAL(MTX_GRD_BATCH_FLUSH(NULL), 0);
+
+    CU_ASSERT_EQUAL(MTX_GRD_ATTR_INIT(&test_batch_mtx_grd, PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_PRIVATE), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_ATTR_SET_BATCHING(&test_batch_mtx_grd, 4, 0), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_INIT(&test_batch_mtx_grd), 0);
+
+    test_batch_counter = 0;
+
+    // Applied once full, under a single acquisition.
+    for(int batch_index = 0; batch_index < 3; batch_index++)
+        CU_ASSERT_EQUAL(MTX_GRD_BATCH(&test_batch_mtx_grd, TestExecuteIncrement, &test_batch_counter), 0);
+
+    CU_ASSERT_EQUAL(test_batch_counter, 0);
+    CU_ASSERT_EQUAL(MTX_GRD_BATCH(&test_batch_mtx_grd, TestExecuteIncrement, &test_batch_counter), 0);
+    CU_ASSERT_EQUAL(test_batch_counter, 4);
+    CU_ASSERT_EQUAL(test_batch_mtx_grd.lock_counter, 0);
+
+    for(int batch_index = 0; batch_index < 2; batch_index++)
+        CU_ASSERT_EQUAL(MTX_GRD_BATCH(&test_batch_mtx_grd, TestExecuteIncrement, &test_batch_counter), 0);
+
+    CU_ASSERT_EQUAL(MTX_GRD_BATCH_FLUSH(&test_batch_mtx_grd), 0);
+    CU_ASSERT_EQUAL(test_batch_counter, 6);
+    CU_ASSERT_EQUAL(MTX_GRD_BATCH_FLUSH(&test_batch_mtx_grd), 0);
+    CU_ASSERT_EQUAL(test_batch_counter, 6);
+
+    int batch_num = 3;
+    pthread_t thread_0;
+
+    pthread_create(&thread_0, NULL, TestBatchHelper, &batch_num);
+    pthread_join(thread_0, NULL);
+
+    CU_ASSERT_EQUAL(test_batch_counter, 9);
+
+    // Applied by the first operation queued after the batch delay elapsed.
+    CU_ASSERT_EQUAL(MTX_GRD_ATTR_SET_BATCHING(&test_batch_mtx_grd, 0, 1000000), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_BATCH(&test_batch_mtx_grd, TestExecuteIncrement, &test_batch_counter), 0);
+    usleep(2000);
+    CU_ASSERT_EQUAL(test_batch_counter, 9);
+    CU_ASSERT_EQUAL(MTX_GRD_BATCH(&test_batch_mtx_grd, TestExecuteIncrement, &test_batch_counter), 0);
+    CU_ASSERT_EQUAL(test_batch_counter, 11);
+
+    CU_ASSERT_EQUAL(MutexGuardGetBatchStats(&test_batch_mtx_grd, &test_stats), 0);
+    CU_ASSERT_EQUAL(test_stats.flush_counter, 4);
+    CU_ASSERT_EQUAL(test_stats.op_counter, 11);
+    CU_ASSERT_EQUAL(test_stats.full_flush_counter, 1);
+    CU_ASSERT_EQUAL(test_stats.timed_flush_counter, 1);
+    CU_ASSERT_EQUAL(test_stats.exit_flush_counter, 1);
+    CU_ASSERT_EQUAL(test_stats.batch_size_max, 4);
+    CU_ASSERT_EQUAL(test_stats.batch_size_histogram[1], 3);
+    CU_ASSERT_EQUAL(test_stats.batch_size_histogram[2], 1);
+
+    MTX_GRD_STATS test_guard_stats;
+
+    CU_ASSERT_EQUAL(MutexGuardGetStats(&test_batch_mtx_grd, &test_guard_stats), 0);
+    CU_ASSERT_EQUAL(test_guard_stats.acquisition_counter, 4);
+
+    // Refused destruction while another thread has a batch for it.
+    pthread_barrier_init(&test_batch_barrier, NULL, 2);
+    pthread_create(&thread_0, NULL, TestPendingBatchHelper, NULL);
+    pthread_barrier_wait(&test_batch_barrier);
+
+    CU_ASSERT_EQUAL(MTX_GRD_DESTROY(&test_batch_mtx_grd), -4);
+    CU_ASSERT_EQUAL(test_batch_counter, 11);
+
+    pthread_barrier_wait(&test_batch_barrier);
+    pthread_join(thread_0, NULL);
+    pthread_barrier_destroy(&test_batch_barrier);
+
+    CU_ASSERT_EQUAL(test_batch_counter, 12);
+
+    // Destroying a guard applies the calling thread's batch for it.
+    CU_ASSERT_EQUAL(MTX_GRD_BATCH(&test_batch_mtx_grd, TestExecuteIncrement, &test_batch_counter), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_DESTROY(&test_batch_mtx_grd), 0);
+    CU_ASSERT_EQUAL(test_batch_counter, 13);
+}
+
+static int TestTryLockUnlockHelper(MTX_GRD* p_mtx_grd)
+{
+    int ret_lock = MTX_GRD_TRY_LOCK(p_mtx_grd);
+
+    return (ret_lock ? ret_lock : MTX_GRD_UNLOCK(p_mtx_grd));
+}
+
+static void TestDeferInThread(void* arg)
+{
+    pthread_t thread_0;
+
+    pthread_create(&thread_0, NULL, TestEvalHelper, arg);
+    pthread_join(thread_0, NULL);
+}
+
+static void TestDeferAfterUnlock()
+{
+    unsigned long test_counters[2] = {0};
+
+    MTX_GRD_CREATE(test_mtx_grd_0);
+    MTX_GRD_CREATE(test_mtx_grd_1);
+
+    CU_ASSERT_EQUAL(MTX_GRD_DEFER_AFTER_UNLOCK(NULL, TestExecuteIncrement, &test_counters[0]), -1);
+    CU_ASSERT_EQUAL(MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd_0, NULL, NULL), -2);
+
+    MTX_GRD_ATTR_INIT_SC(&test_mtx_grd_0, PTHREAD_MUTEX_RECURSIVE_NP, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_PRIVATE, dummy_mtx_grd_attr_0);
+    MTX_GRD_INIT_SC(&test_mtx_grd_0, dummy_mtx_0);
+    MTX_GRD_INIT_SC(&test_mtx_grd_1, dummy_mtx_1);
+
+    CU_ASSERT_EQUAL(MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd_0, TestExecuteIncrement, &test_counters[0]), -3);
+
+    // Run once the guard is actually released.
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd_0), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd_0), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd_0, TestExecuteIncrement, &test_counters[0]), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_UNLOCK(&test_mtx_grd_0), 0);
+    CU_ASSERT_EQUAL(test_counters[0], 0);
+    CU_ASSERT_EQUAL(MTX_GRD_UNLOCK(&test_mtx_grd_0), 0);
+    CU_ASSERT_EQUAL(test_counters[0], 1);
+
+    {
+        MTX_GRD_LOCK_SC(&test_mtx_grd_0, dummy_lock_0);
+        MTX_GRD_LOCK_SC(&test_mtx_grd_1, dummy_lock_1);
+
+        CU_ASSERT_EQUAL(MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd_0, TestExecuteIncrement, &test_counters[0]), 0);
+        CU_ASSERT_EQUAL(MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd_1, TestExecuteIncrement, &test_counters[1]), 0);
+        CU_ASSERT_EQUAL(MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd_0, TestExecuteIncrement, &test_counters[0]), 0);
+    }
+
+    CU_ASSERT_EQUAL(test_counters[0], 3);
+    CU_ASSERT_EQUAL(test_counters[1], 1);
+
+    // Only the released guard's work is run.
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd_0), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd_1), 0);
+
+    for(int defer_index = 0; defer_index < __MTX_GRD_DEFER_NUM__ - 1; defer_index++)
+        CU_ASSERT_EQUAL(MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd_0, TestExecuteIncrement, &test_counters[0]), 0);
+
+    CU_ASSERT_EQUAL(MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd_1, TestExecuteIncrement, &test_counters[1]), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd_1, TestExecuteIncrement, &test_counters[1]), -4);
+
+    CU_ASSERT_EQUAL(MTX_GRD_UNLOCK(&test_mtx_grd_1), 0);
+    CU_ASSERT_EQUAL(test_counters[0], 3);
+    CU_ASSERT_EQUAL(test_counters[1], 2);
+
+    CU_ASSERT_EQUAL(MTX_GRD_UNLOCK(&test_mtx_grd_0), 0);
+    CU_ASSERT_EQUAL(test_counters[0], 3 + __MTX_GRD_DEFER_NUM__ - 1);
+
+    // Run by condition waits, which release the guard before going to sleep.
+    MTX_GRD_COND test_mtx_grd_cond;
+    CU_ASSERT_EQUAL(MTX_GRD_COND_INIT(&test_mtx_grd_cond), 0);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd_1), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_DEFER_AFTER_UNLOCK(&test_mtx_grd_1, TestExecuteIncrement, &test_counters[1]), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_COND_TIMED_WAIT(&test_mtx_grd_cond, &test_mtx_grd_1, 1000000), ETIMEDOUT);
+    CU_ASSERT_EQUAL(test_counters[1], 3);
+    CU_ASSERT_EQUAL(MTX_GRD_UNLOCK(&test_mtx_grd_1), 0);
+    CU_ASSERT_EQUAL(test_counters[1], 3);
+    CU_ASSERT_EQUAL(MutexGuardCondDestroy(&test_mtx_grd_cond), 0);
+
+    // Run by destroying the guard, with its internal mutex free for other threads.
+    TEST_UNLOCK_HELPER_STRUCT test_defer_helper_struct = { .fnMutexGuard = &TestTryLockUnlockHelper, .test_value = -1 };
+    CU_ASSERT_EQUAL(MTX_GRD_INIT(&test_defer_helper_struct.mtx_grd), 0);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_defer_helper_struct.mtx_grd), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_DEFER_AFTER_UNLOCK(&test_defer_helper_struct.mtx_grd, TestDeferInThread, &test_defer_helper_struct), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_DESTROY(&test_defer_helper_struct.mtx_grd), 0);
+    CU_ASSERT_EQUAL(test_defer_helper_struct.test_value, 0);
+}
+
+static int TestLockAsyncHelper(MTX_GRD* p_mtx_grd)
+{
+    int fd;
+
+    if(MTX_GRD_LOCK_ASYNC(p_mtx_grd, &fd) != EINPROGRESS)
+        return -1;
+
+    struct pollfd test_poll_fd = { .fd = fd, .events = POLLIN };
+
+    if(poll(&test_poll_fd, 1, 5000) != 1)
+        return -2;
+
+    int ret_complete = MTX_GRD_LOCK_ASYNC_COMPLETE(p_mtx_grd, fd);
+
+    return (ret_complete ? ret_complete : MTX_GRD_UNLOCK(p_mtx_grd));
+}
+
+static int TestTimedLockAsyncHelper(MTX_GRD* p_mtx_grd)
+{
+    int fd;
+
+    if(MTX_GRD_TIMED_LOCK_ASYNC(p_mtx_grd, 10000000, &fd) != EINPROGRESS)
+        return -1;
+
+    struct pollfd test_poll_fd = { .fd = fd, .events = POLLIN };
+
+    if(poll(&test_poll_fd, 1, 5000) != 1)
+        return -2;
+
+    return MTX_GRD_LOCK_ASYNC_COMPLETE(p_mtx_grd, fd);
+}
+
+static int TestQueueLockAsyncHelper(MTX_GRD* p_mtx_grd)
+{
+    int fd;
+
+    return ((MTX_GRD_LOCK_ASYNC(p_mtx_grd, &fd) == EINPROGRESS) ? fd : -1);
+}
+
+static int TestCancelLockAsyncHelper(MTX_GRD* p_mtx_grd)
+{
+    int fd;
+
+    if(MTX_GRD_LOCK_ASYNC(p_mtx_grd, &fd) != EINPROGRESS)
+        return -1;
+
+    if(MTX_GRD_LOCK_ASYNC_COMPLETE(p_mtx_grd, fd) != EINPROGRESS)
+        return -2;
+
+    return MTX_GRD_LOCK_ASYNC_CANCEL(p_mtx_grd, fd);
+}
+
+static void TestLockAsync()
+{
+    int fd = 0;
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK_ASYNC(NULL, &fd), -1);
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK_ASYNC_COMPLETE(NULL, 0), -1);
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK_ASYNC_CANCEL(NULL, 0), -1);
+
+    TEST_UNLOCK_HELPER_STRUCT test_async_helper_struct = { .fnMutexGuard = &TestLockAsyncHelper };
+    MTX_GRD_INIT_SC(&test_async_helper_struct.mtx_grd, dummy_mtx);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK_ASYNC(&test_async_helper_struct.mtx_grd, NULL), -2);
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK_ASYNC_COMPLETE(&test_async_helper_struct.mtx_grd, 0), -2);
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK_ASYNC_CANCEL(&test_async_helper_struct.mtx_grd, 0), -2);
+
+    // Locked right away if available, refused to its own owner.
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK_ASYNC(&test_async_helper_struct.mtx_grd, &fd), 0);
+    CU_ASSERT_EQUAL(fd, -1);
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK_ASYNC(&test_async_helper_struct.mtx_grd, &fd), EDEADLK);
+    CU_ASSERT_EQUAL(MTX_GRD_UNLOCK(&test_async_helper_struct.mtx_grd), 0);
+
+    // Handed over on release.
+    {
+        MTX_GRD_LOCK_SC(&test_async_helper_struct.mtx_grd, dummy_lock);
+
+        pthread_t thread_0;
+        pthread_create(&thread_0, NULL, TestEvalHelper, &test_async_helper_struct);
+        usleep(20000);
+
+        MTX_GRD_UNLOCK(&test_async_helper_struct.mtx_grd);
+        pthread_join(thread_0, NULL);
+    }
+
+    CU_ASSERT_EQUAL(test_async_helper_struct.test_value, 0);
+
+    // Timed out, or withdrawn, while the guard is held.
+    MTX_GRD_LOCK(&test_async_helper_struct.mtx_grd);
+
+    pthread_t thread_0;
+    test_async_helper_struct.fnMutexGuard = &TestTimedLockAsyncHelper;
+    pthread_create(&thread_0, NULL, TestEvalHelper, &test_async_helper_struct);
+    pthread_join(thread_0, NULL);
+
+    CU_ASSERT_EQUAL(test_async_helper_struct.test_value, ETIMEDOUT);
+
+    test_async_helper_struct.fnMutexGuard = &TestCancelLockAsyncHelper;
+    pthread_create(&thread_0, NULL, TestEvalHelper, &test_async_helper_struct);
+    pthread_join(thread_0, NULL);
+
+    CU_ASSERT_EQUAL(test_async_helper_struct.test_value, 0);
+    CU_ASSERT_EQUAL(MTX_GRD_UNLOCK(&test_async_helper_struct.mtx_grd), 0);
+
+    // Taken by the completing thread itself: error checking guards are released by their owner.
+    TEST_UNLOCK_HELPER_STRUCT test_check_helper_struct = { .fnMutexGuard = &TestLockAsyncHelper };
+    MTX_GRD_ATTR_INIT_SC(&test_check_helper_struct.mtx_grd, PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_PRIVATE, dummy_check_attr);
+    MTX_GRD_INIT_SC(&test_check_helper_struct.mtx_grd, dummy_check_mtx);
+
+    {
+        MTX_GRD_LOCK_SC(&test_check_helper_struct.mtx_grd, dummy_lock);
+
+        pthread_create(&thread_0, NULL, TestEvalHelper, &test_check_helper_struct);
+        usleep(20000);
+
+        MTX_GRD_UNLOCK(&test_check_helper_struct.mtx_grd);
+        pthread_join(thread_0, NULL);
+    }
+
+    CU_ASSERT_EQUAL(test_check_helper_struct.test_value, 0);
+
+    // Pending requests' descriptors are made readable by the guard's destruction, and left to their owners to close.
+    TEST_UNLOCK_HELPER_STRUCT test_drop_helper_struct = { .fnMutexGuard = &TestQueueLockAsyncHelper };
+    MTX_GRD_INIT(&test_drop_helper_struct.mtx_grd);
+    MTX_GRD_LOCK(&test_drop_helper_struct.mtx_grd);
+
+    pthread_create(&thread_0, NULL, TestEvalHelper, &test_drop_helper_struct);
+    pthread_join(thread_0, NULL);
+
+    CU_ASSERT(test_drop_helper_struct.test_value >= 0);
+    CU_ASSERT_EQUAL(MutexGuardDestroy(&test_drop_helper_struct.mtx_grd), 0);
+
+    struct pollfd test_poll_fd = { .fd = test_drop_helper_struct.test_value, .events = POLLIN };
+
+    CU_ASSERT_EQUAL(poll(&test_poll_fd, 1, 0), 1);
+    CU_ASSERT_EQUAL(close(test_drop_helper_struct.test_value), 0);
+
+    // Guards with a priority protocol are not supported.
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_ATTR_INIT_SC(&test_mtx_grd, PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_INHERIT, PTHREAD_PROCESS_PRIVATE, dummy_mtx_grd_attr);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_err_mtx);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK_ASYNC(&test_mtx_grd, &fd), -3);
+}
+
+static void TestSourceCallsite()
+{
+    CU_ASSERT_PTR_NULL(MutexGuardSourceCallsite(NULL, 42, NULL));
+
+    void* test_callsite = MutexGuardSourceCallsite("test_source.c", 42, "TestSourceCallsite");
+
+    CU_ASSERT_PTR_NOT_NULL(test_callsite);
+    CU_ASSERT_PTR_EQUAL(MutexGuardSourceCallsite("test_source.c", 42, "TestSourceCallsite"), test_callsite);
+    CU_ASSERT_NOT_EQUAL(MutexGuardSourceCallsite("test_source.c", 43, "TestSourceCallsite"), test_callsite);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_ATTR_INIT_SC(&test_mtx_grd, PTHREAD_MUTEX_ERRORCHECK, PTHREAD_PRIO_NONE, PTHREAD_PROCESS_PRIVATE, dummy_mtx_grd_attr);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+
+    // Lock errors show the location the owner locked the guard at, with no symbolization.
+    CU_ASSERT_EQUAL(MutexGuardLock(&test_mtx_grd, test_callsite, 0, MTX_GRD_LOCK_TYPE_PERMANENT), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd), EDEADLK);
+    CU_ASSERT_PTR_NOT_NULL(strstr(MTX_GRD_GET_LAST_ERR_STR, "TestSourceCallsite defined at test_source.c:42"));
+    CU_ASSERT_EQUAL(MutexGuardUnlock(&test_mtx_grd), 0);
+}
+
+static void TestExternalOwner()
+{
+    CU_ASSERT_EQUAL(MutexGuardExternalAcquired(NULL, NULL, 0), -1);
+    CU_ASSERT_EQUAL(MutexGuardExternalReleased(NULL), -1);
+
+    TEST_UNLOCK_HELPER_STRUCT test_release_helper_struct = { .fnMutexGuard = &MutexGuardExternalReleased };
+    MTX_GRD_INIT_SC(&test_release_helper_struct.mtx_grd, dummy_mtx);
+    MTX_GRD* p_test_mtx_grd = &test_release_helper_struct.mtx_grd;
+
+    CU_ASSERT_EQUAL(MutexGuardExternalReleased(p_test_mtx_grd), -2);
+
+    void* test_callsite = MutexGuardSourceCallsite("test_source.c", 44, "TestExternalOwner");
+
+    CU_ASSERT_EQUAL(MutexGuardExternalAcquired(p_test_mtx_grd, test_callsite, 0), 0);
+    CU_ASSERT_EQUAL(MutexGuardExternalAcquired(p_test_mtx_grd, test_callsite, 0), EBUSY);
+    CU_ASSERT_TRUE(pthread_equal(p_test_mtx_grd->mutex_acq_location.thread_id, pthread_self()));
+    CU_ASSERT_PTR_EQUAL(p_test_mtx_grd->mutex_acq_location.addresses[0], test_callsite);
+
+    // The mutex itself is left alone.
+    CU_ASSERT_EQUAL(pthread_mutex_trylock(&p_test_mtx_grd->mutex), 0);
+    CU_ASSERT_EQUAL(pthread_mutex_unlock(&p_test_mtx_grd->mutex), 0);
+
+    // Released by another thread than the acquirer.
+    pthread_t thread_0;
+    pthread_create(&thread_0, NULL, TestEvalHelper, &test_release_helper_struct);
+    pthread_join(thread_0, NULL);
+
+    CU_ASSERT_EQUAL(test_release_helper_struct.test_value, 0);
+    CU_ASSERT_EQUAL(p_test_mtx_grd->mutex_acq_location.thread_id, 0);
+    CU_ASSERT_EQUAL(p_test_mtx_grd->lock_counter, 0);
+
+    CU_ASSERT_EQUAL(MutexGuardExternalAcquired(p_test_mtx_grd, test_callsite, 1000), 0);
+    CU_ASSERT_EQUAL(MutexGuardExternalReleased(p_test_mtx_grd), 0);
+
+    MTX_GRD_STATS test_stats;
+    CU_ASSERT_EQUAL(MutexGuardGetStats(p_test_mtx_grd, &test_stats), 0);
+    CU_ASSERT_EQUAL(test_stats.acquisition_counter, 2);
+    CU_ASSERT_EQUAL(test_stats.contention_counter, 1);
+    CU_ASSERT_EQUAL(test_stats.wait_ns_total, 1000);
+    CU_ASSERT_PTR_EQUAL(test_stats.callsites[0].address, test_callsite);
+    CU_ASSERT_EQUAL(test_stats.callsites[0].acquisition_counter, 2);
+}
+
+static void TestTrace()
+{
+    CU_ASSERT_EQUAL(MutexGuardSetTracing(true), 0);
+    CU_ASSERT_EQUAL(MutexGuardWriteTrace(-1), -1);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+    CU_ASSERT_EQUAL(MutexGuardSetName(&test_mtx_grd, "test_trace_mtx_grd"), 0);
+
+    for(int lock_index = 0; lock_index < 2; lock_index++)
+    {
+        CU_ASSERT_EQUAL(MTX_GRD_LOCK(&test_mtx_grd), 0);
+        CU_ASSERT_EQUAL(MutexGuardUnlock(&test_mtx_grd), 0);
+    }
+
+    CU_ASSERT_EQUAL(MutexGuardSetTracing(false), 0);
+
+    int test_pipe[2];
+    CU_ASSERT_EQUAL(pipe(test_pipe), 0);
+
+    char trace_string[65536] = {0};
+
+    CU_ASSERT_EQUAL(MutexGuardWriteTrace(test_pipe[1]), 2);
+    close(test_pipe[1]);
+
+    CU_ASSERT(read(test_pipe[0], trace_string, sizeof(trace_string) - 1) > 0);
+    close(test_pipe[0]);
+
+    CU_ASSERT_PTR_NOT_NULL(strstr(trace_string, "\"traceEvents\":["));
+    CU_ASSERT_PTR_NOT_NULL(strstr(trace_string, "\"name\":\"holding test_trace_mtx_grd\""));
+    CU_ASSERT_PTR_NOT_NULL(strstr(trace_string, "\"ph\":\"f\",\"bp\":\"e\",\"id\":"));
+}
+
+static void TestAttrDestroy()
+{
+    CU_ASSERT_EQUAL(MutexGuardAttrDestroy(NULL), -1);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_ATTR_INIT(&test_mtx_grd, 0, 0, 0);
+    MTX_GRD_INIT(&test_mtx_grd);
+
+    CU_ASSERT_EQUAL(MutexGuardAttrDestroy(&test_mtx_grd), 0);
+
+    MTX_GRD_DESTROY(&test_mtx_grd);
+}
+
+static void TestDestroy()
+{
+    CU_ASSERT_EQUAL(MutexGuardDestroy(NULL), -1);
+
+    {
+        TEST_UNLOCK_HELPER_STRUCT test_unlock_helper_struct = { .fnMutexGuard = &MutexGuardDestroy };
+        MTX_GRD_INIT_SC(&test_unlock_helper_struct.mtx_grd, dummy_unlock_helper);
+        MTX_GRD_LOCK_SC(&test_unlock_helper_struct.mtx_grd, test_lock_dummy);
+        pthread_t thread_0;
+        pthread_create(&thread_0, NULL, TestEvalHelper, &test_unlock_helper_struct);
+
+        pthread_join(thread_0, NULL);
+
+        CU_ASSERT_EQUAL(test_unlock_helper_struct.test_value, -3);
+    }
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT(&test_mtx_grd);
+
+    CU_ASSERT_EQUAL(MutexGuardDestroy(&test_mtx_grd), 0);
+}
+
+static void TestSetInternalErrMode()
+{
+    CU_ASSERT_EQUAL(MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_MIN - 1), -1);
+    CU_ASSERT_EQUAL(MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_MAX + 1), -1);
+
+    CU_ASSERT_EQUAL(MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_KEEP_TRYING),     0);
+    CU_ASSERT_EQUAL(MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_ABORT_ON_ERROR),  0);
+    CU_ASSERT_EQUAL(MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_FORCE_ONE_SHOT),  0);
+}
+
+static void TestGetInternalErrMode()
+{
+    CU_ASSERT_EQUAL(MutexGuardGetInternalErrMode(), MTX_GRD_INT_ERR_MGMT_FORCE_ONE_SHOT);
+
+    for(int int_err_mgmt_mode = MTX_GRD_INT_ERR_MGMT_MIN; int_err_mgmt_mode <= MTX_GRD_INT_ERR_MGMT_MAX; int_err_mgmt_mode++)
+    {
+        MutexGuardSetInternalErrMode(int_err_mgmt_mode);
+        CU_ASSERT_EQUAL(MutexGuardGetInternalErrMode(), int_err_mgmt_mode);
+    }
+
+    MutexGuardSetInternalErrMode(MTX_GRD_INT_ERR_MGMT_FORCE_ONE_SHOT);
+}
+
+static void TestShmOpen()
+{
+    CU_ASSERT_PTR_NULL(MutexGuardShmOpen(NULL, 0, 0));
+    CU_ASSERT_EQUAL(MutexGuardShmClose(NULL, 0), -1);
+    CU_ASSERT_EQUAL(MutexGuardShmUnlink(NULL), -1);
+
+    MutexGuardShmUnlink("/test_mtx_grd_shm");
+
+    MTX_GRD* p_test_mtx_grd_0 = MutexGuardShmOpen("/test_mtx_grd_shm", sizeof(int), PTHREAD_MUTEX_ERRORCHECK);
+    CU_ASSERT_PTR_NOT_NULL(p_test_mtx_grd_0);
+
+    if(!p_test_mtx_grd_0)
+        return;
+
+    MTX_GRD* p_test_mtx_grd_1 = MutexGuardShmOpen("/test_mtx_grd_shm", sizeof(int), PTHREAD_MUTEX_ERRORCHECK);
+    CU_ASSERT_PTR_NOT_NULL(p_test_mtx_grd_1);
+    CU_ASSERT_TRUE(p_test_mtx_grd_0->process_shared);
+
+    CU_ASSERT_EQUAL(MTX_GRD_LOCK(p_test_mtx_grd_0), 0);
+    *(int*)MTX_GRD_SHM_DATA(p_test_mtx_grd_0) = 1;
+    CU_ASSERT_EQUAL(p_test_mtx_grd_1->mutex_acq_location.process_id, getpid());
+    CU_ASSERT_EQUAL(*(int*)MTX_GRD_SHM_DATA(p_test_mtx_grd_1), 1);
+    CU_ASSERT_NOT_EQUAL(MTX_GRD_TRY_LOCK(p_test_mtx_grd_1), 0);
+
+    // Both mappings are dumped, without any of this process' pointers being written into the segment.
+    int test_pipe[2];
+    char dump_string[4096] = {0};
+
+    CU_ASSERT_EQUAL(MutexGuardSetName(p_test_mtx_grd_0, "test_shm_mtx_grd"), 0);
+    CU_ASSERT_EQUAL(pipe(test_pipe), 0);
+    CU_ASSERT(MutexGuardDumpAll(test_pipe[1]) >= 2);
+    CU_ASSERT(read(test_pipe[0], dump_string, sizeof(dump_string) - 1) > 0);
+    CU_ASSERT_PTR_NOT_NULL(strstr(dump_string, "MTX_GRD <test_shm_mtx_grd>"));
+    CU_ASSERT_PTR_NULL(p_test_mtx_grd_0->registry_next);
+    close(test_pipe[0]);
+    close(test_pipe[1]);
+
+    CU_ASSERT_EQUAL(MTX_GRD_UNLOCK(p_test_mtx_grd_1), 0);
+
+    CU_ASSERT_EQUAL(MutexGuardShmClose(p_test_mtx_grd_1, sizeof(int)), 0);
+    CU_ASSERT_EQUAL(MutexGuardShmClose(p_test_mtx_grd_0, sizeof(int)), 0);
+    CU_ASSERT_EQUAL(MutexGuardShmUnlink("/test_mtx_grd_shm"), 0);
+    CU_ASSERT_EQUAL(MutexGuardShmUnlink("/test_mtx_grd_shm"), -2);
+}
+
+static void TestCondInit()
+{
+    CU_ASSERT_EQUAL(MutexGuardCondInit(NULL), -1);
+    CU_ASSERT_PTR_NULL(MutexGuardCondInitAddr(NULL));
+
+    MTX_GRD_COND_CREATE(test_mtx_grd_cond);
+
+    CU_ASSERT_EQUAL(MutexGuardCondInit(&test_mtx_grd_cond), 0);
+    CU_ASSERT_EQUAL(MutexGuardCondDestroy(&test_mtx_grd_cond), 0);
+    CU_ASSERT_PTR_NOT_NULL(MutexGuardCondInitAddr(&test_mtx_grd_cond));
+    CU_ASSERT_EQUAL(MutexGuardCondDestroy(&test_mtx_grd_cond), 0);
+    CU_ASSERT_EQUAL(MutexGuardCondDestroy(NULL), -1);
+}
+
+static void TestCondTimedWait()
+{
+    MTX_GRD_COND_CREATE(test_mtx_grd_cond);
+    MTX_GRD_COND_INIT_SC(&test_mtx_grd_cond, dummy_cond);
+
+    MTX_GRD_CREATE(test_mtx_grd);
+    MTX_GRD_INIT_SC(&test_mtx_grd, dummy_mtx);
+
+    CU_ASSERT_EQUAL(MutexGuardCondTimedWait(NULL, &test_mtx_grd, NULL, 0), -1);
+    CU_ASSERT_EQUAL(MutexGuardCondTimedWait(&test_mtx_grd_cond, NULL, NULL, 0), -2);
+    CU_ASSERT_EQUAL(MutexGuardCondTimedWait(&test_mtx_grd_cond, &test_mtx_grd, NULL, 0), -3);
+
+    MTX_GRD_LOCK_SC(&test_mtx_grd, dummy_lock);
+
+    CU_ASSERT_EQUAL(MTX_GRD_COND_TIMED_WAIT(&test_mtx_grd_cond, &test_mtx_grd, 1000000), ETIMEDOUT);
+
+    // The guard must be owned by the calling thread again, with its record intact.
+    CU_ASSERT_EQUAL(test_mtx_grd.lock_counter, 1);
+    CU_ASSERT(pthread_equal(test_mtx_grd.mutex_acq_location.thread_id, pthread_self()));
+    CU_ASSERT_PTR_NOT_NULL(test_mtx_grd.mutex_acq_location.addresses[0]);
+    CU_ASSERT_PTR_NULL(test_mtx_grd.mutex_acq_location.addresses[1]);
+
+    MTX_GRD_COND_STATS stats = {0};
+    CU_ASSERT_EQUAL(MutexGuardCondGetStats(&test_mtx_grd_cond, &stats), 0);
+    CU_ASSERT_EQUAL(stats.wait_counter, 1);
+    CU_ASSERT_EQUAL(stats.timeout_counter, 1);
+}
+
+typedef struct
+{
+    MTX_GRD         mtx_grd;
+    MTX_GRD_COND    mtx_grd_cond;
+    int             ready;
+    int             woken;
+} TEST_COND_HELPER_STRUCT;
+
+static void* TestCondWaitHelper(void* arg)
+{
+    TEST_COND_HELPER_STRUCT* test_st = (TEST_COND_HELPER_STRUCT*)arg;
+
+    MTX_GRD_LOCK_SC(&test_st->mtx_grd, dummy_lock);
+
+    while(!test_st->ready)
+        MTX_GRD_COND_WAIT(&test_st->mtx_grd_cond, &test_st->mtx_grd);
+
+    ++test_st->woken;
+
+    return NULL;
+}
+
+static void TestCondBroadcast()
+{
+    CU_ASSERT_EQUAL(MutexGuardCondSignal(NULL), -1);
+    CU_ASSERT_EQUAL(MutexGuardCondBroadcast(NULL), -1);
+
+    TEST_COND_HELPER_STRUCT test_cond_helper_struct = {0};
+    MTX_GRD_INIT_SC(&test_cond_helper_struct.mtx_grd, dummy_mtx);
+    MTX_GRD_COND_INIT_SC(&test_cond_helper_struct.mtx_grd_cond, dummy_cond);
+
+    pthread_t threads[4];
+
+    for(int i = 0; i < 4; i++)
+        pthread_create(&threads[i], NULL, TestCondWaitHelper, &test_cond_helper_struct);
+
+    usleep(50000);
+
+    MTX_GRD_LOCK(&test_cond_helper_struct.mtx_grd);
+    test_cond_helper_struct.ready = 1;
+    CU_ASSERT_EQUAL(MTX_GRD_COND_BROADCAST(&test_cond_helper_struct.mtx_grd_cond), 0);
+    MTX_GRD_UNLOCK(&test_cond_helper_struct.mtx_grd);
+
+    for(int i = 0; i < 4; i++)
+        pthread_join(threads[i], NULL);
+
+    CU_ASSERT_EQUAL(test_cond_helper_struct.woken, 4);
+    CU_ASSERT_EQUAL(test_cond_helper_struct.mtx_grd.lock_counter, 0);
+}
+
+typedef struct
+{
+    MTX_GRD_RW*         p_mtx_grd_rw;
+    MTX_GRD_RW_MODES    mode;
+    uint64_t            timeout_ns;
+    int                 test_value;
+} TEST_RW_HELPER_STRUCT;
+
+static void* TestRwLockHelper(void* arg)
+{
+    TEST_RW_HELPER_STRUCT* test_st = (TEST_RW_HELPER_STRUCT*)arg;
+
+    if(test_st->timeout_ns)
+        test_st->test_value = MTX_GRD_RW_TIMED_LOCK(test_st->p_mtx_grd_rw, test_st->mode, test_st->timeout_ns);
+    else
+        test_st->test_value = MTX_GRD_RW_TRY_LOCK(test_st->p_mtx_grd_rw, test_st->mode);
+
+    if(!test_st->test_value)
+        MTX_GRD_RW_UNLOCK(test_st->p_mtx_grd_rw);
+
+    return NULL;
+}
+
+static int TestRwLockFromThread(MTX_GRD_RW* p_mtx_grd_rw, const MTX_GRD_RW_MODES mode, const uint64_t timeout_ns)
+{
+    TEST_RW_HELPER_STRUCT test_rw_helper_struct = { .p_mtx_grd_rw = p_mtx_grd_rw, .mode = mode, .timeout_ns = timeout_ns };
+    pthread_t thread_0;
+
+    pthread_create(&thread_0, NULL, TestRwLockHelper, &test_rw_helper_struct);
+    pthread_join(thread_0, NULL);
+
+    return test_rw_helper_struct.test_value;
+}
+
+static void TestRwLock()
+{
+    MTX_GRD_RW_HOLDER holders[2];
+
+    CU_ASSERT_EQUAL(MTX_GRD_RW_INIT(NULL, MTX_GRD_RW_PREFER_WRITERS), -1);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_LOCK(NULL, MTX_GRD_RW_MODE_SHARED), -1);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_UNLOCK(NULL), -1);
+    CU_ASSERT_EQUAL(MutexGuardRwGetHolders(NULL, holders, 2), -1);
+
+    MTX_GRD_RW_CREATE(test_mtx_grd_rw);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_INIT(&test_mtx_grd_rw, MTX_GRD_RW_PREFER_MAX + 1), -2);
+    MTX_GRD_RW_INIT_SC(&test_mtx_grd_rw, MTX_GRD_RW_PREFER_WRITERS, dummy_rw);
+    CU_ASSERT_PTR_NOT_NULL(dummy_rw);
+
+    CU_ASSERT_EQUAL(MTX_GRD_RW_LOCK(&test_mtx_grd_rw, MTX_GRD_RW_MODE_MAX + 1), -2);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_UNLOCK(&test_mtx_grd_rw), -2);
+    CU_ASSERT_EQUAL(MutexGuardRwLock(&test_mtx_grd_rw, MTX_GRD_RW_MODE_SHARED, NULL, 0, MTX_GRD_LOCK_TYPE_PERIODIC), -3);
+    CU_ASSERT_EQUAL(MutexGuardRwGetHolders(&test_mtx_grd_rw, NULL, 2), -2);
+    CU_ASSERT_EQUAL(MutexGuardRwGetHolders(&test_mtx_grd_rw, holders, 2), 0);
+
+    // Shared holds are recursive and recorded by their threads, other holds of the same thread would deadlock.
+    CU_ASSERT_EQUAL(MTX_GRD_RW_LOCK(&test_mtx_grd_rw, MTX_GRD_RW_MODE_SHARED), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_LOCK(&test_mtx_grd_rw, MTX_GRD_RW_MODE_SHARED), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_LOCK(&test_mtx_grd_rw, MTX_GRD_RW_MODE_EXCLUSIVE), EDEADLK);
+    CU_ASSERT_EQUAL(MutexGuardRwGetHolders(&test_mtx_grd_rw, holders, 2), 1);
+    CU_ASSERT_EQUAL(holders[0].mode, MTX_GRD_RW_MODE_SHARED);
+    CU_ASSERT_EQUAL(holders[0].lock_counter, 2);
+    CU_ASSERT(pthread_equal(holders[0].thread_id, pthread_self()));
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_UPGRADABLE, 0), 0);
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_EXCLUSIVE, 0), EBUSY);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_DESTROY(&test_mtx_grd_rw), -2);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_UNLOCK(&test_mtx_grd_rw), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_UNLOCK(&test_mtx_grd_rw), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_UNLOCK(&test_mtx_grd_rw), -2);
+
+    // Upgradable holds let readers in but keep writers out, up to their upgrade.
+    CU_ASSERT_EQUAL(MTX_GRD_RW_UPGRADE(&test_mtx_grd_rw), -3);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_DOWNGRADE(&test_mtx_grd_rw, MTX_GRD_RW_MODE_SHARED), -2);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_LOCK(&test_mtx_grd_rw, MTX_GRD_RW_MODE_UPGRADABLE), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_DOWNGRADE(&test_mtx_grd_rw, MTX_GRD_RW_MODE_EXCLUSIVE), -3);
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_SHARED, 0), 0);
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_UPGRADABLE, 0), EBUSY);
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_EXCLUSIVE, 0), EBUSY);
+
+    CU_ASSERT_EQUAL(MTX_GRD_RW_TIMED_UPGRADE(&test_mtx_grd_rw, 10000000), 0);
+    CU_ASSERT_EQUAL(MutexGuardRwGetHolders(&test_mtx_grd_rw, holders, 2), 1);
+    CU_ASSERT_EQUAL(holders[0].mode, MTX_GRD_RW_MODE_EXCLUSIVE);
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_SHARED, 0), EBUSY);
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_SHARED, 10000000), ETIMEDOUT);
+
+    CU_ASSERT_EQUAL(MTX_GRD_RW_DOWNGRADE(&test_mtx_grd_rw, MTX_GRD_RW_MODE_SHARED), 0);
+    CU_ASSERT_EQUAL(MutexGuardRwGetHolders(&test_mtx_grd_rw, holders, 2), 1);
+    CU_ASSERT_EQUAL(holders[0].mode, MTX_GRD_RW_MODE_SHARED);
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_UPGRADABLE, 0), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_UNLOCK(&test_mtx_grd_rw), 0);
+
+    {
+        MTX_GRD_RW_LOCK_SC(&test_mtx_grd_rw, MTX_GRD_RW_MODE_EXCLUSIVE, dummy_rw_lock);
+        CU_ASSERT_PTR_NOT_NULL(dummy_rw_lock);
+        CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_UPGRADABLE, 0), EBUSY);
+    }
+
+    CU_ASSERT_EQUAL(MutexGuardRwGetHolders(&test_mtx_grd_rw, holders, 2), 0);
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_EXCLUSIVE, 0), 0);
+}
+
+static void TestRwReaderBias()
+{
+    MTX_GRD_RW_HOLDER holders[2];
+    MTX_GRD_RW_BIAS_STATS bias_stats;
+
+    CU_ASSERT_EQUAL(MTX_GRD_RW_SET_READER_BIAS(NULL, true), -1);
+    CU_ASSERT_EQUAL(MutexGuardRwGetBiasStats(NULL, &bias_stats), -1);
+
+    MTX_GRD_RW_CREATE(test_mtx_grd_rw);
+    MTX_GRD_RW_INIT_SC(&test_mtx_grd_rw, MTX_GRD_RW_PREFER_WRITERS, dummy_rw);
+    CU_ASSERT_EQUAL(MutexGuardRwGetBiasStats(&test_mtx_grd_rw, NULL), -2);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_SET_READER_BIAS(&test_mtx_grd_rw, true), 0);
+
+    // The first reader goes through the rwlock and turns the bias on, the next ones only publish themselves.
+    CU_ASSERT_EQUAL(MTX_GRD_RW_LOCK(&test_mtx_grd_rw, MTX_GRD_RW_MODE_SHARED), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_UNLOCK(&test_mtx_grd_rw), 0);
+    CU_ASSERT_EQUAL(MutexGuardRwGetBiasStats(&test_mtx_grd_rw, &bias_stats), 0);
+    CU_ASSERT(bias_stats.biased);
+    CU_ASSERT_EQUAL(bias_stats.revocation_counter, 0);
+
+    CU_ASSERT_EQUAL(MTX_GRD_RW_LOCK(&test_mtx_grd_rw, MTX_GRD_RW_MODE_SHARED), 0);
+    CU_ASSERT_EQUAL(MutexGuardRwGetHolders(&test_mtx_grd_rw, holders, 2), 1);
+    CU_ASSERT_EQUAL(holders[0].mode, MTX_GRD_RW_MODE_SHARED);
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_SHARED, 0), 0);
+
+    // Writers which cannot wait for the biased reader give up and leave the bias on.
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_EXCLUSIVE, 0), EBUSY);
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_EXCLUSIVE, 10000000), ETIMEDOUT);
+    CU_ASSERT_EQUAL(MutexGuardRwGetBiasStats(&test_mtx_grd_rw, &bias_stats), 0);
+    CU_ASSERT(bias_stats.biased);
+    CU_ASSERT_EQUAL(bias_stats.revocation_counter, 0);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_UNLOCK(&test_mtx_grd_rw), 0);
+
+    CU_ASSERT_EQUAL(TestRwLockFromThread(&test_mtx_grd_rw, MTX_GRD_RW_MODE_EXCLUSIVE, 0), 0);
+    CU_ASSERT_EQUAL(MutexGuardRwGetBiasStats(&test_mtx_grd_rw, &bias_stats), 0);
+    CU_ASSERT(!bias_stats.biased);
+    CU_ASSERT_EQUAL(bias_stats.revocation_counter, 1);
+    CU_ASSERT(bias_stats.inhibit_until_ns > 0);
+
+    CU_ASSERT_EQUAL(MTX_GRD_RW_SET_READER_BIAS(&test_mtx_grd_rw, false), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_LOCK(&test_mtx_grd_rw, MTX_GRD_RW_MODE_SHARED), 0);
+    CU_ASSERT_EQUAL(MTX_GRD_RW_UNLOCK(&test_mtx_grd_rw), 0);
+    CU_ASSERT_EQUAL(MutexGuardRwGetBiasStats(&test_mtx_grd_rw, &bias_stats), 0);
+    CU_ASSERT(!bias_stats.biased);
 }
 
 int CreateReturnValueTestsSuite()
@@ -211,10 +1870,38 @@ int CreateReturnValueTestsSuite()
     ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestLock);
     ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestLockAddr);
     ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestUnlock);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestRobustLock);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestPrioStats);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestPrioCeiling);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestDumpAll);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestHoldBudget);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestGetStats);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestGetStatsDelta);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestSampling);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestExportPrometheus);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestExportShm);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestContentionProfile);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestSlowCapture);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestExecute);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestLockMany);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestLockManyOwnerDead);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestDelegation);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestBatch);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestDeferAfterUnlock);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestLockAsync);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestSourceCallsite);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestExternalOwner);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestTrace);
     ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestAttrDestroy);
     ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestDestroy);
     ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestSetInternalErrMode);
     ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestGetInternalErrMode);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestShmOpen);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestCondInit);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestCondTimedWait);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestCondBroadcast);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestRwLock);
+    ADD_TEST_2_SUITE(pReturnValueTestsSuite, TestRwReaderBias);
 
     return 0;
 }
@@ -0,0 +1,388 @@
+/************************************************************************************************************/
+// mgtop: live, top-like viewer of the stats segment published by MutexGuardExporterStartShm.
+// Attaches read-only, so it neither blocks nor slows down the observed process.
+/************************************************************************************************************/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "MutexGuard_api.h"
+
+#define MGTOP_DEFAULT_INTERVAL_MS   1000
+#define MGTOP_SEQLOCK_RETRY_NUM     1000
+#define MGTOP_1_S_AS_NS             1000000000ULL
+#define MGTOP_1_MS_AS_NS            1000000ULL
+#define MGTOP_1_US_AS_NS            1000ULL
+#define MGTOP_CLEAR_SCREEN          "\033[H\033[2J"
+#define MGTOP_USAGE                 "Usage: %s [-n interval_ms] [-s acq|cont|wait|hold|waiters|name] [-b] <shm name>\n"     \
+                                    "  -n  Refresh interval in milliseconds (default %d).\n"                                \
+                                    "  -s  Sort key (default cont).\n"                                                      \
+                                    "  -b  Batch mode: print one snapshot and exit.\n"                                      \
+                                    "Keys: a/c/w/h/W/n sort by acquisitions/contentions/wait/hold/waiters/name, q quits.\n"
+
+/// @brief Sort keys.
+typedef enum
+{
+    MGTOP_SORT_ACQ = 0  ,
+    MGTOP_SORT_CONT     ,
+    MGTOP_SORT_WAIT     ,
+    MGTOP_SORT_HOLD     ,
+    MGTOP_SORT_WAITERS  ,
+    MGTOP_SORT_NAME
+} MGTOP_SORT;
+
+/// @brief Displayed row: a published entry plus its rates since the previous snapshot.
+typedef struct
+{
+    MTX_GRD_STATS_SHM_ENTRY entry;
+    double                  acq_rate;
+    double                  cont_rate;
+    double                  wait_ms_rate;
+} MGTOP_ROW;
+
+/// @brief Consistent copy of the stats segment.
+typedef struct
+{
+    MTX_GRD_STATS_SHM           header;
+    MTX_GRD_STATS_SHM_ENTRY*    entries;
+} MGTOP_SNAPSHOT;
+
+static MGTOP_SORT sort_key = MGTOP_SORT_CONT;
+static struct termios saved_termios;
+static bool raw_terminal = false;
+
+/// @brief Reads a consistent snapshot of the segment, retrying while the publisher is writing it.
+/// @param p_segment Pointer to the mapped segment.
+/// @param p_snapshot Pointer to target snapshot (its entries must fit the segment's capacity).
+/// @return 0 if succeeded, < 0 otherwise.
+static int MgtopReadSnapshot(const MTX_GRD_STATS_SHM* p_segment, MGTOP_SNAPSHOT* p_snapshot)
+{
+    for(int retry = 0; retry < MGTOP_SEQLOCK_RETRY_NUM; retry++)
+    {
+        uint32_t sequence = __atomic_load_n(&p_segment->sequence, __ATOMIC_ACQUIRE);
+
+        if(sequence & 1)
+        {
+            sched_yield();
+            continue;
+        }
+
+        memcpy(&p_snapshot->header, p_segment, sizeof(MTX_GRD_STATS_SHM));
+
+        if(p_snapshot->header.entry_num > p_snapshot->header.entry_capacity)
+            continue;
+
+        memcpy(p_snapshot->entries, MTX_GRD_STATS_SHM_ENTRIES(p_segment), p_snapshot->header.entry_num * sizeof(MTX_GRD_STATS_SHM_ENTRY));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if(__atomic_load_n(&p_segment->sequence, __ATOMIC_RELAXED) == sequence)
+            return 0;
+    }
+
+    return -1;
+}
+
+/// @brief Compares two rows according to the current sort key (descending, but for names).
+static int MgtopCompareRows(const void* a, const void* b)
+{
+    const MGTOP_ROW* p_a = a;
+    const MGTOP_ROW* p_b = b;
+    double value_a = 0;
+    double value_b = 0;
+
+    switch(sort_key)
+    {
+        case MGTOP_SORT_ACQ:        value_a = p_a->acq_rate;                    value_b = p_b->acq_rate;                    break;
+        case MGTOP_SORT_CONT:       value_a = p_a->cont_rate;                   value_b = p_b->cont_rate;                   break;
+        case MGTOP_SORT_WAIT:       value_a = p_a->wait_ms_rate;                value_b = p_b->wait_ms_rate;                break;
+        case MGTOP_SORT_HOLD:       value_a = (double)p_a->entry.hold_ns_max;   value_b = (double)p_b->entry.hold_ns_max;   break;
+        case MGTOP_SORT_WAITERS:    value_a = p_a->entry.waiter_counter;        value_b = p_b->entry.waiter_counter;        break;
+        case MGTOP_SORT_NAME:       return strcmp(p_a->entry.name, p_b->entry.name);
+    }
+
+    return (value_a < value_b) - (value_a > value_b);
+}
+
+/// @brief Looks for a guard's entry in the previous snapshot.
+static const MTX_GRD_STATS_SHM_ENTRY* MgtopFindPrevious(const MGTOP_SNAPSHOT* p_previous, const uint64_t guard_address)
+{
+    for(uint32_t index = 0; index < p_previous->header.entry_num; index++)
+        if(p_previous->entries[index].guard_address == guard_address)
+            return &p_previous->entries[index];
+
+    return NULL;
+}
+
+/// @brief Prints a snapshot as a table, with rates computed against the previous snapshot (if any).
+static void MgtopPrint(const char* shm_name, const MGTOP_SNAPSHOT* p_current, const MGTOP_SNAPSHOT* p_previous, MGTOP_ROW* rows, const bool clear_screen)
+{
+    uint64_t elapsed_ns = ((p_previous->header.publish_ns && (p_current->header.publish_ns > p_previous->header.publish_ns)) ? (p_current->header.publish_ns - p_previous->header.publish_ns) : 0);
+    double elapsed_s    = (double)elapsed_ns / MGTOP_1_S_AS_NS;
+
+    for(uint32_t index = 0; index < p_current->header.entry_num; index++)
+    {
+        const MTX_GRD_STATS_SHM_ENTRY* p_entry          = &p_current->entries[index];
+        const MTX_GRD_STATS_SHM_ENTRY* p_previous_entry = (elapsed_ns ? MgtopFindPrevious(p_previous, p_entry->guard_address) : NULL);
+
+        rows[index].entry           = *p_entry;
+        rows[index].acq_rate        = 0;
+        rows[index].cont_rate       = 0;
+        rows[index].wait_ms_rate    = 0;
+
+        if(p_previous_entry && (p_entry->acquisition_counter >= p_previous_entry->acquisition_counter))
+        {
+            rows[index].acq_rate        = (p_entry->acquisition_counter - p_previous_entry->acquisition_counter) / elapsed_s;
+            rows[index].cont_rate       = (p_entry->contention_counter - p_previous_entry->contention_counter) / elapsed_s;
+            rows[index].wait_ms_rate    = ((double)(p_entry->wait_ns_total - p_previous_entry->wait_ns_total) / MGTOP_1_MS_AS_NS) / elapsed_s;
+        }
+    }
+
+    qsort(rows, p_current->header.entry_num, sizeof(MGTOP_ROW), MgtopCompareRows);
+
+    if(clear_screen)
+        printf(MGTOP_CLEAR_SCREEN);
+
+    printf("mgtop - %s - pid %d - %" PRIu32 " guards%s\n\n",  shm_name, p_current->header.pid, p_current->header.entry_num,
+                                                                (elapsed_ns ? "" : " (rates available from next refresh)"));
+    printf("%-24s %-18s %10s %10s %10s %7s %12s %12s %12s %8s\n", "NAME", "GUARD", "ACQ/s", "CONT/s", "WAITms/s", "WAITERS",
+                                                                    "HOLD_AVGus", "HOLD_MAXus", "HOLD_NOWus", "OWNER");
+
+    for(uint32_t index = 0; index < p_current->header.entry_num; index++)
+    {
+        const MTX_GRD_STATS_SHM_ENTRY* p_entry = &rows[index].entry;
+        uint64_t hold_avg_ns = (p_entry->acquisition_counter ? (p_entry->hold_ns_total / p_entry->acquisition_counter) : 0);
+        char owner[16];
+
+        if(p_entry->owner_tid)
+            snprintf(owner, sizeof(owner), "%d", p_entry->owner_tid);
+        else
+            snprintf(owner, sizeof(owner), "-");
+
+        printf("%-24.24s 0x%016" PRIx64 " %10.1f %10.1f %10.2f %7" PRIu32 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %8s\n",
+                (p_entry->name[0] ? p_entry->name : "-"), p_entry->guard_address, rows[index].acq_rate, rows[index].cont_rate,
+                rows[index].wait_ms_rate, p_entry->waiter_counter, (uint64_t)(hold_avg_ns / MGTOP_1_US_AS_NS), (uint64_t)(p_entry->hold_ns_max / MGTOP_1_US_AS_NS),
+                (uint64_t)(p_entry->hold_ns_current / MGTOP_1_US_AS_NS), owner);
+    }
+
+    fflush(stdout);
+}
+
+/// @brief Restores the terminal mode (if changed).
+static void MgtopRestoreTerminal(void)
+{
+    if(raw_terminal)
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+}
+
+/// @brief Switches the terminal to non-canonical mode, so that keys are read without waiting for a new line.
+static void MgtopRawTerminal(void)
+{
+    if(!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &saved_termios))
+        return;
+
+    struct termios raw_termios = saved_termios;
+    raw_termios.c_lflag &= ~(ICANON | ECHO);
+    raw_termios.c_cc[VMIN]  = 0;
+    raw_termios.c_cc[VTIME] = 0;
+
+    if(!tcsetattr(STDIN_FILENO, TCSANOW, &raw_termios))
+    {
+        raw_terminal = true;
+        atexit(MgtopRestoreTerminal);
+    }
+}
+
+/// @brief Parses a sort key.
+/// @return 0 if succeeded, < 0 otherwise.
+static int MgtopParseSortKey(const char* key)
+{
+    static const char* const keys[] = {"acq", "cont", "wait", "hold", "waiters", "name"};
+
+    for(size_t index = 0; index < (sizeof(keys) / sizeof(keys[0])); index++)
+        if(!strcmp(key, keys[index]))
+        {
+            sort_key = (MGTOP_SORT)index;
+            return 0;
+        }
+
+    return -1;
+}
+
+/// @brief Waits for the refresh interval, handling key presses meanwhile.
+/// @return true if the user asked to quit.
+static bool MgtopWaitForKeys(const int interval_ms)
+{
+    struct pollfd stdin_poll = {.fd = STDIN_FILENO, .events = POLLIN};
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    while(true)
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        long elapsed_ms = ((now.tv_sec - start.tv_sec) * 1000) + ((now.tv_nsec - start.tv_nsec) / (long)MGTOP_1_MS_AS_NS);
+
+        if(elapsed_ms >= interval_ms)
+            return false;
+
+        if((poll(&stdin_poll, (raw_terminal ? 1 : 0), interval_ms - elapsed_ms) <= 0) || !raw_terminal)
+            continue;
+
+        char key;
+
+        if(read(STDIN_FILENO, &key, 1) != 1)
+            continue;
+
+        switch(key)
+        {
+            case 'a':   sort_key = MGTOP_SORT_ACQ;      return false;
+            case 'c':   sort_key = MGTOP_SORT_CONT;     return false;
+            case 'w':   sort_key = MGTOP_SORT_WAIT;     return false;
+            case 'h':   sort_key = MGTOP_SORT_HOLD;     return false;
+            case 'W':   sort_key = MGTOP_SORT_WAITERS;  return false;
+            case 'n':   sort_key = MGTOP_SORT_NAME;     return false;
+            case 'q':   return true;
+            default:    break;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int interval_ms = MGTOP_DEFAULT_INTERVAL_MS;
+    bool batch_mode = false;
+    int option;
+
+    while((option = getopt(argc, argv, "n:s:bh")) != -1)
+    {
+        switch(option)
+        {
+            case 'n':
+                interval_ms = atoi(optarg);
+                if(interval_ms > 0)
+                    break;
+                fprintf(stderr, "Invalid interval: %s\n", optarg);
+                return EXIT_FAILURE;
+            case 's':
+                if(!MgtopParseSortKey(optarg))
+                    break;
+                fprintf(stderr, "Invalid sort key: %s\n", optarg);
+                return EXIT_FAILURE;
+            case 'b':
+                batch_mode = true;
+                break;
+            default:
+                fprintf(stderr, MGTOP_USAGE, argv[0], MGTOP_DEFAULT_INTERVAL_MS);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if(optind != (argc - 1))
+    {
+        fprintf(stderr, MGTOP_USAGE, argv[0], MGTOP_DEFAULT_INTERVAL_MS);
+        return EXIT_FAILURE;
+    }
+
+    const char* shm_name = argv[optind];
+    int shm_fd = shm_open(shm_name, O_RDONLY, 0);
+    struct stat shm_stat;
+
+    if((shm_fd < 0) || fstat(shm_fd, &shm_stat))
+    {
+        fprintf(stderr, "Could not open %s: %s\n", shm_name, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    if((size_t)shm_stat.st_size < sizeof(MTX_GRD_STATS_SHM))
+    {
+        fprintf(stderr, "%s is not a MTX_GRD stats segment\n", shm_name);
+        return EXIT_FAILURE;
+    }
+
+    const MTX_GRD_STATS_SHM* p_segment = mmap(NULL, shm_stat.st_size, PROT_READ, MAP_SHARED, shm_fd, 0);
+    close(shm_fd);
+
+    if(p_segment == MAP_FAILED)
+    {
+        fprintf(stderr, "Could not map %s: %s\n", shm_name, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    if( (__atomic_load_n(&p_segment->magic, __ATOMIC_ACQUIRE) != MTX_GRD_STATS_SHM_MAGIC)  ||
+        (p_segment->version != MTX_GRD_STATS_SHM_VERSION)                                   ||
+        ((size_t)shm_stat.st_size < MTX_GRD_STATS_SHM_SIZE(p_segment->entry_capacity))      )
+    {
+        fprintf(stderr, "%s is not a compatible MTX_GRD stats segment\n", shm_name);
+        return EXIT_FAILURE;
+    }
+
+    uint32_t entry_capacity     = p_segment->entry_capacity;
+    MGTOP_SNAPSHOT current      = {.entries = calloc(entry_capacity, sizeof(MTX_GRD_STATS_SHM_ENTRY))};
+    MGTOP_SNAPSHOT previous     = {.entries = calloc(entry_capacity, sizeof(MTX_GRD_STATS_SHM_ENTRY))};
+    MGTOP_ROW* rows             = calloc(entry_capacity, sizeof(MGTOP_ROW));
+
+    if(!current.entries || !previous.entries || !rows)
+    {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    if(!batch_mode)
+        MgtopRawTerminal();
+
+    bool quit = false;
+
+    while(!quit)
+    {
+        if(MgtopReadSnapshot(p_segment, &current))
+        {
+            fprintf(stderr, "Could not read a consistent snapshot of %s\n", shm_name);
+            return EXIT_FAILURE;
+        }
+
+        // Both publishes are needed for rates, so batch mode waits for the next one before printing.
+        if(batch_mode && !previous.header.publish_ns)
+        {
+            MGTOP_SNAPSHOT swap = previous;
+            previous            = current;
+            current             = swap;
+
+            uint64_t sleep_ns = (previous.header.period_ns ? previous.header.period_ns : MGTOP_1_S_AS_NS);
+            struct timespec sleep_time = {.tv_sec = sleep_ns / MGTOP_1_S_AS_NS, .tv_nsec = sleep_ns % MGTOP_1_S_AS_NS};
+            nanosleep(&sleep_time, NULL);
+            continue;
+        }
+
+        MgtopPrint(shm_name, &current, &previous, rows, !batch_mode);
+
+        MGTOP_SNAPSHOT swap = previous;
+        previous            = current;
+        current             = swap;
+
+        quit = (batch_mode || MgtopWaitForKeys(interval_ms));
+    }
+
+    free(rows);
+    free(current.entries);
+    free(previous.entries);
+    munmap((void*)p_segment, shm_stat.st_size);
+
+    return EXIT_SUCCESS;
+}